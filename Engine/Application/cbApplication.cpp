@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/Prefetch.h>
 #include <Engine/Graphics/Graphics.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/Time/Time.h>
@@ -288,6 +289,17 @@ eae6320::cResult eae6320::Application::cbApplication::Initialize_all( const sEnt
         EAE6320_ASSERT( false );
         goto OnExit;
     }
+    // Start prefetching the assets that were loaded the last time the application was initialized
+    // so that reading them overlaps with initializing the engine
+    if ( const auto* const path_manifest = GetAssetPrefetchManifestPath() )
+    {
+        if ( !Assets::StartPrefetchingManifest( path_manifest ) )
+        {
+            // The application can still be initialized without prefetching
+            Logging::OutputError( "Asset prefetching couldn't be started; assets will be loaded normally" );
+        }
+        Assets::StartRecordingManifest();
+    }
     // Initialize engine systems
     if ( !( result = Initialize_engine() ) )
     {
@@ -300,6 +312,13 @@ eae6320::cResult eae6320::Application::cbApplication::Initialize_all( const sEnt
         EAE6320_ASSERT( false );
         goto OnExit;
     }
+    // Save the assets that were loaded for the next time the application starts
+    // (and free any prefetched data that is no longer needed)
+    if ( const auto* const path_manifest = GetAssetPrefetchManifestPath() )
+    {
+        Assets::StopRecordingManifestAndSave( path_manifest );
+        Assets::StopPrefetching();
+    }
 
     // Start the application loop thread
     if ( !( result = m_applicationLoopThread.Start( EntryPoint_applicationLoopThread, this ) ) )
@@ -384,6 +403,18 @@ eae6320::cResult eae6320::Application::cbApplication::CleanUp_all()
             }
         }
     }
+    // Make sure that prefetching has stopped even if initialization failed
+    {
+        const auto localResult = Assets::StopPrefetching();
+        if ( !localResult )
+        {
+            EAE6320_ASSERT( false );
+            if ( result )
+            {
+                result = localResult;
+            }
+        }
+    }
     // Clean up the derived application
     {
         const auto localResult = CleanUp();
@@ -136,6 +136,12 @@ namespace eae6320
             // and observe the change in responsiveness or simulation accuracy.
             virtual float GetSimulationUpdatePeriod_inSeconds() const { return 1.0f / 15.0f; }
 
+            // If this returns a path then the asset files that are loaded during Initialize() are recorded in a manifest at that path,
+            // and the next time the application starts every file in that manifest will be prefetched in parallel
+            // while the engine and application are initializing.
+            // The default is to not record or prefetch anything.
+            virtual const char* GetAssetPrefetchManifestPath() const { return nullptr; }
+
             // Run
             //----
 
@@ -0,0 +1,565 @@
+// Include Files
+//==============
+
+#include "Compression.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Concurrency/cThread.h>
+#include <sstream>
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+    // A compressed file is laid out as:
+    //  * sHeader
+    //  * uint32_t[blockCount], the compressed size of each block
+    //      (if the high bit is set the block is stored uncompressed)
+    //  * The blocks, one after the other
+    struct sHeader
+    {
+        uint32_t fourCc;
+        // The four CC alone could also be the start of an uncompressed file,
+        // and so a header is only trusted if its version is known
+        // and its sizes exactly describe the rest of the data
+        uint32_t version;
+        uint32_t uncompressedSize;
+        uint32_t blockSize;
+        uint32_t blockCount;
+    };
+
+    struct sDecompressionJob
+    {
+        const uint8_t* compressedData = nullptr;
+        std::vector<uint32_t> blockSizes;
+        std::vector<size_t> blockOffsets;
+        uint8_t* uncompressedData = nullptr;
+        size_t uncompressedSize = 0;
+        uint32_t blockSize = 0;
+        std::atomic<uint32_t> nextBlockIndex;
+        std::atomic<bool> wasThereAnError;
+
+        sDecompressionJob() : nextBlockIndex( 0 ), wasThereAnError( false ) {}
+    };
+}
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+    constexpr uint32_t s_fourCc = 'E' | ( 'A' << 8 ) | ( 'E' << 16 ) | ( 'Z' << 24 );
+    constexpr uint32_t s_version = 1;
+    constexpr uint32_t s_isBlockStoredFlag = 0x80000000;
+
+    constexpr unsigned int s_hashBitCount = 14;
+    constexpr size_t s_minMatchLength = 4;
+    constexpr size_t s_maxMatchOffset = 0xffff;
+    // A length that doesn't fit in a token's 4 bits is continued in extra bytes
+    constexpr size_t s_maxTokenLength = 15;
+
+    constexpr unsigned int s_maxDecompressionThreadCount = 8;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+    // Codec
+    void CompressBlock( const uint8_t* const i_data, const size_t i_size, std::vector<int32_t>& io_hashTable, std::vector<uint8_t>& io_compressedData );
+    bool DecompressBlock( const uint8_t* const i_compressedData, const size_t i_compressedSize, uint8_t* const o_data, const size_t i_size );
+    uint32_t Hash( const uint32_t i_value );
+    uint32_t Read32( const uint8_t* const i_data );
+    bool ReadLength( const uint8_t*& io_position, const uint8_t* const i_end, size_t& io_length );
+    void WriteLength( size_t i_length, std::vector<uint8_t>& io_compressedData );
+    void WriteSequence( const uint8_t* const i_literals, const size_t i_literalCount, const size_t i_matchOffset, const size_t i_matchLength,
+        std::vector<uint8_t>& io_compressedData );
+
+    // Container
+    void DecompressBlocks( void* const io_job );
+    bool ReadHeader( const void* const i_data, const size_t i_size, sHeader& o_header );
+}
+
+// Interface
+//==========
+
+bool eae6320::Assets::Compression::IsCompressed( const void* const i_data, const size_t i_size )
+{
+    sHeader header;
+    return ReadHeader( i_data, i_size, header );
+}
+
+eae6320::cResult eae6320::Assets::Compression::Compress( const void* const i_data, const size_t i_size, std::vector<uint8_t>& o_compressedData,
+    const uint32_t i_blockSize )
+{
+    o_compressedData.clear();
+
+    if ( ( i_size == 0 ) || ( i_size > ( s_isBlockStoredFlag - 1 ) ) || ( i_blockSize == 0 ) || ( i_blockSize >= s_isBlockStoredFlag ) )
+    {
+        // Empty files aren't worth compressing and huge files can't be described by the header
+        return Results::Success;
+    }
+
+    const auto* const data = static_cast<const uint8_t*>( i_data );
+    sHeader header;
+    {
+        header.fourCc = s_fourCc;
+        header.version = s_version;
+        header.uncompressedSize = static_cast<uint32_t>( i_size );
+        header.blockSize = i_blockSize;
+        header.blockCount = static_cast<uint32_t>( ( i_size + i_blockSize - 1 ) / i_blockSize );
+    }
+    std::vector<uint32_t> blockSizes;
+    std::vector<uint8_t> blocks;
+    {
+        blockSizes.reserve( header.blockCount );
+        blocks.reserve( i_size );
+        std::vector<int32_t> hashTable( size_t( 1 ) << s_hashBitCount );
+        std::vector<uint8_t> compressedBlock;
+        for ( uint32_t i = 0; i < header.blockCount; ++i )
+        {
+            const auto offset = static_cast<size_t>( i ) * i_blockSize;
+            const auto size = ( ( i_size - offset ) < i_blockSize ) ? ( i_size - offset ) : static_cast<size_t>( i_blockSize );
+            compressedBlock.clear();
+            CompressBlock( data + offset, size, hashTable, compressedBlock );
+            if ( compressedBlock.size() < size )
+            {
+                blockSizes.push_back( static_cast<uint32_t>( compressedBlock.size() ) );
+                blocks.insert( blocks.end(), compressedBlock.begin(), compressedBlock.end() );
+            }
+            else
+            {
+                // Incompressible blocks are stored as-is
+                blockSizes.push_back( static_cast<uint32_t>( size ) | s_isBlockStoredFlag );
+                blocks.insert( blocks.end(), data + offset, data + offset + size );
+            }
+        }
+    }
+
+    const auto compressedSize = sizeof( header ) + ( blockSizes.size() * sizeof( uint32_t ) ) + blocks.size();
+    if ( compressedSize < i_size )
+    {
+        o_compressedData.resize( compressedSize );
+        auto* output = o_compressedData.data();
+        memcpy( output, &header, sizeof( header ) );
+        output += sizeof( header );
+        memcpy( output, blockSizes.data(), blockSizes.size() * sizeof( uint32_t ) );
+        output += blockSizes.size() * sizeof( uint32_t );
+        memcpy( output, blocks.data(), blocks.size() );
+    }
+
+    return Results::Success;
+}
+
+eae6320::cResult eae6320::Assets::Compression::Decompress( const void* const i_compressedData, const size_t i_compressedSize,
+    Platform::sDataFromFile& o_data, const unsigned int i_maxThreadCount, std::string* const o_errorMessage )
+{
+    auto result = Results::Success;
+
+    sHeader header;
+    sDecompressionJob job;
+    Concurrency::cThread threads[s_maxDecompressionThreadCount];
+    unsigned int startedThreadCount = 0;
+
+    if ( !ReadHeader( i_compressedData, i_compressedSize, header ) )
+    {
+        result = Results::InvalidFile;
+        if ( o_errorMessage )
+        {
+            *o_errorMessage = "The data doesn't have a valid compression header";
+        }
+        goto OnExit;
+    }
+    // Find where each block starts
+    // (ReadHeader() has already made sure that they add up to the size of the data)
+    {
+        const auto* const blockSizes = static_cast<const uint8_t*>( i_compressedData ) + sizeof( header );
+        job.blockSizes.resize( header.blockCount );
+        memcpy( job.blockSizes.data(), blockSizes, header.blockCount * sizeof( uint32_t ) );
+        job.compressedData = blockSizes + ( header.blockCount * sizeof( uint32_t ) );
+        job.blockOffsets.reserve( header.blockCount );
+        size_t offset = 0;
+        for ( const auto blockSize : job.blockSizes )
+        {
+            job.blockOffsets.push_back( offset );
+            offset += blockSize & ~s_isBlockStoredFlag;
+        }
+        EAE6320_ASSERT( offset == ( i_compressedSize - ( sizeof( header ) + ( header.blockCount * sizeof( uint32_t ) ) ) ) );
+    }
+    // Allocate the uncompressed data
+    {
+        job.uncompressedSize = header.uncompressedSize;
+        job.blockSize = header.blockSize;
+        job.uncompressedData = static_cast<uint8_t*>( malloc( header.uncompressedSize ) );
+        if ( !job.uncompressedData )
+        {
+            result = Results::OutOfMemory;
+            if ( o_errorMessage )
+            {
+                std::ostringstream errorMessage;
+                errorMessage << "Failed to allocate " << header.uncompressedSize << " bytes for the decompressed data";
+                *o_errorMessage = errorMessage.str();
+            }
+            goto OnExit;
+        }
+    }
+    // Decompress the blocks.
+    // The calling thread always helps,
+    // and additional threads are only started if there are enough blocks for them to do
+    {
+        auto threadCount = ( i_maxThreadCount < s_maxDecompressionThreadCount ) ? i_maxThreadCount : s_maxDecompressionThreadCount;
+        if ( threadCount > header.blockCount )
+        {
+            threadCount = header.blockCount;
+        }
+        for ( unsigned int i = 1; i < threadCount; ++i )
+        {
+            if ( !threads[startedThreadCount].Start( DecompressBlocks, &job ) )
+            {
+                // The remaining blocks will be decompressed by the threads that did start
+                break;
+            }
+            ++startedThreadCount;
+        }
+        DecompressBlocks( &job );
+        for ( unsigned int i = 0; i < startedThreadCount; ++i )
+        {
+            const auto localResult = Concurrency::WaitForThreadToStop( threads[i] );
+            EAE6320_ASSERT( localResult );
+        }
+        if ( job.wasThereAnError )
+        {
+            result = Results::InvalidFile;
+            if ( o_errorMessage )
+            {
+                *o_errorMessage = "The compressed data is corrupt";
+            }
+            goto OnExit;
+        }
+    }
+
+OnExit:
+
+    if ( result )
+    {
+        o_data.data = job.uncompressedData;
+        o_data.size = job.uncompressedSize;
+    }
+    else if ( job.uncompressedData )
+    {
+        free( job.uncompressedData );
+    }
+
+    return result;
+}
+
+eae6320::cResult eae6320::Assets::Compression::CompressFile( const char* const i_path, std::string* const o_errorMessage )
+{
+    auto result = Results::Success;
+
+    Platform::sDataFromFile dataFromFile;
+    std::vector<uint8_t> compressedData;
+
+    if ( !( result = Platform::LoadBinaryFile( i_path, dataFromFile, o_errorMessage ) ) )
+    {
+        goto OnExit;
+    }
+    if ( IsCompressed( dataFromFile.data, dataFromFile.size ) )
+    {
+        goto OnExit;
+    }
+    if ( !( result = Compress( dataFromFile.data, dataFromFile.size, compressedData ) ) )
+    {
+        goto OnExit;
+    }
+    if ( !compressedData.empty() )
+    {
+        if ( !( result = Platform::WriteBinaryFile( i_path, compressedData.data(), compressedData.size(), o_errorMessage ) ) )
+        {
+            goto OnExit;
+        }
+    }
+
+OnExit:
+
+    dataFromFile.Free();
+
+    return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+    // Codec
+    //------
+
+    // A block is a series of sequences:
+    //  * A token byte (the high 4 bits are the literal count and the low 4 bits are the match length minus the minimum)
+    //  * Extra literal count bytes if the count didn't fit in the token
+    //  * The literals
+    //  * A 2 byte offset back into the already-decompressed data
+    //  * Extra match length bytes if the length didn't fit in the token
+    // The final sequence in a block only has literals (and may have zero of them)
+
+    void CompressBlock( const uint8_t* const i_data, const size_t i_size, std::vector<int32_t>& io_hashTable, std::vector<uint8_t>& io_compressedData )
+    {
+        std::fill( io_hashTable.begin(), io_hashTable.end(), -1 );
+
+        size_t literalStart = 0;
+        size_t position = 0;
+        while ( ( position + s_minMatchLength ) <= i_size )
+        {
+            const auto value = Read32( i_data + position );
+            auto& hashTableEntry = io_hashTable[Hash( value )];
+            const auto candidate = hashTableEntry;
+            hashTableEntry = static_cast<int32_t>( position );
+            if ( ( candidate >= 0 ) && ( ( position - static_cast<size_t>( candidate ) ) <= s_maxMatchOffset )
+                && ( Read32( i_data + candidate ) == value ) )
+            {
+                auto matchLength = s_minMatchLength;
+                while ( ( ( position + matchLength ) < i_size ) && ( i_data[candidate + matchLength] == i_data[position + matchLength] ) )
+                {
+                    ++matchLength;
+                }
+                WriteSequence( i_data + literalStart, position - literalStart, position - static_cast<size_t>( candidate ), matchLength,
+                    io_compressedData );
+                position += matchLength;
+                literalStart = position;
+            }
+            else
+            {
+                ++position;
+            }
+        }
+        constexpr size_t noMatch = 0;
+        WriteSequence( i_data + literalStart, i_size - literalStart, noMatch, noMatch, io_compressedData );
+    }
+
+    bool DecompressBlock( const uint8_t* const i_compressedData, const size_t i_compressedSize, uint8_t* const o_data, const size_t i_size )
+    {
+        const auto* input = i_compressedData;
+        const auto* const inputEnd = i_compressedData + i_compressedSize;
+        auto* output = o_data;
+        const auto* const outputEnd = o_data + i_size;
+        while ( input < inputEnd )
+        {
+            const auto token = *input++;
+            // Literals
+            {
+                size_t literalCount = token >> 4;
+                if ( ( literalCount == s_maxTokenLength ) && !ReadLength( input, inputEnd, literalCount ) )
+                {
+                    return false;
+                }
+                if ( ( literalCount > static_cast<size_t>( inputEnd - input ) ) || ( literalCount > static_cast<size_t>( outputEnd - output ) ) )
+                {
+                    return false;
+                }
+                memcpy( output, input, literalCount );
+                input += literalCount;
+                output += literalCount;
+            }
+            // The final sequence doesn't have a match
+            if ( input == inputEnd )
+            {
+                break;
+            }
+            // Match
+            {
+                if ( ( inputEnd - input ) < 2 )
+                {
+                    return false;
+                }
+                const size_t offset = input[0] | ( static_cast<size_t>( input[1] ) << 8 );
+                input += 2;
+                if ( ( offset == 0 ) || ( offset > static_cast<size_t>( output - o_data ) ) )
+                {
+                    return false;
+                }
+                size_t matchLength = token & 0x0f;
+                if ( ( matchLength == s_maxTokenLength ) && !ReadLength( input, inputEnd, matchLength ) )
+                {
+                    return false;
+                }
+                matchLength += s_minMatchLength;
+                if ( matchLength > static_cast<size_t>( outputEnd - output ) )
+                {
+                    return false;
+                }
+                const auto* const match = output - offset;
+                if ( offset >= matchLength )
+                {
+                    memcpy( output, match, matchLength );
+                }
+                else
+                {
+                    // An overlapping match repeats the most recent bytes
+                    for ( size_t i = 0; i < matchLength; ++i )
+                    {
+                        output[i] = match[i];
+                    }
+                }
+                output += matchLength;
+            }
+        }
+        return output == outputEnd;
+    }
+
+    uint32_t Hash( const uint32_t i_value )
+    {
+        return ( i_value * 2654435761u ) >> ( 32 - s_hashBitCount );
+    }
+
+    uint32_t Read32( const uint8_t* const i_data )
+    {
+        uint32_t value;
+        memcpy( &value, i_data, sizeof( value ) );
+        return value;
+    }
+
+    bool ReadLength( const uint8_t*& io_position, const uint8_t* const i_end, size_t& io_length )
+    {
+        uint8_t value;
+        do
+        {
+            if ( io_position >= i_end )
+            {
+                return false;
+            }
+            value = *io_position++;
+            io_length += value;
+        } while ( value == 0xff );
+        return true;
+    }
+
+    void WriteLength( size_t i_length, std::vector<uint8_t>& io_compressedData )
+    {
+        i_length -= s_maxTokenLength;
+        while ( i_length >= 0xff )
+        {
+            io_compressedData.push_back( 0xff );
+            i_length -= 0xff;
+        }
+        io_compressedData.push_back( static_cast<uint8_t>( i_length ) );
+    }
+
+    void WriteSequence( const uint8_t* const i_literals, const size_t i_literalCount, const size_t i_matchOffset, const size_t i_matchLength,
+        std::vector<uint8_t>& io_compressedData )
+    {
+        const auto tokenIndex = io_compressedData.size();
+        io_compressedData.push_back( 0 );
+        uint8_t token;
+        {
+            token = static_cast<uint8_t>( ( ( i_literalCount < s_maxTokenLength ) ? i_literalCount : s_maxTokenLength ) << 4 );
+            if ( i_literalCount >= s_maxTokenLength )
+            {
+                WriteLength( i_literalCount, io_compressedData );
+            }
+            io_compressedData.insert( io_compressedData.end(), i_literals, i_literals + i_literalCount );
+        }
+        if ( i_matchLength > 0 )
+        {
+            EAE6320_ASSERT( ( i_matchOffset > 0 ) && ( i_matchOffset <= s_maxMatchOffset ) && ( i_matchLength >= s_minMatchLength ) );
+            io_compressedData.push_back( static_cast<uint8_t>( i_matchOffset & 0xff ) );
+            io_compressedData.push_back( static_cast<uint8_t>( i_matchOffset >> 8 ) );
+            const auto lengthCode = i_matchLength - s_minMatchLength;
+            token |= static_cast<uint8_t>( ( lengthCode < s_maxTokenLength ) ? lengthCode : s_maxTokenLength );
+            if ( lengthCode >= s_maxTokenLength )
+            {
+                WriteLength( lengthCode, io_compressedData );
+            }
+        }
+        io_compressedData[tokenIndex] = token;
+    }
+
+    // Container
+    //----------
+
+    void DecompressBlocks( void* const io_job )
+    {
+        auto& job = *static_cast<sDecompressionJob*>( io_job );
+        const auto blockCount = static_cast<uint32_t>( job.blockSizes.size() );
+        for ( auto i = job.nextBlockIndex++; ( i < blockCount ) && !job.wasThereAnError; i = job.nextBlockIndex++ )
+        {
+            const auto offset_uncompressed = static_cast<size_t>( i ) * job.blockSize;
+            const auto size_uncompressed = ( ( job.uncompressedSize - offset_uncompressed ) < job.blockSize )
+                ? ( job.uncompressedSize - offset_uncompressed ) : static_cast<size_t>( job.blockSize );
+            const auto* const block = job.compressedData + job.blockOffsets[i];
+            const auto blockSize = job.blockSizes[i];
+            if ( ( blockSize & s_isBlockStoredFlag ) != 0 )
+            {
+                if ( ( blockSize & ~s_isBlockStoredFlag ) == size_uncompressed )
+                {
+                    memcpy( job.uncompressedData + offset_uncompressed, block, size_uncompressed );
+                }
+                else
+                {
+                    job.wasThereAnError = true;
+                }
+            }
+            else if ( !DecompressBlock( block, blockSize, job.uncompressedData + offset_uncompressed, size_uncompressed ) )
+            {
+                job.wasThereAnError = true;
+            }
+        }
+    }
+
+    bool ReadHeader( const void* const i_data, const size_t i_size, sHeader& o_header )
+    {
+        if ( !i_data || ( i_size < sizeof( o_header ) ) )
+        {
+            return false;
+        }
+        memcpy( &o_header, i_data, sizeof( o_header ) );
+        if ( ( o_header.fourCc != s_fourCc ) || ( o_header.version != s_version )
+            || ( o_header.blockSize == 0 ) || ( o_header.blockSize >= s_isBlockStoredFlag ) )
+        {
+            return false;
+        }
+        // Data is only stored compressed if that makes it smaller
+        if ( ( o_header.uncompressedSize == 0 ) || ( o_header.uncompressedSize <= i_size ) )
+        {
+            return false;
+        }
+        const auto expectedBlockCount = ( static_cast<uint64_t>( o_header.uncompressedSize ) + o_header.blockSize - 1 ) / o_header.blockSize;
+        if ( o_header.blockCount != expectedBlockCount )
+        {
+            return false;
+        }
+        const auto blocksOffset = sizeof( o_header ) + ( static_cast<uint64_t>( o_header.blockCount ) * sizeof( uint32_t ) );
+        if ( blocksOffset > i_size )
+        {
+            return false;
+        }
+        // The block sizes must add up to exactly the rest of the data,
+        // and no block can be bigger than the uncompressed block that it stores
+        {
+            const auto* const blockSizes = static_cast<const uint8_t*>( i_data ) + sizeof( o_header );
+            uint64_t blocksSize = 0;
+            for ( uint32_t i = 0; i < o_header.blockCount; ++i )
+            {
+                uint32_t blockSize;
+                memcpy( &blockSize, blockSizes + ( i * sizeof( uint32_t ) ), sizeof( blockSize ) );
+                blockSize &= ~s_isBlockStoredFlag;
+                if ( blockSize > o_header.blockSize )
+                {
+                    return false;
+                }
+                blocksSize += blockSize;
+            }
+            if ( ( blocksOffset + blocksSize ) != i_size )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,59 @@
+/*
+    Built asset files can optionally be compressed:
+        * The payload is split into fixed-size blocks
+            that are compressed independently with a fast LZ77-style codec
+            (the format is similar to LZ4: runs of literals followed by back-references of at most 64 KB)
+        * Because every block is independent the blocks can be decompressed in parallel,
+            each one directly into its final location in the uncompressed buffer
+        * A compressed file starts with a header that identifies it,
+            and so loaders can transparently handle both compressed and uncompressed files
+            (the header has a version, and its sizes must exactly match the data,
+            and so an uncompressed file that happens to start with the same four CC isn't mistaken for a compressed one)
+*/
+
+#ifndef EAE6320_ASSETS_COMPRESSION_H
+#define EAE6320_ASSETS_COMPRESSION_H
+
+// Include Files
+//==============
+
+#include <cstdint>
+#include <Engine/Platform/Platform.h>
+#include <Engine/Results/Results.h>
+#include <string>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+    namespace Assets
+    {
+        namespace Compression
+        {
+            // Larger blocks compress slightly better but give fewer opportunities for parallel decompression
+            constexpr uint32_t DefaultBlockSize = 64 * 1024;
+
+            // This returns true if the data starts with a valid compressed file header
+            bool IsCompressed( const void* const i_data, const size_t i_size );
+
+            // If the compressed data wouldn't be smaller than the uncompressed data
+            // the function still succeeds, but o_compressedData will be empty
+            // (the caller should store the data uncompressed)
+            cResult Compress( const void* const i_data, const size_t i_size, std::vector<uint8_t>& o_compressedData,
+                const uint32_t i_blockSize = DefaultBlockSize );
+            // The returned data is allocated in the same way as Platform::LoadBinaryFile()
+            // and must be freed by the caller.
+            // Blocks are decompressed on up to i_maxThreadCount threads (including the calling thread)
+            cResult Decompress( const void* const i_compressedData, const size_t i_compressedSize, Platform::sDataFromFile& o_data,
+                const unsigned int i_maxThreadCount = 4, std::string* const o_errorMessage = nullptr );
+
+            // This compresses a file in place
+            // (if compression doesn't make the file smaller it is left unchanged)
+            cResult CompressFile( const char* const i_path, std::string* const o_errorMessage = nullptr );
+        }
+    }
+}
+
+#endif	// EAE6320_ASSETS_COMPRESSION_H
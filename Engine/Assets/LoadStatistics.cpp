@@ -0,0 +1,68 @@
+// Include Files
+//==============
+
+#include "LoadStatistics.h"
+
+#include <Engine/Time/Time.h>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+    // Every thread can be loading its own asset
+    thread_local eae6320::Assets::sLoadStatistics* s_currentStatistics = nullptr;
+}
+
+// Interface
+//==========
+
+uint64_t eae6320::Assets::sLoadStatistics::GetDecodeTickCount() const
+{
+    const auto tickCount_notDecoding = tickCount_io + tickCount_upload;
+    return ( tickCount_total > tickCount_notDecoding ) ? ( tickCount_total - tickCount_notDecoding ) : 0;
+}
+
+eae6320::Assets::cLoadStatisticsScope::cLoadStatisticsScope( sLoadStatistics& io_statistics )
+    :
+    m_previousStatistics( s_currentStatistics )
+{
+    s_currentStatistics = &io_statistics;
+}
+
+eae6320::Assets::cLoadStatisticsScope::~cLoadStatisticsScope()
+{
+    s_currentStatistics = m_previousStatistics;
+}
+
+eae6320::Assets::cLoadPhaseTimer::cLoadPhaseTimer( const LoadPhases::eLoadPhase i_phase )
+    :
+    m_tickCount_start( Time::GetCurrentSystemTimeTickCount() ), m_phase( i_phase )
+{
+
+}
+
+eae6320::Assets::cLoadPhaseTimer::~cLoadPhaseTimer()
+{
+    if ( s_currentStatistics )
+    {
+        const auto tickCount_elapsed = Time::GetCurrentSystemTimeTickCount() - m_tickCount_start;
+        switch ( m_phase )
+        {
+        case LoadPhases::IO:
+            s_currentStatistics->tickCount_io += tickCount_elapsed;
+            break;
+        case LoadPhases::Upload:
+            s_currentStatistics->tickCount_upload += tickCount_elapsed;
+            break;
+        }
+    }
+}
+
+void eae6320::Assets::AddResidentBytesToCurrentLoad( const size_t i_byteCount )
+{
+    if ( s_currentStatistics )
+    {
+        s_currentStatistics->byteCount_resident += i_byteCount;
+    }
+}
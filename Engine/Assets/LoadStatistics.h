@@ -0,0 +1,82 @@
+/*
+    Load statistics measure where the time goes when an asset is loaded
+    and how much memory the loaded asset keeps resident:
+        * An asset manager makes a sLoadStatistics current on the loading thread
+            for the duration of an asset's Load() function
+        * Code called during the load reports into it
+            (Assets::LoadBinaryFile() times file I/O,
+            and asset types time their graphics API uploads and report their resident size)
+        * Whatever load time isn't I/O or upload is considered decoding
+*/
+
+#ifndef EAE6320_ASSETS_LOADSTATISTICS_H
+#define EAE6320_ASSETS_LOADSTATISTICS_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+    namespace Assets
+    {
+        struct sLoadStatistics
+        {
+            uint64_t tickCount_total = 0;
+            uint64_t tickCount_io = 0;
+            uint64_t tickCount_upload = 0;
+            size_t byteCount_resident = 0;
+
+            uint64_t GetDecodeTickCount() const;
+        };
+
+        namespace LoadPhases
+        {
+            enum eLoadPhase
+            {
+                IO,
+                Upload,
+            };
+        }
+
+        // This makes the given statistics current for the calling thread until it is destroyed
+        // (the previously-current statistics are restored so that nested loads are measured separately)
+        class cLoadStatisticsScope
+        {
+        public:
+
+            cLoadStatisticsScope( sLoadStatistics& io_statistics );
+            ~cLoadStatisticsScope();
+
+        private:
+
+            sLoadStatistics* const m_previousStatistics;
+        };
+
+        // This adds the time between its construction and destruction
+        // to the given phase of the calling thread's current statistics (if there are any)
+        class cLoadPhaseTimer
+        {
+        public:
+
+            cLoadPhaseTimer( const LoadPhases::eLoadPhase i_phase );
+            ~cLoadPhaseTimer();
+
+        private:
+
+            const uint64_t m_tickCount_start;
+            const LoadPhases::eLoadPhase m_phase;
+        };
+
+        // Asset types call this to report the memory that a loaded asset keeps
+        // (e.g. the size of its GPU buffers)
+        void AddResidentBytesToCurrentLoad( const size_t i_byteCount );
+    }
+}
+
+#endif	// EAE6320_ASSETS_LOADSTATISTICS_H
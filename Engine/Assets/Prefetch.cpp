@@ -0,0 +1,422 @@
+// Include Files
+//==============
+
+#include "Prefetch.h"
+
+#include "Compression.h"
+#include "LoadStatistics.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Concurrency/cEvent.h>
+#include <Engine/Concurrency/cMutex.h>
+#include <Engine/Concurrency/cThread.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Time/Time.h>
+#include <map>
+#include <new>
+#include <set>
+#include <vector>
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+    struct sPrefetchEntry
+    {
+        std::string path;
+        size_t expectedSize = 0;
+        eae6320::Platform::sDataFromFile data;
+        // This is signaled by a worker thread once it has finished trying to read the file
+        eae6320::Concurrency::cEvent hasBeenRead;
+        bool wasReadSuccessful = false;
+        bool hasBeenClaimed = false;
+    };
+}
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+    // Recording
+    bool s_isRecording = false;
+    std::vector<std::pair<std::string, size_t>> s_recordedFiles;
+    std::set<std::string> s_recordedPaths;
+    eae6320::Concurrency::cMutex s_recordingMutex;
+
+    // Prefetching
+    constexpr unsigned int s_maxPrefetchThreadCount = 4;
+    eae6320::Concurrency::cThread s_prefetchThreads[s_maxPrefetchThreadCount];
+    unsigned int s_prefetchThreadCount = 0;
+    // The entries and the map are only modified when no worker threads are running
+    std::vector<sPrefetchEntry*> s_prefetchEntries;
+    std::map<std::string, sPrefetchEntry*> s_map_pathsToPrefetchEntries;
+    std::atomic<size_t> s_nextEntryToRead( 0 );
+    // This protects the data and claimed state of the entries
+    eae6320::Concurrency::cMutex s_prefetchMutex;
+    uint64_t s_tickCount_whenPrefetchingStarted = 0;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+    void EntryPoint_prefetchThread( void* const );
+    eae6320::cResult DecompressIfNecessary( eae6320::Platform::sDataFromFile& io_data, const unsigned int i_maxThreadCount,
+        std::string* const o_errorMessage );
+    eae6320::cResult ParseManifest( const eae6320::Platform::sDataFromFile& i_manifest, const char* const i_path_manifest );
+    void RecordLoadedFile( const char* const i_path, const size_t i_size );
+    bool TakePrefetchedData( const char* const i_path, eae6320::Platform::sDataFromFile& o_data );
+}
+
+// Interface
+//==========
+
+// Asset Loading
+//--------------
+
+eae6320::cResult eae6320::Assets::LoadBinaryFile( const char* const i_path, Platform::sDataFromFile& o_data, std::string* const o_errorMessage )
+{
+    auto result = Results::Success;
+
+    bool wasDataPrefetched;
+    {
+        // Waiting for a prefetch still counts as I/O
+        cLoadPhaseTimer ioTimer( LoadPhases::IO );
+        wasDataPrefetched = TakePrefetchedData( i_path, o_data );
+        if ( !wasDataPrefetched )
+        {
+            if ( !( result = Platform::LoadBinaryFile( i_path, o_data, o_errorMessage ) ) )
+            {
+                return result;
+            }
+        }
+    }
+    if ( !wasDataPrefetched )
+    {
+        // The file is being loaded on demand, and so it is worth using several threads to decompress it
+        constexpr unsigned int maxThreadCount = 4;
+        if ( !( result = DecompressIfNecessary( o_data, maxThreadCount, o_errorMessage ) ) )
+        {
+            return result;
+        }
+    }
+
+    RecordLoadedFile( i_path, o_data.size );
+
+    return result;
+}
+
+// Recording
+//----------
+
+eae6320::cResult eae6320::Assets::StartRecordingManifest()
+{
+    Concurrency::cMutex::cScopeLock autoLock( s_recordingMutex );
+    {
+        s_recordedFiles.clear();
+        s_recordedPaths.clear();
+        s_isRecording = true;
+    }
+    return Results::Success;
+}
+
+eae6320::cResult eae6320::Assets::StopRecordingManifestAndSave( const char* const i_path_manifest )
+{
+    auto result = Results::Success;
+
+    std::string manifest;
+    size_t fileCount = 0;
+    {
+        Concurrency::cMutex::cScopeLock autoLock( s_recordingMutex );
+        {
+            EAE6320_ASSERTF( s_isRecording, "A manifest can't be saved when it isn't being recorded" );
+            for ( const auto& recordedFile : s_recordedFiles )
+            {
+                manifest += std::to_string( recordedFile.second );
+                manifest += ' ';
+                manifest += recordedFile.first;
+                manifest += '\n';
+            }
+            fileCount = s_recordedFiles.size();
+            s_recordedFiles.clear();
+            s_recordedPaths.clear();
+            s_isRecording = false;
+        }
+    }
+
+    std::string errorMessage;
+    if ( result = Platform::WriteBinaryFile( i_path_manifest, manifest.c_str(), manifest.size(), &errorMessage ) )
+    {
+        Logging::OutputMessage( "Recorded %u loaded asset files in the prefetch manifest \"%s\"", fileCount, i_path_manifest );
+    }
+    else
+    {
+        EAE6320_ASSERTF( false, errorMessage.c_str() );
+        Logging::OutputError( "Failed to save the asset prefetch manifest \"%s\": %s", i_path_manifest, errorMessage.c_str() );
+    }
+
+    return result;
+}
+
+// Prefetching
+//------------
+
+eae6320::cResult eae6320::Assets::StartPrefetchingManifest( const char* const i_path_manifest )
+{
+    auto result = Results::Success;
+
+    EAE6320_ASSERTF( s_prefetchEntries.empty() && ( s_prefetchThreadCount == 0 ), "Only one manifest can be prefetched at a time" );
+
+    Platform::sDataFromFile manifest;
+
+    if ( !Platform::DoesFileExist( i_path_manifest ) )
+    {
+        Logging::OutputMessage( "The asset prefetch manifest \"%s\" doesn't exist yet and so nothing will be prefetched", i_path_manifest );
+        goto OnExit;
+    }
+    // Load the manifest
+    {
+        std::string errorMessage;
+        if ( !( result = Platform::LoadBinaryFile( i_path_manifest, manifest, &errorMessage ) ) )
+        {
+            EAE6320_ASSERTF( false, errorMessage.c_str() );
+            Logging::OutputError( "Failed to load the asset prefetch manifest \"%s\": %s", i_path_manifest, errorMessage.c_str() );
+            goto OnExit;
+        }
+    }
+    // Create an entry for every file
+    if ( !( result = ParseManifest( manifest, i_path_manifest ) ) )
+    {
+        goto OnExit;
+    }
+    // Start the worker threads
+    {
+        s_tickCount_whenPrefetchingStarted = Time::GetCurrentSystemTimeTickCount();
+        s_nextEntryToRead = 0;
+        const auto entryCount = s_prefetchEntries.size();
+        const auto threadCount = static_cast<unsigned int>( entryCount < s_maxPrefetchThreadCount ? entryCount : s_maxPrefetchThreadCount );
+        for ( unsigned int i = 0; i < threadCount; ++i )
+        {
+            if ( !( result = s_prefetchThreads[i].Start( EntryPoint_prefetchThread ) ) )
+            {
+                EAE6320_ASSERTF( false, "Couldn't start an asset prefetch thread" );
+                Logging::OutputError( "Failed to start asset prefetch thread #%u", i );
+                break;
+            }
+            ++s_prefetchThreadCount;
+        }
+        if ( s_prefetchThreadCount > 0 )
+        {
+            // Any entries that can't be read because a thread failed to start will be read by the threads that did
+            result = Results::Success;
+            Logging::OutputMessage( "Prefetching %u asset files from \"%s\" using %u threads",
+                entryCount, i_path_manifest, s_prefetchThreadCount );
+        }
+    }
+
+OnExit:
+
+    manifest.Free();
+
+    if ( !result )
+    {
+        StopPrefetching();
+    }
+
+    return result;
+}
+
+eae6320::cResult eae6320::Assets::StopPrefetching()
+{
+    auto result = Results::Success;
+
+    // Wait for the worker threads to finish
+    for ( unsigned int i = 0; i < s_prefetchThreadCount; ++i )
+    {
+        const auto localResult = Concurrency::WaitForThreadToStop( s_prefetchThreads[i] );
+        if ( !localResult )
+        {
+            EAE6320_ASSERTF( false, "Couldn't wait for an asset prefetch thread to stop" );
+            if ( result )
+            {
+                result = localResult;
+            }
+        }
+    }
+    // Free the entries
+    {
+        size_t claimedCount = 0;
+        size_t claimedByteCount = 0;
+        {
+            Concurrency::cMutex::cScopeLock autoLock( s_prefetchMutex );
+            for ( auto* const entry : s_prefetchEntries )
+            {
+                if ( entry->hasBeenClaimed )
+                {
+                    ++claimedCount;
+                    claimedByteCount += entry->expectedSize;
+                }
+                entry->data.Free();
+                delete entry;
+            }
+        }
+        if ( s_prefetchThreadCount > 0 )
+        {
+            const auto elapsedSecondCount = Time::ConvertTicksToSeconds( Time::GetCurrentSystemTimeTickCount() - s_tickCount_whenPrefetchingStarted );
+            Logging::OutputMessage( "Asset prefetching finished after %f seconds: %u of %u prefetched files (%u bytes) were used",
+                elapsedSecondCount, claimedCount, s_prefetchEntries.size(), claimedByteCount );
+        }
+        s_prefetchEntries.clear();
+        s_map_pathsToPrefetchEntries.clear();
+        s_prefetchThreadCount = 0;
+    }
+
+    return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+    void EntryPoint_prefetchThread( void* const )
+    {
+        // Each thread keeps reading the next unread entry until there are none left
+        const auto entryCount = s_prefetchEntries.size();
+        for ( auto index = s_nextEntryToRead++; index < entryCount; index = s_nextEntryToRead++ )
+        {
+            auto* const entry = s_prefetchEntries[index];
+            eae6320::Platform::sDataFromFile data;
+            auto result = eae6320::Platform::LoadBinaryFile( entry->path.c_str(), data );
+            if ( result )
+            {
+                // Every prefetch thread is already busy,
+                // and so there's no point in using more threads to decompress
+                constexpr unsigned int maxThreadCount = 1;
+                result = DecompressIfNecessary( data, maxThreadCount, nullptr );
+            }
+            {
+                eae6320::Concurrency::cMutex::cScopeLock autoLock( s_prefetchMutex );
+                entry->data = data;
+                entry->wasReadSuccessful = result;
+            }
+            // A file that can't be prefetched isn't an error;
+            // it will be loaded normally (and the error reported) if it is actually requested
+            entry->hasBeenRead.Signal();
+        }
+    }
+
+    eae6320::cResult DecompressIfNecessary( eae6320::Platform::sDataFromFile& io_data, const unsigned int i_maxThreadCount,
+        std::string* const o_errorMessage )
+    {
+        namespace Compression = eae6320::Assets::Compression;
+
+        if ( !Compression::IsCompressed( io_data.data, io_data.size ) )
+        {
+            return eae6320::Results::Success;
+        }
+        eae6320::Platform::sDataFromFile uncompressedData;
+        const auto result = Compression::Decompress( io_data.data, io_data.size, uncompressedData, i_maxThreadCount, o_errorMessage );
+        io_data.Free();
+        if ( result )
+        {
+            io_data = uncompressedData;
+        }
+        return result;
+    }
+
+    eae6320::cResult ParseManifest( const eae6320::Platform::sDataFromFile& i_manifest, const char* const i_path_manifest )
+    {
+        const auto* const manifestText = static_cast<const char*>( i_manifest.data );
+        const auto* const manifestEnd = manifestText + i_manifest.size;
+        for ( auto* lineStart = manifestText; lineStart < manifestEnd; )
+        {
+            auto* lineEnd = lineStart;
+            while ( ( lineEnd < manifestEnd ) && ( *lineEnd != '\n' ) )
+            {
+                ++lineEnd;
+            }
+            const std::string line( lineStart, lineEnd );
+            lineStart = lineEnd + 1;
+
+            // Each line is "<size> <path>"
+            const auto separatorIndex = line.find( ' ' );
+            if ( ( separatorIndex == std::string::npos ) || ( ( separatorIndex + 1 ) >= line.size() ) )
+            {
+                if ( !line.empty() )
+                {
+                    eae6320::Logging::OutputError( "Ignoring an invalid line (\"%s\") in the asset prefetch manifest \"%s\"",
+                        line.c_str(), i_path_manifest );
+                }
+                continue;
+            }
+            const auto path = line.substr( separatorIndex + 1 );
+            if ( s_map_pathsToPrefetchEntries.find( path ) != s_map_pathsToPrefetchEntries.end() )
+            {
+                continue;
+            }
+
+            auto* const newEntry = new (std::nothrow) sPrefetchEntry;
+            if ( !newEntry )
+            {
+                EAE6320_ASSERTF( false, "Couldn't allocate memory for an asset prefetch entry" );
+                eae6320::Logging::OutputError( "Failed to allocate memory for an asset prefetch entry" );
+                return eae6320::Results::OutOfMemory;
+            }
+            newEntry->path = path;
+            newEntry->expectedSize = static_cast<size_t>( std::strtoull( line.c_str(), nullptr, 10 ) );
+            s_prefetchEntries.push_back( newEntry );
+            if ( !newEntry->hasBeenRead.Initialize( eae6320::Concurrency::EventType::RemainSignaledUntilReset ) )
+            {
+                EAE6320_ASSERTF( false, "Couldn't initialize an asset prefetch event" );
+                eae6320::Logging::OutputError( "Failed to initialize the event for the prefetched asset file \"%s\"", path.c_str() );
+                return eae6320::Results::Failure;
+            }
+            s_map_pathsToPrefetchEntries.insert( std::make_pair( path, newEntry ) );
+        }
+
+        return eae6320::Results::Success;
+    }
+
+    void RecordLoadedFile( const char* const i_path, const size_t i_size )
+    {
+        eae6320::Concurrency::cMutex::cScopeLock autoLock( s_recordingMutex );
+        if ( s_isRecording && s_recordedPaths.insert( i_path ).second )
+        {
+            s_recordedFiles.push_back( std::make_pair( std::string( i_path ), i_size ) );
+        }
+    }
+
+    bool TakePrefetchedData( const char* const i_path, eae6320::Platform::sDataFromFile& o_data )
+    {
+        // The map isn't modified while the worker threads are running
+        // and so it can be searched without locking
+        const auto iterator = s_map_pathsToPrefetchEntries.find( i_path );
+        if ( iterator == s_map_pathsToPrefetchEntries.end() )
+        {
+            return false;
+        }
+        auto* const entry = iterator->second;
+        // If the file is still being read it is faster to wait for it
+        // than to start reading it again
+        if ( !eae6320::Concurrency::WaitForEvent( entry->hasBeenRead ) )
+        {
+            EAE6320_ASSERTF( false, "Couldn't wait for an asset file to be prefetched" );
+            return false;
+        }
+        eae6320::Concurrency::cMutex::cScopeLock autoLock( s_prefetchMutex );
+        if ( entry->wasReadSuccessful && !entry->hasBeenClaimed )
+        {
+            o_data = entry->data;
+            entry->data = eae6320::Platform::sDataFromFile();
+            entry->hasBeenClaimed = true;
+            return true;
+        }
+        return false;
+    }
+}
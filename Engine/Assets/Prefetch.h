@@ -0,0 +1,59 @@
+/*
+    Asset prefetching records the order that asset files are loaded in during a run
+    and then, on the next run, loads those same files in parallel
+    before the application asks for them:
+        * While recording, every file loaded through Assets::LoadBinaryFile() is added to a manifest
+            (its path and size, in the order that it was first loaded)
+        * When prefetching, worker threads read every file listed in a manifest into memory;
+            when an asset's Load() function later calls Assets::LoadBinaryFile() for one of those files
+            it takes ownership of the data that has already been read (waiting for it if necessary)
+            instead of going to disk
+        * A file that isn't in the manifest (or that failed to prefetch) is loaded normally
+*/
+
+#ifndef EAE6320_ASSETS_PREFETCH_H
+#define EAE6320_ASSETS_PREFETCH_H
+
+// Include Files
+//==============
+
+#include <Engine/Platform/Platform.h>
+#include <Engine/Results/Results.h>
+#include <string>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+    namespace Assets
+    {
+        // Asset Loading
+        //--------------
+
+        // Asset Load() functions should call this instead of Platform::LoadBinaryFile()
+        // so that prefetched data can be used and the load can be recorded.
+        // Compressed files (see Compression.h) are decompressed transparently.
+        // Like Platform::LoadBinaryFile() the caller is responsible for freeing the returned data
+        cResult LoadBinaryFile( const char* const i_path, Platform::sDataFromFile& o_data, std::string* const o_errorMessage = nullptr );
+
+        // Recording
+        //----------
+
+        cResult StartRecordingManifest();
+        // The manifest is a text file with one "<size in bytes> <path>" line per loaded file
+        cResult StopRecordingManifestAndSave( const char* const i_path_manifest );
+
+        // Prefetching
+        //------------
+
+        // If the manifest doesn't exist nothing is prefetched and the function still succeeds
+        // (this is expected the first time an application is run)
+        cResult StartPrefetchingManifest( const char* const i_path_manifest );
+        // This waits for any outstanding prefetches to finish
+        // and frees any prefetched data that was never used
+        cResult StopPrefetching();
+    }
+}
+
+#endif	// EAE6320_ASSETS_PREFETCH_H
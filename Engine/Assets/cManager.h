@@ -6,6 +6,8 @@
             and can return the asset's actual pointer given its handle
         * When every handle to an asset has been released
             the manager releases its own reference to the asset so that it can be unloaded
+        * The manager keeps statistics about how long assets took to load, how much memory they use,
+            and how often a load request was satisfied by an asset that had already been loaded
 */
 
 #ifndef EAE6320_ASSETS_CMANAGER_H
@@ -15,9 +17,12 @@
 //==============
 
 #include "cHandle.h"
+#include "LoadStatistics.h"
+
 #include <Engine/Concurrency/cMutex.h>
 #include <Engine/Results/Results.h>
 #include <map>
+#include <string>
 #include <vector>
 
 // Interface
@@ -48,6 +53,28 @@ namespace eae6320
                 cResult Load( const char* const i_path, cHandle<tAsset>& o_handle, tConstructorArguments&&... i_constructorArguments );
             cResult Release( cHandle<tAsset>& io_handle );
 
+            // Statistics
+            //-----------
+
+            struct sStatistics
+            {
+                // The number of times that Load() created a new asset
+                size_t loadCount = 0;
+                // The number of times that Load() returned an asset that was already loaded
+                size_t duplicateLoadCount = 0;
+                size_t assetCount = 0;
+                size_t assetCount_peak = 0;
+                size_t byteCount_resident = 0;
+                size_t byteCount_resident_peak = 0;
+                uint64_t tickCount_loading = 0;
+            };
+            sStatistics GetStatistics();
+
+            // These list every currently-loaded asset with its reference count and load statistics
+            // (the asset type name is only used to label the output)
+            void OutputInventoryToLog( const char* const i_assetTypeName );
+            cResult SaveInventoryAsJson( const char* const i_path, const char* const i_assetTypeName );
+
             // Initialization / Clean Up
             //--------------------------
 
@@ -66,13 +93,23 @@ namespace eae6320
                 tAsset* asset = nullptr;
                 uint16_t id = cHandle<tAsset>::InvalidValue;
                 uint16_t referenceCount = 0;
+                uint16_t referenceCount_peak = 0;
+                uint32_t duplicateLoadCount = 0;
+                std::string path;
+                sLoadStatistics loadStatistics;
 
                 sAssetRecord( tAsset* const i_asset, const uint16_t i_id, const uint16_t i_referenceCount );
             };
             std::vector<sAssetRecord> m_assetRecords;
             std::vector<uint16_t> m_unusedAssetRecordIndices;
             std::map< std::string, cHandle<tAsset> > m_map_pathsToHandles;
+            sStatistics m_statistics;
             eae6320::Concurrency::cMutex m_mutex;
+
+            // Implementation
+            //===============
+
+            void OnAssetRecordUsed( sAssetRecord& io_assetRecord, const char* const i_path, const sLoadStatistics& i_loadStatistics );
         };
     }
 }
@@ -8,7 +8,10 @@
 
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Logging/Logging.h>
+#include <Engine/Platform/Platform.h>
+#include <Engine/Time/Time.h>
 #include <limits>
+#include <sstream>
 
 // Interface
 //==========
@@ -81,6 +84,12 @@ template <class tAsset> template <typename... tConstructorArguments>
                         if ( referenceCount < std::numeric_limits<decltype( assetRecord.referenceCount )>::max() )
                         {
                             assetRecord.referenceCount = referenceCount + 1;
+                            if ( assetRecord.referenceCount > assetRecord.referenceCount_peak )
+                            {
+                                assetRecord.referenceCount_peak = assetRecord.referenceCount;
+                            }
+                            ++assetRecord.duplicateLoadCount;
+                            ++m_statistics.duplicateLoadCount;
                             o_handle = existingHandle;
                             return Results::Success;
                         }
@@ -103,7 +112,16 @@ template <class tAsset> template <typename... tConstructorArguments>
     auto result = Results::Success;
 
     tAsset* newAsset;
-    if ( result = tAsset::Load( i_path, newAsset, std::forward<tConstructorArguments>( i_constructorArguments )... ) )
+    sLoadStatistics loadStatistics;
+    {
+        const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+        {
+            cLoadStatisticsScope statisticsScope( loadStatistics );
+            result = tAsset::Load( i_path, newAsset, std::forward<tConstructorArguments>( i_constructorArguments )... );
+        }
+        loadStatistics.tickCount_total = Time::GetCurrentSystemTimeTickCount() - tickCount_start;
+    }
+    if ( result )
     {
         // Lock the collections
         Concurrency::cMutex::cScopeLock autoLock( m_mutex );
@@ -119,6 +137,7 @@ template <class tAsset> template <typename... tConstructorArguments>
                 {
                     assetRecord.asset = newAsset;
                     assetRecord.referenceCount = 1;
+                    OnAssetRecordUsed( assetRecord, i_path, loadStatistics );
                 }
                 o_handle = cHandle<tAsset>( index, assetRecord.id );
             }
@@ -132,6 +151,7 @@ template <class tAsset> template <typename... tConstructorArguments>
                     {
                         constexpr uint16_t referenceCount = 1;
                         m_assetRecords.push_back( sAssetRecord( newAsset, id, referenceCount ) );
+                        OnAssetRecordUsed( m_assetRecords.back(), i_path, loadStatistics );
                     }
                     {
                         const auto index = static_cast<uint_fast32_t>( assetRecordCount );
@@ -199,6 +219,14 @@ template <class tAsset>
                             assetRecord.id = static_cast<uint16_t>( cHandle<tAsset>::IncrementId( id_assetRecord ) );
                             m_unusedAssetRecordIndices.push_back( index );
                         }
+                        // The asset no longer counts as loaded
+                        {
+                            EAE6320_ASSERT( m_statistics.assetCount > 0 );
+                            --m_statistics.assetCount;
+                            EAE6320_ASSERT( m_statistics.byteCount_resident >= assetRecord.loadStatistics.byteCount_resident );
+                            m_statistics.byteCount_resident -= assetRecord.loadStatistics.byteCount_resident;
+                            assetRecord.path.clear();
+                        }
                     }
                 }
                 else
@@ -222,6 +250,126 @@ template <class tAsset>
     return result;
 }
 
+// Statistics
+//-----------
+
+template <class tAsset>
+    typename eae6320::Assets::cManager<tAsset>::sStatistics eae6320::Assets::cManager<tAsset>::GetStatistics()
+{
+    Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+    return m_statistics;
+}
+
+template <class tAsset>
+    void eae6320::Assets::cManager<tAsset>::OutputInventoryToLog( const char* const i_assetTypeName )
+{
+    Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+    {
+        Logging::OutputMessage( "%s inventory: %u loaded (peak %u), %u bytes resident (peak %u),"
+            " %u loads and %u duplicate load requests taking %f ms in total",
+            i_assetTypeName, m_statistics.assetCount, m_statistics.assetCount_peak,
+            m_statistics.byteCount_resident, m_statistics.byteCount_resident_peak,
+            m_statistics.loadCount, m_statistics.duplicateLoadCount,
+            Time::ConvertTicksToSeconds( m_statistics.tickCount_loading ) * 1000.0 );
+        for ( const auto& assetRecord : m_assetRecords )
+        {
+            if ( assetRecord.asset )
+            {
+                const auto& loadStatistics = assetRecord.loadStatistics;
+                Logging::OutputMessage( "\t%s: %u references (peak %u, %u duplicate loads), %u bytes,"
+                    " loaded in %f ms (I/O %f ms, decode %f ms, upload %f ms)",
+                    assetRecord.path.c_str(), assetRecord.referenceCount, assetRecord.referenceCount_peak, assetRecord.duplicateLoadCount,
+                    loadStatistics.byteCount_resident,
+                    Time::ConvertTicksToSeconds( loadStatistics.tickCount_total ) * 1000.0,
+                    Time::ConvertTicksToSeconds( loadStatistics.tickCount_io ) * 1000.0,
+                    Time::ConvertTicksToSeconds( loadStatistics.GetDecodeTickCount() ) * 1000.0,
+                    Time::ConvertTicksToSeconds( loadStatistics.tickCount_upload ) * 1000.0 );
+            }
+        }
+    }
+}
+
+template <class tAsset>
+    eae6320::cResult eae6320::Assets::cManager<tAsset>::SaveInventoryAsJson( const char* const i_path, const char* const i_assetTypeName )
+{
+    // Paths are the only strings that could contain characters that need to be escaped
+    // (quotes, backslashes, and control characters aren't allowed in a JSON string as-is)
+    const auto WriteJsonString = []( std::ostringstream& io_json, const std::string& i_string )
+    {
+        io_json << '"';
+        for ( const auto character : i_string )
+        {
+            switch ( character )
+            {
+            case '"': io_json << "\\\""; break;
+            case '\\': io_json << "\\\\"; break;
+            case '\b': io_json << "\\b"; break;
+            case '\f': io_json << "\\f"; break;
+            case '\n': io_json << "\\n"; break;
+            case '\r': io_json << "\\r"; break;
+            case '\t': io_json << "\\t"; break;
+            default:
+                if ( static_cast<unsigned char>( character ) < 0x20 )
+                {
+                    constexpr char hexDigits[] = "0123456789abcdef";
+                    io_json << "\\u00" << hexDigits[( character >> 4 ) & 0xf] << hexDigits[character & 0xf];
+                }
+                else
+                {
+                    io_json << character;
+                }
+            }
+        }
+        io_json << '"';
+    };
+
+    std::ostringstream json;
+    {
+        Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+        json << "{\n\t\"type\": ";
+        WriteJsonString( json, i_assetTypeName );
+        json << ",\n\t\"loadCount\": " << m_statistics.loadCount
+            << ",\n\t\"duplicateLoadCount\": " << m_statistics.duplicateLoadCount
+            << ",\n\t\"assetCount\": " << m_statistics.assetCount
+            << ",\n\t\"assetCount_peak\": " << m_statistics.assetCount_peak
+            << ",\n\t\"byteCount_resident\": " << m_statistics.byteCount_resident
+            << ",\n\t\"byteCount_resident_peak\": " << m_statistics.byteCount_resident_peak
+            << ",\n\t\"loadTime_ms\": " << Time::ConvertTicksToSeconds( m_statistics.tickCount_loading ) * 1000.0
+            << ",\n\t\"assets\": [";
+        bool isFirstAsset = true;
+        for ( const auto& assetRecord : m_assetRecords )
+        {
+            if ( assetRecord.asset )
+            {
+                const auto& loadStatistics = assetRecord.loadStatistics;
+                json << ( isFirstAsset ? "\n" : ",\n" ) << "\t\t{ \"path\": ";
+                WriteJsonString( json, assetRecord.path );
+                json << ", \"referenceCount\": " << assetRecord.referenceCount
+                    << ", \"referenceCount_peak\": " << assetRecord.referenceCount_peak
+                    << ", \"duplicateLoadCount\": " << assetRecord.duplicateLoadCount
+                    << ", \"byteCount_resident\": " << loadStatistics.byteCount_resident
+                    << ", \"loadTime_ms\": " << Time::ConvertTicksToSeconds( loadStatistics.tickCount_total ) * 1000.0
+                    << ", \"ioTime_ms\": " << Time::ConvertTicksToSeconds( loadStatistics.tickCount_io ) * 1000.0
+                    << ", \"decodeTime_ms\": " << Time::ConvertTicksToSeconds( loadStatistics.GetDecodeTickCount() ) * 1000.0
+                    << ", \"uploadTime_ms\": " << Time::ConvertTicksToSeconds( loadStatistics.tickCount_upload ) * 1000.0
+                    << " }";
+                isFirstAsset = false;
+            }
+        }
+        json << "\n\t]\n}\n";
+    }
+
+    const auto jsonString = json.str();
+    std::string errorMessage;
+    const auto result = Platform::WriteBinaryFile( i_path, jsonString.c_str(), jsonString.size(), &errorMessage );
+    if ( !result )
+    {
+        EAE6320_ASSERTF( false, errorMessage.c_str() );
+        Logging::OutputError( "Failed to save the %s inventory to \"%s\": %s", i_assetTypeName, i_path, errorMessage.c_str() );
+    }
+    return result;
+}
+
 template <class tAsset>
     eae6320::cResult eae6320::Assets::cManager<tAsset>::Initialize()
 {
@@ -261,6 +409,10 @@ template <class tAsset>
                 m_assetRecords.clear();
                 m_unusedAssetRecordIndices.clear();
                 m_map_pathsToHandles.clear();
+                // The cumulative statistics are kept,
+                // but nothing is loaded anymore
+                m_statistics.assetCount = 0;
+                m_statistics.byteCount_resident = 0;
             }
         }
 
@@ -283,6 +435,30 @@ template <class tAsset>
 // Implementation
 //===============
 
+template <class tAsset>
+    void eae6320::Assets::cManager<tAsset>::OnAssetRecordUsed( sAssetRecord& io_assetRecord, const char* const i_path,
+        const sLoadStatistics& i_loadStatistics )
+{
+    // This is called with the mutex already locked
+    io_assetRecord.referenceCount_peak = io_assetRecord.referenceCount;
+    io_assetRecord.duplicateLoadCount = 0;
+    io_assetRecord.path = i_path;
+    io_assetRecord.loadStatistics = i_loadStatistics;
+
+    ++m_statistics.loadCount;
+    m_statistics.tickCount_loading += i_loadStatistics.tickCount_total;
+    ++m_statistics.assetCount;
+    if ( m_statistics.assetCount > m_statistics.assetCount_peak )
+    {
+        m_statistics.assetCount_peak = m_statistics.assetCount;
+    }
+    m_statistics.byteCount_resident += i_loadStatistics.byteCount_resident;
+    if ( m_statistics.byteCount_resident > m_statistics.byteCount_resident_peak )
+    {
+        m_statistics.byteCount_resident_peak = m_statistics.byteCount_resident;
+    }
+}
+
 template <class tAsset>
     eae6320::Assets::cManager<tAsset>::sAssetRecord::sAssetRecord( tAsset* const i_asset, const uint16_t i_id, const uint16_t i_referenceCount )
     :
@@ -17,4 +17,31 @@
 	#define EAE6320_GRAPHICS_AREDEBUGSHADERSENABLED
 #endif
 
+// Textures with the same size, format, and MIP count can be put in the same texture array
+// so that objects with different textures don't need a different texture to be bound.
+// Only textures whose every MIP level is resident when they are loaded are shared:
+// a texture array has a single resident MIP range, and so textures whose levels are streamed always have an array of their own.
+// With texture streaming (see TextureStreaming.h) that means that only textures that fit in the MIP tail
+// (TextureStreaming::TailDimension, i.e. 64x64 or smaller) share arrays;
+// larger textures (e.g. 256x256 content textures) are still bound for every change of texture
+// (the texture bind statistics that are written to the log when the game exits show how many binds remain)
+#define EAE6320_GRAPHICS_ARETEXTUREARRAYSSHARED
+
+// With OpenGL consecutive meshes that use the same effect, geometry pool, and texture array
+// are drawn with a single indirect multi-draw call (see cGeometryPool.h),
+// and so each mesh's per-draw-call data is read by the vertex shader as per-instance vertex attributes
+// rather than from the per-draw-call constant buffer
+// (the GLSL mesh shaders always read it that way, and so this can't be turned off by itself).
+// Direct3D 11 has no multi-draw, and so it still draws each mesh with its own constant buffer data
+#if defined( EAE6320_PLATFORM_GL )
+	#define EAE6320_GRAPHICS_AREMESHDRAWSBATCHED
+#endif
+
+// A depth prepass draws the depth of every opaque mesh before the meshes are drawn normally
+// so that each pixel is only shaded once.
+// This is only worth the extra draw calls when fragment shaders are expensive,
+// and so it is disabled by default
+// (the overdraw statistics that are written to the log when the game exits show how much it would save)
+// #define EAE6320_GRAPHICS_ISDEPTHPREPASSENABLED
+
 #endif	// EAE6320_GRAPHICS_CONFIGURATION_H
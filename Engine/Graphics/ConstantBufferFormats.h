@@ -46,6 +46,15 @@ namespace eae6320
             struct sPerDrawCall
             {
                 Math::cMatrix_transformation g_transform_localToWorld;
+
+                // These come from the mesh being drawn (see MeshFormats::sPositionDequantization);
+                // the fourth value of each is unused, and is only there for float4 alignment
+                float g_positionDequantization_offset[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                float g_positionDequantization_scale[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+                // This comes from the texture being drawn (see cTexture::GetArrayLayer());
+                // only the first value is used, and the others are only there for float4 alignment
+                float g_textureArrayLayer[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
             };
         }
     }
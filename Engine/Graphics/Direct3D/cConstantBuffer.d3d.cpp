@@ -35,52 +35,6 @@ void eae6320::Graphics::cConstantBuffer::Bind( const uint_fast8_t i_shaderTypesT
 	}
 }
 
-void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
-{
-	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
-	EAE6320_ASSERT( direct3dImmediateContext );
-
-	EAE6320_ASSERT( m_buffer );
-
-	auto mustConstantBufferBeUnmapped = false;
-
-	// Get a pointer from Direct3D that can be written to
-	void* memoryToWriteTo;
-	{
-		D3D11_MAPPED_SUBRESOURCE mappedSubResource;
-		{
-			// Discard previous contents when writing
-			constexpr unsigned int noSubResources = 0;
-			constexpr D3D11_MAP mapType = D3D11_MAP_WRITE_DISCARD;
-			constexpr unsigned int noFlags = 0;
-			const auto d3dResult = direct3dImmediateContext->Map( m_buffer, noSubResources, mapType, noFlags, &mappedSubResource );
-			if ( SUCCEEDED( d3dResult ) )
-			{
-				mustConstantBufferBeUnmapped = true;
-			}
-			else
-			{
-				EAE6320_ASSERT( false );
-				Logging::OutputError( "Direct3D failed to map a constant buffer" );
-				goto OnExit;
-			}
-		}
-		memoryToWriteTo = mappedSubResource.pData;
-	}
-	// Copy the new data to the memory that Direct3D has provided
-	memcpy( memoryToWriteTo, i_data, m_size );
-
-OnExit:
-
-	if ( mustConstantBufferBeUnmapped )
-	{
-		// Let Direct3D know that the memory contains the data
-		// (the pointer will be invalid after this call)
-		constexpr unsigned int noSubResources = 0;
-		direct3dImmediateContext->Unmap( m_buffer, noSubResources );
-	}
-}
-
 // Initialization / Clean Up
 //--------------------------
 
@@ -140,3 +94,61 @@ eae6320::cResult eae6320::Graphics::cConstantBuffer::Initialize_platformSpecific
 		return Results::Failure;
 	}
 }
+
+// Render
+//-------
+
+size_t eae6320::Graphics::cConstantBuffer::Update_platformSpecific( const size_t, const size_t )
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+
+	EAE6320_ASSERT( m_buffer );
+
+	auto mustConstantBufferBeUnmapped = false;
+	size_t byteCount_uploaded = 0;
+
+	// Get a pointer from Direct3D that can be written to
+	void* memoryToWriteTo;
+	{
+		D3D11_MAPPED_SUBRESOURCE mappedSubResource;
+		{
+			// Discard previous contents when writing
+			constexpr unsigned int noSubResources = 0;
+			constexpr D3D11_MAP mapType = D3D11_MAP_WRITE_DISCARD;
+			constexpr unsigned int noFlags = 0;
+			const auto d3dResult = direct3dImmediateContext->Map( m_buffer, noSubResources, mapType, noFlags, &mappedSubResource );
+			if ( SUCCEEDED( d3dResult ) )
+			{
+				mustConstantBufferBeUnmapped = true;
+			}
+			else
+			{
+				EAE6320_ASSERT( false );
+				Logging::OutputError( "Direct3D failed to map a constant buffer" );
+				// The GPU doesn't have the data in the shadow copy,
+				// and so the next update must upload everything
+				m_isShadowCopyValid = false;
+				goto OnExit;
+			}
+		}
+		memoryToWriteTo = mappedSubResource.pData;
+	}
+	// Copy the new data to the memory that Direct3D has provided
+	// (the previous contents were discarded,
+	// and so the entire shadow copy must be written rather than only the range that changed)
+	memcpy( memoryToWriteTo, m_shadowCopy.data(), m_size );
+	byteCount_uploaded = m_size;
+
+OnExit:
+
+	if ( mustConstantBufferBeUnmapped )
+	{
+		// Let Direct3D know that the memory contains the data
+		// (the pointer will be invalid after this call)
+		constexpr unsigned int noSubResources = 0;
+		direct3dImmediateContext->Unmap( m_buffer, noSubResources );
+	}
+
+	return byteCount_uploaded;
+}
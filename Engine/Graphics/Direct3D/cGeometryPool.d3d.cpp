@@ -0,0 +1,389 @@
+// Include Files
+//==============
+
+#include "../cGeometryPool.h"
+
+#include "Includes.h"
+#include "../sContext.h"
+#include "../VertexFormats.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/Prefetch.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Platform/Platform.h>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+    // A new buffer is created and the first part of the old one (if there is one) is copied into it
+    eae6320::cResult CreateBuffer(const uint64_t i_size, const unsigned int i_bindFlags, ID3D11Buffer* const i_bufferToCopy, const uint64_t i_sizeToCopy,
+        ID3D11Buffer*& o_buffer, const char* const i_bufferDescription);
+    void CopyToBuffer(ID3D11Buffer* const i_buffer, const uint64_t i_offset, const void* const i_data, const uint64_t i_size);
+}
+
+// Interface
+//==========
+
+// Render
+//-------
+
+void eae6320::Graphics::cGeometryPool::Draw(const sAllocation& i_allocation, const sIndexRange* const i_indexRanges, const size_t i_indexRangeCount,
+    const ConstantBufferFormats::sPerDrawCall&)
+{
+    EAE6320_ASSERT(i_allocation.pool == this);
+    EAE6320_ASSERT(i_indexRanges && (i_indexRangeCount > 0));
+
+    auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+    EAE6320_ASSERT(direct3dImmediateContext);
+
+    // Meshes in the same pool share vertex and index buffers
+    if (s_boundPool != this)
+    {
+        Bind();
+    }
+    // Render triangles from the currently-bound vertex buffer
+    // (Direct3D 11 doesn't have a way to draw multiple ranges with a single call,
+    // but all of the state only needs to be set once for every mesh in the pool)
+    for (size_t i = 0; i < i_indexRangeCount; ++i)
+    {
+        // It's possible to start rendering primitives in the middle of the stream
+        const auto indexOfFirstIndexToUse = static_cast<unsigned int>(i_allocation.firstIndex + i_indexRanges[i].indexOffset);
+        // A mesh's indices are relative to its first vertex
+        const auto offsetToAddToEachIndex = static_cast<int>(i_allocation.firstVertex);
+        direct3dImmediateContext->DrawIndexed(static_cast<unsigned int>(i_indexRanges[i].indexCount), indexOfFirstIndexToUse, offsetToAddToEachIndex);
+    }
+}
+
+void eae6320::Graphics::cGeometryPool::SubmitBatch()
+{
+    // Draws aren't batched with Direct3D
+    // (each one is submitted immediately with the data that is in the per-draw-call constant buffer)
+}
+
+// Implementation
+//===============
+
+// Platform-Specific
+//------------------
+
+void eae6320::Graphics::cGeometryPool::Bind()
+{
+    auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+    EAE6320_ASSERT(direct3dImmediateContext);
+
+    // Bind a specific vertex buffer to the device as a data source
+    {
+        EAE6320_ASSERT(m_vertexBuffer);
+        constexpr unsigned int startingSlot = 0;
+        constexpr unsigned int vertexBufferCount = 1;
+        // The "stride" defines how large a single vertex is in the stream of data
+        const unsigned int bufferStride = MeshFormats::VertexEncodings::GetSizeOfVertex(m_vertexEncoding);
+        // It's possible to start streaming data in the middle of a vertex buffer
+        constexpr unsigned int bufferOffset = 0;
+        direct3dImmediateContext->IASetVertexBuffers(startingSlot, vertexBufferCount, &m_vertexBuffer, &bufferStride, &bufferOffset);
+    }
+    // Specify what kind of data the vertex buffer holds
+    {
+        // Set the layout (which defines how to interpret a single vertex)
+        {
+            EAE6320_ASSERT(m_vertexInputLayout);
+            direct3dImmediateContext->IASetInputLayout(m_vertexInputLayout);
+        }
+
+        // Set the topology 
+        direct3dImmediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    }
+    // Bind an index buffer to the device as a data source
+    {
+        EAE6320_ASSERT(m_indexBuffer);
+        // The indices start at the beginning of the buffer
+        // (each draw call adds the offset to a mesh's first index)
+        constexpr unsigned int offset = 0;
+        // The format must match the size of the indices in the index buffer
+        const auto indexFormat = (m_indexFormat == MeshFormats::IndexFormats::Index32) ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT;
+        direct3dImmediateContext->IASetIndexBuffer(m_indexBuffer, indexFormat, offset);
+    }
+    s_boundPool = this;
+}
+
+eae6320::cResult eae6320::Graphics::cGeometryPool::Grow(const uint32_t i_vertexCapacity, const uint32_t i_indexCapacity)
+{
+    auto result = eae6320::Results::Success;
+
+    const auto isQuantized = (m_vertexEncoding == MeshFormats::VertexEncodings::Quantized);
+    const auto vertexSize = MeshFormats::VertexEncodings::GetSizeOfVertex(m_vertexEncoding);
+    const auto indexSize = MeshFormats::IndexFormats::GetSizeOfIndex(m_indexFormat);
+    EAE6320_ASSERT((vertexSize != 0) && (indexSize != 0));
+    // The new buffers replace the old ones only once they have both been created
+    ID3D11Buffer* vertexBuffer_new = nullptr;
+    ID3D11Buffer* indexBuffer_new = nullptr;
+
+    auto* const direct3dDevice = eae6320::Graphics::sContext::g_context.direct3dDevice;
+    EAE6320_ASSERT(direct3dDevice);
+
+    // Initialize the vertex format the first time
+    // (it only depends on the encoding)
+    if (!m_vertexInputLayout)
+    {
+        // Load the compiled binary vertex shader for the input layout
+        eae6320::Platform::sDataFromFile vertexShaderDataFromFile;
+        std::string errorMessage;
+        if (result = eae6320::Assets::LoadBinaryFile("data/Shaders/Vertex/vertexInputLayout_mesh.shd", vertexShaderDataFromFile, &errorMessage))
+        {
+            // Create the vertex layout
+
+            // These elements must match the VertexFormats::sMesh (or VertexFormats::sMeshQuantized) layout struct exactly.
+            // They instruct Direct3D how to match the binary data in the vertex buffer
+            // to the input elements in a vertex shader
+            // (by using so-called "semantic" names so that, for example,
+            // "POSITION" here matches with "POSITION" in shader code.
+            // "COLOR" here matches with "COLOR" in shader code).
+            // Note that OpenGL uses arbitrarily assignable number IDs to do the same thing.
+            constexpr unsigned int vertexElementCount = 3;
+            D3D11_INPUT_ELEMENT_DESC layoutDescription[vertexElementCount] = {};
+            {
+                // Slot 0
+
+                // POSITION
+                // 3 floats == 12 bytes (or 4 16-bit normalized ints == 8 bytes if quantized)
+                // Offset = 0
+                {
+                    auto& positionElement = layoutDescription[0];
+
+                    positionElement.SemanticName = "POSITION";
+                    positionElement.SemanticIndex = 0;  // (Semantics without modifying indices at the end can always use zero)
+                    // Quantized ints are converted to [0,1] so that the vertex shader can dequantize them
+                    positionElement.Format = isQuantized ? DXGI_FORMAT_R16G16B16A16_UNORM : DXGI_FORMAT_R32G32B32_FLOAT;
+                    positionElement.InputSlot = 0;
+                    positionElement.AlignedByteOffset = static_cast<unsigned int>(isQuantized
+                        ? offsetof(eae6320::Graphics::VertexFormats::sMeshQuantized, x) : offsetof(eae6320::Graphics::VertexFormats::sMesh, x));
+                    positionElement.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+                    positionElement.InstanceDataStepRate = 0;   // (Must be zero for per-vertex data)
+                }
+
+                // TEXCOORD
+                // 2 floats == 8 bytes (or 2 16-bit floats == 4 bytes if quantized)
+                // Offset = 12 (or 8 if quantized)
+                {
+                    auto& colorElement = layoutDescription[1];
+
+                    colorElement.SemanticName = "TEXCOORD";
+                    colorElement.SemanticIndex = 0; // (Semantics without modifying indices at the end can always use zero)
+                    colorElement.Format = isQuantized ? DXGI_FORMAT_R16G16_FLOAT : DXGI_FORMAT_R32G32_FLOAT;
+                    colorElement.InputSlot = 0;
+                    colorElement.AlignedByteOffset = static_cast<unsigned int>(isQuantized
+                        ? offsetof(eae6320::Graphics::VertexFormats::sMeshQuantized, u) : offsetof(eae6320::Graphics::VertexFormats::sMesh, u));
+                    colorElement.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+                    colorElement.InstanceDataStepRate = 0;  // (Must be zero for per-vertex data)
+                }
+
+                // COLOR
+                // 4 8-bit ints == 4 bytes
+                // Offset = 20 (or 12 if quantized)
+                {
+                    auto& colorElement = layoutDescription[2];
+
+                    colorElement.SemanticName = "COLOR";
+                    colorElement.SemanticIndex = 0;	// (Semantics without modifying indices at the end can always use zero)
+                    colorElement.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+                    colorElement.InputSlot = 0;
+                    colorElement.AlignedByteOffset = static_cast<unsigned int>(isQuantized
+                        ? offsetof(eae6320::Graphics::VertexFormats::sMeshQuantized, r) : offsetof(eae6320::Graphics::VertexFormats::sMesh, r));
+                    colorElement.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+                    colorElement.InstanceDataStepRate = 0;	// (Must be zero for per-vertex data)
+                }
+            }
+
+            const auto d3dResult = direct3dDevice->CreateInputLayout(layoutDescription, vertexElementCount,
+                vertexShaderDataFromFile.data, vertexShaderDataFromFile.size, &m_vertexInputLayout);
+            if (FAILED(d3dResult))
+            {
+                result = eae6320::Results::Failure;
+                EAE6320_ASSERTF(false, "Geometry vertex input layout creation failed (HRESULT %#010x)", d3dResult);
+                eae6320::Logging::OutputError("Direct3D failed to create the geometry vertex input layout (HRESULT %#010x)", d3dResult);
+            }
+
+            vertexShaderDataFromFile.Free();
+            if (!result)
+            {
+                goto OnExit;
+            }
+        }
+        else
+        {
+            EAE6320_ASSERTF(false, errorMessage.c_str());
+            eae6320::Logging::OutputError("The geometry vertex input layout shader couldn't be loaded: %s", errorMessage.c_str());
+            goto OnExit;
+        }
+    }
+
+    // Create the bigger buffers
+    if (i_vertexCapacity != m_vertexCapacity)
+    {
+        if (!(result = CreateBuffer(uint64_t(i_vertexCapacity) * vertexSize, D3D11_BIND_VERTEX_BUFFER, m_vertexBuffer, uint64_t(m_vertexCapacity) * vertexSize,
+            vertexBuffer_new, "vertex")))
+        {
+            goto OnExit;
+        }
+    }
+    if (i_indexCapacity != m_indexCapacity)
+    {
+        if (!(result = CreateBuffer(uint64_t(i_indexCapacity) * indexSize, D3D11_BIND_INDEX_BUFFER, m_indexBuffer, uint64_t(m_indexCapacity) * indexSize,
+            indexBuffer_new, "index")))
+        {
+            goto OnExit;
+        }
+    }
+    // Replace the old buffers
+    if (vertexBuffer_new)
+    {
+        if (m_vertexBuffer)
+        {
+            m_vertexBuffer->Release();
+        }
+        m_vertexBuffer = vertexBuffer_new;
+        vertexBuffer_new = nullptr;
+    }
+    if (indexBuffer_new)
+    {
+        if (m_indexBuffer)
+        {
+            m_indexBuffer->Release();
+        }
+        m_indexBuffer = indexBuffer_new;
+        indexBuffer_new = nullptr;
+    }
+    // If this pool was bound it was bound with the old buffers
+    if (s_boundPool == this)
+    {
+        s_boundPool = nullptr;
+    }
+
+OnExit:
+
+    // Any new buffers that didn't replace the old ones are released
+    if (vertexBuffer_new)
+    {
+        vertexBuffer_new->Release();
+        vertexBuffer_new = nullptr;
+    }
+    if (indexBuffer_new)
+    {
+        indexBuffer_new->Release();
+        indexBuffer_new = nullptr;
+    }
+
+    return result;
+}
+
+eae6320::cResult eae6320::Graphics::cGeometryPool::Upload(const sAllocation& i_allocation, const void* const i_vertexData, const void* const i_indices)
+{
+    const auto vertexSize = MeshFormats::VertexEncodings::GetSizeOfVertex(m_vertexEncoding);
+    const auto indexSize = MeshFormats::IndexFormats::GetSizeOfIndex(m_indexFormat);
+    CopyToBuffer(m_vertexBuffer, uint64_t(i_allocation.firstVertex) * vertexSize, i_vertexData, uint64_t(i_allocation.vertexCount) * vertexSize);
+    CopyToBuffer(m_indexBuffer, uint64_t(i_allocation.firstIndex) * indexSize, i_indices, uint64_t(i_allocation.indexCount) * indexSize);
+
+    return eae6320::Results::Success;
+}
+
+eae6320::cResult eae6320::Graphics::cGeometryPool::CleanUp()
+{
+    auto result = eae6320::Results::Success;
+
+    if (m_vertexBuffer)
+    {
+        m_vertexBuffer->Release();
+        m_vertexBuffer = nullptr;
+    }
+
+    if (m_indexBuffer)
+    {
+        m_indexBuffer->Release();
+        m_indexBuffer = nullptr;
+    }
+
+    if (m_vertexInputLayout)
+    {
+        m_vertexInputLayout->Release();
+        m_vertexInputLayout = nullptr;
+    }
+
+    return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+    eae6320::cResult CreateBuffer(const uint64_t i_size, const unsigned int i_bindFlags, ID3D11Buffer* const i_bufferToCopy, const uint64_t i_sizeToCopy,
+        ID3D11Buffer*& o_buffer, const char* const i_bufferDescription)
+    {
+        auto* const direct3dDevice = eae6320::Graphics::sContext::g_context.direct3dDevice;
+        EAE6320_ASSERT(direct3dDevice);
+        EAE6320_ASSERT(i_sizeToCopy <= i_size);
+
+        D3D11_BUFFER_DESC bufferDescription{};
+        {
+            EAE6320_ASSERT(i_size < (uint64_t(1u) << (sizeof(bufferDescription.ByteWidth) * 8)));
+            bufferDescription.ByteWidth = static_cast<unsigned int>(i_size);
+            bufferDescription.Usage = D3D11_USAGE_DEFAULT;  // Meshes are copied into the buffer as they are loaded
+            bufferDescription.BindFlags = i_bindFlags;
+            bufferDescription.CPUAccessFlags = 0;   // No CPU access is necessary
+            bufferDescription.MiscFlags = 0;
+            bufferDescription.StructureByteStride = 0;  // Not used
+        }
+        const auto d3dResult = direct3dDevice->CreateBuffer(&bufferDescription, nullptr, &o_buffer);
+        if (FAILED(d3dResult))
+        {
+            EAE6320_ASSERTF(false, "Geometry pool %s buffer creation failed (HRESULT %#010x)", i_bufferDescription, d3dResult);
+            eae6320::Logging::OutputError("Direct3D failed to create a geometry pool %s buffer (HRESULT %#010x)", i_bufferDescription, d3dResult);
+            o_buffer = nullptr;
+            return eae6320::Results::Failure;
+        }
+        // The existing data is copied on the GPU
+        if (i_bufferToCopy && (i_sizeToCopy > 0))
+        {
+            auto* const direct3dImmediateContext = eae6320::Graphics::sContext::g_context.direct3dImmediateContext;
+            EAE6320_ASSERT(direct3dImmediateContext);
+            D3D11_BOX sourceBox{};
+            {
+                sourceBox.left = 0;
+                sourceBox.right = static_cast<unsigned int>(i_sizeToCopy);
+                sourceBox.top = 0;
+                sourceBox.bottom = 1;
+                sourceBox.front = 0;
+                sourceBox.back = 1;
+            }
+            constexpr unsigned int subresource = 0;
+            constexpr unsigned int destinationX = 0, destinationY = 0, destinationZ = 0;
+            direct3dImmediateContext->CopySubresourceRegion(o_buffer, subresource, destinationX, destinationY, destinationZ,
+                i_bufferToCopy, subresource, &sourceBox);
+        }
+        return eae6320::Results::Success;
+    }
+
+    void CopyToBuffer(ID3D11Buffer* const i_buffer, const uint64_t i_offset, const void* const i_data, const uint64_t i_size)
+    {
+        EAE6320_ASSERT(i_buffer);
+        auto* const direct3dImmediateContext = eae6320::Graphics::sContext::g_context.direct3dImmediateContext;
+        EAE6320_ASSERT(direct3dImmediateContext);
+
+        // Only the mesh's range of the buffer is written
+        D3D11_BOX destinationBox{};
+        {
+            destinationBox.left = static_cast<unsigned int>(i_offset);
+            destinationBox.right = static_cast<unsigned int>(i_offset + i_size);
+            destinationBox.top = 0;
+            destinationBox.bottom = 1;
+            destinationBox.front = 0;
+            destinationBox.back = 1;
+        }
+        constexpr unsigned int subresource = 0;
+        // (The pitches are ignored for buffers)
+        constexpr unsigned int rowPitch = 0, depthPitch = 0;
+        direct3dImmediateContext->UpdateSubresource(i_buffer, subresource, &destinationBox, i_data, rowPitch, depthPitch);
+    }
+}
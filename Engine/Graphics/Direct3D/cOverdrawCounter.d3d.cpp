@@ -0,0 +1,98 @@
+// Include Files
+//==============
+
+#include "../cOverdrawCounter.h"
+
+#include "Includes.h"
+#include "../sContext.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Implementation
+//===============
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Graphics::cOverdrawCounter::InitializePlatform()
+{
+	auto* const direct3dDevice = sContext::g_context.direct3dDevice;
+	EAE6320_ASSERT( direct3dDevice );
+
+	D3D11_QUERY_DESC queryDescription{};
+	{
+		// An occlusion query counts the samples that pass the depth test
+		queryDescription.Query = D3D11_QUERY_OCCLUSION;
+		queryDescription.MiscFlags = 0;
+	}
+	for ( auto& query : m_queries )
+	{
+		const auto d3dResult = direct3dDevice->CreateQuery( &queryDescription, &query.query );
+		if ( FAILED( d3dResult ) )
+		{
+			EAE6320_ASSERTF( false, "CreateQuery() failed (HRESULT %#010x)", d3dResult );
+			Logging::OutputError( "Direct3D failed to create a query for the overdraw counter with HRESULT %#010x", d3dResult );
+			CleanUpPlatform();
+			return Results::Failure;
+		}
+	}
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Graphics::cOverdrawCounter::CleanUpPlatform()
+{
+	auto result = Results::Success;
+
+	for ( auto& query : m_queries )
+	{
+		if ( query.query )
+		{
+			query.query->Release();
+			query.query = nullptr;
+		}
+	}
+
+	return result;
+}
+
+// Render
+//-------
+
+void eae6320::Graphics::cOverdrawCounter::BeginQuery( sQuery& io_query )
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+
+	EAE6320_ASSERT( io_query.query );
+	direct3dImmediateContext->Begin( io_query.query );
+}
+
+void eae6320::Graphics::cOverdrawCounter::EndQuery( sQuery& io_query )
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+
+	EAE6320_ASSERT( io_query.query );
+	direct3dImmediateContext->End( io_query.query );
+}
+
+bool eae6320::Graphics::cOverdrawCounter::GetQueryResult( sQuery& io_query, uint64_t& o_sampleCount )
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+
+	EAE6320_ASSERT( io_query.query );
+	// S_FALSE is returned (rather than waiting) if the result isn't available yet
+	UINT64 sampleCount = 0;
+	constexpr unsigned int dontFlush = D3D11_ASYNC_GETDATA_DONOTFLUSH;
+	const auto d3dResult = direct3dImmediateContext->GetData( io_query.query, &sampleCount, sizeof( sampleCount ), dontFlush );
+	if ( d3dResult != S_OK )
+	{
+		EAE6320_ASSERTF( SUCCEEDED( d3dResult ), "GetData() failed for an overdraw query (HRESULT %#010x)", d3dResult );
+		return false;
+	}
+	o_sampleCount = static_cast<uint64_t>( sampleCount );
+	return true;
+}
@@ -113,7 +113,8 @@ eae6320::cResult eae6320::Graphics::cRenderState::InitializeFromBits()
 				renderTargetBlendDescription.DestBlendAlpha = D3D11_BLEND_ZERO;
 				renderTargetBlendDescription.BlendOpAlpha = D3D11_BLEND_OP_ADD;
 			}
-			renderTargetBlendDescription.RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+			// Depth Only
+			renderTargetBlendDescription.RenderTargetWriteMask = IsDepthOnlyEnabled() ? 0 : D3D11_COLOR_WRITE_ENABLE_ALL;
 		}
 		const auto d3dResult = direct3dDevice->CreateBlendState( &blendStateDescription, &m_blendState );
 		if ( FAILED( d3dResult ) )
@@ -139,9 +140,11 @@ eae6320::cResult eae6320::Graphics::cRenderState::InitializeFromBits()
 			D3D11_STENCIL_OP_KEEP;
 		if ( IsDepthBufferingEnabled() )
 		{
-			// The new fragment becomes a pixel if its depth is less than what has previously been written
+			// The new fragment becomes a pixel if its depth is less than or equal to what has previously been written
+			// (equal so that a mesh can be drawn again after a depth prepass,
+			// and so that the sky box can be drawn at the far plane after the depth buffer is cleared to it)
 			depthStateDescription.DepthEnable = TRUE;
-			depthStateDescription.DepthFunc = D3D11_COMPARISON_LESS;
+			depthStateDescription.DepthFunc = D3D11_COMPARISON_LESS_EQUAL;
 			// Write to the depth buffer
 			depthStateDescription.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
 		}
@@ -4,10 +4,12 @@
 #include "../cSprite.h"
 
 #include "Includes.h"
+#include "../cGeometryPool.h"
 #include "../sContext.h"
 #include "../VertexFormats.h"
 
 #include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/Prefetch.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/Platform/Platform.h>
 
@@ -44,6 +46,8 @@ void eae6320::Graphics::cSprite::Draw() const
         // Set the topology 
         direct3dImmediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
     }
+    // The next mesh has to bind its geometry pool's buffers again
+    cGeometryPool::ForgetBoundPool();
     // Render triangles from the currently-bound vertex buffer
     {
         constexpr unsigned int vertexCountToRender = 4;
@@ -68,7 +72,7 @@ eae6320::cResult eae6320::Graphics::cSprite::Initialize(const eae6320::Math::sVe
         // Load the compiled binary vertex shader for the input layout
         eae6320::Platform::sDataFromFile vertexShaderDataFromFile;
         std::string errorMessage;
-        if (result = eae6320::Platform::LoadBinaryFile("data/Shaders/Vertex/vertexInputLayout_sprite.shd", vertexShaderDataFromFile, &errorMessage))
+        if (result = eae6320::Assets::LoadBinaryFile("data/Shaders/Vertex/vertexInputLayout_sprite.shd", vertexShaderDataFromFile, &errorMessage))
         {
             // Create the vertex layout
 
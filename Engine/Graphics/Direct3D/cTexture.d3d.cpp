@@ -17,7 +17,13 @@
 
 namespace
 {
+	// The texture only has the MIP levels from the given one on
+	// (if there is no subresource data the texture's contents are undefined)
+	eae6320::cResult CreateTextureAndView( const char* const i_path, const eae6320::Graphics::TextureFormats::sTextureInfo& i_info,
+		const uint8_t i_mostDetailedMipLevel, const uint16_t i_layerCount, const D3D11_SUBRESOURCE_DATA* const i_subResourceData,
+		ID3D11Texture2D*& o_resource, ID3D11ShaderResourceView*& o_view );
 	constexpr DXGI_FORMAT GetDxgiFormat( const eae6320::Graphics::TextureFormats::Compression::eType i_compressionType );
+	unsigned int GetRowPitch( const eae6320::Graphics::TextureFormats::sTextureInfo& i_info, const uint8_t i_mipLevel );
 }
 
 // Interface
@@ -45,17 +51,14 @@ eae6320::cResult eae6320::Graphics::cTexture::Initialize( const char* const i_pa
 {
 	auto result = Results::Success;
 
-	auto* const direct3dDevice = sContext::g_context.direct3dDevice;
-	EAE6320_ASSERT( direct3dDevice );
-
 	ID3D11Texture2D* resource = nullptr;
 	D3D11_SUBRESOURCE_DATA* subResourceData = nullptr;
 
-	// Allocate data for a "subresource" for each MIP level
+	// Allocate data for a "subresource" for each resident MIP level
 	// (Subresources are the way that Direct3D deals with textures that act like a single resource
 	// but that actually have multiple textures associated with that single resource
 	// (e.g. MIP maps, volume textures, texture arrays))
-	const auto mipMapCount = static_cast<uint_fast8_t>( m_info.mipMapCount );
+	const auto mipMapCount = static_cast<uint_fast8_t>( m_info.mipMapCount - m_mostDetailedResidentMipLevel );
 	{
 		subResourceData = new (std::nothrow) D3D11_SUBRESOURCE_DATA[mipMapCount];
 		if ( !subResourceData )
@@ -67,100 +70,22 @@ eae6320::cResult eae6320::Graphics::cTexture::Initialize( const char* const i_pa
 			goto OnExit;
 		}
 	}
-	// Fill in the data for each MIP level
-	const auto width = static_cast<uint_fast16_t>( m_info.width );
-	const auto height = static_cast<uint_fast16_t>( m_info.height );
+	// Fill in the data for each resident MIP level
+	// (the size of the texture data has already been validated)
+	for ( uint_fast8_t i = 0; i < mipMapCount; ++i )
 	{
-		auto currentWidth = width;
-		auto currentHeight = height;
-		auto currentOffset = reinterpret_cast<uintptr_t>( i_textureData );
-		const auto finalOffset = currentOffset + i_textureDataSize;
-		const auto blockSize = TextureFormats::Compression::GetSizeOfBlock( m_info.compressionType );
-		for ( uint_fast8_t i = 0; i < mipMapCount; ++i )
-		{
-			// Calculate how much memory this MIP level uses
-			const auto blockCount_singleRow = ( currentWidth + 3 ) / 4;
-			const auto byteCount_singleRow = blockCount_singleRow * blockSize;
-			const auto rowCount = ( currentHeight + 3 ) / 4;
-			const auto byteCount_currentMipLevel = byteCount_singleRow * rowCount;
-			// Set the data into the subresource
-			{
-				auto& currentSubResourceData = subResourceData[i];
-				currentSubResourceData.pSysMem = reinterpret_cast<void*>( currentOffset );
-				currentSubResourceData.SysMemPitch = static_cast<unsigned int>( byteCount_singleRow );
-				currentSubResourceData.SysMemSlicePitch = static_cast<unsigned int>( byteCount_currentMipLevel );
-			}
-			// Update current data for next iteration
-			{
-				currentOffset += byteCount_currentMipLevel;
-				if ( currentOffset <= finalOffset )
-				{
-					currentWidth = std::max( currentWidth / 2, 1u );
-					currentHeight = std::max( currentHeight / 2, 1u );
-				}
-				else
-				{
-					result = Results::InvalidFile;
-					EAE6320_ASSERTF( false, "Texture file %s is too small to contain MIP map #%u",
-						i_path, i );
-					Logging::OutputError( "The texture file %s is too small to contain MIP map #%u",
-						i_path, i );
-					goto OnExit;
-				}
-			}
-		}
-		EAE6320_ASSERTF( currentOffset == finalOffset, "The texture file %s has more texture data (%u) than it should (%u)",
-			i_path, finalOffset, currentOffset );
-	}
-	// Create the resource
-	const auto dxgiFormat = GetDxgiFormat( m_info.compressionType );
-	{
-		D3D11_TEXTURE2D_DESC textureDescription{};
-		{
-			textureDescription.Width = static_cast<unsigned int>( width );
-			textureDescription.Height = static_cast<unsigned int>( height );
-			textureDescription.MipLevels = static_cast<unsigned int>( mipMapCount );
-			textureDescription.ArraySize = 1;
-			textureDescription.Format = dxgiFormat;
-			{
-				DXGI_SAMPLE_DESC& sampleDescription = textureDescription.SampleDesc;
-				sampleDescription.Count = 1;	// No multisampling
-				sampleDescription.Quality = 0;	// Doesn't matter when Count is 1
-			}
-			textureDescription.Usage = D3D11_USAGE_IMMUTABLE;	// The texture will never change once it's been created
-			textureDescription.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-			textureDescription.CPUAccessFlags = 0;	// No CPU access is necessary
-			textureDescription.MiscFlags = 0;
-		}
-		const auto d3dResult = direct3dDevice->CreateTexture2D( &textureDescription, subResourceData, &resource );
-		if ( FAILED( d3dResult ) )
-		{
-			result = Results::Failure;
-			EAE6320_ASSERTF( false, "CreateTexture2D() failed for %s with HRESULT %#010x", i_path, d3dResult );
-			eae6320::Logging::OutputError( "Direct3D failed to create a texture from %s with HRESULT %#010x", i_path, d3dResult );
-			goto OnExit;
-		}
+		const auto mipLevel = static_cast<uint8_t>( m_mostDetailedResidentMipLevel + i );
+		auto& currentSubResourceData = subResourceData[i];
+		currentSubResourceData.pSysMem = static_cast<const uint8_t*>( i_textureData ) + GetMipLevelOffset( mipLevel );
+		currentSubResourceData.SysMemPitch = GetRowPitch( m_info, mipLevel );
+		currentSubResourceData.SysMemSlicePitch = static_cast<unsigned int>( GetMipLevelByteCount( mipLevel ) );
 	}
-	// Create the view
+	// Create the resource and the view
+	// (a texture that doesn't share an array is the only layer in its own)
+	constexpr uint16_t singleLayer = 1;
+	if ( !( result = CreateTextureAndView( i_path, m_info, m_mostDetailedResidentMipLevel, singleLayer, subResourceData, resource, m_textureView ) ) )
 	{
-		D3D11_SHADER_RESOURCE_VIEW_DESC shaderResourceViewDescription{};
-		{
-			shaderResourceViewDescription.Format = dxgiFormat;
-			shaderResourceViewDescription.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-			{
-				D3D11_TEX2D_SRV& shaderResourceView2dDescription = shaderResourceViewDescription.Texture2D;
-				shaderResourceView2dDescription.MostDetailedMip = 0;	// Use the highest resolution in the texture resource
-				shaderResourceView2dDescription.MipLevels = -1;	// Use all MIP levels
-			}
-		}
-		const auto d3dResult = direct3dDevice->CreateShaderResourceView( resource, &shaderResourceViewDescription, &m_textureView );
-		if ( FAILED( d3dResult ) )
-		{
-			result = Results::Failure;
-			EAE6320_ASSERTF( false, "CreateShaderResourceView() failed for %s with HRESULT %#010x", i_path, d3dResult );
-			eae6320::Logging::OutputError( "Direct3D failed to create a shader resource view for %s with HRESULT %#010x", i_path, d3dResult );
-			goto OnExit;
-		}
+		goto OnExit;
 	}
 
 OnExit:
@@ -194,21 +119,240 @@ eae6320::cResult eae6320::Graphics::cTexture::CleanUp()
 	return result;
 }
 
+// Shared Arrays
+//--------------
+
+eae6320::cResult eae6320::Graphics::cTexture::UploadToSharedArray( const char* const i_path, const void* const i_textureData )
+{
+	auto result = Results::Success;
+
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+
+	EAE6320_ASSERT( m_sharedArray && m_sharedArray->textureView );
+	ID3D11Resource* resource = nullptr;
+	m_sharedArray->textureView->GetResource( &resource );
+	// Every MIP level is copied into the texture's layer
+	// (the size of the texture data has already been validated)
+	for ( uint_fast8_t mipLevel = 0; mipLevel < m_info.mipMapCount; ++mipLevel )
+	{
+		const auto subResource = D3D11CalcSubresource( static_cast<unsigned int>( mipLevel ), static_cast<unsigned int>( m_arrayLayer ),
+			static_cast<unsigned int>( m_info.mipMapCount ) );
+		constexpr D3D11_BOX* const updateEntireSubResource = nullptr;
+		direct3dImmediateContext->UpdateSubresource( resource, subResource, updateEntireSubResource,
+			static_cast<const uint8_t*>( i_textureData ) + GetMipLevelOffset( static_cast<uint8_t>( mipLevel ) ),
+			GetRowPitch( m_info, static_cast<uint8_t>( mipLevel ) ),
+			static_cast<unsigned int>( GetMipLevelByteCount( static_cast<uint8_t>( mipLevel ) ) ) );
+	}
+	resource->Release();
+	resource = nullptr;
+	// The texture holds its own reference to the array's view
+	// (so that binding it and cleaning it up work the same as for a texture with its own array)
+	m_textureView = m_sharedArray->textureView;
+	m_textureView->AddRef();
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::cTexture::CreateSharedArray( const char* const i_path, const uint16_t i_layerCount, sSharedArray& io_array )
+{
+	auto result = Results::Success;
+
+	ID3D11Texture2D* resource = nullptr;
+
+	// The layers are filled in as textures are added
+	constexpr uint8_t mostDetailedMipLevel = 0;
+	constexpr D3D11_SUBRESOURCE_DATA* const noInitialData = nullptr;
+	if ( !( result = CreateTextureAndView( i_path, io_array.info, mostDetailedMipLevel, i_layerCount, noInitialData,
+		resource, io_array.textureView ) ) )
+	{
+		goto OnExit;
+	}
+
+OnExit:
+
+	// The view holds its own reference to the resource
+	if ( resource )
+	{
+		resource->Release();
+		resource = nullptr;
+	}
+	if ( !result && io_array.textureView )
+	{
+		io_array.textureView->Release();
+		io_array.textureView = nullptr;
+	}
+
+	return result;
+}
+
+void eae6320::Graphics::cTexture::DestroySharedArray( sSharedArray& io_array )
+{
+	if ( io_array.textureView )
+	{
+		io_array.textureView->Release();
+		io_array.textureView = nullptr;
+	}
+}
+
+// Streaming
+//----------
+
+eae6320::cResult eae6320::Graphics::cTexture::ChangeMostDetailedResidentMipLevel( const uint8_t i_mipLevel, const void* const i_textureData )
+{
+	auto result = Results::Success;
+
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+
+	// A Direct3D texture can't change how many MIP levels it has,
+	// and so a new texture is created with the new levels
+	// and the levels that were already resident are copied into it on the GPU
+	ID3D11Texture2D* resource_new = nullptr;
+	ID3D11ShaderResourceView* view_new = nullptr;
+	ID3D11Resource* resource_old = nullptr;
+	// Only textures that have an array of their own are streamed
+	EAE6320_ASSERT( !m_sharedArray );
+	constexpr uint16_t singleLayer = 1;
+	if ( !( result = CreateTextureAndView( m_path.c_str(), m_info, i_mipLevel, singleLayer, nullptr, resource_new, view_new ) ) )
+	{
+		goto OnExit;
+	}
+	EAE6320_ASSERT( m_textureView );
+	m_textureView->GetResource( &resource_old );
+	for ( auto mipLevel = i_mipLevel; mipLevel < m_info.mipMapCount; ++mipLevel )
+	{
+		const auto subResource_new = static_cast<unsigned int>( mipLevel - i_mipLevel );
+		if ( mipLevel >= m_mostDetailedResidentMipLevel )
+		{
+			const auto subResource_old = static_cast<unsigned int>( mipLevel - m_mostDetailedResidentMipLevel );
+			constexpr unsigned int x = 0, y = 0, z = 0;
+			constexpr D3D11_BOX* const copyEntireSubResource = nullptr;
+			direct3dImmediateContext->CopySubresourceRegion( resource_new, subResource_new, x, y, z,
+				resource_old, subResource_old, copyEntireSubResource );
+		}
+		else
+		{
+			constexpr D3D11_BOX* const updateEntireSubResource = nullptr;
+			direct3dImmediateContext->UpdateSubresource( resource_new, subResource_new, updateEntireSubResource,
+				static_cast<const uint8_t*>( i_textureData ) + GetMipLevelOffset( mipLevel ), GetRowPitch( m_info, mipLevel ),
+				static_cast<unsigned int>( GetMipLevelByteCount( mipLevel ) ) );
+		}
+	}
+	// The new view replaces the old one
+	// (anything that is still using the old texture keeps its own reference)
+	m_textureView->Release();
+	m_textureView = view_new;
+	view_new = nullptr;
+
+OnExit:
+
+	if ( resource_old )
+	{
+		resource_old->Release();
+		resource_old = nullptr;
+	}
+	if ( view_new )
+	{
+		view_new->Release();
+		view_new = nullptr;
+	}
+	if ( resource_new )
+	{
+		resource_new->Release();
+		resource_new = nullptr;
+	}
+
+	return result;
+}
+
 // Helper Function Definitions
 //============================
 
 namespace
 {
+	eae6320::cResult CreateTextureAndView( const char* const i_path, const eae6320::Graphics::TextureFormats::sTextureInfo& i_info,
+		const uint8_t i_mostDetailedMipLevel, const uint16_t i_layerCount, const D3D11_SUBRESOURCE_DATA* const i_subResourceData,
+		ID3D11Texture2D*& o_resource, ID3D11ShaderResourceView*& o_view )
+	{
+		auto* const direct3dDevice = eae6320::Graphics::sContext::g_context.direct3dDevice;
+		EAE6320_ASSERT( direct3dDevice );
+
+		const auto dxgiFormat = GetDxgiFormat( i_info.compressionType );
+		// Create the resource
+		{
+			D3D11_TEXTURE2D_DESC textureDescription{};
+			{
+				textureDescription.Width = std::max( static_cast<unsigned int>( i_info.width ) >> i_mostDetailedMipLevel, 1u );
+				textureDescription.Height = std::max( static_cast<unsigned int>( i_info.height ) >> i_mostDetailedMipLevel, 1u );
+				textureDescription.MipLevels = static_cast<unsigned int>( i_info.mipMapCount - i_mostDetailedMipLevel );
+				textureDescription.ArraySize = static_cast<unsigned int>( i_layerCount );
+				textureDescription.Format = dxgiFormat;
+				{
+					DXGI_SAMPLE_DESC& sampleDescription = textureDescription.SampleDesc;
+					sampleDescription.Count = 1;	// No multisampling
+					sampleDescription.Quality = 0;	// Doesn't matter when Count is 1
+				}
+				// The texture is only ever changed by copying into it on the GPU
+				// (when a more detailed or less detailed texture is streamed in to replace it)
+				textureDescription.Usage = D3D11_USAGE_DEFAULT;
+				textureDescription.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+				textureDescription.CPUAccessFlags = 0;	// No CPU access is necessary
+				textureDescription.MiscFlags = 0;
+			}
+			const auto d3dResult = direct3dDevice->CreateTexture2D( &textureDescription, i_subResourceData, &o_resource );
+			if ( FAILED( d3dResult ) )
+			{
+				EAE6320_ASSERTF( false, "CreateTexture2D() failed for %s with HRESULT %#010x", i_path, d3dResult );
+				eae6320::Logging::OutputError( "Direct3D failed to create a texture from %s with HRESULT %#010x", i_path, d3dResult );
+				return eae6320::Results::Failure;
+			}
+		}
+		// Create the view
+		{
+			D3D11_SHADER_RESOURCE_VIEW_DESC shaderResourceViewDescription{};
+			{
+				shaderResourceViewDescription.Format = dxgiFormat;
+				shaderResourceViewDescription.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+				{
+					D3D11_TEX2D_ARRAY_SRV& shaderResourceView2dArrayDescription = shaderResourceViewDescription.Texture2DArray;
+					shaderResourceView2dArrayDescription.MostDetailedMip = 0;	// Use the highest resolution in the texture resource
+					shaderResourceView2dArrayDescription.MipLevels = -1;	// Use all MIP levels
+					shaderResourceView2dArrayDescription.FirstArraySlice = 0;
+					shaderResourceView2dArrayDescription.ArraySize = static_cast<unsigned int>( i_layerCount );
+				}
+			}
+			const auto d3dResult = direct3dDevice->CreateShaderResourceView( o_resource, &shaderResourceViewDescription, &o_view );
+			if ( FAILED( d3dResult ) )
+			{
+				EAE6320_ASSERTF( false, "CreateShaderResourceView() failed for %s with HRESULT %#010x", i_path, d3dResult );
+				eae6320::Logging::OutputError( "Direct3D failed to create a shader resource view for %s with HRESULT %#010x", i_path, d3dResult );
+				return eae6320::Results::Failure;
+			}
+		}
+
+		return eae6320::Results::Success;
+	}
+
 	constexpr DXGI_FORMAT GetDxgiFormat( const eae6320::Graphics::TextureFormats::Compression::eType i_compressionType )
 	{
 		switch ( i_compressionType )
 		{
 			case eae6320::Graphics::TextureFormats::Compression::BC1: return DXGI_FORMAT_BC1_UNORM;
 			case eae6320::Graphics::TextureFormats::Compression::BC3: return DXGI_FORMAT_BC3_UNORM;
+			case eae6320::Graphics::TextureFormats::Compression::BC4: return DXGI_FORMAT_BC4_UNORM;
+			case eae6320::Graphics::TextureFormats::Compression::BC5: return DXGI_FORMAT_BC5_UNORM;
 		}
 
 		// Other formats are possible, but not for our class
 		EAE6320_ASSERT( false );
 		return DXGI_FORMAT_UNKNOWN;
 	}
+
+	unsigned int GetRowPitch( const eae6320::Graphics::TextureFormats::sTextureInfo& i_info, const uint8_t i_mipLevel )
+	{
+		const auto width = std::max( static_cast<unsigned int>( i_info.width ) >> i_mipLevel, 1u );
+		const auto blockCount_singleRow = ( width + 3 ) / 4;
+		return blockCount_singleRow * eae6320::Graphics::TextureFormats::Compression::GetSizeOfBlock( i_info.compressionType );
+	}
 }
@@ -6,7 +6,9 @@
 #include "cConstantBuffer.h"
 #include "ConstantBufferFormats.h"
 #include "cEffect.h"
+#include "cGeometryPool.h"
 #include "cMesh.h"
+#include "cOverdrawCounter.h"
 #include "cSamplerState.h"
 #include "cSprite.h"
 #include "cTexture.h"
@@ -14,6 +16,7 @@
 #include "sCamera.h"
 #include "sContext.h"
 #include "sColor.h"
+#include "TextureStreaming.h"
 
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Concurrency/cEvent.h>
@@ -27,6 +30,9 @@
 #include <Engine/UserOutput/UserOutput.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
 #include <utility>
 #include <vector>
 
@@ -44,6 +50,25 @@ namespace
     eae6320::Graphics::cConstantBuffer                              s_constantBuffer_perDrawCall(eae6320::Graphics::ConstantBufferTypes::PerDrawCall);
     // In our class we will only have a single sampler state
     eae6320::Graphics::cSamplerState                                s_samplerState;
+    // This counts how many times each pixel is shaded by the meshes in the 3D scene
+    eae6320::Graphics::cOverdrawCounter                             s_overdrawCounter;
+    // This counts how many opaque mesh draw calls had to bind their texture
+    // (the others sampled a layer of the array that was already bound)
+    struct
+    {
+        uint64_t drawCount = 0;
+        uint64_t bindCount = 0;
+    }                                                               s_textureBindStatistics;
+#ifdef EAE6320_GRAPHICS_ISDEPTHPREPASSENABLED
+    // The depth prepass draws every opaque mesh with this effect before the meshes are drawn with their own
+    // (it uses the same vertex shader as the meshes' effects so that the depths match exactly)
+    eae6320::Graphics::cEffect::Handle                              s_effect_depthPrepass;
+    constexpr auto* const                                           s_vertexShaderPath_depthPrepass = "data/Shaders/Vertex/mesh.shd";
+    constexpr auto* const                                           s_fragmentShaderPath_depthPrepass = "data/Shaders/Fragment/depthOnly.shd";
+#endif
+    // The resolution is needed to estimate how many pixels a texture covers
+    uint16_t                                                        s_resolutionWidth = 0;
+    uint16_t                                                        s_resolutionHeight = 0;
 
     // Submission Data
     //----------------
@@ -70,9 +95,16 @@ namespace
     {
         std::vector<sDataRequiredToRenderAMesh>                     meshRenderDataList;
         std::vector<sDataRequiredToRenderASprite>                   spriteRenderDataList;
+        // The sky box is drawn after every opaque mesh
+        // (if no sky box was submitted its mesh is null)
+        sDataRequiredToRenderAMesh                                  skyBoxRenderData;
         eae6320::Graphics::ConstantBufferFormats::sPerFrame         constantData_perFrame;
         eae6320::Graphics::ConstantBufferFormats::sPerDrawCall      constantData_perDrawCall;
         eae6320::Graphics::sColor                                   backgroundColor;
+        // The camera's position is needed to cull the clusters of meshes that face away from it
+        eae6320::Math::sVector                                      cameraPosition;
+        // Multiplying a size by this and dividing by the distance from the camera gives the size in pixels
+        float                                                       screenSizeScale = 0.0f;
         float                                                       depthBufferClearDepth;
     };
     // In our class there will be two copies of the data required to render a frame:
@@ -93,6 +125,23 @@ namespace
     eae6320::Concurrency::cEvent                                    s_whenDataForANewFrameCanBeSubmittedFromApplicationThread;
 }
 
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+    void SetPositionDequantization(const eae6320::Graphics::cMesh& i_mesh, eae6320::Graphics::ConstantBufferFormats::sPerDrawCall& io_constantData_perDrawCall);
+    void SetTextureArrayLayer(const eae6320::Graphics::cTexture& i_texture, eae6320::Graphics::ConstantBufferFormats::sPerDrawCall& io_constantData_perDrawCall);
+    // The references to the submitted sky box are released
+    void ReleaseSkyBox(sDataRequiredToRenderAMesh& io_skyBoxRenderData);
+    // Only the mesh's clusters that could be visible are drawn
+    // (the draw data is uploaded to the per-draw-call constant buffer unless mesh draws are batched)
+    void DrawMesh(const sDataRequiredToRenderAMesh& i_meshRenderData, const eae6320::Math::cMatrix_transformation& i_transform_localToWorld,
+        const eae6320::Graphics::ConstantBufferFormats::sPerDrawCall& i_constantData_perDrawCall);
+    // The texture is asked for the MIP level that matches how big the mesh is on the screen
+    void RequestTextureResolution(const sDataRequiredToRenderAMesh& i_meshRenderData, const eae6320::Math::cMatrix_transformation& i_transform_localToWorld);
+}
+
 // Interface
 //==========
 
@@ -125,6 +174,8 @@ void eae6320::Graphics::SubmitCamera(const sCamera& i_camera, const Math::sVecto
     auto& constantData_perFrame = s_dataBeingSubmittedByApplicationThread->constantData_perFrame;
     constantData_perFrame.g_transform_worldToCamera = Math::cMatrix_transformation::CreateWorldToCameraTransform(i_orientation, i_position);
     constantData_perFrame.g_transform_cameraToProjected = Math::cMatrix_transformation::CreateCameraToProjectedTransform_perspective(i_camera.m_verticalFieldOfView_inRadians, i_camera.m_aspectRatio, i_camera.m_z_nearPlane, i_camera.m_z_farPlane);
+    s_dataBeingSubmittedByApplicationThread->cameraPosition = i_position;
+    s_dataBeingSubmittedByApplicationThread->screenSizeScale = static_cast<float>(s_resolutionHeight) / (2.0f * std::tan(i_camera.m_verticalFieldOfView_inRadians * 0.5f));
 }
     
 void eae6320::Graphics::SubmitMeshToBeRendered(cMesh* i_meshToDraw, cEffect* i_effectToBind, cTexture* i_textureToBind, const Math::sVector& i_position, const Math::cQuaternion& i_orientation)
@@ -147,6 +198,26 @@ void eae6320::Graphics::SubmitMeshToBeRendered(cMesh* i_meshToDraw, cEffect* i_e
     s_dataBeingSubmittedByApplicationThread->meshRenderDataList.push_back(meshRenderData);
 }
 
+void eae6320::Graphics::SubmitSkyBoxToBeRendered(cMesh* i_meshToDraw, cEffect* i_effectToBind, cTexture* i_textureToBind, const Math::sVector& i_position)
+{
+    EAE6320_ASSERT(s_dataBeingSubmittedByApplicationThread);
+    EAE6320_ASSERT(i_meshToDraw && i_effectToBind && i_textureToBind);
+
+    auto& skyBoxRenderData = s_dataBeingSubmittedByApplicationThread->skyBoxRenderData;
+    EAE6320_ASSERTF(!skyBoxRenderData.constantData_mesh, "Only one sky box can be submitted per frame");
+    ReleaseSkyBox(skyBoxRenderData);
+    {
+        skyBoxRenderData.constantData_texture = i_textureToBind;
+        skyBoxRenderData.constantData_texture->IncrementReferenceCount();
+        skyBoxRenderData.constantData_mesh = i_meshToDraw;
+        skyBoxRenderData.constantData_mesh->IncrementReferenceCount();
+        skyBoxRenderData.constantData_effect = i_effectToBind;
+        skyBoxRenderData.constantData_effect->IncrementReferenceCount();
+        skyBoxRenderData.constantData_position = i_position;
+        skyBoxRenderData.constantData_orientation = Math::cQuaternion();
+    }
+}
+
 void eae6320::Graphics::SubmitSpriteToBeRendered(cSprite* i_spriteToDraw, cEffect* i_effectToBind, cTexture* i_textureToBind)
 {
     EAE6320_ASSERT(s_dataBeingSubmittedByApplicationThread);
@@ -228,43 +299,139 @@ void eae6320::Graphics::RenderFrame()
         s_constantBuffer_perFrame.Update(&constantData_perFrame);
     }
 
-    // Scratch-pad for transparent meshes
+    // Scratch-pad for sorting meshes
     struct sMeshIndexTransformPair
     {
         uint16_t indexIntoMeshRenderDataList = 0;
         float cameraSpaceZ = 0.0f;
     };
     uint16_t meshCounter = 0;
+    std::vector<sMeshIndexTransformPair> opaqueMeshData;
     std::vector<sMeshIndexTransformPair> transparentMeshData;
+    const auto& meshRenderDataList = s_dataBeingRenderedByRenderThread->meshRenderDataList;
 
-    // Draw the opaque meshes & filter out transparent mehses
+    // Separate the opaque meshes from the transparent meshes
+    for (const auto& meshRenderData : meshRenderDataList)
     {
-        for (const auto& meshRenderData : s_dataBeingRenderedByRenderThread->meshRenderDataList)
+        const Math::sVector translation_localToCamera = s_dataBeingRenderedByRenderThread->constantData_perFrame.g_transform_worldToCamera * meshRenderData.constantData_position;
+        if (meshRenderData.constantData_effect->GetRenderState().IsAlphaTransparencyEnabled())
+        {
+            transparentMeshData.push_back({ meshCounter, translation_localToCamera.z });
+        }
+        else
         {
-            Math::cMatrix_transformation transform_localToWorld = Math::cMatrix_transformation(meshRenderData.constantData_orientation, meshRenderData.constantData_position);
+            opaqueMeshData.push_back({ meshCounter, translation_localToCamera.z });
+        }
 
-            if (meshRenderData.constantData_effect->GetRenderState().IsAlphaTransparencyEnabled())
+        ++meshCounter;
+    }
+
+    // Sort the opaque meshes by effect and then from near-to-far in camera space
+    // (so that the effect still only has to be bound once for every mesh that uses it,
+    // and so that the depth test rejects the hidden fragments of farther meshes before they are shaded)
+    std::sort(opaqueMeshData.begin(), opaqueMeshData.end(), [&meshRenderDataList](const sMeshIndexTransformPair& a, const sMeshIndexTransformPair& b)
+    {
+        const cEffect* const effect_a = meshRenderDataList[a.indexIntoMeshRenderDataList].constantData_effect;
+        const cEffect* const effect_b = meshRenderDataList[b.indexIntoMeshRenderDataList].constantData_effect;
+        if (effect_a != effect_b)
+        {
+            return std::less<const cEffect*>()(effect_a, effect_b);
+        }
+        // The camera looks down the negative Z axis, and so nearer meshes have bigger Z values
+        return a.cameraSpaceZ > b.cameraSpaceZ;
+    });
+
+#ifdef EAE6320_GRAPHICS_ISDEPTHPREPASSENABLED
+    // Draw the depth of every opaque mesh first
+    // (so that when the meshes are drawn with their own effects
+    // only the fragments that are actually visible are shaded)
+    {
+        auto* const effect_depthPrepass = cEffect::s_manager.Get(s_effect_depthPrepass);
+        EAE6320_ASSERT(effect_depthPrepass);
+        effect_depthPrepass->Bind();
+        for (const auto& meshIndexTransformPair : opaqueMeshData)
+        {
+            const auto& meshRenderData = meshRenderDataList[meshIndexTransformPair.indexIntoMeshRenderDataList];
+            auto& constantData_perDrawCall = s_dataBeingRenderedByRenderThread->constantData_perDrawCall;
+            const Math::cMatrix_transformation transform_localToWorld(meshRenderData.constantData_orientation, meshRenderData.constantData_position);
             {
-                const Math::sVector translation_localToCamera = s_dataBeingRenderedByRenderThread->constantData_perFrame.g_transform_worldToCamera * transform_localToWorld.GetTranslation();
-                transparentMeshData.push_back({ meshCounter, translation_localToCamera.z });
+                constantData_perDrawCall.g_transform_localToWorld = transform_localToWorld;
+                SetPositionDequantization(*meshRenderData.constantData_mesh, constantData_perDrawCall);
             }
-            else
+
+            DrawMesh(meshRenderData, transform_localToWorld, constantData_perDrawCall);
+        }
+        cGeometryPool::SubmitBatch();
+    }
+#endif
+
+    // Everything that is shaded in the 3D scene is counted
+    // (the depth prepass isn't, because it doesn't shade anything)
+    s_overdrawCounter.BeginFrame();
+
+    // Draw the opaque meshes
+    {
+        // Objects that use the same shaders and render state share an effect,
+        // and so it only has to be bound again when it changes
+        const cEffect* effect_bound = nullptr;
+        // Textures that share an array only differ by the layer in the per-draw-call data,
+        // and so the texture only has to be bound again when the array changes
+        // (and consecutive meshes that don't need either to be bound again are drawn as a single batch if mesh draws are batched)
+        const cTexture* texture_bound = nullptr;
+        for (const auto& meshIndexTransformPair : opaqueMeshData)
+        {
+            const auto& meshRenderData = meshRenderDataList[meshIndexTransformPair.indexIntoMeshRenderDataList];
+            auto& constantData_perDrawCall = s_dataBeingRenderedByRenderThread->constantData_perDrawCall;
+            const Math::cMatrix_transformation transform_localToWorld(meshRenderData.constantData_orientation, meshRenderData.constantData_position);
             {
-                auto& constantData_perDrawCall = s_dataBeingRenderedByRenderThread->constantData_perDrawCall;
-                {
-                    constantData_perDrawCall.g_transform_localToWorld = transform_localToWorld;
-                }
-                s_constantBuffer_perDrawCall.Update(&constantData_perDrawCall);
+                constantData_perDrawCall.g_transform_localToWorld = transform_localToWorld;
+                SetPositionDequantization(*meshRenderData.constantData_mesh, constantData_perDrawCall);
+                SetTextureArrayLayer(*meshRenderData.constantData_texture, constantData_perDrawCall);
+            }
 
+            if (meshRenderData.constantData_effect != effect_bound)
+            {
+                cGeometryPool::SubmitBatch();
                 meshRenderData.constantData_effect->Bind();
-                {
-                    constexpr unsigned int id = 0;
-                    meshRenderData.constantData_texture->Bind(id);
-                }
-                meshRenderData.constantData_mesh->Draw();
+                effect_bound = meshRenderData.constantData_effect;
+            }
+            ++s_textureBindStatistics.drawCount;
+            if (!texture_bound || !meshRenderData.constantData_texture->IsInSameArrayAs(*texture_bound))
+            {
+                cGeometryPool::SubmitBatch();
+                constexpr unsigned int id = 0;
+                meshRenderData.constantData_texture->Bind(id);
+                texture_bound = meshRenderData.constantData_texture;
+                ++s_textureBindStatistics.bindCount;
             }
+            DrawMesh(meshRenderData, transform_localToWorld, constantData_perDrawCall);
+            RequestTextureResolution(meshRenderData, transform_localToWorld);
+        }
+        cGeometryPool::SubmitBatch();
+    }
 
-            ++meshCounter;
+    // Draw the sky box
+    // (its effect puts it at the far plane, and so only the pixels that no opaque mesh covers are shaded)
+    {
+        const auto& skyBoxRenderData = s_dataBeingRenderedByRenderThread->skyBoxRenderData;
+        if (skyBoxRenderData.constantData_mesh)
+        {
+            auto& constantData_perDrawCall = s_dataBeingRenderedByRenderThread->constantData_perDrawCall;
+            const Math::cMatrix_transformation transform_localToWorld(skyBoxRenderData.constantData_orientation, skyBoxRenderData.constantData_position);
+            {
+                constantData_perDrawCall.g_transform_localToWorld = transform_localToWorld;
+                SetPositionDequantization(*skyBoxRenderData.constantData_mesh, constantData_perDrawCall);
+                SetTextureArrayLayer(*skyBoxRenderData.constantData_texture, constantData_perDrawCall);
+            }
+
+            skyBoxRenderData.constantData_effect->Bind();
+            {
+                constexpr unsigned int id = 0;
+                skyBoxRenderData.constantData_texture->Bind(id);
+            }
+            DrawMesh(skyBoxRenderData, transform_localToWorld, constantData_perDrawCall);
+            cGeometryPool::SubmitBatch();
+            RequestTextureResolution(skyBoxRenderData, transform_localToWorld);
         }
     }
 
@@ -274,35 +441,58 @@ void eae6320::Graphics::RenderFrame()
 
         for (const auto& meshIndexTransformPair : transparentMeshData)
         {
-            const auto& meshRenderData = s_dataBeingRenderedByRenderThread->meshRenderDataList[meshIndexTransformPair.indexIntoMeshRenderDataList];
+            const auto& meshRenderData = meshRenderDataList[meshIndexTransformPair.indexIntoMeshRenderDataList];
             auto& constantData_perDrawCall = s_dataBeingRenderedByRenderThread->constantData_perDrawCall;
+            const Math::cMatrix_transformation transform_localToWorld(meshRenderData.constantData_orientation, meshRenderData.constantData_position);
             {
-                constantData_perDrawCall.g_transform_localToWorld = Math::cMatrix_transformation(meshRenderData.constantData_orientation, meshRenderData.constantData_position);
+                constantData_perDrawCall.g_transform_localToWorld = transform_localToWorld;
+                SetPositionDequantization(*meshRenderData.constantData_mesh, constantData_perDrawCall);
+                SetTextureArrayLayer(*meshRenderData.constantData_texture, constantData_perDrawCall);
             }
-            s_constantBuffer_perDrawCall.Update(&constantData_perDrawCall);
 
+            // Every transparent mesh binds its effect and texture,
+            // and so each one is its own batch
             meshRenderData.constantData_effect->Bind();
             {
                 constexpr unsigned int id = 0;
                 meshRenderData.constantData_texture->Bind(id);
             }
-            meshRenderData.constantData_mesh->Draw();
+            DrawMesh(meshRenderData, transform_localToWorld, constantData_perDrawCall);
+            cGeometryPool::SubmitBatch();
+            RequestTextureResolution(meshRenderData, transform_localToWorld);
         }
     }
 
+    s_overdrawCounter.EndFrame(static_cast<uint32_t>(s_resolutionWidth) * static_cast<uint32_t>(s_resolutionHeight));
+
     // Draw the sprites
     {
         for (const auto& spriteRenderData : s_dataBeingRenderedByRenderThread->spriteRenderDataList)
         {
+            // Sprites don't use the transform,
+            // but they do sample their texture's layer
+            // (and so that is the only part of the constant buffer that has to be compared and uploaded)
+            auto& constantData_perDrawCall = s_dataBeingRenderedByRenderThread->constantData_perDrawCall;
+            SetTextureArrayLayer(*spriteRenderData.constantData_texture, constantData_perDrawCall);
+            s_constantBuffer_perDrawCall.Update(&constantData_perDrawCall,
+                offsetof(ConstantBufferFormats::sPerDrawCall, g_textureArrayLayer), sizeof(constantData_perDrawCall.g_textureArrayLayer));
+
             spriteRenderData.constantData_effect->Bind();
             {
                 constexpr unsigned int id = 0;
                 spriteRenderData.constantData_texture->Bind(id);
             }
             spriteRenderData.constantData_sprite->Draw();
+            // Sprites are drawn in screen space and can be as big as the screen
+            TextureStreaming::RequestScreenSize(*spriteRenderData.constantData_texture, static_cast<float>(std::max(s_resolutionWidth, s_resolutionHeight)));
         }
     }
 
+    // Now that every texture has been asked for the MIP level that it needs
+    // the levels that have finished loading can be uploaded and new ones can be requested
+    // (this must happen before the render data is cleared because that releases the textures)
+    TextureStreaming::Update();
+
     // Everything has been drawn to the "back buffer", which is just an image in memory.
     // In order to display it the contents of the back buffer must be "presented"
     // (or "swapped" with the "front buffer")
@@ -322,6 +512,8 @@ void eae6320::Graphics::RenderFrame()
         }
         s_dataBeingRenderedByRenderThread->meshRenderDataList.clear();
 
+        ReleaseSkyBox(s_dataBeingRenderedByRenderThread->skyBoxRenderData);
+
         for (auto& spriteRenderData : s_dataBeingRenderedByRenderThread->spriteRenderDataList)
         {
             spriteRenderData.constantData_texture->DecrementReferenceCount();
@@ -346,6 +538,9 @@ eae6320::cResult eae6320::Graphics::Initialize(const sInitializationParameters&
         goto OnExit;
     }
 
+    s_resolutionWidth = i_initializationParameters.resolutionWidth;
+    s_resolutionHeight = i_initializationParameters.resolutionHeight;
+
     // Initialize the asset managers
     {
         if (!(result = cShader::s_manager.Initialize()))
@@ -353,6 +548,11 @@ eae6320::cResult eae6320::Graphics::Initialize(const sInitializationParameters&
             EAE6320_ASSERT(false);
             goto OnExit;
         }
+        if (!(result = cEffect::s_manager.Initialize()))
+        {
+            EAE6320_ASSERT(false);
+            goto OnExit;
+        }
     }
 
     // Initialize the platform-independent graphics objects
@@ -398,6 +598,29 @@ eae6320::cResult eae6320::Graphics::Initialize(const sInitializationParameters&
             EAE6320_ASSERT(false);
             goto OnExit;
         }
+
+        if (!(result = s_overdrawCounter.Initialize()))
+        {
+            EAE6320_ASSERT(false);
+            goto OnExit;
+        }
+
+#ifdef EAE6320_GRAPHICS_ISDEPTHPREPASSENABLED
+        if (!(result = cEffect::Load(s_effect_depthPrepass, s_vertexShaderPath_depthPrepass, s_fragmentShaderPath_depthPrepass,
+            RenderStates::DepthBuffering | RenderStates::DepthOnly)))
+        {
+            EAE6320_ASSERT(false);
+            goto OnExit;
+        }
+#endif
+    }
+    // Initialize texture streaming
+    {
+        if (!(result = TextureStreaming::Initialize()))
+        {
+            EAE6320_ASSERT(false);
+            goto OnExit;
+        }
     }
     // Initialize the events
     {
@@ -454,6 +677,8 @@ eae6320::cResult eae6320::Graphics::CleanUp()
         s_dataBeingSubmittedByApplicationThread->meshRenderDataList.clear();
     }
 
+    ReleaseSkyBox(s_dataBeingSubmittedByApplicationThread->skyBoxRenderData);
+
     if (!s_dataBeingSubmittedByApplicationThread->spriteRenderDataList.empty())
     {
         for (auto& spriteRenderData : s_dataBeingSubmittedByApplicationThread->spriteRenderDataList)
@@ -476,6 +701,8 @@ eae6320::cResult eae6320::Graphics::CleanUp()
         s_dataBeingRenderedByRenderThread->meshRenderDataList.clear();
     }
 
+    ReleaseSkyBox(s_dataBeingRenderedByRenderThread->skyBoxRenderData);
+
     if (!s_dataBeingRenderedByRenderThread->spriteRenderDataList.empty())
     {
         for (auto& spriteRenderData : s_dataBeingRenderedByRenderThread->spriteRenderDataList)
@@ -487,6 +714,10 @@ eae6320::cResult eae6320::Graphics::CleanUp()
         s_dataBeingRenderedByRenderThread->spriteRenderDataList.clear();
     }
 
+    // Report how much uploading the constant buffers' shadow copies saved
+    s_constantBuffer_perFrame.OutputStatisticsToLog();
+    s_constantBuffer_perDrawCall.OutputStatisticsToLog();
+
     {
         const auto localResult = s_constantBuffer_perFrame.CleanUp();
         if (!localResult)
@@ -511,6 +742,43 @@ eae6320::cResult eae6320::Graphics::CleanUp()
         }
     }
 
+    // Report how many times each pixel was shaded
+    s_overdrawCounter.OutputStatisticsToLog();
+    // Report how many texture binds sharing texture arrays saved
+    if (s_textureBindStatistics.drawCount > 0)
+    {
+        Logging::OutputMessage("%llu of %llu opaque mesh draw calls bound a texture (%.1f%%); the others used an array that was already bound",
+            s_textureBindStatistics.bindCount, s_textureBindStatistics.drawCount,
+            100.0 * static_cast<double>(s_textureBindStatistics.bindCount) / static_cast<double>(s_textureBindStatistics.drawCount));
+    }
+
+    {
+        const auto localResult = s_overdrawCounter.CleanUp();
+        if (!localResult)
+        {
+            EAE6320_ASSERT(false);
+            if (result)
+            {
+                result = localResult;
+            }
+        }
+    }
+
+#ifdef EAE6320_GRAPHICS_ISDEPTHPREPASSENABLED
+    if (s_effect_depthPrepass)
+    {
+        const auto localResult = cEffect::s_manager.Release(s_effect_depthPrepass);
+        if (!localResult)
+        {
+            EAE6320_ASSERT(false);
+            if (result)
+            {
+                result = localResult;
+            }
+        }
+    }
+#endif
+
     {
         const auto localResult = s_samplerState.CleanUp();
         if (!localResult)
@@ -523,6 +791,34 @@ eae6320::cResult eae6320::Graphics::CleanUp()
         }
     }
 
+    // Textures that are still being streamed are released
+    // (the graphics context must still exist in case this destroys them)
+    {
+        const auto localResult = TextureStreaming::CleanUp();
+        if (!localResult)
+        {
+            EAE6320_ASSERT(false);
+            if (result)
+            {
+                result = localResult;
+            }
+        }
+    }
+
+    // Effects release their shaders,
+    // and so they must be cleaned up first
+    {
+        const auto localResult = cEffect::s_manager.CleanUp();
+        if (!localResult)
+        {
+            EAE6320_ASSERT(false);
+            if (result)
+            {
+                result = localResult;
+            }
+        }
+    }
+
     {
         const auto localResult = cShader::s_manager.CleanUp();
         if (!localResult)
@@ -535,6 +831,19 @@ eae6320::cResult eae6320::Graphics::CleanUp()
         }
     }
 
+    // Every mesh has been released by now
+    {
+        const auto localResult = cGeometryPool::CleanUpAll();
+        if (!localResult)
+        {
+            EAE6320_ASSERT(false);
+            if (result)
+            {
+                result = localResult;
+            }
+        }
+    }
+
     {
         const auto localResult = sContext::g_context.CleanUp();
         if (!localResult)
@@ -549,3 +858,75 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 
     return result;
 }
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+    void SetPositionDequantization(const eae6320::Graphics::cMesh& i_mesh, eae6320::Graphics::ConstantBufferFormats::sPerDrawCall& io_constantData_perDrawCall)
+    {
+        const auto& positionDequantization = i_mesh.GetPositionDequantization();
+        for (size_t i = 0; i < 3; ++i)
+        {
+            io_constantData_perDrawCall.g_positionDequantization_offset[i] = positionDequantization.offset[i];
+            io_constantData_perDrawCall.g_positionDequantization_scale[i] = positionDequantization.scale[i];
+        }
+    }
+
+    void SetTextureArrayLayer(const eae6320::Graphics::cTexture& i_texture, eae6320::Graphics::ConstantBufferFormats::sPerDrawCall& io_constantData_perDrawCall)
+    {
+        io_constantData_perDrawCall.g_textureArrayLayer[0] = static_cast<float>(i_texture.GetArrayLayer());
+    }
+
+    void ReleaseSkyBox(sDataRequiredToRenderAMesh& io_skyBoxRenderData)
+    {
+        if (io_skyBoxRenderData.constantData_mesh)
+        {
+            io_skyBoxRenderData.constantData_texture->DecrementReferenceCount();
+            io_skyBoxRenderData.constantData_effect->DecrementReferenceCount();
+            io_skyBoxRenderData.constantData_mesh->DecrementReferenceCount();
+        }
+        io_skyBoxRenderData = sDataRequiredToRenderAMesh();
+    }
+
+    void DrawMesh(const sDataRequiredToRenderAMesh& i_meshRenderData, const eae6320::Math::cMatrix_transformation& i_transform_localToWorld,
+        const eae6320::Graphics::ConstantBufferFormats::sPerDrawCall& i_constantData_perDrawCall)
+    {
+#ifndef EAE6320_GRAPHICS_AREMESHDRAWSBATCHED
+        s_constantBuffer_perDrawCall.Update(&i_constantData_perDrawCall);
+#endif
+
+        const auto& constantData_perFrame = s_dataBeingRenderedByRenderThread->constantData_perFrame;
+        const auto transform_localToProjected = constantData_perFrame.g_transform_cameraToProjected
+            * eae6320::Math::cMatrix_transformation::ConcatenateAffine(constantData_perFrame.g_transform_worldToCamera, i_transform_localToWorld);
+        // A mesh's local-to-world transform is only a rotation and a translation,
+        // and so its inverse can be calculated from the inverse rotation
+        const auto cameraPosition_local = eae6320::Math::cMatrix_transformation(i_meshRenderData.constantData_orientation.GetInverse(), eae6320::Math::sVector::ZERO)
+            * (s_dataBeingRenderedByRenderThread->cameraPosition - i_meshRenderData.constantData_position);
+        // Clusters that face away from the camera can only be culled if the GPU would cull their triangles
+        const auto shouldCullBackFacingClusters = !i_meshRenderData.constantData_effect->GetRenderState().ShouldBothTriangleSidesBeDrawn();
+
+        i_meshRenderData.constantData_mesh->Draw(transform_localToProjected, cameraPosition_local, shouldCullBackFacingClusters, i_constantData_perDrawCall);
+    }
+
+    void RequestTextureResolution(const sDataRequiredToRenderAMesh& i_meshRenderData, const eae6320::Math::cMatrix_transformation& i_transform_localToWorld)
+    {
+        const auto& mesh = *i_meshRenderData.constantData_mesh;
+        const auto radius = mesh.GetBoundingSphereRadius();
+        // If the mesh's size isn't known (or the camera is inside of it) the texture could cover the whole screen
+        auto screenSize_inPixels = static_cast<float>(std::max(s_resolutionWidth, s_resolutionHeight));
+        if (radius > 0.0f)
+        {
+            const auto* const center_local = mesh.GetBoundingSphereCenter();
+            const auto center_world = i_transform_localToWorld * eae6320::Math::sVector(center_local[0], center_local[1], center_local[2]);
+            const auto distance = (center_world - s_dataBeingRenderedByRenderThread->cameraPosition).GetLength();
+            if (distance > radius)
+            {
+                // The texture is assumed to be stretched once across the mesh
+                screenSize_inPixels = std::min(screenSize_inPixels, (2.0f * radius * s_dataBeingRenderedByRenderThread->screenSizeScale) / distance);
+            }
+        }
+        eae6320::Graphics::TextureStreaming::RequestScreenSize(*i_meshRenderData.constantData_texture, screenSize_inPixels);
+    }
+}
@@ -60,6 +60,10 @@ namespace eae6320
         void SubmitDepthToClear( const float i_depth = 1.0f );
         void SubmitCamera(const sCamera& i_camera, const Math::sVector& i_position, const Math::cQuaternion& i_orientation);
         void SubmitMeshToBeRendered(cMesh* i_meshToDraw, cEffect* i_effectToBind, cTexture* i_textureToBind, const Math::sVector& i_position, const Math::cQuaternion& i_orientation);
+        // The sky box is drawn after every opaque mesh,
+        // and so its effect must put it at the far plane (and test depth) so that it is only drawn where nothing else was
+        // (only one sky box can be submitted per frame)
+        void SubmitSkyBoxToBeRendered(cMesh* i_meshToDraw, cEffect* i_effectToBind, cTexture* i_textureToBind, const Math::sVector& i_position);
         void SubmitSpriteToBeRendered(cSprite* i_spriteToDraw, cEffect* i_effectToBind, cTexture* i_textureToBind);
 
         // When the application is ready to submit data for a new frame
@@ -86,9 +90,10 @@ namespace eae6320
         {
 #if defined( EAE6320_PLATFORM_WINDOWS )
             HWND mainWindow = NULL;
-    #if defined( EAE6320_PLATFORM_D3D )
+            // The resolution is also used to estimate how big things are on the screen
+            // (e.g. to decide which MIP levels of textures are needed)
             uint16_t resolutionWidth, resolutionHeight;
-    #elif defined( EAE6320_PLATFORM_GL )
+    #if defined( EAE6320_PLATFORM_GL )
             HINSTANCE thisInstanceOfTheApplication = NULL;
     #endif
 #endif
@@ -0,0 +1,175 @@
+/*
+    A mesh format determines the layout of a built mesh file
+    that is loaded and used at run-time
+*/
+
+#ifndef EAE6320_GRAPHICS_MESHFORMATS_H
+#define EAE6320_GRAPHICS_MESHFORMATS_H
+
+// Include Files
+//==============
+
+#include "Configuration.h"
+#include "VertexFormats.h"
+
+#include <cstdint>
+
+// Mesh Formats
+//=============
+
+namespace eae6320
+{
+    namespace Graphics
+    {
+        namespace MeshFormats
+        {
+            // Most meshes have few enough vertices that 16-bit indices can be used,
+            // but high-density meshes need 32-bit indices
+            namespace IndexFormats
+            {
+                enum eType : uint8_t
+                {
+                    Index16,
+                    Index32,
+
+                    Unknown
+                };
+
+                // Returns the size in bytes of a single index
+                inline constexpr unsigned int GetSizeOfIndex(const eType i_format)
+                {
+                    return (i_format == Index16) ? sizeof(uint16_t) : ((i_format == Index32) ? sizeof(uint32_t) : 0);
+                }
+
+                // 16-bit indices are used whenever every vertex can be addressed with them
+                inline constexpr eType GetSmallestFormat(const uint32_t i_vertexCount)
+                {
+                    return (i_vertexCount <= (uint32_t(1u) << 16)) ? Index16 : Index32;
+                }
+            }
+
+            // A mesh's vertices can either be stored with full-precision floats (VertexFormats::sMesh)
+            // or quantized (VertexFormats::sMeshQuantized),
+            // which uses two thirds of the memory and bandwidth
+            namespace VertexEncodings
+            {
+                enum eType : uint8_t
+                {
+                    Float,
+                    Quantized,
+
+                    Unknown
+                };
+
+                // Returns the size in bytes of a single vertex
+                inline constexpr unsigned int GetSizeOfVertex(const eType i_encoding)
+                {
+                    return (i_encoding == Float) ? sizeof(VertexFormats::sMesh)
+                        : ((i_encoding == Quantized) ? sizeof(VertexFormats::sMeshQuantized) : 0);
+                }
+            }
+
+            // A vertex shader calculates a local position as (position * scale) + offset;
+            // for quantized vertices these map [0,1] to the mesh's bounding box,
+            // and for float vertices the scale is one and the offset is zero
+            struct sPositionDequantization
+            {
+                float offset[3];
+                float scale[3];
+            };
+
+            // A mesh's triangles are split into small clusters
+            // so that the parts of the mesh that can't be seen don't have to be drawn.
+            // Each cluster's triangles are contiguous in the index buffer,
+            // and its bounds are in the mesh's local space
+            struct sCluster
+            {
+                uint32_t indexOffset;
+                uint32_t indexCount;
+
+                // Every triangle in the cluster is inside this sphere
+                float boundingSphere_center[3];
+                float boundingSphere_radius;
+
+                // Every triangle's normal is within a cone around this axis,
+                // and so every triangle in the cluster faces away from a camera when
+                //  dot(center - cameraPosition, axis) > (cutoff * length(center - cameraPosition)) + radius
+                // (the cutoff is 1 if the triangles face too many directions for the cluster to ever be culled this way)
+                float normalCone_axis[3];
+                float normalCone_cutoff;
+            };
+
+            // This struct describes the mesh;
+            // it is stored in the Info section of a mesh file
+            struct sMeshInfo
+            {
+                uint32_t vertexCount;
+                uint32_t indexCount;
+                uint32_t clusterCount;
+                IndexFormats::eType indexFormat;
+                VertexEncodings::eType vertexEncoding;
+                uint8_t padding[2];
+                sPositionDequantization positionDequantization;
+            };
+
+            // Container
+            //----------
+
+            // A built mesh file is laid out as:
+            //  * An sFileHeader
+            //  * An sSectionInfo for each section
+            //  * The payload of each section,
+            //      each of which starts at a multiple of PayloadAlignment bytes from the start of the file
+            //      (and so the payloads can be given to the GPU as-is)
+            // A file must have an Info, Vertices, and Indices section and may have a Clusters section;
+            // sections of unknown types are ignored so that new kinds of data (e.g. LODs or submeshes)
+            // can be added without breaking older code
+            namespace Container
+            {
+                // The magic number is the characters "EMSH" when the file is viewed in a hex editor
+                constexpr uint32_t FileMagic = 'E' | ('M' << 8) | ('S' << 16) | ('H' << 24);
+                // The version must be incremented whenever the meaning of an existing section changes
+                constexpr uint16_t FileVersion = 1;
+                constexpr uint32_t PayloadAlignment = 16;
+
+                namespace SectionTypes
+                {
+                    enum eType : uint32_t
+                    {
+                        // An sMeshInfo
+                        Info,
+                        // sMesh or sMeshQuantized (depending on sMeshInfo::vertexEncoding)
+                        Vertices,
+                        // 16-bit or 32-bit indices (depending on sMeshInfo::indexFormat)
+                        Indices,
+                        // sCluster
+                        Clusters,
+                    };
+                }
+
+                struct sFileHeader
+                {
+                    uint32_t magic;
+                    uint16_t version;
+                    uint16_t sectionCount;
+                };
+
+                struct sSectionInfo
+                {
+                    SectionTypes::eType type;
+                    // The offset is from the start of the file
+                    uint32_t offset;
+                    uint32_t size;
+                    uint32_t padding;
+                };
+
+                inline constexpr uint32_t AlignOffset(const uint32_t i_offset)
+                {
+                    return ((i_offset + (PayloadAlignment - 1)) / PayloadAlignment) * PayloadAlignment;
+                }
+            }
+        }
+    }
+}
+
+#endif	// EAE6320_GRAPHICS_MESHFORMATS_H
@@ -0,0 +1,214 @@
+// Include Files
+//==============
+
+#include "ProgramBinaryCache.h"
+
+#include "../cShader.h"
+
+#include <cstring>
+#include <Engine/Assets/LoadStatistics.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Platform/Platform.h>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+	// A cached program's file is this header followed by the binary
+	struct sFileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		// The key is stored in the file (as well as in its name)
+		// so that a file that was renamed or copied by hand is never used for the wrong program
+		uint64_t key;
+		uint32_t binaryFormat;
+		uint32_t binarySize;
+	};
+	constexpr uint32_t s_fileMagic = 0x50474c45;	// "ELGP" in a hex editor
+	constexpr uint32_t s_fileVersion = 1;
+
+	struct sDriverDescription
+	{
+		// A hash of the strings that identify the driver
+		uint64_t hash = eae6320::Graphics::ProgramBinaryCache::InitialHash;
+		bool areBinariesSupported = false;
+	};
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// The driver is the same for every program,
+	// and so it is only asked about the first time that this is called
+	const sDriverDescription& GetDriverDescription();
+	std::string GetPath( const uint64_t i_key );
+}
+
+// Interface
+//==========
+
+uint64_t eae6320::Graphics::ProgramBinaryCache::CalculateHash( const void* const i_data, const size_t i_size, const uint64_t i_previousHash )
+{
+	const auto* const bytes = static_cast<const uint8_t*>( i_data );
+	auto hash = i_previousHash;
+	for ( size_t i = 0; i < i_size; ++i )
+	{
+		hash = ( hash ^ bytes[i] ) * 1099511628211ull;
+	}
+	return hash;
+}
+
+uint64_t eae6320::Graphics::ProgramBinaryCache::CalculateKey( const cShader& i_vertexShader, const cShader& i_fragmentShader )
+{
+	auto key = GetDriverDescription().hash;
+	key = CalculateHash( &i_vertexShader.m_sourceHash, sizeof( i_vertexShader.m_sourceHash ), key );
+	key = CalculateHash( &i_fragmentShader.m_sourceHash, sizeof( i_fragmentShader.m_sourceHash ), key );
+	return key;
+}
+
+bool eae6320::Graphics::ProgramBinaryCache::Load( const uint64_t i_key, const GLuint i_programId )
+{
+	if ( !GetDriverDescription().areBinariesSupported )
+	{
+		return false;
+	}
+
+	// A missing file just means that the program hasn't been cached yet
+	Platform::sDataFromFile dataFromFile;
+	{
+		Assets::cLoadPhaseTimer ioTimer( Assets::LoadPhases::IO );
+		if ( !Platform::LoadBinaryFile( GetPath( i_key ).c_str(), dataFromFile ) )
+		{
+			return false;
+		}
+	}
+	auto wasProgramLoaded = false;
+	if ( dataFromFile.size >= sizeof( sFileHeader ) )
+	{
+		sFileHeader fileHeader;
+		memcpy( &fileHeader, dataFromFile.data, sizeof( fileHeader ) );
+		if ( ( fileHeader.magic == s_fileMagic ) && ( fileHeader.version == s_fileVersion ) && ( fileHeader.key == i_key )
+			&& ( fileHeader.binarySize == ( dataFromFile.size - sizeof( fileHeader ) ) ) )
+		{
+			Assets::cLoadPhaseTimer uploadTimer( Assets::LoadPhases::Upload );
+			glProgramBinary( i_programId, static_cast<GLenum>( fileHeader.binaryFormat ),
+				static_cast<const uint8_t*>( dataFromFile.data ) + sizeof( fileHeader ), static_cast<GLsizei>( fileHeader.binarySize ) );
+			// An error means that the driver doesn't support the binary's format anymore
+			if ( glGetError() == GL_NO_ERROR )
+			{
+				// The driver can also reject a binary that it doesn't like
+				// by failing to link the program
+				GLint didLinkingSucceed = GL_FALSE;
+				glGetProgramiv( i_programId, GL_LINK_STATUS, &didLinkingSucceed );
+				wasProgramLoaded = ( glGetError() == GL_NO_ERROR ) && ( didLinkingSucceed != GL_FALSE );
+			}
+		}
+	}
+	dataFromFile.Free();
+
+	if ( !wasProgramLoaded )
+	{
+		Logging::OutputMessage( "The cached binary of the program %s couldn't be used and will be replaced", GetPath( i_key ).c_str() );
+	}
+	return wasProgramLoaded;
+}
+
+void eae6320::Graphics::ProgramBinaryCache::Save( const uint64_t i_key, const GLuint i_programId )
+{
+	if ( !GetDriverDescription().areBinariesSupported )
+	{
+		return;
+	}
+
+	std::vector<uint8_t> fileData;
+	{
+		GLint binarySize = 0;
+		glGetProgramiv( i_programId, GL_PROGRAM_BINARY_LENGTH, &binarySize );
+		if ( ( glGetError() != GL_NO_ERROR ) || ( binarySize <= 0 ) )
+		{
+			return;
+		}
+		fileData.resize( sizeof( sFileHeader ) + static_cast<size_t>( binarySize ) );
+
+		GLsizei binarySize_written = 0;
+		GLenum binaryFormat = GL_NONE;
+		glGetProgramBinary( i_programId, binarySize, &binarySize_written, &binaryFormat, fileData.data() + sizeof( sFileHeader ) );
+		if ( ( glGetError() != GL_NO_ERROR ) || ( binarySize_written <= 0 ) )
+		{
+			return;
+		}
+		fileData.resize( sizeof( sFileHeader ) + static_cast<size_t>( binarySize_written ) );
+
+		sFileHeader fileHeader;
+		{
+			fileHeader.magic = s_fileMagic;
+			fileHeader.version = s_fileVersion;
+			fileHeader.key = i_key;
+			fileHeader.binaryFormat = static_cast<uint32_t>( binaryFormat );
+			fileHeader.binarySize = static_cast<uint32_t>( binarySize_written );
+		}
+		memcpy( fileData.data(), &fileHeader, sizeof( fileHeader ) );
+	}
+
+	const auto path = GetPath( i_key );
+	std::string errorMessage;
+	if ( !Platform::CreateDirectoryIfItDoesntExist( path, &errorMessage )
+		|| !Platform::WriteBinaryFile( path.c_str(), fileData.data(), fileData.size(), &errorMessage ) )
+	{
+		Logging::OutputMessage( "The program binary %s couldn't be saved (the program will be linked again next time): %s",
+			path.c_str(), errorMessage.c_str() );
+	}
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	const sDriverDescription& GetDriverDescription()
+	{
+		static sDriverDescription s_driverDescription;
+		static auto s_hasDriverBeenDescribed = false;
+		if ( !s_hasDriverBeenDescribed )
+		{
+			s_hasDriverBeenDescribed = true;
+
+			GLint binaryFormatCount = 0;
+			glGetIntegerv( GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount );
+			s_driverDescription.areBinariesSupported = ( glGetError() == GL_NO_ERROR ) && ( binaryFormatCount > 0 );
+			if ( !s_driverDescription.areBinariesSupported )
+			{
+				eae6320::Logging::OutputMessage( "The OpenGL driver doesn't support program binaries, and so programs won't be cached" );
+			}
+
+			constexpr GLenum descriptionNames[] = { GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION };
+			for ( const auto descriptionName : descriptionNames )
+			{
+				const auto* const description = reinterpret_cast<const char*>( glGetString( descriptionName ) );
+				if ( ( glGetError() == GL_NO_ERROR ) && description )
+				{
+					// The NULL terminator is included so that the strings can't run together
+					s_driverDescription.hash = eae6320::Graphics::ProgramBinaryCache::CalculateHash(
+						description, strlen( description ) + 1, s_driverDescription.hash );
+				}
+			}
+		}
+		return s_driverDescription;
+	}
+
+	std::string GetPath( const uint64_t i_key )
+	{
+		std::ostringstream path;
+		path << eae6320::Graphics::ProgramBinaryCache::DirectoryPath
+			<< std::hex << std::setw( 16 ) << std::setfill( '0' ) << i_key << ".glprogram";
+		return path.str();
+	}
+}
@@ -0,0 +1,68 @@
+/*
+	The program binary cache saves linked OpenGL programs to disk
+	so that later runs don't have to compile their shaders and link them again:
+		* A program's key is a hash of its shaders' source code
+			and of the driver's vendor, renderer, and version
+			(render state isn't part of a program, and so effects that only differ by render state share a cached binary)
+		* A binary that the driver rejects (e.g. because it was updated without its version string changing)
+			is treated like a missing one: the program is compiled and linked, and the binary is replaced
+		* Nothing is cached if the driver doesn't support any program binary formats
+
+	Only OpenGL functions are used (nothing window-system-specific),
+	and so the cache can be exercised with any OpenGL 4.1 implementation
+*/
+
+#ifndef EAE6320_GRAPHICS_OPENGL_PROGRAMBINARYCACHE_H
+#define EAE6320_GRAPHICS_OPENGL_PROGRAMBINARYCACHE_H
+
+// Include Files
+//==============
+
+#include "Includes.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cShader;
+	}
+}
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace ProgramBinaryCache
+		{
+			// The binaries are saved in this directory (relative to the game's directory)
+			constexpr auto* const DirectoryPath = "ProgramBinaries/";
+
+			// FNV-1a
+			// (a previous hash can be passed in to continue hashing more data)
+			constexpr uint64_t InitialHash = 14695981039346656037ull;
+			uint64_t CalculateHash( const void* const i_data, const size_t i_size, const uint64_t i_previousHash = InitialHash );
+
+			// An OpenGL context must be current
+			// (the first call gets the driver's description)
+			uint64_t CalculateKey( const cShader& i_vertexShader, const cShader& i_fragmentShader );
+
+			// If this succeeds the program is linked and ready to use;
+			// if it fails the program can still have shaders attached and be linked normally
+			bool Load( const uint64_t i_key, const GLuint i_programId );
+			// The program must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+			// Failing to save isn't an error (the program will just be linked again the next time)
+			void Save( const uint64_t i_key, const GLuint i_programId );
+		}
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_OPENGL_PROGRAMBINARYCACHE_H
@@ -0,0 +1,397 @@
+// Include Files
+//==============
+
+#include "UploadManager.h"
+
+#include <deque>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Concurrency/cMutex.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Math/Functions.h>
+#include <External/OpenGlExtensions/OpenGlExtensions.h>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// Every allocation starts at a multiple of this
+	// (which is more than any upload requires)
+	constexpr uint64_t s_alignment = 64;
+
+	GLuint s_stagingBufferId = 0;
+	uint8_t* s_stagingData = nullptr;
+
+	// Positions increase forever and are wrapped into the staging buffer when they are used,
+	// and so the memory in [tail, head) is what is currently in use
+	uint64_t s_headPosition = 0;
+	uint64_t s_tailPosition = 0;
+
+	// Allocations that haven't been fenced yet, in the order that they were made
+	struct sOutstandingAllocation
+	{
+		uint64_t begin = 0;
+		uint64_t end = 0;
+		bool isReleased = false;
+	};
+	std::deque<sOutstandingAllocation> s_outstandingAllocations;
+	// Fences that the GPU hasn't signaled yet, in the order that they were inserted
+	struct sFence
+	{
+		GLsync fence = nullptr;
+		// All of the staging memory before this can be reused once the fence is signaled
+		uint64_t end = 0;
+	};
+	std::deque<sFence> s_fences;
+
+	// Allocations can be made from any thread
+	eae6320::Concurrency::cMutex s_mutex;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	void ReclaimSignaledFences();
+}
+
+// Interface
+//==========
+
+// Any Thread
+//-----------
+
+bool eae6320::Graphics::UploadManager::Allocate( const size_t i_size, sAllocation& o_allocation )
+{
+	o_allocation = sAllocation();
+
+	if ( ( i_size == 0 ) || ( i_size > StagingBufferSize_inBytes ) )
+	{
+		return false;
+	}
+
+	Concurrency::cMutex::cScopeLock autoLock( s_mutex );
+
+	if ( !s_stagingData )
+	{
+		return false;
+	}
+	auto begin = Math::RoundUpToMultiple_powerOf2( s_headPosition, s_alignment );
+	// An allocation can't wrap around the end of the staging buffer
+	if ( ( ( begin % StagingBufferSize_inBytes ) + i_size ) > StagingBufferSize_inBytes )
+	{
+		begin = Math::RoundUpToMultiple( begin, static_cast<uint64_t>( StagingBufferSize_inBytes ) );
+	}
+	const auto end = begin + i_size;
+	if ( ( end - s_tailPosition ) > StagingBufferSize_inBytes )
+	{
+		// The GPU is still copying from the memory that would be needed
+		return false;
+	}
+	s_headPosition = end;
+	{
+		sOutstandingAllocation outstandingAllocation;
+		outstandingAllocation.begin = begin;
+		outstandingAllocation.end = end;
+		s_outstandingAllocations.push_back( outstandingAllocation );
+	}
+
+	o_allocation.offset = static_cast<GLintptr>( begin % StagingBufferSize_inBytes );
+	o_allocation.data = s_stagingData + o_allocation.offset;
+	o_allocation.size = i_size;
+	o_allocation.position = begin;
+
+	return true;
+}
+
+// Render Thread
+//--------------
+
+eae6320::Graphics::UploadManager::cScopeBindForTextureUpload::cScopeBindForTextureUpload( const sAllocation& i_allocation )
+	:
+	m_isBound( i_allocation.IsValid() )
+{
+	if ( m_isBound )
+	{
+		EAE6320_ASSERT( s_stagingBufferId != 0 );
+		glBindBuffer( GL_PIXEL_UNPACK_BUFFER, s_stagingBufferId );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	}
+}
+
+eae6320::Graphics::UploadManager::cScopeBindForTextureUpload::~cScopeBindForTextureUpload()
+{
+	if ( m_isBound )
+	{
+		// Other texture functions must get pointers to CPU memory again
+		glBindBuffer( GL_PIXEL_UNPACK_BUFFER, 0 );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	}
+}
+
+eae6320::cResult eae6320::Graphics::UploadManager::CopyToBuffer( sAllocation& io_allocation, const GLenum i_target, const GLintptr i_offset )
+{
+	auto result = Results::Success;
+
+	EAE6320_ASSERT( io_allocation.IsValid() );
+	glBindBuffer( GL_COPY_READ_BUFFER, s_stagingBufferId );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	glCopyBufferSubData( GL_COPY_READ_BUFFER, i_target, io_allocation.offset, i_offset, static_cast<GLsizeiptr>( io_allocation.size ) );
+	const auto errorCode = glGetError();
+	if ( errorCode != GL_NO_ERROR )
+	{
+		result = Results::Failure;
+		EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+		Logging::OutputError( "OpenGL failed to copy %u bytes from the staging buffer: %s",
+			io_allocation.size, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+	}
+	glBindBuffer( GL_COPY_READ_BUFFER, 0 );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+
+	Release( io_allocation );
+
+	return result;
+}
+
+void eae6320::Graphics::UploadManager::Release( sAllocation& io_allocation )
+{
+	EAE6320_ASSERT( io_allocation.IsValid() );
+	{
+		Concurrency::cMutex::cScopeLock autoLock( s_mutex );
+
+		for ( auto& outstandingAllocation : s_outstandingAllocations )
+		{
+			if ( outstandingAllocation.begin == io_allocation.position )
+			{
+				EAE6320_ASSERT( !outstandingAllocation.isReleased );
+				outstandingAllocation.isReleased = true;
+				break;
+			}
+		}
+	}
+	io_allocation = sAllocation();
+}
+
+void eae6320::Graphics::UploadManager::EndFrame()
+{
+	Concurrency::cMutex::cScopeLock autoLock( s_mutex );
+
+	// Only a contiguous run of released allocations can be fenced
+	// (an allocation that is still being written to by another thread blocks any that were made after it)
+	{
+		auto end = s_tailPosition;
+		auto areThereAllocationsToFence = false;
+		while ( !s_outstandingAllocations.empty() && s_outstandingAllocations.front().isReleased )
+		{
+			end = s_outstandingAllocations.front().end;
+			areThereAllocationsToFence = true;
+			s_outstandingAllocations.pop_front();
+		}
+		if ( areThereAllocationsToFence )
+		{
+			constexpr GLbitfield noFlags = 0;
+			sFence fence;
+			fence.fence = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, noFlags );
+			EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+			fence.end = end;
+			if ( fence.fence )
+			{
+				s_fences.push_back( fence );
+			}
+			else
+			{
+				// If the fence couldn't be created the only safe thing to do is to wait for every copy
+				glFinish();
+				s_tailPosition = end;
+			}
+		}
+	}
+	ReclaimSignaledFences();
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Graphics::UploadManager::Initialize()
+{
+	auto result = Results::Success;
+
+	if ( !glBufferStorage )
+	{
+		Logging::OutputMessage( "The OpenGL driver can't persistently map buffers, and so uploads won't be staged" );
+		goto OnExit;
+	}
+
+	// Create the staging buffer
+	{
+		constexpr GLsizei bufferCount = 1;
+		glGenBuffers( bufferCount, &s_stagingBufferId );
+		const auto errorCode = glGetError();
+		if ( errorCode == GL_NO_ERROR )
+		{
+			glBindBuffer( GL_COPY_READ_BUFFER, s_stagingBufferId );
+			const auto errorCode = glGetError();
+			if ( errorCode != GL_NO_ERROR )
+			{
+				result = Results::Failure;
+				EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+				Logging::OutputError( "OpenGL failed to bind the new staging buffer: %s",
+					reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+				goto OnExit;
+			}
+		}
+		else
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to get an unused staging buffer ID: %s",
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			goto OnExit;
+		}
+	}
+	// Allocate it and keep it mapped
+	{
+		// The CPU only writes, and coherent mapping means that anything written
+		// is visible to copies that are started afterwards without having to flush explicitly
+		constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage( GL_COPY_READ_BUFFER, static_cast<GLsizeiptr>( StagingBufferSize_inBytes ), nullptr, flags );
+		const auto errorCode = glGetError();
+		if ( errorCode == GL_NO_ERROR )
+		{
+			constexpr GLintptr mapTheWholeBuffer = 0;
+			s_stagingData = static_cast<uint8_t*>( glMapBufferRange( GL_COPY_READ_BUFFER, mapTheWholeBuffer,
+				static_cast<GLsizeiptr>( StagingBufferSize_inBytes ), flags ) );
+			const auto errorCode = glGetError();
+			if ( ( errorCode != GL_NO_ERROR ) || !s_stagingData )
+			{
+				result = Results::Failure;
+				s_stagingData = nullptr;
+				EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+				Logging::OutputError( "OpenGL failed to map the staging buffer: %s",
+					reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+				goto OnExit;
+			}
+		}
+		else
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to allocate the staging buffer (%u bytes): %s",
+				StagingBufferSize_inBytes, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			goto OnExit;
+		}
+	}
+	Logging::OutputMessage( "Uploads will be staged through a persistently mapped buffer of %u bytes", StagingBufferSize_inBytes );
+
+OnExit:
+
+	glBindBuffer( GL_COPY_READ_BUFFER, 0 );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	if ( !result && ( s_stagingBufferId != 0 ) )
+	{
+		constexpr GLsizei bufferCount = 1;
+		glDeleteBuffers( bufferCount, &s_stagingBufferId );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+		s_stagingBufferId = 0;
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::UploadManager::CleanUp()
+{
+	auto result = Results::Success;
+
+	Concurrency::cMutex::cScopeLock autoLock( s_mutex );
+
+#ifdef EAE6320_ASSERTS_AREENABLED
+	for ( const auto& outstandingAllocation : s_outstandingAllocations )
+	{
+		EAE6320_ASSERTF( outstandingAllocation.isReleased, "An allocation from the staging buffer was never released" );
+	}
+#endif
+	// The staging buffer can't be deleted while the GPU might still be copying from it
+	for ( auto& fence : s_fences )
+	{
+		constexpr GLuint64 waitForever = ~GLuint64( 0 );
+		const auto waitResult = glClientWaitSync( fence.fence, GL_SYNC_FLUSH_COMMANDS_BIT, waitForever );
+		EAE6320_ASSERT( ( waitResult == GL_ALREADY_SIGNALED ) || ( waitResult == GL_CONDITION_SATISFIED ) );
+		glDeleteSync( fence.fence );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	}
+	s_fences.clear();
+	if ( !s_outstandingAllocations.empty() )
+	{
+		// Any copies that were started from these must also finish
+		glFinish();
+		s_outstandingAllocations.clear();
+	}
+	s_headPosition = s_tailPosition = 0;
+
+	if ( s_stagingBufferId != 0 )
+	{
+		if ( s_stagingData )
+		{
+			glBindBuffer( GL_COPY_READ_BUFFER, s_stagingBufferId );
+			EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+			if ( glUnmapBuffer( GL_COPY_READ_BUFFER ) == GL_FALSE )
+			{
+				// This can only happen if the buffer's contents were corrupted,
+				// which doesn't matter because it is about to be deleted
+				EAE6320_ASSERT( false );
+			}
+			glBindBuffer( GL_COPY_READ_BUFFER, 0 );
+			EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+			s_stagingData = nullptr;
+		}
+		constexpr GLsizei bufferCount = 1;
+		glDeleteBuffers( bufferCount, &s_stagingBufferId );
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			if ( result )
+			{
+				result = Results::Failure;
+			}
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to delete the staging buffer: %s",
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+		}
+		s_stagingBufferId = 0;
+	}
+
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void ReclaimSignaledFences()
+	{
+		while ( !s_fences.empty() )
+		{
+			auto& fence = s_fences.front();
+			// This only checks whether the fence has been signaled (it doesn't wait)
+			constexpr GLbitfield noFlags = 0;
+			constexpr GLuint64 dontWait = 0;
+			const auto waitResult = glClientWaitSync( fence.fence, noFlags, dontWait );
+			if ( ( waitResult == GL_ALREADY_SIGNALED ) || ( waitResult == GL_CONDITION_SATISFIED ) )
+			{
+				s_tailPosition = fence.end;
+				glDeleteSync( fence.fence );
+				EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+				s_fences.pop_front();
+			}
+			else
+			{
+				// Fences are signaled in order,
+				// and so if this one hasn't been the later ones haven't either
+				EAE6320_ASSERT( waitResult != GL_WAIT_FAILED );
+				break;
+			}
+		}
+	}
+}
@@ -0,0 +1,100 @@
+/*
+	The upload manager copies texture and buffer data to the GPU through a staging buffer
+	rather than handing CPU pointers to OpenGL
+	(which makes the driver copy the data synchronously before the call returns):
+		* The staging buffer is persistently mapped,
+			and so data can be written into it from any thread while the render thread keeps drawing
+		* The render thread then only has to start a GPU copy
+			(from a pixel-unpack buffer for textures, or with glCopyBufferSubData() for buffers)
+		* The staging buffer is used as a ring:
+			once per frame a fence is inserted after the copies that were started,
+			and the memory behind a fence is reused once the GPU has signaled it
+		* If the staging buffer is full (or the data is bigger than it is)
+			or if the driver doesn't support persistent mapping (which requires OpenGL 4.4 or ARB_buffer_storage)
+			callers fall back to uploading directly from CPU memory
+*/
+
+#ifndef EAE6320_GRAPHICS_OPENGL_UPLOADMANAGER_H
+#define EAE6320_GRAPHICS_OPENGL_UPLOADMANAGER_H
+
+// Include Files
+//==============
+
+#include "Includes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace UploadManager
+		{
+			constexpr size_t StagingBufferSize_inBytes = 32 * 1024 * 1024;
+
+			// A range of the staging buffer that has been reserved for one upload
+			struct sAllocation
+			{
+				void* data = nullptr;
+				// The offset of the data in the staging buffer
+				// (this is what is passed to OpenGL instead of a pointer while the staging buffer is bound)
+				GLintptr offset = 0;
+				size_t size = 0;
+				// Allocations are released in the order that they were made,
+				// and so this identifies the allocation in the ring
+				uint64_t position = 0;
+
+				bool IsValid() const { return data != nullptr; }
+			};
+
+			// Any Thread
+			//-----------
+
+			// This fails if the data can't be staged
+			// (the caller should then upload directly from its own memory).
+			// Once the data has been written into the allocation it must be released on the render thread
+			// (either with one of the copy functions below or with Release() if it won't be used)
+			bool Allocate( const size_t i_size, sAllocation& o_allocation );
+
+			// Render Thread
+			//--------------
+
+			// If the allocation is valid the staging buffer is bound to GL_PIXEL_UNPACK_BUFFER for as long as this exists,
+			// and so the "data" passed to texture functions is interpreted as an offset into it
+			// (if the allocation isn't valid nothing is bound and the data must be a pointer to CPU memory)
+			class cScopeBindForTextureUpload
+			{
+			public:
+				explicit cScopeBindForTextureUpload( const sAllocation& i_allocation );
+				~cScopeBindForTextureUpload();
+			private:
+				const bool m_isBound;
+			};
+			// The buffer bound to the target is written to;
+			// the allocation is released
+			cResult CopyToBuffer( sAllocation& io_allocation, const GLenum i_target, const GLintptr i_offset = 0 );
+			// Every copy from the allocation must have been started
+			void Release( sAllocation& io_allocation );
+
+			// This is called once per frame:
+			// it fences the copies that have been started since the last call
+			// and reclaims the staging memory of copies that the GPU has finished
+			void EndFrame();
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// An OpenGL context must be current
+			cResult Initialize();
+			// This waits for every copy to finish
+			cResult CleanUp();
+		}
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_OPENGL_UPLOADMANAGER_H
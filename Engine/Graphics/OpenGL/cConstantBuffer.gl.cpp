@@ -23,23 +23,6 @@ void eae6320::Graphics::cConstantBuffer::Bind( const uint_fast8_t ) const
 	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
 }
 
-void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
-{
-	EAE6320_ASSERT( m_bufferId != 0 );
-
-	// Make the uniform buffer active
-	{
-		glBindBuffer( GL_UNIFORM_BUFFER, m_bufferId );
-		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
-	}
-	// Copy the updated memory to the GPU
-	{
-		GLintptr updateAtTheBeginning = 0;
-		glBufferSubData( GL_UNIFORM_BUFFER, updateAtTheBeginning, static_cast<GLsizeiptr>( m_size ), i_data );
-		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
-	}
-}
-
 // Initialization / Clean Up
 //--------------------------
 
@@ -122,3 +105,26 @@ OnExit:
 
 	return result;
 }
+
+// Render
+//-------
+
+size_t eae6320::Graphics::cConstantBuffer::Update_platformSpecific( const size_t i_offset, const size_t i_size )
+{
+	EAE6320_ASSERT( m_bufferId != 0 );
+
+	// Make the uniform buffer active
+	{
+		glBindBuffer( GL_UNIFORM_BUFFER, m_bufferId );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	}
+	// Copy the updated memory to the GPU
+	// (only the range that changed is copied)
+	{
+		glBufferSubData( GL_UNIFORM_BUFFER, static_cast<GLintptr>( i_offset ), static_cast<GLsizeiptr>( i_size ),
+			m_shadowCopy.data() + i_offset );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	}
+
+	return i_size;
+}
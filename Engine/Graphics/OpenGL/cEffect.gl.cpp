@@ -4,6 +4,7 @@
 #include "../cEffect.h"
 
 #include "Includes.h"
+#include "ProgramBinaryCache.h"
 
 #include <Engine/Asserts/Asserts.h>
 
@@ -29,6 +30,10 @@ eae6320::cResult eae6320::Graphics::cEffect::InitializePlatform()
 {
 	auto result = eae6320::Results::Success;
 
+	auto* const vertexShader = eae6320::Graphics::cShader::s_manager.Get(m_vertexShader);
+	auto* const fragmentShader = eae6320::Graphics::cShader::s_manager.Get(m_fragmentShader);
+	const auto programKey = ProgramBinaryCache::CalculateKey(*vertexShader, *fragmentShader);
+
 	// Create a program
 	{
 		m_programId = glCreateProgram();
@@ -49,11 +54,43 @@ eae6320::cResult eae6320::Graphics::cEffect::InitializePlatform()
 			goto OnExit;
 		}
 	}
+	// Use the program's cached binary if there is one
+	// (the shaders don't need to be compiled in that case)
+	if (ProgramBinaryCache::Load(programKey, m_programId))
+	{
+		vertexShader->FreeSource();
+		fragmentShader->FreeSource();
+		goto OnExit;
+	}
+	// Otherwise compile the shaders
+	{
+		if (!(result = vertexShader->CompileIfNecessary()))
+		{
+			goto OnExit;
+		}
+		if (!(result = fragmentShader->CompileIfNecessary()))
+		{
+			goto OnExit;
+		}
+	}
+	// The linked program will be saved to the cache
+	{
+		glProgramParameteri(m_programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		const auto errorCode = glGetError();
+		if (errorCode != GL_NO_ERROR)
+		{
+			result = eae6320::Results::Failure;
+			EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+			eae6320::Logging::OutputError("OpenGL failed to make the program's binary retrievable: %s",
+				reinterpret_cast<const char*>(gluErrorString(errorCode)));
+			goto OnExit;
+		}
+	}
 	// Attach the shaders to the program
 	{
 		// Vertex
 		{
-			glAttachShader(m_programId, eae6320::Graphics::cShader::s_manager.Get(m_vertexShader)->m_shaderId);
+			glAttachShader(m_programId, vertexShader->m_shaderId);
 			const auto errorCode = glGetError();
 			if (errorCode != GL_NO_ERROR)
 			{
@@ -66,7 +103,7 @@ eae6320::cResult eae6320::Graphics::cEffect::InitializePlatform()
 		}
 		// Fragment
 		{
-			glAttachShader(m_programId, eae6320::Graphics::cShader::s_manager.Get(m_fragmentShader)->m_shaderId);
+			glAttachShader(m_programId, fragmentShader->m_shaderId);
 			const auto errorCode = glGetError();
 			if (errorCode != GL_NO_ERROR)
 			{
@@ -150,6 +187,7 @@ eae6320::cResult eae6320::Graphics::cEffect::InitializePlatform()
 					goto OnExit;
 				}
 			}
+			ProgramBinaryCache::Save(programKey, m_programId);
 		}
 		else
 		{
@@ -0,0 +1,713 @@
+// Include Files
+//==============
+
+#include "../cGeometryPool.h"
+
+#include "UploadManager.h"
+#include "../VertexFormats.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <External/OpenGlExtensions/OpenGlExtensions.h>
+#include <vector>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+    // This is the layout that glMultiDrawElementsIndirect() reads
+    struct sDrawElementsIndirectCommand
+    {
+        GLuint indexCount;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+
+    // The draws that haven't been submitted yet all use this pool
+    // (this is only used from the render thread)
+    eae6320::Graphics::cGeometryPool* s_batchPool = nullptr;
+    // The base instance of each command is the index of its draw's data in this batch
+    // (the index of the batch's first draw data in the pool's buffer is added when the batch is submitted)
+    std::vector<sDrawElementsIndirectCommand> s_batchCommands;
+    std::vector<eae6320::Graphics::ConstantBufferFormats::sPerDrawCall> s_batchDrawData;
+
+    // The per-instance vertex attributes start after the per-vertex ones
+    // (the locations must match the vertex shaders)
+    constexpr GLuint s_vertexElementLocation_transform_localToWorld = 3;
+    constexpr GLuint s_vertexElementLocation_positionDequantization_offset = 7;
+    constexpr GLuint s_vertexElementLocation_positionDequantization_scale = 8;
+    constexpr GLuint s_vertexElementLocation_textureArrayLayer = 9;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+    // A new buffer is created and the first part of the old one (if there is one) is copied into it
+    eae6320::cResult CreateBuffer(const uint64_t i_size, const GLuint i_bufferToCopy, const uint64_t i_sizeToCopy, GLuint& o_bufferId,
+        const char* const i_bufferDescription);
+    // The data is staged if possible
+    eae6320::cResult CopyToBuffer(const GLuint i_bufferId, const uint64_t i_offset, const void* const i_data, const uint64_t i_size,
+        const char* const i_bufferDescription);
+}
+
+// Interface
+//==========
+
+// Render
+//-------
+
+void eae6320::Graphics::cGeometryPool::Draw(const sAllocation& i_allocation, const sIndexRange* const i_indexRanges, const size_t i_indexRangeCount,
+    const ConstantBufferFormats::sPerDrawCall& i_drawData)
+{
+    EAE6320_ASSERT(i_allocation.pool == this);
+    EAE6320_ASSERT(i_indexRanges && (i_indexRangeCount > 0));
+
+    // A batch can only draw from one pool
+    if (s_batchPool != this)
+    {
+        SubmitBatch();
+    }
+    // Meshes in the same pool share a vertex array
+    if (s_boundPool != this)
+    {
+        Bind();
+    }
+    s_batchPool = this;
+    // Every range of the mesh reads the same draw data
+    const auto drawDataIndex = static_cast<GLuint>(s_batchDrawData.size());
+    s_batchDrawData.push_back(i_drawData);
+    // A mesh's indices are relative to its first vertex
+    const auto baseVertex = static_cast<GLint>(i_allocation.firstVertex);
+    for (size_t i = 0; i < i_indexRangeCount; ++i)
+    {
+        sDrawElementsIndirectCommand command;
+        {
+            command.indexCount = static_cast<GLuint>(i_indexRanges[i].indexCount);
+            command.instanceCount = 1;
+            command.firstIndex = static_cast<GLuint>(i_allocation.firstIndex + i_indexRanges[i].indexOffset);
+            command.baseVertex = baseVertex;
+            command.baseInstance = drawDataIndex;
+        }
+        s_batchCommands.push_back(command);
+    }
+}
+
+void eae6320::Graphics::cGeometryPool::SubmitBatch()
+{
+    if (s_batchCommands.empty())
+    {
+        s_batchPool = nullptr;
+        return;
+    }
+
+    auto& pool = *s_batchPool;
+    EAE6320_ASSERT(s_boundPool == s_batchPool);
+    // Write the draw data after the data of the previous batches
+    // (when the buffer is full it is orphaned: the driver gives it new memory
+    // while the GPU keeps reading the data that was already written)
+    GLuint firstDrawData = 0;
+    {
+        const auto drawDataCount = static_cast<uint32_t>(s_batchDrawData.size());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, pool.m_drawDataBufferId);
+        EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+        if ((pool.m_nextDrawData + drawDataCount) > pool.m_drawDataCapacity)
+        {
+            pool.m_drawDataCapacity = std::max(std::max(pool.m_drawDataCapacity, drawDataCount), 1024u);
+            glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(pool.m_drawDataCapacity * sizeof(ConstantBufferFormats::sPerDrawCall)),
+                nullptr, GL_STREAM_DRAW);
+            EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+            pool.m_nextDrawData = 0;
+        }
+        firstDrawData = static_cast<GLuint>(pool.m_nextDrawData);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(pool.m_nextDrawData * sizeof(ConstantBufferFormats::sPerDrawCall)),
+            static_cast<GLsizeiptr>(drawDataCount * sizeof(ConstantBufferFormats::sPerDrawCall)), s_batchDrawData.data());
+        EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+        pool.m_nextDrawData += drawDataCount;
+    }
+    for (auto& command : s_batchCommands)
+    {
+        command.baseInstance += firstDrawData;
+    }
+    // Render triangles from the pool's vertex array
+    {
+        // The mode defines how to interpret multiple vertices as a single "primitive";
+        // a triangle list is defined
+        // (meaning that every primitive is a triangle and will be defined by three vertices)
+        constexpr GLenum mode = GL_TRIANGLES;
+        // The index type must match the size of the indices in the index buffer
+        const GLenum indexType = (pool.m_indexFormat == MeshFormats::IndexFormats::Index32) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+        const auto commandCount = static_cast<uint32_t>(s_batchCommands.size());
+        if (glMultiDrawElementsIndirect)
+        {
+            // The commands are written after the commands of the previous batches in the same way as the draw data
+            if ((pool.m_nextIndirectCommand + commandCount) > pool.m_indirectCommandCapacity)
+            {
+                pool.m_indirectCommandCapacity = std::max(std::max(pool.m_indirectCommandCapacity, commandCount), 1024u);
+                glBufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(pool.m_indirectCommandCapacity * sizeof(sDrawElementsIndirectCommand)),
+                    nullptr, GL_STREAM_DRAW);
+                EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+                pool.m_nextIndirectCommand = 0;
+            }
+            const auto offset = static_cast<GLintptr>(pool.m_nextIndirectCommand * sizeof(sDrawElementsIndirectCommand));
+            glBufferSubData(GL_DRAW_INDIRECT_BUFFER, offset, static_cast<GLsizeiptr>(commandCount * sizeof(sDrawElementsIndirectCommand)), s_batchCommands.data());
+            EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+            constexpr GLsizei commandsAreTightlyPacked = 0;
+            glMultiDrawElementsIndirect(mode, indexType, reinterpret_cast<const GLvoid*>(offset), static_cast<GLsizei>(commandCount), commandsAreTightlyPacked);
+            EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+            pool.m_nextIndirectCommand += commandCount;
+        }
+        else
+        {
+            // If indirect drawing isn't supported each command is drawn with its own call
+            // (the draw data is still only uploaded once for the whole batch)
+            const auto indexSize = MeshFormats::IndexFormats::GetSizeOfIndex(pool.m_indexFormat);
+            for (const auto& command : s_batchCommands)
+            {
+                glDrawElementsInstancedBaseVertexBaseInstance(mode, static_cast<GLsizei>(command.indexCount), indexType,
+                    reinterpret_cast<const GLvoid*>(uintptr_t(command.firstIndex) * indexSize), static_cast<GLsizei>(command.instanceCount),
+                    command.baseVertex, command.baseInstance);
+                EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+            }
+        }
+    }
+
+    s_batchCommands.clear();
+    s_batchDrawData.clear();
+    s_batchPool = nullptr;
+}
+
+// Implementation
+//===============
+
+// Platform-Specific
+//------------------
+
+void eae6320::Graphics::cGeometryPool::Bind()
+{
+    // A batch from another pool must be submitted while its vertex array is still bound
+    if (s_batchPool && (s_batchPool != this))
+    {
+        SubmitBatch();
+    }
+    EAE6320_ASSERT(m_vertexArrayId != 0);
+    glBindVertexArray(m_vertexArrayId);
+    EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+    // The indirect buffer isn't part of the vertex array's state
+    if (m_indirectBufferId != 0)
+    {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBufferId);
+        EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+    }
+    s_boundPool = this;
+}
+
+eae6320::cResult eae6320::Graphics::cGeometryPool::Grow(const uint32_t i_vertexCapacity, const uint32_t i_indexCapacity)
+{
+    auto result = eae6320::Results::Success;
+
+    const auto isQuantized = (m_vertexEncoding == MeshFormats::VertexEncodings::Quantized);
+    const auto vertexSize = MeshFormats::VertexEncodings::GetSizeOfVertex(m_vertexEncoding);
+    const auto indexSize = MeshFormats::IndexFormats::GetSizeOfIndex(m_indexFormat);
+    EAE6320_ASSERT((vertexSize != 0) && (indexSize != 0));
+    // The new buffers replace the old ones only once they have both been created
+    auto vertexBufferId_new = m_vertexBufferId;
+    auto indexBufferId_new = m_indexBufferId;
+
+    // Create a vertex array the first time
+    if (m_vertexArrayId == 0)
+    {
+        constexpr GLsizei arrayCount = 1;
+        glGenVertexArrays(arrayCount, &m_vertexArrayId);
+        const auto errorCode = glGetError();
+        if (errorCode != GL_NO_ERROR)
+        {
+            result = eae6320::Results::Failure;
+            EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+            eae6320::Logging::OutputError("OpenGL failed to get an unused vertex array ID for a geometry pool: %s",
+                reinterpret_cast<const char*>(gluErrorString(errorCode)));
+            goto OnExit;
+        }
+    }
+    // Create an indirect buffer the first time
+    if (glMultiDrawElementsIndirect && (m_indirectBufferId == 0))
+    {
+        constexpr GLsizei bufferCount = 1;
+        glGenBuffers(bufferCount, &m_indirectBufferId);
+        const auto errorCode = glGetError();
+        if (errorCode != GL_NO_ERROR)
+        {
+            result = eae6320::Results::Failure;
+            EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+            eae6320::Logging::OutputError("OpenGL failed to get an unused indirect buffer ID for a geometry pool: %s",
+                reinterpret_cast<const char*>(gluErrorString(errorCode)));
+            goto OnExit;
+        }
+    }
+
+    // Create a draw data buffer the first time
+    if (m_drawDataBufferId == 0)
+    {
+        constexpr GLsizei bufferCount = 1;
+        glGenBuffers(bufferCount, &m_drawDataBufferId);
+        const auto errorCode = glGetError();
+        if (errorCode != GL_NO_ERROR)
+        {
+            result = eae6320::Results::Failure;
+            EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+            eae6320::Logging::OutputError("OpenGL failed to get an unused draw data buffer ID for a geometry pool: %s",
+                reinterpret_cast<const char*>(gluErrorString(errorCode)));
+            goto OnExit;
+        }
+    }
+
+    // Create the bigger buffers
+    if (i_vertexCapacity != m_vertexCapacity)
+    {
+        if (!(result = CreateBuffer(uint64_t(i_vertexCapacity) * vertexSize, m_vertexBufferId, uint64_t(m_vertexCapacity) * vertexSize,
+            vertexBufferId_new, "vertex")))
+        {
+            goto OnExit;
+        }
+    }
+    if (i_indexCapacity != m_indexCapacity)
+    {
+        if (!(result = CreateBuffer(uint64_t(i_indexCapacity) * indexSize, m_indexBufferId, uint64_t(m_indexCapacity) * indexSize,
+            indexBufferId_new, "index")))
+        {
+            goto OnExit;
+        }
+    }
+    // Replace the old buffers
+    {
+        constexpr GLsizei bufferCount = 1;
+        if (vertexBufferId_new != m_vertexBufferId)
+        {
+            if (m_vertexBufferId != 0)
+            {
+                glDeleteBuffers(bufferCount, &m_vertexBufferId);
+                EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+            }
+            m_vertexBufferId = vertexBufferId_new;
+        }
+        if (indexBufferId_new != m_indexBufferId)
+        {
+            if (m_indexBufferId != 0)
+            {
+                glDeleteBuffers(bufferCount, &m_indexBufferId);
+                EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+            }
+            m_indexBufferId = indexBufferId_new;
+        }
+    }
+
+    // Point the vertex array at the new buffers
+    Bind();
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, m_vertexBufferId);
+        const auto errorCode = glGetError();
+        if (errorCode == GL_NO_ERROR)
+        {
+            // The index buffer binding is part of the vertex array's state
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferId);
+            const auto errorCode = glGetError();
+            if (errorCode != GL_NO_ERROR)
+            {
+                result = eae6320::Results::Failure;
+                EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                eae6320::Logging::OutputError("OpenGL failed to bind a geometry pool's index buffer: %s",
+                    reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                goto OnExit;
+            }
+        }
+        else
+        {
+            result = eae6320::Results::Failure;
+            EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+            eae6320::Logging::OutputError("OpenGL failed to bind a geometry pool's vertex buffer: %s",
+                reinterpret_cast<const char*>(gluErrorString(errorCode)));
+            goto OnExit;
+        }
+    }
+
+    // Initialize vertex format
+    {
+        // The "stride" defines how large a single vertex is in the stream of data
+        // (or, said another way, how far apart each position element is)
+        const auto stride = static_cast<GLsizei>(MeshFormats::VertexEncodings::GetSizeOfVertex(m_vertexEncoding));
+
+        // Position (0)
+        // 3 floats == 12 bytes (or 3 of the 4 16-bit normalized ints == 8 bytes if quantized)
+        // Offset = 0
+        {
+            constexpr GLuint vertexElementLocation = 0;
+            constexpr GLint elementCount = 3;
+            // The given floats should be used as-is,
+            // but quantized ints must be converted to [0,1] so that the vertex shader can dequantize them
+            const GLenum type = isQuantized ? GL_UNSIGNED_SHORT : GL_FLOAT;
+            const GLboolean normalized = isQuantized ? GL_TRUE : GL_FALSE;
+            const auto offset = isQuantized ? offsetof(eae6320::Graphics::VertexFormats::sMeshQuantized, x) : offsetof(eae6320::Graphics::VertexFormats::sMesh, x);
+            glVertexAttribPointer(vertexElementLocation, elementCount, type, normalized, stride, reinterpret_cast<GLvoid*>(offset));
+            const auto errorCode = glGetError();
+            if (errorCode == GL_NO_ERROR)
+            {
+                glEnableVertexAttribArray(vertexElementLocation);
+                const GLenum errorCode = glGetError();
+                if (errorCode != GL_NO_ERROR)
+                {
+                    result = eae6320::Results::Failure;
+                    EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                    eae6320::Logging::OutputError("OpenGL failed to enable the POSITION vertex attribute at location %u: %s",
+                        vertexElementLocation, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                    goto OnExit;
+                }
+            }
+            else
+            {
+                result = eae6320::Results::Failure;
+                EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                eae6320::Logging::OutputError("OpenGL failed to set the POSITION vertex attribute at location %u: %s",
+                    vertexElementLocation, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                goto OnExit;
+            }
+        }
+
+        // Texture Coordinates (1)
+        // 2 floats == 8 bytes (or 2 16-bit floats == 4 bytes if quantized)
+        // Offset = 12 (or 8 if quantized)
+        {
+            constexpr GLuint vertexElementLocation = 1;
+            constexpr GLint elementCount = 2;
+            constexpr GLboolean normalized = GL_FALSE;  // The given floats should be used as-is
+            const GLenum type = isQuantized ? GL_HALF_FLOAT : GL_FLOAT;
+            const auto offset = isQuantized ? offsetof(eae6320::Graphics::VertexFormats::sMeshQuantized, u) : offsetof(eae6320::Graphics::VertexFormats::sMesh, u);
+            glVertexAttribPointer(vertexElementLocation, elementCount, type, normalized, stride, reinterpret_cast<GLvoid*>(offset));
+            const auto errorCode = glGetError();
+            if (errorCode == GL_NO_ERROR)
+            {
+                glEnableVertexAttribArray(vertexElementLocation);
+                const GLenum errorCode = glGetError();
+                if (errorCode != GL_NO_ERROR)
+                {
+                    result = eae6320::Results::Failure;
+                    EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                    eae6320::Logging::OutputError("OpenGL failed to enable the TEXCOORD vertex attribute at location %u: %s",
+                        vertexElementLocation, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                    goto OnExit;
+                }
+            }
+            else
+            {
+                result = eae6320::Results::Failure;
+                EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                eae6320::Logging::OutputError("OpenGL failed to set the TEXCOORD vertex attribute at location %u: %s",
+                    vertexElementLocation, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                goto OnExit;
+            }
+        }
+
+        // Color (2)
+        // 4 8-bit ints == 4 bytes
+        // Offset = 20 (or 12 if quantized)
+        {
+            constexpr GLuint vertexElementLocation = 2;
+            constexpr GLint elementCount = 4;
+            constexpr GLboolean normalized = GL_TRUE;
+            const auto offset = isQuantized ? offsetof(eae6320::Graphics::VertexFormats::sMeshQuantized, r) : offsetof(eae6320::Graphics::VertexFormats::sMesh, r);
+            glVertexAttribPointer(vertexElementLocation, elementCount, GL_UNSIGNED_BYTE, normalized, stride, reinterpret_cast<GLvoid*>(offset));
+            const auto errorCode = glGetError();
+            if (errorCode == GL_NO_ERROR)
+            {
+                glEnableVertexAttribArray(vertexElementLocation);
+                const GLenum errorCode = glGetError();
+                if (errorCode != GL_NO_ERROR)
+                {
+                    result = eae6320::Results::Failure;
+                    EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                    eae6320::Logging::OutputError("OpenGL failed to enable the COLOR vertex attribute at location %u: %s",
+                        vertexElementLocation, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                    goto OnExit;
+                }
+            }
+            else
+            {
+                result = eae6320::Results::Failure;
+                EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                eae6320::Logging::OutputError("OpenGL failed to set the COLOR vertex attribute at location %u: %s",
+                    vertexElementLocation, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                goto OnExit;
+            }
+        }
+    }
+    // Initialize the per-draw-call data format
+    // (each draw's data is a ConstantBufferFormats::sPerDrawCall,
+    // and it is read once per instance so that the draw's base instance selects it)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, m_drawDataBufferId);
+        const auto errorCode = glGetError();
+        if (errorCode != GL_NO_ERROR)
+        {
+            result = eae6320::Results::Failure;
+            EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+            eae6320::Logging::OutputError("OpenGL failed to bind a geometry pool's draw data buffer: %s",
+                reinterpret_cast<const char*>(gluErrorString(errorCode)));
+            goto OnExit;
+        }
+
+        constexpr auto stride = static_cast<GLsizei>(sizeof(eae6320::Graphics::ConstantBufferFormats::sPerDrawCall));
+        // A 4x4 matrix is four attributes (one for each column),
+        // followed by three attributes of 4 floats each
+        struct
+        {
+            GLuint location;
+            size_t offset;
+            const char* description;
+        } constexpr attributes[] =
+        {
+            { s_vertexElementLocation_transform_localToWorld + 0,
+                offsetof(eae6320::Graphics::ConstantBufferFormats::sPerDrawCall, g_transform_localToWorld) + (0 * 4 * sizeof(float)), "TRANSFORM" },
+            { s_vertexElementLocation_transform_localToWorld + 1,
+                offsetof(eae6320::Graphics::ConstantBufferFormats::sPerDrawCall, g_transform_localToWorld) + (1 * 4 * sizeof(float)), "TRANSFORM" },
+            { s_vertexElementLocation_transform_localToWorld + 2,
+                offsetof(eae6320::Graphics::ConstantBufferFormats::sPerDrawCall, g_transform_localToWorld) + (2 * 4 * sizeof(float)), "TRANSFORM" },
+            { s_vertexElementLocation_transform_localToWorld + 3,
+                offsetof(eae6320::Graphics::ConstantBufferFormats::sPerDrawCall, g_transform_localToWorld) + (3 * 4 * sizeof(float)), "TRANSFORM" },
+            { s_vertexElementLocation_positionDequantization_offset,
+                offsetof(eae6320::Graphics::ConstantBufferFormats::sPerDrawCall, g_positionDequantization_offset), "DEQUANTIZATION OFFSET" },
+            { s_vertexElementLocation_positionDequantization_scale,
+                offsetof(eae6320::Graphics::ConstantBufferFormats::sPerDrawCall, g_positionDequantization_scale), "DEQUANTIZATION SCALE" },
+            { s_vertexElementLocation_textureArrayLayer,
+                offsetof(eae6320::Graphics::ConstantBufferFormats::sPerDrawCall, g_textureArrayLayer), "TEXTURE ARRAY LAYER" },
+        };
+        for (const auto& attribute : attributes)
+        {
+            constexpr GLint elementCount = 4;
+            constexpr GLboolean normalized = GL_FALSE;  // The given floats should be used as-is
+            glVertexAttribPointer(attribute.location, elementCount, GL_FLOAT, normalized, stride, reinterpret_cast<GLvoid*>(attribute.offset));
+            auto errorCode = glGetError();
+            if (errorCode == GL_NO_ERROR)
+            {
+                // The attribute advances once per instance rather than once per vertex
+                constexpr GLuint advanceOncePerInstance = 1;
+                glVertexAttribDivisor(attribute.location, advanceOncePerInstance);
+                errorCode = glGetError();
+                if (errorCode == GL_NO_ERROR)
+                {
+                    glEnableVertexAttribArray(attribute.location);
+                    errorCode = glGetError();
+                }
+            }
+            if (errorCode != GL_NO_ERROR)
+            {
+                result = eae6320::Results::Failure;
+                EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                eae6320::Logging::OutputError("OpenGL failed to set the %s per-instance vertex attribute at location %u: %s",
+                    attribute.description, attribute.location, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                goto OnExit;
+            }
+        }
+    }
+
+OnExit:
+
+    if (!result)
+    {
+        // Any new buffers that didn't replace the old ones are deleted
+        constexpr GLsizei bufferCount = 1;
+        if (vertexBufferId_new != m_vertexBufferId)
+        {
+            glDeleteBuffers(bufferCount, &vertexBufferId_new);
+            EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+        }
+        if (indexBufferId_new != m_indexBufferId)
+        {
+            glDeleteBuffers(bufferCount, &indexBufferId_new);
+            EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+        }
+    }
+
+    return result;
+}
+
+eae6320::cResult eae6320::Graphics::cGeometryPool::Upload(const sAllocation& i_allocation, const void* const i_vertexData, const void* const i_indices)
+{
+    auto result = eae6320::Results::Success;
+
+    const auto vertexSize = MeshFormats::VertexEncodings::GetSizeOfVertex(m_vertexEncoding);
+    const auto indexSize = MeshFormats::IndexFormats::GetSizeOfIndex(m_indexFormat);
+    if (!(result = CopyToBuffer(m_vertexBufferId, uint64_t(i_allocation.firstVertex) * vertexSize, i_vertexData,
+        uint64_t(i_allocation.vertexCount) * vertexSize, "vertex")))
+    {
+        return result;
+    }
+    result = CopyToBuffer(m_indexBufferId, uint64_t(i_allocation.firstIndex) * indexSize, i_indices,
+        uint64_t(i_allocation.indexCount) * indexSize, "index");
+
+    return result;
+}
+
+eae6320::cResult eae6320::Graphics::cGeometryPool::CleanUp()
+{
+    auto result = eae6320::Results::Success;
+
+    if (m_vertexArrayId != 0)
+    {
+        // Make sure that the vertex array isn't bound
+        {
+            // Unbind the vertex array
+            glBindVertexArray(0);
+            const auto errorCode = glGetError();
+            if (errorCode != GL_NO_ERROR)
+            {
+                if (result)
+                {
+                    result = Results::Failure;
+                }
+                EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                Logging::OutputError("OpenGL failed to unbind all vertex arrays before cleaning up a geometry pool: %s",
+                    reinterpret_cast<const char*>(gluErrorString(errorCode)));
+            }
+        }
+        constexpr GLsizei arrayCount = 1;
+        glDeleteVertexArrays(arrayCount, &m_vertexArrayId);
+        const auto errorCode = glGetError();
+        if (errorCode != GL_NO_ERROR)
+        {
+            if (result)
+            {
+                result = Results::Failure;
+            }
+            EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+            Logging::OutputError("OpenGL failed to delete a geometry pool's vertex array: %s",
+                reinterpret_cast<const char*>(gluErrorString(errorCode)));
+        }
+        m_vertexArrayId = 0;
+    }
+    // Any draws that haven't been submitted are discarded
+    if (s_batchPool == this)
+    {
+        s_batchCommands.clear();
+        s_batchDrawData.clear();
+        s_batchPool = nullptr;
+    }
+    for (auto* const bufferId : { &m_vertexBufferId, &m_indexBufferId, &m_indirectBufferId, &m_drawDataBufferId })
+    {
+        if (*bufferId != 0)
+        {
+            constexpr GLsizei bufferCount = 1;
+            glDeleteBuffers(bufferCount, bufferId);
+            const auto errorCode = glGetError();
+            if (errorCode != GL_NO_ERROR)
+            {
+                if (result)
+                {
+                    result = Results::Failure;
+                }
+                EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                Logging::OutputError("OpenGL failed to delete a geometry pool's buffer: %s",
+                    reinterpret_cast<const char*>(gluErrorString(errorCode)));
+            }
+            *bufferId = 0;
+        }
+    }
+    m_indirectCommandCapacity = 0;
+    m_nextIndirectCommand = 0;
+    m_drawDataCapacity = 0;
+    m_nextDrawData = 0;
+
+    return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+    eae6320::cResult CreateBuffer(const uint64_t i_size, const GLuint i_bufferToCopy, const uint64_t i_sizeToCopy, GLuint& o_bufferId,
+        const char* const i_bufferDescription)
+    {
+        EAE6320_ASSERT(i_size < (uint64_t(1u) << (sizeof(GLsizeiptr) * 8 - 1)));
+        EAE6320_ASSERT(i_sizeToCopy <= i_size);
+
+        // The buffer is bound to the copy target so that the bound vertex array isn't changed
+        constexpr GLsizei bufferCount = 1;
+        glGenBuffers(bufferCount, &o_bufferId);
+        auto errorCode = glGetError();
+        if (errorCode == GL_NO_ERROR)
+        {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, o_bufferId);
+            errorCode = glGetError();
+            if (errorCode == GL_NO_ERROR)
+            {
+                glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(i_size), nullptr,
+                    // In our class we won't ever read from the buffer
+                    GL_STATIC_DRAW);
+                errorCode = glGetError();
+                if ((errorCode == GL_NO_ERROR) && (i_bufferToCopy != 0) && (i_sizeToCopy > 0))
+                {
+                    // The existing data is copied on the GPU
+                    glBindBuffer(GL_COPY_READ_BUFFER, i_bufferToCopy);
+                    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(i_sizeToCopy));
+                    errorCode = glGetError();
+                    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+                }
+            }
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+        if (errorCode != GL_NO_ERROR)
+        {
+            EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+            eae6320::Logging::OutputError("OpenGL failed to create a geometry pool's %s buffer (%llu bytes): %s",
+                i_bufferDescription, static_cast<unsigned long long>(i_size), reinterpret_cast<const char*>(gluErrorString(errorCode)));
+            if (o_bufferId != 0)
+            {
+                glDeleteBuffers(bufferCount, &o_bufferId);
+                o_bufferId = 0;
+            }
+            return eae6320::Results::Failure;
+        }
+        return eae6320::Results::Success;
+    }
+
+    eae6320::cResult CopyToBuffer(const GLuint i_bufferId, const uint64_t i_offset, const void* const i_data, const uint64_t i_size,
+        const char* const i_bufferDescription)
+    {
+        auto result = eae6320::Results::Success;
+
+        // The buffer is bound to the copy target so that the bound vertex array isn't changed
+        glBindBuffer(GL_COPY_WRITE_BUFFER, i_bufferId);
+        EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+        // If there is room in the staging buffer the data is copied there
+        // and the GPU copies it into the pool asynchronously
+        eae6320::Graphics::UploadManager::sAllocation allocation;
+        if (eae6320::Graphics::UploadManager::Allocate(static_cast<size_t>(i_size), allocation))
+        {
+            memcpy(allocation.data, i_data, allocation.size);
+            result = eae6320::Graphics::UploadManager::CopyToBuffer(allocation, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(i_offset));
+        }
+        else
+        {
+            glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(i_offset), static_cast<GLsizeiptr>(i_size), i_data);
+            const auto errorCode = glGetError();
+            if (errorCode != GL_NO_ERROR)
+            {
+                result = eae6320::Results::Failure;
+                EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+                eae6320::Logging::OutputError("OpenGL failed to copy %llu bytes into a geometry pool's %s buffer: %s",
+                    static_cast<unsigned long long>(i_size), i_bufferDescription, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+            }
+        }
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+
+        return result;
+    }
+}
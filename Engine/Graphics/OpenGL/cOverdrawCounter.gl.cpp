@@ -0,0 +1,103 @@
+// Include Files
+//==============
+
+#include "../cOverdrawCounter.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Implementation
+//===============
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Graphics::cOverdrawCounter::InitializePlatform()
+{
+	auto result = Results::Success;
+
+	GLuint queryIds[s_queryCount] = {};
+	{
+		glGenQueries( static_cast<GLsizei>( s_queryCount ), queryIds );
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to get %u unused query IDs for the overdraw counter: %s",
+				s_queryCount, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			goto OnExit;
+		}
+	}
+	for ( size_t i = 0; i < s_queryCount; ++i )
+	{
+		m_queries[i].queryId = queryIds[i];
+	}
+
+OnExit:
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::cOverdrawCounter::CleanUpPlatform()
+{
+	auto result = Results::Success;
+
+	for ( auto& query : m_queries )
+	{
+		if ( query.queryId != 0 )
+		{
+			constexpr GLsizei queryCount = 1;
+			glDeleteQueries( queryCount, &query.queryId );
+			const auto errorCode = glGetError();
+			if ( errorCode != GL_NO_ERROR )
+			{
+				if ( result )
+				{
+					result = Results::Failure;
+				}
+				EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+				Logging::OutputError( "OpenGL failed to delete the overdraw counter's query %u: %s",
+					query.queryId, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			}
+			query.queryId = 0;
+		}
+	}
+
+	return result;
+}
+
+// Render
+//-------
+
+void eae6320::Graphics::cOverdrawCounter::BeginQuery( sQuery& io_query )
+{
+	EAE6320_ASSERT( io_query.queryId != 0 );
+	glBeginQuery( GL_SAMPLES_PASSED, io_query.queryId );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+}
+
+void eae6320::Graphics::cOverdrawCounter::EndQuery( sQuery& )
+{
+	glEndQuery( GL_SAMPLES_PASSED );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+}
+
+bool eae6320::Graphics::cOverdrawCounter::GetQueryResult( sQuery& io_query, uint64_t& o_sampleCount )
+{
+	EAE6320_ASSERT( io_query.queryId != 0 );
+
+	// Asking whether the result is available doesn't wait for it
+	GLuint isResultAvailable = GL_FALSE;
+	glGetQueryObjectuiv( io_query.queryId, GL_QUERY_RESULT_AVAILABLE, &isResultAvailable );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	if ( isResultAvailable == GL_FALSE )
+	{
+		return false;
+	}
+	GLuint64 sampleCount = 0;
+	glGetQueryObjectui64v( io_query.queryId, GL_QUERY_RESULT, &sampleCount );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	o_sampleCount = static_cast<uint64_t>( sampleCount );
+	return true;
+}
@@ -34,10 +34,12 @@ void eae6320::Graphics::cRenderState::Bind() const
 	// Depth Buffering
 	if ( IsDepthBufferingEnabled() )
 	{
-		// The new fragment becomes a pixel if its depth is less than what has previously been written
+		// The new fragment becomes a pixel if its depth is less than or equal to what has previously been written
+		// (equal so that a mesh can be drawn again after a depth prepass,
+		// and so that the sky box can be drawn at the far plane after the depth buffer is cleared to it)
 		glEnable( GL_DEPTH_TEST );
 		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
-		glDepthFunc( GL_LESS );
+		glDepthFunc( GL_LEQUAL );
 		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
 		// Write to the depth buffer
 		glDepthMask( GL_TRUE );
@@ -69,6 +71,12 @@ void eae6320::Graphics::cRenderState::Bind() const
 		glFrontFace( GL_CCW );
 		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
 	}
+	// Depth Only
+	{
+		const auto shouldColorsBeWritten = IsDepthOnlyEnabled() ? GL_FALSE : GL_TRUE;
+		glColorMask( shouldColorsBeWritten, shouldColorsBeWritten, shouldColorsBeWritten, shouldColorsBeWritten );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	}
 }
 
 // Initialization / Clean Up
@@ -3,8 +3,11 @@
 
 #include "../cShader.h"
 
+#include "ProgramBinaryCache.h"
+
 #include <cstdlib>
 #include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/Prefetch.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/Platform/Platform.h>
 
@@ -30,13 +33,49 @@ namespace
 //--------------------------
 
 eae6320::cResult eae6320::Graphics::cShader::Initialize( const char* const i_path, const Platform::sDataFromFile& i_loadedShader )
+{
+	// The source code is only compiled if a program needs it (see CompileIfNecessary())
+	m_path = i_path;
+	m_source.assign( static_cast<const char*>( i_loadedShader.data ), i_loadedShader.size );
+	m_sourceHash = ProgramBinaryCache::CalculateHash( m_source.data(), m_source.size() );
+
+	return Results::Success;
+}
+
+void eae6320::Graphics::cShader::FreeSource()
+{
+	std::string().swap( m_source );
+}
+
+eae6320::cResult eae6320::Graphics::cShader::CompileIfNecessary()
 {
 	auto result = Results::Success;
 
+	if ( m_shaderId != 0 )
+	{
+		return result;
+	}
+
+	const auto* const path = m_path.c_str();
 	GLuint shaderId = 0;
 	const auto shaderType = ( m_type == eae6320::Graphics::ShaderTypes::Vertex ) ? GL_VERTEX_SHADER : GL_FRAGMENT_SHADER;
 	const auto* const shaderType_description = ( shaderType == eae6320::Graphics::ShaderTypes::Vertex ) ? "vertex" : "fragment";
 
+	// If the source code was freed because a program was loaded from the program binary cache
+	// it has to be loaded again for this program
+	if ( m_source.empty() )
+	{
+		Platform::sDataFromFile dataFromFile;
+		std::string errorMessage;
+		if ( !( result = Assets::LoadBinaryFile( path, dataFromFile, &errorMessage ) ) )
+		{
+			EAE6320_ASSERTF( false, errorMessage.c_str() );
+			eae6320::Logging::OutputError( "Failed to reload the source code of the shader %s: %s", path, errorMessage.c_str() );
+			goto OnExit;
+		}
+		m_source.assign( static_cast<const char*>( dataFromFile.data ), dataFromFile.size );
+		dataFromFile.Free();
+	}
 	// Verify that compiling shaders at run-time is supported
 	{
 		GLboolean isShaderCompilingSupported;
@@ -73,15 +112,16 @@ eae6320::cResult eae6320::Graphics::cShader::Initialize( const char* const i_pat
 	// Set the source code into the shader
 	{
 		const GLsizei shaderSourceCount = 1;
-		const auto length = static_cast<GLint>( i_loadedShader.size );
-		glShaderSource( shaderId, shaderSourceCount, reinterpret_cast<GLchar* const*>( &i_loadedShader.data ), &length );
+		const auto* const source = m_source.c_str();
+		const auto length = static_cast<GLint>( m_source.length() );
+		glShaderSource( shaderId, shaderSourceCount, &source, &length );
 		const auto errorCode = glGetError();
 		if ( errorCode != GL_NO_ERROR )
 		{
 			result = Results::Failure;
 			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 			eae6320::Logging::OutputError( "OpenGL failed to set the shader source code from %s: %s",
-				i_path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+				path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 			goto OnExit;
 		}
 	}
@@ -114,7 +154,7 @@ eae6320::cResult eae6320::Graphics::cShader::Initialize( const char* const i_pat
 						result = Results::Failure;
 						EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 						eae6320::Logging::OutputError( "OpenGL failed to get compilation info about the shader source code of %s: %s",
-							i_path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+							path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 						goto OnExit;
 					}
 				}
@@ -123,7 +163,7 @@ eae6320::cResult eae6320::Graphics::cShader::Initialize( const char* const i_pat
 					result = Results::Failure;
 					EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 					eae6320::Logging::OutputError( "OpenGL failed to get the length of the shader compilation info of %s: %s",
-						i_path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+						path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 					goto OnExit;
 				}
 			}
@@ -139,7 +179,7 @@ eae6320::cResult eae6320::Graphics::cShader::Initialize( const char* const i_pat
 						result = Results::Failure;
 						EAE6320_ASSERTF( false, compilationInfo.c_str() );
 						eae6320::Logging::OutputError( "OpenGL failed to compile the shader %s: %s",
-							i_path, compilationInfo.c_str() );
+							path, compilationInfo.c_str() );
 						goto OnExit;
 					}
 				}
@@ -148,7 +188,7 @@ eae6320::cResult eae6320::Graphics::cShader::Initialize( const char* const i_pat
 					result = Results::Failure;
 					EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 					eae6320::Logging::OutputError( "OpenGL failed to find if compilation of the shader source code from %s succeeded: %s",
-						i_path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+						path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 					goto OnExit;
 				}
 			}
@@ -158,7 +198,7 @@ eae6320::cResult eae6320::Graphics::cShader::Initialize( const char* const i_pat
 			result = Results::Failure;
 			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 			eae6320::Logging::OutputError( "OpenGL failed to compile the shader source code from %s: %s",
-				i_path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+				path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 			goto OnExit;
 		}
 	}
@@ -170,6 +210,8 @@ OnExit:
 		if ( result )
 		{
 			m_shaderId = shaderId;
+			// The source code isn't needed anymore
+			std::string().swap( m_source );
 		}
 		else
 		{
@@ -3,6 +3,7 @@
 
 #include "../cSprite.h"
 
+#include "../cGeometryPool.h"
 #include "../VertexFormats.h"
 
 #include <Engine/Asserts/Asserts.h>
@@ -21,6 +22,8 @@ void eae6320::Graphics::cSprite::Draw() const
     {
         glBindVertexArray(m_vertexArrayId);
         EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+        // The next mesh has to bind its geometry pool's vertex array again
+        cGeometryPool::ForgetBoundPool();
     }
     // Render triangles from the currently-bound vertex buffer
     {
@@ -52,6 +55,7 @@ eae6320::cResult eae6320::Graphics::cSprite::Initialize(const eae6320::Math::sVe
         if (errorCode == GL_NO_ERROR)
         {
             glBindVertexArray(m_vertexArrayId);
+            cGeometryPool::ForgetBoundPool();
             const auto errorCode = glGetError();
             if (errorCode != GL_NO_ERROR)
             {
@@ -208,6 +212,7 @@ eae6320::cResult eae6320::Graphics::cSprite::CleanUp()
         {
             // Unbind the vertex array
             glBindVertexArray(0);
+            cGeometryPool::ForgetBoundPool();
             const auto errorCode = glGetError();
             if (errorCode != GL_NO_ERROR)
             {
@@ -3,7 +3,10 @@
 
 #include "../cTexture.h"
 
+#include "UploadManager.h"
+
 #include <algorithm>
+#include <cstring>
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Logging/Logging.h>
 
@@ -13,6 +16,21 @@
 namespace
 {
 	constexpr GLenum GetGlFormat( const eae6320::Graphics::TextureFormats::Compression::eType i_compressionType );
+	// The texture must be bound
+	eae6320::cResult SetMipLevelRange( const char* const i_path, const uint8_t i_mostDetailedMipLevel, const uint8_t i_mipMapCount );
+	// This means that the texture has a single layer and the storage for each level is allocated when it is uploaded
+	constexpr GLint s_allocateSingleLayer = -1;
+	// The texture must be bound;
+	// the data is every MIP level, and only the levels in [i_firstMipLevel, i_endMipLevel) are uploaded
+	// (if a layer is given the storage has already been allocated and the levels are copied into that layer)
+	eae6320::cResult UploadMipLevels( const char* const i_path, const eae6320::Graphics::TextureFormats::sTextureInfo& i_info,
+		const uint8_t i_firstMipLevel, const uint8_t i_endMipLevel, const void* const i_textureData, const GLint i_layer = s_allocateSingleLayer );
+	// The texture must be bound;
+	// if the staging buffer is bound the address is an offset into it, and otherwise it is a pointer to CPU memory
+	// (in either case it is where MIP level 0 of the texture data would start)
+	eae6320::cResult CopyMipLevels( const char* const i_path, const eae6320::Graphics::TextureFormats::sTextureInfo& i_info,
+		const uint8_t i_firstMipLevel, const uint8_t i_endMipLevel, const uintptr_t i_textureDataAddress, const GLint i_layer );
+	GLsizei GetMipLevelByteCount( const size_t i_blockSize, const GLsizei i_width, const GLsizei i_height );
 }
 
 // Interface
@@ -31,11 +49,68 @@ void eae6320::Graphics::cTexture::Bind( const unsigned int i_id ) const
 	// Bind the texture to the texture unit
 	{
 		EAE6320_ASSERT( m_textureId != 0 );
-		glBindTexture( GL_TEXTURE_2D, m_textureId );
+		glBindTexture( GL_TEXTURE_2D_ARRAY, m_textureId );
 		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
 	}
 }
 
+// Streaming
+//----------
+
+eae6320::cResult eae6320::Graphics::cTexture::SetMostDetailedResidentMipLevel( const uint8_t i_mipLevel,
+	UploadManager::sAllocation& io_stagedTextureData, const size_t i_stagedTextureDataOffset )
+{
+	auto result = Results::Success;
+
+	EAE6320_ASSERT( io_stagedTextureData.IsValid() );
+	EAE6320_ASSERT( i_mipLevel < m_info.mipMapCount );
+	// Making the texture less detailed doesn't need any data
+	if ( i_mipLevel >= m_mostDetailedResidentMipLevel )
+	{
+		constexpr void* const noDataIsNeeded = nullptr;
+		constexpr size_t noDataSize = 0;
+		result = SetMostDetailedResidentMipLevel( i_mipLevel, noDataIsNeeded, noDataSize );
+		goto OnExit;
+	}
+	// Only the levels that aren't resident yet are copied from the staging buffer
+	if ( ( GetMipLevelOffset( i_mipLevel ) < i_stagedTextureDataOffset )
+		|| ( GetMipLevelOffset( m_mostDetailedResidentMipLevel ) > ( i_stagedTextureDataOffset + io_stagedTextureData.size ) ) )
+	{
+		result = Results::InvalidFile;
+		EAE6320_ASSERTF( false, "The staged texture data for %s doesn't contain MIP map #%u", m_path.c_str(), i_mipLevel );
+		Logging::OutputError( "The staged texture data for %s (%u bytes) doesn't contain MIP map #%u",
+			m_path.c_str(), io_stagedTextureData.size, i_mipLevel );
+		goto OnExit;
+	}
+	// Only textures that have an array of their own are streamed
+	EAE6320_ASSERT( !m_sharedArray );
+	EAE6320_ASSERT( m_textureId != 0 );
+	glBindTexture( GL_TEXTURE_2D_ARRAY, m_textureId );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	// The new levels are uploaded before they are used
+	{
+		// While the staging buffer is bound the "data" for each level is an offset into it
+		const UploadManager::cScopeBindForTextureUpload scopeBind( io_stagedTextureData );
+		const auto textureDataAddress = static_cast<uintptr_t>( io_stagedTextureData.offset ) - i_stagedTextureDataOffset;
+		if ( !( result = CopyMipLevels( m_path.c_str(), m_info, i_mipLevel, m_mostDetailedResidentMipLevel, textureDataAddress, s_allocateSingleLayer ) ) )
+		{
+			goto OnExit;
+		}
+	}
+	if ( !( result = SetMipLevelRange( m_path.c_str(), i_mipLevel, m_info.mipMapCount ) ) )
+	{
+		goto OnExit;
+	}
+	m_mostDetailedResidentMipLevel = i_mipLevel;
+
+OnExit:
+
+	// The staging memory is reused once the GPU has finished copying from it
+	UploadManager::Release( io_stagedTextureData );
+
+	return result;
+}
+
 // Initialization / Clean Up
 //--------------------------
 
@@ -58,7 +133,7 @@ eae6320::cResult eae6320::Graphics::cTexture::Initialize( const char* const i_pa
 		{
 			if ( m_textureId != 0 )
 			{
-				glBindTexture( GL_TEXTURE_2D, m_textureId );
+				glBindTexture( GL_TEXTURE_2D_ARRAY, m_textureId );
 				const auto errorCode = glGetError();
 				if ( errorCode != GL_NO_ERROR )
 				{
@@ -86,60 +161,16 @@ eae6320::cResult eae6320::Graphics::cTexture::Initialize( const char* const i_pa
 			goto OnExit;
 		}
 	}
-	// Fill in the data for each MIP level
+	// Fill in the data for each resident MIP level
+	// (the size of the texture data has already been validated)
+	if ( !( result = UploadMipLevels( i_path, m_info, m_mostDetailedResidentMipLevel, m_info.mipMapCount, i_textureData ) ) )
 	{
-		auto currentWidth = static_cast<GLsizei>( m_info.width );
-		auto currentHeight = static_cast<GLsizei>( m_info.height );
-		auto currentOffset = reinterpret_cast<uintptr_t>( i_textureData );
-		const auto finalOffset = currentOffset + i_textureDataSize;
-		const auto compressionType = m_info.compressionType;
-		const auto blockSize = TextureFormats::Compression::GetSizeOfBlock( compressionType );
-		const auto glFormat = GetGlFormat( compressionType );
-		constexpr GLint borderWidth = 0;
-		const auto mipMapCount = static_cast<GLint>( m_info.mipMapCount );
-		for ( GLint i = 0; i < mipMapCount; ++i )
-		{
-			// Calculate how much memory this MIP level uses
-			const auto blockCount_singleRow = ( currentWidth + 3 ) / 4;
-			const auto byteCount_singleRow = blockCount_singleRow * blockSize;
-			const auto rowCount = ( currentHeight + 3 ) / 4;
-			const auto byteCount_currentMipLevel = byteCount_singleRow * rowCount;
-			// Set the data into the texture
-			glCompressedTexImage2D( GL_TEXTURE_2D, i, glFormat, currentWidth, currentHeight,
-				borderWidth, byteCount_currentMipLevel, reinterpret_cast<void*>( currentOffset ) );
-			const auto errorCode = glGetError();
-			if ( errorCode == GL_NO_ERROR )
-			{
-				// Update current data for next iteration
-				{
-					currentOffset += byteCount_currentMipLevel;
-					if ( currentOffset <= finalOffset )
-					{
-						currentWidth = std::max( currentWidth / 2, 1 );
-						currentHeight = std::max( currentHeight / 2, 1 );
-					}
-					else
-					{
-						result = Results::InvalidFile;
-						EAE6320_ASSERTF( false, "Texture file %s is too small to contain MIP map #%i",
-							i_path, i );
-						Logging::OutputError( "The texture file %s is too small to contain MIP map #%i",
-							i_path, i );
-						goto OnExit;
-					}
-				}
-			}
-			else
-			{
-				result = Results::Failure;
-				EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
-				eae6320::Logging::OutputError( "OpenGL failed to copy the texture data from MIP map #%i of %s: %s",
-					i, i_path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
-				goto OnExit;
-			}
-		}
-		EAE6320_ASSERTF( currentOffset == finalOffset, "The texture file %s has more texture data (%u) than it should (%u)",
-			i_path, finalOffset, currentOffset );
+		goto OnExit;
+	}
+	// The more detailed levels that aren't resident yet are ignored
+	if ( !( result = SetMipLevelRange( i_path, m_mostDetailedResidentMipLevel, m_info.mipMapCount ) ) )
+	{
+		goto OnExit;
 	}
 
 OnExit:
@@ -159,7 +190,12 @@ eae6320::cResult eae6320::Graphics::cTexture::CleanUp()
 {
 	auto result = Results::Success;
 
-	if ( m_textureId != 0 )
+	// A shared array is deleted once every texture in it has been removed
+	if ( m_sharedArray )
+	{
+		m_textureId = 0;
+	}
+	else if ( m_textureId != 0 )
 	{
 		constexpr GLsizei textureCount = 1;
 		glDeleteTextures( textureCount, &m_textureId );
@@ -180,6 +216,166 @@ eae6320::cResult eae6320::Graphics::cTexture::CleanUp()
 	return result;
 }
 
+// Shared Arrays
+//--------------
+
+eae6320::cResult eae6320::Graphics::cTexture::UploadToSharedArray( const char* const i_path, const void* const i_textureData )
+{
+	auto result = Results::Success;
+
+	EAE6320_ASSERT( m_sharedArray && ( m_sharedArray->textureId != 0 ) );
+	glBindTexture( GL_TEXTURE_2D_ARRAY, m_sharedArray->textureId );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	// Every MIP level is copied into the texture's layer
+	// (the size of the texture data has already been validated)
+	constexpr uint8_t mostDetailedMipLevel = 0;
+	if ( !( result = UploadMipLevels( i_path, m_info, mostDetailedMipLevel, m_info.mipMapCount, i_textureData, static_cast<GLint>( m_arrayLayer ) ) ) )
+	{
+		return result;
+	}
+	m_textureId = m_sharedArray->textureId;
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::cTexture::CreateSharedArray( const char* const i_path, const uint16_t i_layerCount, sSharedArray& io_array )
+{
+	auto result = Results::Success;
+
+	const auto& info = io_array.info;
+
+	// Create a new texture and make it active
+	{
+		constexpr GLsizei textureCount = 1;
+		glGenTextures( textureCount, &io_array.textureId );
+		const auto errorCode = glGetError();
+		if ( errorCode == GL_NO_ERROR )
+		{
+			glBindTexture( GL_TEXTURE_2D_ARRAY, io_array.textureId );
+			const auto errorCode = glGetError();
+			if ( errorCode != GL_NO_ERROR )
+			{
+				result = Results::Failure;
+				EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+				eae6320::Logging::OutputError( "OpenGL failed to bind a new texture array for %s: %s",
+					i_path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+				goto OnExit;
+			}
+		}
+		else
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			eae6320::Logging::OutputError( "OpenGL failed to create a texture array for %s: %s",
+				i_path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			goto OnExit;
+		}
+	}
+	// Allocate every level of every layer at once
+	// (the layers are filled in as textures are added)
+	{
+		glTexStorage3D( GL_TEXTURE_2D_ARRAY, static_cast<GLsizei>( info.mipMapCount ), GetGlFormat( info.compressionType ),
+			static_cast<GLsizei>( info.width ), static_cast<GLsizei>( info.height ), static_cast<GLsizei>( i_layerCount ) );
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			eae6320::Logging::OutputError( "OpenGL failed to allocate a texture array with %u layers of %ux%u for %s: %s",
+				i_layerCount, info.width, info.height, i_path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			goto OnExit;
+		}
+	}
+	{
+		constexpr uint8_t mostDetailedMipLevel = 0;
+		if ( !( result = SetMipLevelRange( i_path, mostDetailedMipLevel, info.mipMapCount ) ) )
+		{
+			goto OnExit;
+		}
+	}
+
+OnExit:
+
+	if ( !result && ( io_array.textureId != 0 ) )
+	{
+		constexpr GLsizei textureCount = 1;
+		glDeleteTextures( textureCount, &io_array.textureId );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+		io_array.textureId = 0;
+	}
+
+	return result;
+}
+
+void eae6320::Graphics::cTexture::DestroySharedArray( sSharedArray& io_array )
+{
+	if ( io_array.textureId != 0 )
+	{
+		constexpr GLsizei textureCount = 1;
+		glDeleteTextures( textureCount, &io_array.textureId );
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to delete the texture array %u: %s",
+				io_array.textureId, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+		}
+		io_array.textureId = 0;
+	}
+}
+
+// Streaming
+//----------
+
+eae6320::cResult eae6320::Graphics::cTexture::ChangeMostDetailedResidentMipLevel( const uint8_t i_mipLevel, const void* const i_textureData )
+{
+	auto result = Results::Success;
+
+	// Only textures that have an array of their own are streamed
+	EAE6320_ASSERT( !m_sharedArray );
+	EAE6320_ASSERT( m_textureId != 0 );
+	glBindTexture( GL_TEXTURE_2D_ARRAY, m_textureId );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+
+	if ( i_mipLevel < m_mostDetailedResidentMipLevel )
+	{
+		// The new levels are uploaded before they are used
+		if ( !( result = UploadMipLevels( m_path.c_str(), m_info, i_mipLevel, m_mostDetailedResidentMipLevel, i_textureData ) ) )
+		{
+			return result;
+		}
+		result = SetMipLevelRange( m_path.c_str(), i_mipLevel, m_info.mipMapCount );
+	}
+	else
+	{
+		// The old levels stop being used before they are freed
+		if ( !( result = SetMipLevelRange( m_path.c_str(), i_mipLevel, m_info.mipMapCount ) ) )
+		{
+			return result;
+		}
+		// A level's memory is freed by making it empty
+		// (levels that are less detailed than the base level don't have to be consistent with the others)
+		for ( auto i = m_mostDetailedResidentMipLevel; i < i_mipLevel; ++i )
+		{
+			constexpr GLsizei emptySize = 0;
+			constexpr GLint borderWidth = 0;
+			glTexImage3D( GL_TEXTURE_2D_ARRAY, static_cast<GLint>( i ), GL_RGBA8, emptySize, emptySize, emptySize, borderWidth,
+				GL_RGBA, GL_UNSIGNED_BYTE, nullptr );
+			const auto errorCode = glGetError();
+			if ( errorCode != GL_NO_ERROR )
+			{
+				result = Results::Failure;
+				EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+				eae6320::Logging::OutputError( "OpenGL failed to free MIP map #%u of %s: %s",
+					i, m_path.c_str(), reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+				break;
+			}
+		}
+	}
+
+	return result;
+}
+
 // Helper Function Definitions
 //============================
 
@@ -191,10 +387,126 @@ namespace
 		{
 			case eae6320::Graphics::TextureFormats::Compression::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
 			case eae6320::Graphics::TextureFormats::Compression::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+			case eae6320::Graphics::TextureFormats::Compression::BC4: return GL_COMPRESSED_RED_RGTC1;
+			case eae6320::Graphics::TextureFormats::Compression::BC5: return GL_COMPRESSED_RG_RGTC2;
 		}
 
 		// Other formats are possible, but not for our class
 		EAE6320_ASSERT( false );
 		return 0;
 	}
+
+	eae6320::cResult SetMipLevelRange( const char* const i_path, const uint8_t i_mostDetailedMipLevel, const uint8_t i_mipMapCount )
+	{
+		glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>( i_mostDetailedMipLevel ) );
+		glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>( i_mipMapCount ) - 1 );
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			eae6320::Logging::OutputError( "OpenGL failed to set the MIP levels of %s to start at #%u: %s",
+				i_path, i_mostDetailedMipLevel, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			return eae6320::Results::Failure;
+		}
+		return eae6320::Results::Success;
+	}
+
+	eae6320::cResult UploadMipLevels( const char* const i_path, const eae6320::Graphics::TextureFormats::sTextureInfo& i_info,
+		const uint8_t i_firstMipLevel, const uint8_t i_endMipLevel, const void* const i_textureData, const GLint i_layer )
+	{
+		const auto blockSize = eae6320::Graphics::TextureFormats::Compression::GetSizeOfBlock( i_info.compressionType );
+
+		// Find the range of the data that will be uploaded
+		size_t firstByte = 0, endByte = 0;
+		{
+			auto currentWidth = static_cast<GLsizei>( i_info.width );
+			auto currentHeight = static_cast<GLsizei>( i_info.height );
+			for ( GLint i = 0; i < static_cast<GLint>( i_endMipLevel ); ++i )
+			{
+				if ( i == static_cast<GLint>( i_firstMipLevel ) )
+				{
+					firstByte = endByte;
+				}
+				endByte += static_cast<size_t>( GetMipLevelByteCount( blockSize, currentWidth, currentHeight ) );
+				currentWidth = std::max( currentWidth / 2, 1 );
+				currentHeight = std::max( currentHeight / 2, 1 );
+			}
+		}
+		// Copy it into the staging buffer if there is room
+		// so that the driver can copy it to the texture asynchronously
+		// (otherwise the driver has to copy it from the CPU memory before each call returns)
+		eae6320::Graphics::UploadManager::sAllocation allocation;
+		if ( eae6320::Graphics::UploadManager::Allocate( endByte - firstByte, allocation ) )
+		{
+			memcpy( allocation.data, static_cast<const uint8_t*>( i_textureData ) + firstByte, allocation.size );
+		}
+
+		auto result = eae6320::Results::Success;
+		{
+			// While the staging buffer is bound the "data" for each level is an offset into it
+			const eae6320::Graphics::UploadManager::cScopeBindForTextureUpload scopeBind( allocation );
+			const auto textureDataAddress = allocation.IsValid()
+				? ( static_cast<uintptr_t>( allocation.offset ) - firstByte ) : reinterpret_cast<uintptr_t>( i_textureData );
+			result = CopyMipLevels( i_path, i_info, i_firstMipLevel, i_endMipLevel, textureDataAddress, i_layer );
+		}
+		// The staging memory is reused once the GPU has finished copying from it
+		if ( allocation.IsValid() )
+		{
+			eae6320::Graphics::UploadManager::Release( allocation );
+		}
+		return result;
+	}
+
+	eae6320::cResult CopyMipLevels( const char* const i_path, const eae6320::Graphics::TextureFormats::sTextureInfo& i_info,
+		const uint8_t i_firstMipLevel, const uint8_t i_endMipLevel, const uintptr_t i_textureDataAddress, const GLint i_layer )
+	{
+		const auto blockSize = eae6320::Graphics::TextureFormats::Compression::GetSizeOfBlock( i_info.compressionType );
+		const auto glFormat = GetGlFormat( i_info.compressionType );
+
+		auto currentOffset = i_textureDataAddress;
+		auto currentWidth = static_cast<GLsizei>( i_info.width );
+		auto currentHeight = static_cast<GLsizei>( i_info.height );
+		constexpr GLint borderWidth = 0;
+		for ( GLint i = 0; i < static_cast<GLint>( i_endMipLevel ); ++i )
+		{
+			const auto byteCount_currentMipLevel = GetMipLevelByteCount( blockSize, currentWidth, currentHeight );
+			// Set the data into the texture
+			if ( i >= static_cast<GLint>( i_firstMipLevel ) )
+			{
+				constexpr GLsizei layerCount = 1;
+				if ( i_layer == s_allocateSingleLayer )
+				{
+					glCompressedTexImage3D( GL_TEXTURE_2D_ARRAY, i, glFormat, currentWidth, currentHeight, layerCount,
+						borderWidth, byteCount_currentMipLevel, reinterpret_cast<void*>( currentOffset ) );
+				}
+				else
+				{
+					constexpr GLint x = 0, y = 0;
+					glCompressedTexSubImage3D( GL_TEXTURE_2D_ARRAY, i, x, y, i_layer, currentWidth, currentHeight, layerCount,
+						glFormat, byteCount_currentMipLevel, reinterpret_cast<void*>( currentOffset ) );
+				}
+				const auto errorCode = glGetError();
+				if ( errorCode != GL_NO_ERROR )
+				{
+					EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+					eae6320::Logging::OutputError( "OpenGL failed to copy the texture data from MIP map #%i of %s: %s",
+						i, i_path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+					return eae6320::Results::Failure;
+				}
+			}
+			// Update current data for next iteration
+			currentOffset += byteCount_currentMipLevel;
+			currentWidth = std::max( currentWidth / 2, 1 );
+			currentHeight = std::max( currentHeight / 2, 1 );
+		}
+		return eae6320::Results::Success;
+	}
+
+	GLsizei GetMipLevelByteCount( const size_t i_blockSize, const GLsizei i_width, const GLsizei i_height )
+	{
+		const auto blockCount_singleRow = ( i_width + 3 ) / 4;
+		const auto byteCount_singleRow = blockCount_singleRow * i_blockSize;
+		const auto rowCount = ( i_height + 3 ) / 4;
+		return static_cast<GLsizei>( byteCount_singleRow * rowCount );
+	}
 }
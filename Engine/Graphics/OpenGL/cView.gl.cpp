@@ -6,6 +6,7 @@
 #include "Includes.h"
 #include "../sColor.h"
 #include "../sContext.h"
+#include "UploadManager.h"
 
 #include <Engine/Asserts/Asserts.h>
 
@@ -50,6 +51,9 @@ void eae6320::Graphics::cView::Swap() const
 
     const auto glResult = SwapBuffers(deviceContext);
     EAE6320_ASSERT(glResult != FALSE);
+
+    // The uploads that were started this frame are fenced so that their staging memory can be reused
+    UploadManager::EndFrame();
 }
 
 // Initialization / Clean Up
@@ -3,6 +3,8 @@
 
 #include "../sContext.h"
 
+#include "UploadManager.h"
+
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/Windows/Functions.h>
@@ -46,6 +48,12 @@ eae6320::cResult eae6320::Graphics::sContext::Initialize( const sInitializationP
 		EAE6320_ASSERT( false );
 		goto OnExit;
 	}
+	// Create the staging buffer that uploads go through
+	if ( !( result = UploadManager::Initialize() ) )
+	{
+		EAE6320_ASSERT( false );
+		goto OnExit;
+	}
 
 OnExit:
 
@@ -56,6 +64,20 @@ eae6320::cResult eae6320::Graphics::sContext::CleanUp()
 {
 	auto result = Results::Success;
 
+	// The staging buffer must be deleted while the context still exists
+	if ( openGlRenderingContext != NULL )
+	{
+		const auto localResult = UploadManager::CleanUp();
+		if ( !localResult )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+
 	if ( openGlRenderingContext != NULL )
 	{
 		if ( wglMakeCurrent( deviceContext, NULL ) != FALSE )
@@ -0,0 +1,594 @@
+// Include Files
+//==============
+
+#include "TextureStreaming.h"
+
+#include "cTexture.h"
+#include "TextureFormats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/Prefetch.h>
+#include <Engine/Concurrency/cEvent.h>
+#include <Engine/Concurrency/cMutex.h>
+#include <Engine/Concurrency/cThread.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Platform/Platform.h>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined( EAE6320_PLATFORM_GL )
+    #include "OpenGL/UploadManager.h"
+#endif
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+    struct sTextureRecord
+    {
+        uint8_t tailMipLevel = 0;
+        // A bit is set for each level that the texture can start at
+        // (every requested and target level is one of these)
+        uint32_t validMipLevels = 0;
+        // The most detailed level that any draw call has needed this frame
+        uint8_t mipLevel_requested = 0;
+        bool wasRequestedThisFrame = false;
+        // The level that the texture should have once any load has finished
+        uint8_t mipLevel_target = 0;
+        // Detail isn't dropped until it hasn't been needed for a while
+        // so that a texture that is on the edge between two levels doesn't keep being reloaded
+        unsigned int frameCount_lessDetailWasEnough = 0;
+        bool isLoadPending = false;
+        // A texture whose file can't be read isn't tried again
+        bool hasLoadFailed = false;
+    };
+
+    struct sLoadRequest
+    {
+        // The texture has a reference for as long as the request exists
+        eae6320::Graphics::cTexture* texture = nullptr;
+        std::string path;
+        uint8_t mipLevel = 0;
+        // The levels from the requested one up to the tail are the only ones that can be uploaded
+        // (the tail is always resident)
+        uint8_t tailMipLevel = 0;
+        eae6320::Platform::sDataFromFile data;
+#if defined( EAE6320_PLATFORM_GL )
+        // If there is room in the upload staging buffer the loading thread copies the levels into it
+        // and frees the data, and the render thread then only has to start the GPU copy
+        eae6320::Graphics::UploadManager::sAllocation stagedData;
+        // This is where the staged data starts in the texture data
+        size_t stagedDataOffset = 0;
+#endif
+        bool wasSuccessful = false;
+    };
+}
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+    // This many frames must need less detail in a row before the more detailed levels are dropped
+    constexpr unsigned int s_frameCountBeforeDetailIsDropped = 60;
+
+    // Textures
+    std::unordered_map<const eae6320::Graphics::cTexture*, sTextureRecord> s_records;
+    eae6320::Concurrency::cMutex s_recordsMutex;
+    size_t s_budget_inBytes = eae6320::Graphics::TextureStreaming::DefaultBudget_inBytes;
+
+    // Loading
+    eae6320::Concurrency::cThread s_loadingThread;
+    bool s_isLoadingThreadRunning = false;
+    std::atomic<bool> s_shouldLoadingThreadStop( false );
+    // This is signaled by the render thread when there are new requests
+    eae6320::Concurrency::cEvent s_whenLoadRequestsAreWaiting;
+    // This protects both lists
+    std::deque<sLoadRequest*> s_loadRequests_waiting;
+    std::vector<sLoadRequest*> s_loadRequests_completed;
+    eae6320::Concurrency::cMutex s_loadRequestsMutex;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+    void EntryPoint_loadingThread( void* const );
+    size_t GetByteCount( const eae6320::Graphics::cTexture& i_texture, const uint8_t i_mostDetailedMipLevel );
+    // These return the closest valid level that is at least as detailed or at most as detailed as the given level
+    uint8_t GetValidMipLevel_moreDetailed( const sTextureRecord& i_record, const uint8_t i_mipLevel );
+    uint8_t GetValidMipLevel_lessDetailed( const sTextureRecord& i_record, const uint8_t i_mipLevel );
+    // The completed requests are deleted, and their textures are returned so that they can be released
+    // after the records aren't locked anymore
+    void ApplyCompletedLoads( std::vector<eae6320::Graphics::cTexture*>& o_texturesToRelease );
+    void ReleaseTextures( const std::vector<eae6320::Graphics::cTexture*>& i_textures );
+}
+
+// Interface
+//==========
+
+uint32_t eae6320::Graphics::TextureStreaming::GetValidMostDetailedMipLevels( const TextureFormats::sTextureInfo& i_info )
+{
+    const auto width = static_cast<unsigned int>( i_info.width );
+    const auto height = static_cast<unsigned int>( i_info.height );
+    uint32_t validMipLevels = 1u;
+    for ( uint8_t mipLevel = 1; ( mipLevel < i_info.mipMapCount ) && ( mipLevel < 32 ); ++mipLevel )
+    {
+        if ( ( ( ( width >> mipLevel ) % 4 ) == 0 ) && ( ( ( height >> mipLevel ) % 4 ) == 0 ) )
+        {
+            validMipLevels |= 1u << mipLevel;
+        }
+    }
+    return validMipLevels;
+}
+
+uint8_t eae6320::Graphics::TextureStreaming::GetTailMipLevel( const TextureFormats::sTextureInfo& i_info )
+{
+    const auto width = static_cast<unsigned int>( i_info.width );
+    const auto height = static_cast<unsigned int>( i_info.height );
+    uint8_t mipLevel = 0;
+    while ( ( ( mipLevel + 1 ) < i_info.mipMapCount ) && ( std::max( width >> mipLevel, height >> mipLevel ) > TailDimension ) )
+    {
+        ++mipLevel;
+    }
+    const auto validMipLevels = GetValidMostDetailedMipLevels( i_info );
+    while ( ( mipLevel > 0 ) && ( ( validMipLevels & ( 1u << mipLevel ) ) == 0 ) )
+    {
+        --mipLevel;
+    }
+    return mipLevel;
+}
+
+// Render Thread
+//--------------
+
+void eae6320::Graphics::TextureStreaming::RequestScreenSize( const cTexture& i_texture, const float i_screenSize_inPixels )
+{
+    Concurrency::cMutex::cScopeLock autoLock( s_recordsMutex );
+
+    const auto iterator = s_records.find( &i_texture );
+    if ( iterator == s_records.end() )
+    {
+        // The texture doesn't have anything to stream
+        return;
+    }
+    auto& record = iterator->second;
+    // Each less detailed level is half the size,
+    // and so the level whose size matches the screen is the log of how much bigger the texture is
+    auto mipLevel = record.tailMipLevel;
+    if ( i_screenSize_inPixels > 0.0f )
+    {
+        const auto textureSize = static_cast<float>( std::max( i_texture.GetWidth(), i_texture.GetHeight() ) );
+        const auto ratio = textureSize / i_screenSize_inPixels;
+        mipLevel = ( ratio > 1.0f ) ? static_cast<uint8_t>( std::min( std::floor( std::log2( ratio ) ), static_cast<float>( mipLevel ) ) ) : 0;
+        // If the texture can't start at that level it gets the closest more detailed level that it can start at
+        // (so that it is never blurrier than the draw call needs)
+        mipLevel = GetValidMipLevel_moreDetailed( record, mipLevel );
+    }
+    record.mipLevel_requested = std::min( record.mipLevel_requested, mipLevel );
+    record.wasRequestedThisFrame = true;
+}
+
+void eae6320::Graphics::TextureStreaming::Update()
+{
+    std::vector<cTexture*> texturesToRelease;
+    std::vector<sLoadRequest*> newLoadRequests;
+    {
+        Concurrency::cMutex::cScopeLock autoLock( s_recordsMutex );
+
+        // Upload the levels that have finished loading
+        ApplyCompletedLoads( texturesToRelease );
+
+        // Decide which level each texture should have
+        auto byteCount_total = static_cast<size_t>( 0 );
+        for ( auto& textureAndRecord : s_records )
+        {
+            auto& record = textureAndRecord.second;
+            // A texture that wasn't drawn this frame only needs its tail
+            const auto mipLevel_desired = record.wasRequestedThisFrame ? record.mipLevel_requested : record.tailMipLevel;
+            if ( mipLevel_desired <= record.mipLevel_target )
+            {
+                // More detail is streamed in as soon as possible
+                record.mipLevel_target = mipLevel_desired;
+                record.frameCount_lessDetailWasEnough = 0;
+            }
+            else if ( ++record.frameCount_lessDetailWasEnough >= s_frameCountBeforeDetailIsDropped )
+            {
+                record.mipLevel_target = mipLevel_desired;
+                record.frameCount_lessDetailWasEnough = 0;
+            }
+            byteCount_total += GetByteCount( *textureAndRecord.first, record.mipLevel_target );
+        }
+        // If every texture can't have the level that it wants
+        // the detail is taken from whichever texture's most detailed level is the largest
+        // (dropping a level frees three quarters of a texture's memory,
+        // and so the largest textures are reduced until the others fit)
+        if ( byteCount_total > s_budget_inBytes )
+        {
+            using tSizeAndRecord = std::pair<size_t, std::pair<const cTexture*, sTextureRecord*>>;
+            std::priority_queue<tSizeAndRecord> largestLevels;
+            for ( auto& textureAndRecord : s_records )
+            {
+                auto& record = textureAndRecord.second;
+                if ( record.mipLevel_target < record.tailMipLevel )
+                {
+                    largestLevels.push( { textureAndRecord.first->GetMipLevelByteCount( record.mipLevel_target ), { textureAndRecord.first, &record } } );
+                }
+            }
+            while ( ( byteCount_total > s_budget_inBytes ) && !largestLevels.empty() )
+            {
+                const auto largestLevel = largestLevels.top();
+                largestLevels.pop();
+                const auto& texture = *largestLevel.second.first;
+                auto& record = *largestLevel.second.second;
+                // The texture might not be able to start at the next level,
+                // in which case more than one level is dropped
+                const auto mipLevel_new = GetValidMipLevel_lessDetailed( record, static_cast<uint8_t>( record.mipLevel_target + 1 ) );
+                byteCount_total -= GetByteCount( texture, record.mipLevel_target ) - GetByteCount( texture, mipLevel_new );
+                record.mipLevel_target = mipLevel_new;
+                if ( record.mipLevel_target < record.tailMipLevel )
+                {
+                    largestLevels.push( { texture.GetMipLevelByteCount( record.mipLevel_target ), largestLevel.second } );
+                }
+            }
+        }
+        // Make the textures match their target levels
+        for ( auto& textureAndRecord : s_records )
+        {
+            auto& texture = *const_cast<cTexture*>( textureAndRecord.first );
+            auto& record = textureAndRecord.second;
+            const auto mipLevel_resident = texture.GetMostDetailedResidentMipLevel();
+            if ( record.mipLevel_target > mipLevel_resident )
+            {
+                // Levels are dropped immediately
+                constexpr void* const noDataIsNeeded = nullptr;
+                constexpr size_t noDataSize = 0;
+                texture.SetMostDetailedResidentMipLevel( record.mipLevel_target, noDataIsNeeded, noDataSize );
+            }
+            // Only textures that were drawn this frame are loaded
+            // (the render data holds references to them, and so they can't be in the middle of being destroyed)
+            else if ( ( record.mipLevel_target < mipLevel_resident ) && record.wasRequestedThisFrame
+                && !record.isLoadPending && !record.hasLoadFailed )
+            {
+                auto* const loadRequest = new sLoadRequest;
+                {
+                    loadRequest->texture = &texture;
+                    loadRequest->texture->IncrementReferenceCount();
+                    loadRequest->path = texture.GetPath();
+                    loadRequest->mipLevel = record.mipLevel_target;
+                    loadRequest->tailMipLevel = record.tailMipLevel;
+                }
+                newLoadRequests.push_back( loadRequest );
+                record.isLoadPending = true;
+            }
+            // Requests are recorded again every frame
+            record.mipLevel_requested = record.tailMipLevel;
+            record.wasRequestedThisFrame = false;
+        }
+    }
+    if ( !newLoadRequests.empty() )
+    {
+        {
+            Concurrency::cMutex::cScopeLock autoLock( s_loadRequestsMutex );
+            s_loadRequests_waiting.insert( s_loadRequests_waiting.end(), newLoadRequests.begin(), newLoadRequests.end() );
+        }
+        s_whenLoadRequestsAreWaiting.Signal();
+    }
+
+    ReleaseTextures( texturesToRelease );
+}
+
+void eae6320::Graphics::TextureStreaming::SetBudget( const size_t i_budget_inBytes )
+{
+    Concurrency::cMutex::cScopeLock autoLock( s_recordsMutex );
+    s_budget_inBytes = i_budget_inBytes;
+}
+
+size_t eae6320::Graphics::TextureStreaming::GetResidentByteCount()
+{
+    Concurrency::cMutex::cScopeLock autoLock( s_recordsMutex );
+
+    size_t byteCount = 0;
+    for ( const auto& textureAndRecord : s_records )
+    {
+        const auto& texture = *textureAndRecord.first;
+        byteCount += GetByteCount( texture, texture.GetMostDetailedResidentMipLevel() );
+    }
+    return byteCount;
+}
+
+// Textures
+//---------
+
+void eae6320::Graphics::TextureStreaming::Register( cTexture& io_texture )
+{
+    Concurrency::cMutex::cScopeLock autoLock( s_recordsMutex );
+
+    auto& record = s_records[&io_texture];
+    {
+        const auto mipLevel_resident = io_texture.GetMostDetailedResidentMipLevel();
+        record.tailMipLevel = mipLevel_resident;
+        TextureFormats::sTextureInfo info{};
+        {
+            info.width = io_texture.GetWidth();
+            info.height = io_texture.GetHeight();
+            info.mipMapCount = io_texture.GetMipMapCount();
+        }
+        record.validMipLevels = GetValidMostDetailedMipLevels( info );
+        record.mipLevel_requested = mipLevel_resident;
+        record.mipLevel_target = mipLevel_resident;
+    }
+}
+
+void eae6320::Graphics::TextureStreaming::Unregister( const cTexture& i_texture )
+{
+    Concurrency::cMutex::cScopeLock autoLock( s_recordsMutex );
+
+    const auto iterator = s_records.find( &i_texture );
+    if ( iterator != s_records.end() )
+    {
+        // A texture with a pending load still has a reference,
+        // and so it can't be destroyed until the load has been applied
+        EAE6320_ASSERT( !iterator->second.isLoadPending );
+        s_records.erase( iterator );
+    }
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Graphics::TextureStreaming::Initialize( const size_t i_budget_inBytes )
+{
+    auto result = Results::Success;
+
+    SetBudget( i_budget_inBytes );
+
+    if ( !( result = s_whenLoadRequestsAreWaiting.Initialize( Concurrency::EventType::ResetAutomaticallyAfterBeingSignaled ) ) )
+    {
+        EAE6320_ASSERTF( false, "Couldn't initialize the texture streaming event" );
+        Logging::OutputError( "Failed to initialize the event that wakes the texture streaming thread" );
+        return result;
+    }
+    s_shouldLoadingThreadStop = false;
+    if ( !( result = s_loadingThread.Start( EntryPoint_loadingThread ) ) )
+    {
+        EAE6320_ASSERTF( false, "Couldn't start the texture streaming thread" );
+        Logging::OutputError( "Failed to start the texture streaming thread" );
+        return result;
+    }
+    s_isLoadingThreadRunning = true;
+
+    return result;
+}
+
+eae6320::cResult eae6320::Graphics::TextureStreaming::CleanUp()
+{
+    auto result = Results::Success;
+
+    if ( s_isLoadingThreadRunning )
+    {
+        s_shouldLoadingThreadStop = true;
+        s_whenLoadRequestsAreWaiting.Signal();
+        const auto localResult = WaitForThreadToStop( s_loadingThread );
+        if ( !localResult )
+        {
+            EAE6320_ASSERTF( false, "Couldn't wait for the texture streaming thread to stop" );
+            Logging::OutputError( "Failed to wait for the texture streaming thread to stop" );
+            if ( result )
+            {
+                result = localResult;
+            }
+        }
+        s_isLoadingThreadRunning = false;
+    }
+
+    // Any loads that were never applied release their textures
+    std::vector<cTexture*> texturesToRelease;
+    {
+        Concurrency::cMutex::cScopeLock autoLock( s_loadRequestsMutex );
+        s_loadRequests_completed.insert( s_loadRequests_completed.end(), s_loadRequests_waiting.begin(), s_loadRequests_waiting.end() );
+        s_loadRequests_waiting.clear();
+        for ( auto* const loadRequest : s_loadRequests_completed )
+        {
+#if defined( EAE6320_PLATFORM_GL )
+            if ( loadRequest->stagedData.IsValid() )
+            {
+                UploadManager::Release( loadRequest->stagedData );
+            }
+#endif
+            loadRequest->data.Free();
+            texturesToRelease.push_back( loadRequest->texture );
+            delete loadRequest;
+        }
+        s_loadRequests_completed.clear();
+    }
+    {
+        Concurrency::cMutex::cScopeLock autoLock( s_recordsMutex );
+        for ( auto& textureAndRecord : s_records )
+        {
+            textureAndRecord.second.isLoadPending = false;
+        }
+    }
+    ReleaseTextures( texturesToRelease );
+
+    {
+        const auto localResult = s_whenLoadRequestsAreWaiting.CleanUp();
+        if ( !localResult )
+        {
+            EAE6320_ASSERT( false );
+            if ( result )
+            {
+                result = localResult;
+            }
+        }
+    }
+
+    return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+    void EntryPoint_loadingThread( void* const )
+    {
+        while ( eae6320::Concurrency::WaitForEvent( s_whenLoadRequestsAreWaiting ) && !s_shouldLoadingThreadStop )
+        {
+            // Every waiting request is loaded before waiting again
+            while ( !s_shouldLoadingThreadStop )
+            {
+                sLoadRequest* loadRequest = nullptr;
+                {
+                    eae6320::Concurrency::cMutex::cScopeLock autoLock( s_loadRequestsMutex );
+                    if ( s_loadRequests_waiting.empty() )
+                    {
+                        break;
+                    }
+                    loadRequest = s_loadRequests_waiting.front();
+                    s_loadRequests_waiting.pop_front();
+                }
+                // The whole file is read
+                // (built files can be compressed, and so a single MIP level can't be read on its own)
+                {
+                    std::string errorMessage;
+                    loadRequest->wasSuccessful = eae6320::Assets::LoadBinaryFile( loadRequest->path.c_str(), loadRequest->data, &errorMessage );
+                    if ( !loadRequest->wasSuccessful )
+                    {
+                        eae6320::Logging::OutputError( "The texture %s couldn't be read to stream in MIP map #%u: %s",
+                            loadRequest->path.c_str(), loadRequest->mipLevel, errorMessage.c_str() );
+                    }
+                }
+#if defined( EAE6320_PLATFORM_GL )
+                // Copy the levels that can be uploaded into the staging buffer on this thread
+                // (if the staging buffer is full the render thread uploads them from the data instead)
+                if ( loadRequest->wasSuccessful )
+                {
+                    const auto& texture = *loadRequest->texture;
+                    const auto firstByte = texture.GetMipLevelOffset( loadRequest->mipLevel );
+                    const auto endByte = texture.GetMipLevelOffset( loadRequest->tailMipLevel );
+                    constexpr auto infoSize = sizeof( eae6320::Graphics::TextureFormats::sTextureInfo );
+                    if ( ( firstByte < endByte ) && ( loadRequest->data.size >= ( infoSize + endByte ) )
+                        && eae6320::Graphics::UploadManager::Allocate( endByte - firstByte, loadRequest->stagedData ) )
+                    {
+                        memcpy( loadRequest->stagedData.data,
+                            static_cast<const uint8_t*>( loadRequest->data.data ) + infoSize + firstByte, loadRequest->stagedData.size );
+                        loadRequest->stagedDataOffset = firstByte;
+                        loadRequest->data.Free();
+                    }
+                }
+#endif
+                {
+                    eae6320::Concurrency::cMutex::cScopeLock autoLock( s_loadRequestsMutex );
+                    s_loadRequests_completed.push_back( loadRequest );
+                }
+            }
+        }
+    }
+
+    size_t GetByteCount( const eae6320::Graphics::cTexture& i_texture, const uint8_t i_mostDetailedMipLevel )
+    {
+        const auto mipMapCount = i_texture.GetMipMapCount();
+        return i_texture.GetMipLevelOffset( mipMapCount ) - i_texture.GetMipLevelOffset( i_mostDetailedMipLevel );
+    }
+
+    uint8_t GetValidMipLevel_moreDetailed( const sTextureRecord& i_record, const uint8_t i_mipLevel )
+    {
+        // Level 0 is always valid
+        auto mipLevel = i_mipLevel;
+        while ( ( mipLevel > 0 ) && ( ( i_record.validMipLevels & ( 1u << mipLevel ) ) == 0 ) )
+        {
+            --mipLevel;
+        }
+        return mipLevel;
+    }
+
+    uint8_t GetValidMipLevel_lessDetailed( const sTextureRecord& i_record, const uint8_t i_mipLevel )
+    {
+        // The tail level is always valid
+        auto mipLevel = std::min( i_mipLevel, i_record.tailMipLevel );
+        while ( ( mipLevel < i_record.tailMipLevel ) && ( ( i_record.validMipLevels & ( 1u << mipLevel ) ) == 0 ) )
+        {
+            ++mipLevel;
+        }
+        return mipLevel;
+    }
+
+    void ApplyCompletedLoads( std::vector<eae6320::Graphics::cTexture*>& o_texturesToRelease )
+    {
+        std::vector<sLoadRequest*> completedLoads;
+        {
+            eae6320::Concurrency::cMutex::cScopeLock autoLock( s_loadRequestsMutex );
+            std::swap( completedLoads, s_loadRequests_completed );
+        }
+        for ( auto* const loadRequest : completedLoads )
+        {
+            auto& texture = *loadRequest->texture;
+            auto& record = s_records[&texture];
+            record.isLoadPending = false;
+#if defined( EAE6320_PLATFORM_GL )
+            if ( loadRequest->stagedData.IsValid() )
+            {
+                // If the texture needs less detail now than when the load was requested
+                // only the levels that are still needed are copied
+                // (the staged data is released either way)
+                const auto mipLevel = std::max( loadRequest->mipLevel, record.mipLevel_target );
+                if ( mipLevel < texture.GetMostDetailedResidentMipLevel() )
+                {
+                    if ( !texture.SetMostDetailedResidentMipLevel( mipLevel, loadRequest->stagedData, loadRequest->stagedDataOffset ) )
+                    {
+                        record.hasLoadFailed = true;
+                    }
+                }
+                else
+                {
+                    eae6320::Graphics::UploadManager::Release( loadRequest->stagedData );
+                }
+            }
+            else
+#endif
+            if ( loadRequest->wasSuccessful
+                && ( loadRequest->data.size >= sizeof( eae6320::Graphics::TextureFormats::sTextureInfo ) ) )
+            {
+                // If the texture needs less detail now than when the load was requested
+                // only the levels that are still needed are uploaded
+                const auto mipLevel = std::max( loadRequest->mipLevel, record.mipLevel_target );
+                if ( mipLevel < texture.GetMostDetailedResidentMipLevel() )
+                {
+                    const auto* const textureData = static_cast<const uint8_t*>( loadRequest->data.data )
+                        + sizeof( eae6320::Graphics::TextureFormats::sTextureInfo );
+                    const auto textureDataSize = loadRequest->data.size - sizeof( eae6320::Graphics::TextureFormats::sTextureInfo );
+                    if ( !texture.SetMostDetailedResidentMipLevel( mipLevel, textureData, textureDataSize ) )
+                    {
+                        record.hasLoadFailed = true;
+                    }
+                }
+            }
+            else
+            {
+                record.hasLoadFailed = true;
+            }
+            loadRequest->data.Free();
+            o_texturesToRelease.push_back( &texture );
+            delete loadRequest;
+        }
+    }
+
+    void ReleaseTextures( const std::vector<eae6320::Graphics::cTexture*>& i_textures )
+    {
+        for ( auto* const texture : i_textures )
+        {
+            texture->DecrementReferenceCount();
+        }
+    }
+}
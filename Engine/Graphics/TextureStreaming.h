@@ -0,0 +1,95 @@
+/*
+    Texture streaming keeps only the MIP levels of textures that are actually needed in GPU memory:
+        * When a texture is loaded only its "MIP tail" (the levels that are at most TailDimension pixels)
+            is uploaded, and so loading is fast and cheap no matter how big the texture is
+        * While rendering, every draw call reports how big (in pixels) its texture appears on the screen,
+            and each texture's desired MIP level is the most detailed one that any draw call needs
+        * Once per frame the desired levels are fit into a global memory budget
+            (if they don't fit, the textures whose most detailed level is largest are made less detailed first)
+        * More detailed levels are read from disk on a worker thread
+            (which with OpenGL also copies them into the upload staging buffer when there is room)
+            and uploaded on the render thread when they are ready;
+            less detailed levels are dropped as soon as they aren't needed
+        * A texture that isn't drawn for a while is reduced back to its MIP tail
+*/
+
+#ifndef EAE6320_GRAPHICS_TEXTURESTREAMING_H
+#define EAE6320_GRAPHICS_TEXTURESTREAMING_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+    namespace Graphics
+    {
+        class cTexture;
+
+        namespace TextureFormats
+        {
+            struct sTextureInfo;
+        }
+    }
+}
+
+// Interface
+//==========
+
+namespace eae6320
+{
+    namespace Graphics
+    {
+        namespace TextureStreaming
+        {
+            // MIP levels this size or smaller are always resident
+            constexpr uint16_t TailDimension = 64;
+            constexpr size_t DefaultBudget_inBytes = 128 * 1024 * 1024;
+
+            // This returns a mask with a bit set for each MIP level that can be a texture's most detailed resident level
+            // (block-compressed textures can only start at a level whose dimensions are multiples of 4;
+            // level 0 is always included)
+            uint32_t GetValidMostDetailedMipLevels( const TextureFormats::sTextureInfo& i_info );
+            // This returns the most detailed MIP level that is uploaded when a texture is loaded
+            // (it must be a valid most detailed level, and so a tail level may be larger than TailDimension)
+            uint8_t GetTailMipLevel( const TextureFormats::sTextureInfo& i_info );
+
+            // Render Thread
+            //--------------
+
+            // This is called for every draw call that uses the texture;
+            // the size is how many pixels the texture spans on the screen
+            void RequestScreenSize( const cTexture& i_texture, const float i_screenSize_inPixels );
+            // This is called once per frame after everything has been drawn:
+            // levels that finished loading are uploaded, and new loads are started
+            void Update();
+
+            // The budget only covers textures that are registered (i.e. that have levels more detailed than their tail),
+            // and it includes their MIP tails, which can never be dropped;
+            // textures that fit entirely in their tail are always resident and aren't counted
+            void SetBudget( const size_t i_budget_inBytes );
+            size_t GetResidentByteCount();
+
+            // Textures
+            //---------
+
+            // Textures that have more detailed MIP levels than their tail register themselves when they are loaded
+            void Register( cTexture& io_texture );
+            void Unregister( const cTexture& i_texture );
+
+            // Initialization / Clean Up
+            //--------------------------
+
+            cResult Initialize( const size_t i_budget_inBytes = DefaultBudget_inBytes );
+            cResult CleanUp();
+        }
+    }
+}
+
+#endif	// EAE6320_GRAPHICS_TEXTURESTREAMING_H
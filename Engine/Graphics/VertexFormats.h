@@ -11,6 +11,8 @@
 
 #include "Configuration.h"
 
+#include <cstdint>
+
 // Vertex Formats
 //===============
 
@@ -52,6 +54,30 @@ namespace eae6320
                 uint8_t r, g, b, a;
 
             }; // struct sMesh
+
+            // This is a compact alternative to sMesh that a mesh can be built with
+            // (see MeshFormats::VertexEncodings)
+            struct sMeshQuantized
+            {
+                // POSITION
+                // 4 16-bit normalized ints == 8 bytes
+                // Offset = 0
+                // The position is relative to the mesh's bounding box
+                // and must be dequantized with the values in the mesh file's header
+                // (the fourth value is unused, and is only there because GPUs don't support three 16-bit values)
+                uint16_t x, y, z, w;
+
+                // TEXCOORD0
+                // 2 16-bit floats == 4 bytes
+                // Offset = 8
+                uint16_t u, v;
+
+                // COLOR0
+                // 4 8-bit ints == 4 bytes
+                // Offset = 12
+                uint8_t r, g, b, a;
+
+            }; // struct sMeshQuantized
         }
     }
 }
@@ -5,12 +5,113 @@
 
 #include "ConstantBufferFormats.h"
 
+#include <algorithm>
+#include <cstring>
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Logging/Logging.h>
 
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// Changed data is found (and uploaded) in float4-sized pieces
+	// (which is how shaders pack constants)
+	constexpr size_t s_comparisonSize = 16;
+}
+
 // Interface
 //==========
 
+// Render
+//-------
+
+void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
+{
+	constexpr size_t updateEverything = 0;
+	Update( i_data, updateEverything, m_size );
+}
+
+void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data, const size_t i_offset, const size_t i_size )
+{
+	EAE6320_ASSERT( i_data );
+	EAE6320_ASSERT( ( i_size > 0 ) && ( ( i_offset + i_size ) <= m_size ) );
+	EAE6320_ASSERT( m_shadowCopy.size() == m_size );
+
+	const auto* const newData = static_cast<const uint8_t*>( i_data );
+	auto* const shadowCopy = m_shadowCopy.data();
+	++m_statistics.updateCount;
+
+	// Find the part of the range that has changed
+	auto offset_begin = i_offset;
+	auto offset_end = i_offset + i_size;
+	if ( m_isShadowCopyValid )
+	{
+		// The common case is that nothing has changed
+		if ( memcmp( newData + offset_begin, shadowCopy + offset_begin, i_size ) == 0 )
+		{
+			++m_statistics.skippedUpdateCount;
+			m_statistics.byteCount_saved += i_size;
+			return;
+		}
+		offset_begin -= offset_begin % s_comparisonSize;
+		offset_end = std::min( offset_end + ( ( s_comparisonSize - ( offset_end % s_comparisonSize ) ) % s_comparisonSize ), m_size );
+		while ( memcmp( newData + offset_begin, shadowCopy + offset_begin, std::min( s_comparisonSize, offset_end - offset_begin ) ) == 0 )
+		{
+			offset_begin += s_comparisonSize;
+		}
+		while ( true )
+		{
+			const auto offset_lastPiece = ( offset_end - 1 ) - ( ( offset_end - 1 ) % s_comparisonSize );
+			if ( memcmp( newData + offset_lastPiece, shadowCopy + offset_lastPiece, offset_end - offset_lastPiece ) != 0 )
+			{
+				break;
+			}
+			offset_end = offset_lastPiece;
+		}
+	}
+	else
+	{
+		// The GPU doesn't have any data yet,
+		// and so the entire buffer is uploaded
+		// (which is why the caller must always pass the entire struct)
+		offset_begin = 0;
+		offset_end = m_size;
+	}
+	EAE6320_ASSERT( offset_begin < offset_end );
+
+	// Copy the changed data to the GPU
+	{
+		const auto size = offset_end - offset_begin;
+		memcpy( shadowCopy + offset_begin, newData + offset_begin, size );
+		m_isShadowCopyValid = true;
+		const auto byteCount_uploaded = Update_platformSpecific( offset_begin, size );
+		m_statistics.byteCount_uploaded += byteCount_uploaded;
+		if ( byteCount_uploaded < i_size )
+		{
+			m_statistics.byteCount_saved += i_size - byteCount_uploaded;
+		}
+	}
+}
+
+// Statistics
+//-----------
+
+void eae6320::Graphics::cConstantBuffer::OutputStatisticsToLog() const
+{
+	const char* typeName = "unknown";
+	switch ( m_type )
+	{
+		case ConstantBufferTypes::PerFrame: typeName = "per-frame"; break;
+		case ConstantBufferTypes::PerMaterial: typeName = "per-material"; break;
+		case ConstantBufferTypes::PerDrawCall: typeName = "per-draw-call"; break;
+		default: break;
+	}
+	Logging::OutputMessage( "The %s constant buffer was updated %u times (%u were skipped because nothing had changed):"
+		" %llu bytes were uploaded and %llu bytes were saved",
+		typeName, m_statistics.updateCount, m_statistics.skippedUpdateCount, m_statistics.byteCount_uploaded, m_statistics.byteCount_saved );
+}
+
 // Initialization / Clean Up
 //--------------------------
 
@@ -38,6 +139,15 @@ eae6320::cResult eae6320::Graphics::cConstantBuffer::Initialize( const void* con
 			}
 			EAE6320_ASSERT( m_size > 0 );
 		}
+		// Allocate the copy of the GPU's data
+		{
+			m_shadowCopy.resize( m_size );
+			if ( i_initialData )
+			{
+				memcpy( m_shadowCopy.data(), i_initialData, m_size );
+			}
+			m_isShadowCopyValid = i_initialData != nullptr;
+		}
 		// Initialize the platform-specific constant buffer
 		{
 			result = Initialize_platformSpecific( i_initialData );
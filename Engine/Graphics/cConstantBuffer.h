@@ -13,6 +13,10 @@
 		* The constant data is calculated and handled just like any other C++ data in the application,
 			but in order for it to be used in a draw call
 			it must use a constant buffer object to be available to the shader programs running on the GPU
+
+	A constant buffer keeps a copy of the data that the GPU has,
+	and so updating it with data that hasn't changed doesn't upload anything
+	(and only the part of the data that has changed is uploaded when the platform allows it).
 */
 
 #ifndef EAE6320_GRAPHICS_CCONSTANTBUFFER_H
@@ -23,8 +27,10 @@
 
 #include "Configuration.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <Engine/Results/Results.h>
+#include <vector>
 
 #ifdef EAE6320_PLATFORM_GL
 	#include "OpenGL/Includes.h"
@@ -102,8 +108,28 @@ namespace eae6320
 
 			// Copies the specified CPU data to the GPU memory associated with the constant buffer.
 			// The specified data must be the appropriate Graphics::ConstantBufferFormats struct corresponding to this constant buffer's type!
-			// This function only needs to be called when the constant data that the GPU is using needs to change.
+			// This function only needs to be called when the constant data that the GPU is using needs to change
+			// (if the data is the same as the last data nothing is uploaded).
 			void Update( const void* const i_data );
+			// This only compares and uploads the bytes in the range
+			// (the data must still be the entire struct, not just the range).
+			// This can be used when the caller knows that nothing outside of the range has changed.
+			void Update( const void* const i_data, const size_t i_offset, const size_t i_size );
+
+			// Statistics
+			//-----------
+
+			struct sStatistics
+			{
+				size_t updateCount = 0;
+				// The number of updates that didn't change anything and so weren't uploaded
+				size_t skippedUpdateCount = 0;
+				uint64_t byteCount_uploaded = 0;
+				// The number of bytes that were passed to Update() but didn't have to be uploaded
+				uint64_t byteCount_saved = 0;
+			};
+			const sStatistics& GetStatistics() const { return m_statistics; }
+			void OutputStatisticsToLog() const;
 
 			// Initialization / Clean Up
 			//--------------------------
@@ -122,6 +148,11 @@ namespace eae6320
 			// The size of the constant data associated with this constant buffer.
 			// It is calculated internally as sizeof( Graphics::ConstantBufferFormats::[m_type] )
 			size_t m_size = 0;
+			// This is the data that the GPU has
+			// (it is only valid once the GPU has been given data for the entire buffer)
+			std::vector<uint8_t> m_shadowCopy;
+			bool m_isShadowCopyValid = false;
+			sStatistics m_statistics;
 
 #if defined( EAE6320_PLATFORM_D3D )
 			ID3D11Buffer* m_buffer = nullptr;
@@ -143,6 +174,14 @@ namespace eae6320
 
 			cResult Initialize_platformSpecific( const void* const i_initialData );
 
+			// Render
+			//-------
+
+			// The range of the shadow copy is copied to the GPU;
+			// this returns the number of bytes that were actually uploaded
+			// (which can be more than the range if the platform can't update part of a buffer)
+			size_t Update_platformSpecific( const size_t i_offset, const size_t i_size );
+
 			cConstantBuffer( const cConstantBuffer& i_instanceToBeCopied ) = delete;
 			cConstantBuffer& operator =( const cConstantBuffer& i_instanceToBeCopied ) = delete;
 			cConstantBuffer( cConstantBuffer&& i_instanceToBeMoved ) = delete;
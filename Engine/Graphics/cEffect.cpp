@@ -6,6 +6,13 @@
 #include <Engine/Logging/Logging.h>
 
 #include <new>
+#include <sstream>
+#include <string>
+
+// Static Data Initialization
+//===========================
+
+eae6320::Assets::cManager<eae6320::Graphics::cEffect> eae6320::Graphics::cEffect::s_manager;
 
 // Interface
 //==========
@@ -23,7 +30,19 @@ void eae6320::Graphics::cEffect::Bind() const
 // Initialization / Clean Up
 //--------------------------
 
-eae6320::cResult eae6320::Graphics::cEffect::Create(cEffect*& o_effect, const char* i_vertexShaderName, const char* i_fragmentShaderName, uint8_t i_renderStateBits)
+eae6320::cResult eae6320::Graphics::cEffect::Load(Handle& o_effect, const char* i_vertexShaderName, const char* i_fragmentShaderName, uint8_t i_renderStateBits)
+{
+    // The key is also what the manager's inventory shows for the effect
+    std::string key;
+    {
+        std::ostringstream keyStream;
+        keyStream << i_vertexShaderName << " | " << i_fragmentShaderName << " | render state " << static_cast<unsigned int>(i_renderStateBits);
+        key = keyStream.str();
+    }
+    return s_manager.Load(key.c_str(), o_effect, i_vertexShaderName, i_fragmentShaderName, i_renderStateBits);
+}
+
+eae6320::cResult eae6320::Graphics::cEffect::Load(const char* i_key, cEffect*& o_effect, const char* i_vertexShaderName, const char* i_fragmentShaderName, uint8_t i_renderStateBits)
 {
     auto result = eae6320::Results::Success;
 
@@ -45,6 +64,7 @@ eae6320::cResult eae6320::Graphics::cEffect::Create(cEffect*& o_effect, const ch
     if (!(result = newEffect->Initialize(i_vertexShaderName, i_fragmentShaderName, i_renderStateBits)))
     {
         EAE6320_ASSERTF(false, "Failed to initialize the new effect!");
+        Logging::OutputError("Failed to initialize the effect \"%s\"", i_key);
         goto OnExit;
     }
 
@@ -1,5 +1,11 @@
 /*
-    TODO
+    An effect is the combination of the shaders and render state that are bound to draw something
+
+    Many objects draw with the same shaders and render state,
+    and so effects are shared:
+    an effect's manager uses a key made from its shaders and render state bits
+    so that every load request with the same combination gets the same effect
+    (and only one program and one set of render state objects is created for it)
 */
 
 #ifndef EAE6320_GRAPHICS_CEFFECT_H
@@ -11,7 +17,10 @@
 #include "cRenderState.h"
 #include "cShader.h"
     
+#include <Engine/Assets/cHandle.h>
+#include <Engine/Assets/cManager.h>
 #include <Engine/Assets/ReferenceCountedAssets.h>
+#include <Engine/Memory/PooledAllocation.h>
 #include <Engine/Results/Results.h>
 
 #ifdef EAE6320_PLATFORM_GL
@@ -37,10 +46,19 @@ namespace eae6320
 
             void Bind() const;
 
+            // Assets
+            //-------
+
+            using Handle = Assets::cHandle<cEffect>;
+            static Assets::cManager<cEffect> s_manager;
+
             // Initialization / Clean Up
             //--------------------------
 
-            static cResult Create(cEffect*& o_effect, const char* i_vertexShaderName, const char* i_fragmentShaderName, uint8_t i_renderStateBits);
+            // Every handle returned from a successful call must be passed to s_manager.Release()
+            static cResult Load(Handle& o_effect, const char* i_vertexShaderName, const char* i_fragmentShaderName, uint8_t i_renderStateBits);
+            // This is called by the manager when no effect with the key has been loaded yet
+            static cResult Load(const char* i_key, cEffect*& o_effect, const char* i_vertexShaderName, const char* i_fragmentShaderName, uint8_t i_renderStateBits);
 
         public:
 
@@ -51,6 +69,11 @@ namespace eae6320
 
             EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS(cEffect);
 
+            // Memory Allocation
+            //------------------
+
+            EAE6320_MEMORY_DECLAREPOOLEDALLOCATION(cEffect);
+
             // Data
             //=====
 
@@ -0,0 +1,247 @@
+// Include Files
+//==============
+
+#include "cGeometryPool.h"
+
+#include <algorithm>
+#include <Engine/Asserts/Asserts.h>
+#include <iterator>
+
+// Static Data Initialization
+//===========================
+
+eae6320::Graphics::cGeometryPool eae6320::Graphics::cGeometryPool::s_pools[MeshFormats::VertexEncodings::Unknown][MeshFormats::IndexFormats::Unknown];
+const eae6320::Graphics::cGeometryPool* eae6320::Graphics::cGeometryPool::s_boundPool = nullptr;
+
+namespace
+{
+    // A pool's buffers are never smaller than this
+    // (so that loading a lot of small meshes doesn't grow them over and over)
+    constexpr uint32_t s_minimumVertexCapacity = 64 * 1024;
+    constexpr uint32_t s_minimumIndexCapacity = 256 * 1024;
+
+    // The capacity at least doubles so that the existing data is copied fewer times
+    uint32_t CalculateGrownCapacity(const uint32_t i_capacity, const uint32_t i_countThatMustFit, const uint32_t i_minimumCapacity);
+}
+
+// Interface
+//==========
+
+// Access
+//-------
+
+eae6320::Graphics::cGeometryPool& eae6320::Graphics::cGeometryPool::Get(const MeshFormats::VertexEncodings::eType i_vertexEncoding,
+    const MeshFormats::IndexFormats::eType i_indexFormat)
+{
+    EAE6320_ASSERT((i_vertexEncoding < MeshFormats::VertexEncodings::Unknown) && (i_indexFormat < MeshFormats::IndexFormats::Unknown));
+    auto& pool = s_pools[i_vertexEncoding][i_indexFormat];
+    pool.m_vertexEncoding = i_vertexEncoding;
+    pool.m_indexFormat = i_indexFormat;
+    return pool;
+}
+
+// Allocation
+//-----------
+
+eae6320::cResult eae6320::Graphics::cGeometryPool::Allocate(const uint32_t i_vertexCount, const void* const i_vertexData,
+    const uint32_t i_indexCount, const void* const i_indices, sAllocation& o_allocation)
+{
+    auto result = Results::Success;
+
+    EAE6320_ASSERT((i_vertexCount > 0) && (i_indexCount > 0));
+    o_allocation = sAllocation();
+
+    sAllocation allocation;
+    allocation.pool = this;
+    allocation.vertexCount = i_vertexCount;
+    allocation.indexCount = i_indexCount;
+
+    // Find room for the mesh
+    {
+        const auto doVerticesFit = m_freeVertices.Allocate(i_vertexCount, allocation.firstVertex);
+        const auto doIndicesFit = m_freeIndices.Allocate(i_indexCount, allocation.firstIndex);
+        if (!doVerticesFit || !doIndicesFit)
+        {
+            // Any range that was found is given back
+            // so that it can be merged with the new space at the end of the grown buffers
+            if (doVerticesFit)
+            {
+                m_freeVertices.Free(allocation.firstVertex, i_vertexCount);
+            }
+            if (doIndicesFit)
+            {
+                m_freeIndices.Free(allocation.firstIndex, i_indexCount);
+            }
+            const auto vertexCapacity_old = m_vertexCapacity;
+            const auto indexCapacity_old = m_indexCapacity;
+            const auto vertexCapacity_new = doVerticesFit ? vertexCapacity_old
+                : CalculateGrownCapacity(vertexCapacity_old, i_vertexCount, s_minimumVertexCapacity);
+            const auto indexCapacity_new = doIndicesFit ? indexCapacity_old
+                : CalculateGrownCapacity(indexCapacity_old, i_indexCount, s_minimumIndexCapacity);
+            if (!(result = Grow(vertexCapacity_new, indexCapacity_new)))
+            {
+                EAE6320_ASSERTF(false, "The geometry pool couldn't grow");
+                goto OnExit;
+            }
+            m_vertexCapacity = vertexCapacity_new;
+            m_indexCapacity = indexCapacity_new;
+            if (vertexCapacity_new > vertexCapacity_old)
+            {
+                m_freeVertices.Free(vertexCapacity_old, vertexCapacity_new - vertexCapacity_old);
+            }
+            if (indexCapacity_new > indexCapacity_old)
+            {
+                m_freeIndices.Free(indexCapacity_old, indexCapacity_new - indexCapacity_old);
+            }
+            // The new space at the end is always big enough
+            {
+                const auto doVerticesFit = m_freeVertices.Allocate(i_vertexCount, allocation.firstVertex);
+                const auto doIndicesFit = m_freeIndices.Allocate(i_indexCount, allocation.firstIndex);
+                EAE6320_ASSERT(doVerticesFit && doIndicesFit);
+            }
+        }
+    }
+    // Copy the mesh's data into its ranges
+    if (!(result = Upload(allocation, i_vertexData, i_indices)))
+    {
+        m_freeVertices.Free(allocation.firstVertex, i_vertexCount);
+        m_freeIndices.Free(allocation.firstIndex, i_indexCount);
+        goto OnExit;
+    }
+
+    ++m_allocationCount;
+    o_allocation = allocation;
+
+OnExit:
+
+    return result;
+}
+
+void eae6320::Graphics::cGeometryPool::Free(sAllocation& io_allocation)
+{
+    EAE6320_ASSERT(io_allocation.pool == this);
+    EAE6320_ASSERT(m_allocationCount > 0);
+
+    // The GPU might still be drawing from the ranges,
+    // but any new data that is uploaded to them is ordered after those draws
+    m_freeVertices.Free(io_allocation.firstVertex, io_allocation.vertexCount);
+    m_freeIndices.Free(io_allocation.firstIndex, io_allocation.indexCount);
+    --m_allocationCount;
+
+    io_allocation = sAllocation();
+}
+
+// Render
+//-------
+
+void eae6320::Graphics::cGeometryPool::ForgetBoundPool()
+{
+    // The batch's draws need the vertex data that is still bound
+    SubmitBatch();
+    s_boundPool = nullptr;
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Graphics::cGeometryPool::CleanUpAll()
+{
+    auto result = Results::Success;
+
+    for (auto& poolsWithTheSameEncoding : s_pools)
+    {
+        for (auto& pool : poolsWithTheSameEncoding)
+        {
+            EAE6320_ASSERTF(pool.m_allocationCount == 0, "A geometry pool is being cleaned up while meshes are still using it");
+            const auto localResult = pool.CleanUp();
+            if (!localResult)
+            {
+                EAE6320_ASSERT(false);
+                if (result)
+                {
+                    result = localResult;
+                }
+            }
+            pool.m_vertexCapacity = 0;
+            pool.m_indexCapacity = 0;
+            pool.m_freeVertices.countsByFirst.clear();
+            pool.m_freeIndices.countsByFirst.clear();
+            pool.m_allocationCount = 0;
+        }
+    }
+    s_boundPool = nullptr;
+
+    return result;
+}
+
+// Implementation
+//===============
+
+bool eae6320::Graphics::cGeometryPool::sFreeRanges::Allocate(const uint32_t i_count, uint32_t& o_first)
+{
+    // The first range that is big enough is used
+    for (auto i = countsByFirst.begin(); i != countsByFirst.end(); ++i)
+    {
+        if (i->second >= i_count)
+        {
+            o_first = i->first;
+            const auto remainingCount = i->second - i_count;
+            countsByFirst.erase(i);
+            if (remainingCount > 0)
+            {
+                countsByFirst.emplace(o_first + i_count, remainingCount);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void eae6320::Graphics::cGeometryPool::sFreeRanges::Free(const uint32_t i_first, const uint32_t i_count)
+{
+    EAE6320_ASSERT(i_count > 0);
+    auto first = i_first;
+    auto count = i_count;
+    // Merge with the following range
+    {
+        const auto next = countsByFirst.find(first + count);
+        if (next != countsByFirst.end())
+        {
+            count += next->second;
+            countsByFirst.erase(next);
+        }
+    }
+    // Merge with the preceding range
+    {
+        auto next = countsByFirst.lower_bound(first);
+        EAE6320_ASSERTF((next == countsByFirst.end()) || (next->first > first), "A range was freed twice");
+        if (next != countsByFirst.begin())
+        {
+            const auto previous = std::prev(next);
+            EAE6320_ASSERTF((previous->first + previous->second) <= first, "A range was freed twice");
+            if ((previous->first + previous->second) == first)
+            {
+                first = previous->first;
+                count += previous->second;
+                countsByFirst.erase(previous);
+            }
+        }
+    }
+    countsByFirst.emplace(first, count);
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+    uint32_t CalculateGrownCapacity(const uint32_t i_capacity, const uint32_t i_countThatMustFit, const uint32_t i_minimumCapacity)
+    {
+        // The count is added rather than compared so that the new space at the end is big enough by itself
+        // (even if the existing free space at the end isn't merged with it)
+        const auto requiredCapacity = uint64_t(i_capacity) + i_countThatMustFit;
+        const auto grownCapacity = std::max(std::max(uint64_t(i_capacity) * 2, requiredCapacity), uint64_t(i_minimumCapacity));
+        EAE6320_ASSERTF(grownCapacity <= UINT32_MAX, "A geometry pool can't be that big");
+        return static_cast<uint32_t>(std::min(grownCapacity, uint64_t(UINT32_MAX)));
+    }
+}
@@ -0,0 +1,185 @@
+/*
+    A geometry pool holds the vertices and indices of every mesh that has the same vertex encoding and index format
+    in a single vertex buffer and a single index buffer:
+        * Each mesh is given a range of vertices and a range of indices in the pool's buffers,
+            and its indices are relative to its first vertex (which is passed to the GPU as a base vertex)
+        * The buffers grow (by copying on the GPU) when a new mesh doesn't fit,
+            and ranges that are freed are reused by later meshes
+        * Switching between meshes in the same pool doesn't require binding any vertex data,
+            and the visible clusters of a mesh are drawn with a single indirect multi-draw call
+        * With OpenGL draws are collected into a batch instead of being submitted immediately,
+            and every draw in the batch (i.e. consecutive meshes that use the same pool, effect, and textures)
+            is submitted with a single indirect multi-draw call:
+            each mesh's per-draw-call data is written to a per-instance vertex stream
+            and its draw commands use its index in that stream as their base instance
+*/
+
+#ifndef EAE6320_GRAPHICS_CGEOMETRYPOOL_H
+#define EAE6320_GRAPHICS_CGEOMETRYPOOL_H
+
+// Include Files
+//==============
+
+#include "ConstantBufferFormats.h"
+#include "MeshFormats.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+#include <map>
+
+#ifdef EAE6320_PLATFORM_GL
+#include "OpenGL/Includes.h"
+#endif
+
+// Forward Declarations
+//=====================
+
+#ifdef EAE6320_PLATFORM_D3D
+struct ID3D11Buffer;
+struct ID3D11InputLayout;
+#endif
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+    namespace Graphics
+    {
+        class cGeometryPool
+        {
+            // Interface
+            //==========
+
+        public:
+
+            // A contiguous part of a mesh's indices
+            // (the offset is relative to the mesh's first index)
+            struct sIndexRange
+            {
+                uint32_t indexOffset;
+                uint32_t indexCount;
+            };
+
+            // The part of a pool that a single mesh uses
+            struct sAllocation
+            {
+                cGeometryPool* pool = nullptr;
+                uint32_t firstVertex = 0;
+                uint32_t vertexCount = 0;
+                uint32_t firstIndex = 0;
+                uint32_t indexCount = 0;
+
+                bool IsValid() const { return pool != nullptr; }
+            };
+
+            // Access
+            //-------
+
+            static cGeometryPool& Get(const MeshFormats::VertexEncodings::eType i_vertexEncoding, const MeshFormats::IndexFormats::eType i_indexFormat);
+
+            // Allocation
+            //-----------
+
+            // The vertices must be in the pool's encoding and the indices in the pool's format
+            cResult Allocate(const uint32_t i_vertexCount, const void* const i_vertexData, const uint32_t i_indexCount, const void* const i_indices,
+                sAllocation& o_allocation);
+            void Free(sAllocation& io_allocation);
+
+            // Render
+            //-------
+
+            // The pool's buffers are only bound if a different pool (or nothing) was bound before.
+            // If mesh draws are batched (see EAE6320_GRAPHICS_AREMESHDRAWSBATCHED in Configuration.h)
+            // the draw is added to the current batch and the vertex shader reads the draw data from the per-instance vertex stream;
+            // otherwise it is submitted immediately and the draw data must already be in the per-draw-call constant buffer
+            void Draw(const sAllocation& i_allocation, const sIndexRange* const i_indexRanges, const size_t i_indexRangeCount,
+                const ConstantBufferFormats::sPerDrawCall& i_drawData);
+            // The current batch must be submitted before anything that its draws use changes
+            // (e.g. before a different effect or texture array is bound) and before the frame ends
+            // (a draw with a different pool submits the batch automatically)
+            static void SubmitBatch();
+            // This must be called by anything else that binds vertex data
+            // so that the next pool that draws knows to bind its buffers again
+            // (the current batch is submitted first)
+            static void ForgetBoundPool();
+
+            // Initialization / Clean Up
+            //--------------------------
+
+            // Every mesh must have been freed
+            static cResult CleanUpAll();
+
+            // Implementation
+            //===============
+
+        private:
+
+            cGeometryPool() = default;
+            cGeometryPool(const cGeometryPool&) = delete;
+            cGeometryPool& operator =(const cGeometryPool&) = delete;
+
+            // A free list of ranges that are sorted by their first element
+            // (neighboring free ranges are always merged into one)
+            struct sFreeRanges
+            {
+                std::map<uint32_t, uint32_t> countsByFirst;
+
+                // This returns false if no free range is big enough
+                bool Allocate(const uint32_t i_count, uint32_t& o_first);
+                void Free(const uint32_t i_first, const uint32_t i_count);
+            };
+
+            // Platform-Specific
+            //------------------
+
+            void Bind();
+            // The existing data is kept
+            cResult Grow(const uint32_t i_vertexCapacity, const uint32_t i_indexCapacity);
+            cResult Upload(const sAllocation& i_allocation, const void* const i_vertexData, const void* const i_indices);
+            cResult CleanUp();
+
+            // Data
+            //=====
+
+            MeshFormats::VertexEncodings::eType m_vertexEncoding = MeshFormats::VertexEncodings::Unknown;
+            MeshFormats::IndexFormats::eType m_indexFormat = MeshFormats::IndexFormats::Unknown;
+            uint32_t m_vertexCapacity = 0;
+            uint32_t m_indexCapacity = 0;
+            sFreeRanges m_freeVertices;
+            sFreeRanges m_freeIndices;
+            uint32_t m_allocationCount = 0;
+
+#if defined( EAE6320_PLATFORM_D3D )
+            ID3D11Buffer* m_vertexBuffer = nullptr;
+            ID3D11Buffer* m_indexBuffer = nullptr;
+            // The input layout only depends on the vertex encoding,
+            // and so every mesh in the pool shares it
+            ID3D11InputLayout* m_vertexInputLayout = nullptr;
+#elif defined( EAE6320_PLATFORM_GL )
+            GLuint m_vertexBufferId = 0;
+            GLuint m_indexBufferId = 0;
+            // The vertex array points at the pool's buffers,
+            // and so it has to be updated whenever they grow
+            GLuint m_vertexArrayId = 0;
+            // The draw commands of every batch are written one after another
+            // and the buffer is orphaned when it is full
+            // (this is only used if the driver supports glMultiDrawElementsIndirect())
+            GLuint m_indirectBufferId = 0;
+            uint32_t m_indirectCommandCapacity = 0;
+            uint32_t m_nextIndirectCommand = 0;
+            // The draw data of every batch is written one after another in the same way,
+            // and the vertex array reads it as per-instance attributes
+            GLuint m_drawDataBufferId = 0;
+            uint32_t m_drawDataCapacity = 0;
+            uint32_t m_nextDrawData = 0;
+#endif
+
+            static cGeometryPool s_pools[MeshFormats::VertexEncodings::Unknown][MeshFormats::IndexFormats::Unknown];
+            static const cGeometryPool* s_boundPool;
+        };
+    }
+}
+
+#endif  // EAE6320_GRAPHICS_CGEOMETRYPOOL_H
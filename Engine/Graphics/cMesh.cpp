@@ -6,13 +6,20 @@
 #include "VertexFormats.h"
 
 #include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/LoadStatistics.h>
+#include <Engine/Assets/Prefetch.h>
 #include <Engine/Graphics/sColor.h>
 #include <Engine/Logging/Logging.h>
+#include <Engine/Math/cMatrix_transformation.h>
 #include <Engine/Math/sVector.h>
 #include <Engine/Math/sVector2d.h>
 #include <Engine/Platform/Platform.h>
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <new>
+#include <xmmintrin.h>
 
 // Static Data Initialization
 //===========================
@@ -22,6 +29,117 @@ eae6320::Assets::cManager<eae6320::Graphics::cMesh> eae6320::Graphics::cMesh::s_
 // Interface
 //==========
 
+// Render
+//-------
+
+void eae6320::Graphics::cMesh::Draw(const ConstantBufferFormats::sPerDrawCall& i_drawData) const
+{
+    const sIndexRange indexRange = { 0, m_geometry.indexCount };
+    DrawIndexRanges(&indexRange, 1, i_drawData);
+}
+
+void eae6320::Graphics::cMesh::Draw(const Math::cMatrix_transformation& i_transform_localToProjected, const Math::sVector& i_cameraPosition_local,
+    const bool i_shouldCullBackFacingClusters, const ConstantBufferFormats::sPerDrawCall& i_drawData) const
+{
+    // Calculate the planes of the view frustum in the mesh's local space
+    // (a point is inside of a plane if dot(plane.xyz, point) + plane.w >= 0)
+    constexpr size_t planeCount = 6;
+    __m128 planeX[planeCount], planeY[planeCount], planeZ[planeCount], planeW[planeCount];
+    {
+        float rows[4][4];
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            i_transform_localToProjected.GetRow(i, rows[i]);
+        }
+        // The near plane is the one that GL uses (z >= -w);
+        // Direct3D's near plane (z >= 0) is slightly closer to the camera
+        // but using GL's plane only means that a few extra clusters are drawn
+        const float signs[planeCount] = { 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f };
+        const unsigned int rowIndices[planeCount] = { 0, 0, 1, 1, 2, 2 };
+        for (size_t i = 0; i < planeCount; ++i)
+        {
+            float plane[4];
+            for (size_t j = 0; j < 4; ++j)
+            {
+                plane[j] = rows[3][j] + (signs[i] * rows[rowIndices[i]][j]);
+            }
+            // The plane must be normalized so that the distance to a sphere's center can be compared with its radius
+            const auto length = std::sqrt((plane[0] * plane[0]) + (plane[1] * plane[1]) + (plane[2] * plane[2]));
+            const auto scale = (length > 0.0f) ? (1.0f / length) : 0.0f;
+            planeX[i] = _mm_set1_ps(plane[0] * scale);
+            planeY[i] = _mm_set1_ps(plane[1] * scale);
+            planeZ[i] = _mm_set1_ps(plane[2] * scale);
+            planeW[i] = _mm_set1_ps(plane[3] * scale);
+        }
+    }
+
+    // This is only called from the render thread,
+    // and so a single list can be reused every frame
+    static std::vector<sIndexRange> s_visibleIndexRanges;
+    s_visibleIndexRanges.clear();
+
+    // Four clusters are culled at once
+    const auto cameraX = _mm_set1_ps(i_cameraPosition_local.x);
+    const auto cameraY = _mm_set1_ps(i_cameraPosition_local.y);
+    const auto cameraZ = _mm_set1_ps(i_cameraPosition_local.z);
+    const auto clusterCount = m_clusterIndexRanges.size();
+    for (size_t i = 0; i < m_clusterBounds.size(); ++i)
+    {
+        const auto& bounds = m_clusterBounds[i];
+        const auto centerX = _mm_loadu_ps(bounds.boundingSphere_centerX);
+        const auto centerY = _mm_loadu_ps(bounds.boundingSphere_centerY);
+        const auto centerZ = _mm_loadu_ps(bounds.boundingSphere_centerZ);
+        const auto radius = _mm_loadu_ps(bounds.boundingSphere_radius);
+
+        // A cluster is outside of the view frustum if its bounding sphere is completely outside of any plane
+        const auto negativeRadius = _mm_sub_ps(_mm_setzero_ps(), radius);
+        auto isVisible = _mm_cmpeq_ps(radius, radius);
+        for (size_t j = 0; j < planeCount; ++j)
+        {
+            const auto distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[j], centerX), _mm_mul_ps(planeY[j], centerY)),
+                _mm_add_ps(_mm_mul_ps(planeZ[j], centerZ), planeW[j]));
+            isVisible = _mm_and_ps(isVisible, _mm_cmpge_ps(distance, negativeRadius));
+        }
+
+        // A cluster faces away from the camera if the camera is outside of its normal cone (see MeshFormats::sCluster)
+        if (i_shouldCullBackFacingClusters)
+        {
+            const auto offsetX = _mm_sub_ps(centerX, cameraX);
+            const auto offsetY = _mm_sub_ps(centerY, cameraY);
+            const auto offsetZ = _mm_sub_ps(centerZ, cameraZ);
+            const auto distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(offsetX, offsetX), _mm_mul_ps(offsetY, offsetY)), _mm_mul_ps(offsetZ, offsetZ)));
+            const auto projection = _mm_add_ps(_mm_add_ps(_mm_mul_ps(offsetX, _mm_loadu_ps(bounds.normalCone_axisX)),
+                _mm_mul_ps(offsetY, _mm_loadu_ps(bounds.normalCone_axisY))), _mm_mul_ps(offsetZ, _mm_loadu_ps(bounds.normalCone_axisZ)));
+            const auto isBackFacing = _mm_cmpgt_ps(projection, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(bounds.normalCone_cutoff), distance), radius));
+            isVisible = _mm_andnot_ps(isBackFacing, isVisible);
+        }
+
+        // Visible clusters that are next to each other in the index buffer are drawn as a single range
+        const auto visibilityMask = _mm_movemask_ps(isVisible);
+        for (size_t j = 0; (j < 4) && (((i * 4) + j) < clusterCount); ++j)
+        {
+            if (visibilityMask & (1 << j))
+            {
+                const auto& indexRange = m_clusterIndexRanges[(i * 4) + j];
+                if (!s_visibleIndexRanges.empty()
+                    && ((s_visibleIndexRanges.back().indexOffset + s_visibleIndexRanges.back().indexCount) == indexRange.indexOffset))
+                {
+                    s_visibleIndexRanges.back().indexCount += indexRange.indexCount;
+                }
+                else
+                {
+                    s_visibleIndexRanges.push_back(indexRange);
+                }
+            }
+        }
+    }
+
+    if (!s_visibleIndexRanges.empty())
+    {
+        DrawIndexRanges(s_visibleIndexRanges.data(), s_visibleIndexRanges.size(), i_drawData);
+    }
+}
+
 // Initialization / Clean Up
 //--------------------------
 
@@ -30,11 +148,16 @@ eae6320::cResult eae6320::Graphics::cMesh::Load(const char* const i_path, cMesh*
     auto result = Results::Success;
 
     Platform::sDataFromFile dataFromFile;
+    MeshFormats::sMeshInfo meshInfo{};
+    const void* vertexData = nullptr;
+    const void* indices = nullptr;
+    const MeshFormats::sCluster* clusters = nullptr;
+    cMesh* newMesh = nullptr;
 
     // Load the binary data
     {
         std::string errorMessage;
-        if (!(result = Platform::LoadBinaryFile(i_path, dataFromFile, &errorMessage)))
+        if (!(result = Assets::LoadBinaryFile(i_path, dataFromFile, &errorMessage)))
         {
             EAE6320_ASSERTF(false, errorMessage.c_str());
             Logging::OutputError("Failed to load mesh data from file %s: %s", i_path, errorMessage.c_str());
@@ -43,26 +166,111 @@ eae6320::cResult eae6320::Graphics::cMesh::Load(const char* const i_path, cMesh*
     }
 
     // Extract data from the file
-    auto currentOffset = reinterpret_cast<uintptr_t>(dataFromFile.data);
-    const auto finalOffset = currentOffset + dataFromFile.size;
-    EAE6320_ASSERT(finalOffset > currentOffset);
-
-    const uint16_t vertexCount = *(reinterpret_cast<uint16_t*>(currentOffset));
-    currentOffset += sizeof(uint16_t);
+    {
+        const auto* const fileData = static_cast<const uint8_t*>(dataFromFile.data);
+        const auto fileSize = static_cast<uint64_t>(dataFromFile.size);
 
-    VertexFormats::sMesh* vertexData = reinterpret_cast<VertexFormats::sMesh*>(currentOffset);
-    currentOffset += vertexCount * sizeof(VertexFormats::sMesh);
+        // Make sure that the file was built in the current format
+        // (this rejects files built in an older format instead of reading past the end of them)
+        MeshFormats::Container::sFileHeader fileHeader{};
+        if (fileSize >= sizeof(fileHeader))
+        {
+            fileHeader = *reinterpret_cast<const MeshFormats::Container::sFileHeader*>(fileData);
+        }
+        if ((fileSize < sizeof(fileHeader)) || (fileHeader.magic != MeshFormats::Container::FileMagic)
+            || (fileHeader.version != MeshFormats::Container::FileVersion))
+        {
+            result = Results::InvalidFile;
+            EAE6320_ASSERTF(false, "The mesh file %s isn't in the current format", i_path);
+            Logging::OutputError("The mesh file %s isn't in the current format (version %u is expected); it may need to be rebuilt",
+                i_path, MeshFormats::Container::FileVersion);
+            goto OnExit;
+        }
+        const auto sectionTableSize = uint64_t(fileHeader.sectionCount) * sizeof(MeshFormats::Container::sSectionInfo);
+        if ((sizeof(fileHeader) + sectionTableSize) > fileSize)
+        {
+            result = Results::InvalidFile;
+            EAE6320_ASSERTF(false, "The mesh file %s is too small for its section table", i_path);
+            Logging::OutputError("The mesh file %s is only %u bytes, but it has %u sections", i_path, dataFromFile.size, fileHeader.sectionCount);
+            goto OnExit;
+        }
 
-    uint16_t indexCount = *(reinterpret_cast<uint16_t*>(currentOffset));
-    currentOffset += sizeof(uint16_t);
+        // Find each section
+        // (the payloads aren't copied; the mesh is initialized directly from the loaded file)
+        const auto* const sectionTable = reinterpret_cast<const MeshFormats::Container::sSectionInfo*>(fileData + sizeof(fileHeader));
+        const MeshFormats::Container::sSectionInfo* infoSection = nullptr;
+        const MeshFormats::Container::sSectionInfo* vertexSection = nullptr;
+        const MeshFormats::Container::sSectionInfo* indexSection = nullptr;
+        const MeshFormats::Container::sSectionInfo* clusterSection = nullptr;
+        for (uint16_t i = 0; i < fileHeader.sectionCount; ++i)
+        {
+            const auto& section = sectionTable[i];
+            if (((uint64_t(section.offset) + section.size) > fileSize) || ((section.offset % MeshFormats::Container::PayloadAlignment) != 0))
+            {
+                result = Results::InvalidFile;
+                EAE6320_ASSERTF(false, "The mesh file %s has an invalid section", i_path);
+                Logging::OutputError("The mesh file %s is invalid (section %u of type %u is %u bytes at offset %u, but the file is %u bytes)",
+                    i_path, i, section.type, section.size, section.offset, dataFromFile.size);
+                goto OnExit;
+            }
+            switch (section.type)
+            {
+            case MeshFormats::Container::SectionTypes::Info: infoSection = &section; break;
+            case MeshFormats::Container::SectionTypes::Vertices: vertexSection = &section; break;
+            case MeshFormats::Container::SectionTypes::Indices: indexSection = &section; break;
+            case MeshFormats::Container::SectionTypes::Clusters: clusterSection = &section; break;
+            // Sections that this version of the engine doesn't know about are ignored
+            default: break;
+            }
+        }
+        if (!infoSection || (infoSection->size != sizeof(MeshFormats::sMeshInfo)) || !vertexSection || !indexSection)
+        {
+            result = Results::InvalidFile;
+            EAE6320_ASSERTF(false, "The mesh file %s is missing a required section", i_path);
+            Logging::OutputError("The mesh file %s is invalid (it must have an info, a vertex, and an index section)", i_path);
+            goto OnExit;
+        }
+        meshInfo = *reinterpret_cast<const MeshFormats::sMeshInfo*>(fileData + infoSection->offset);
 
-    uint16_t* indices = reinterpret_cast<uint16_t*>(currentOffset);
-    currentOffset += indexCount * sizeof(uint16_t);
+        // Make sure that each section is exactly as big as the info says it should be
+        const auto vertexSize = MeshFormats::VertexEncodings::GetSizeOfVertex(meshInfo.vertexEncoding);
+        const auto indexSize = MeshFormats::IndexFormats::GetSizeOfIndex(meshInfo.indexFormat);
+        const auto clusterSectionSize = clusterSection ? clusterSection->size : 0u;
+        if ((vertexSize == 0) || (indexSize == 0)
+            || (vertexSection->size != (uint64_t(meshInfo.vertexCount) * vertexSize))
+            || (indexSection->size != (uint64_t(meshInfo.indexCount) * indexSize))
+            || (clusterSectionSize != (uint64_t(meshInfo.clusterCount) * sizeof(MeshFormats::sCluster))))
+        {
+            result = Results::InvalidFile;
+            EAE6320_ASSERTF(false, "The mesh file %s is invalid", i_path);
+            Logging::OutputError("The mesh file %s is invalid (its sections don't match its description of %u vertices in encoding %u, %u indices in format %u,"
+                " and %u clusters); it may need to be rebuilt", i_path, meshInfo.vertexCount, meshInfo.vertexEncoding,
+                meshInfo.indexCount, meshInfo.indexFormat, meshInfo.clusterCount);
+            goto OnExit;
+        }
 
-    // Make sure we reached the end of the file
-    EAE6320_ASSERT(currentOffset == finalOffset);
+        vertexData = fileData + vertexSection->offset;
+        indices = fileData + indexSection->offset;
+        if (clusterSection)
+        {
+            clusters = reinterpret_cast<const MeshFormats::sCluster*>(fileData + clusterSection->offset);
+        }
 
-    cMesh* newMesh = nullptr;
+        // Make sure that every cluster only draws indices that the mesh has
+        // (otherwise drawing it would read another mesh's indices from the geometry pool)
+        for (uint32_t i = 0; i < meshInfo.clusterCount; ++i)
+        {
+            const auto& cluster = clusters[i];
+            if ((uint64_t(cluster.indexOffset) + cluster.indexCount) > meshInfo.indexCount)
+            {
+                result = Results::InvalidFile;
+                EAE6320_ASSERTF(false, "The mesh file %s is invalid", i_path);
+                Logging::OutputError("The mesh file %s is invalid (cluster %u uses %u indices starting at %u, but the mesh only has %u indices);"
+                    " it may need to be rebuilt", i_path, i, cluster.indexCount, cluster.indexOffset, meshInfo.indexCount);
+                goto OnExit;
+            }
+        }
+    }
 
     // Allocate a new mesh
     {
@@ -77,11 +285,19 @@ eae6320::cResult eae6320::Graphics::cMesh::Load(const char* const i_path, cMesh*
     }
 
     // Initialize the new mesh's geometry
-    if (!(result = newMesh->Initialize(vertexCount, vertexData, indexCount, indices)))
     {
-        EAE6320_ASSERTF(false, "Could not initialize the new mesh!");
-        goto OnExit;
+        Assets::cLoadPhaseTimer uploadTimer(Assets::LoadPhases::Upload);
+        if (!(result = newMesh->Initialize(meshInfo.vertexCount, vertexData, meshInfo.vertexEncoding, meshInfo.indexCount, indices, meshInfo.indexFormat)))
+        {
+            EAE6320_ASSERTF(false, "Could not initialize the new mesh!");
+            goto OnExit;
+        }
+        newMesh->m_positionDequantization = meshInfo.positionDequantization;
+        newMesh->InitializeClusters(clusters, meshInfo.clusterCount);
     }
+    Assets::AddResidentBytesToCurrentLoad((meshInfo.vertexCount * MeshFormats::VertexEncodings::GetSizeOfVertex(meshInfo.vertexEncoding))
+        + (meshInfo.indexCount * MeshFormats::IndexFormats::GetSizeOfIndex(meshInfo.indexFormat))
+        + (newMesh->m_clusterIndexRanges.size() * sizeof(sIndexRange)) + (newMesh->m_clusterBounds.size() * sizeof(sClusterBounds)));
 
 OnExit:
 
@@ -109,3 +325,96 @@ eae6320::Graphics::cMesh::~cMesh()
 {
     CleanUp();
 }
+
+// Implementation
+//===============
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Graphics::cMesh::Initialize(const uint32_t i_vertexCount, const void* i_vertexData, const MeshFormats::VertexEncodings::eType i_vertexEncoding,
+    const uint32_t i_indexCount, const void* i_indices, const MeshFormats::IndexFormats::eType i_indexFormat)
+{
+    EAE6320_ASSERT(MeshFormats::IndexFormats::GetSizeOfIndex(i_indexFormat) != 0);
+    EAE6320_ASSERT(MeshFormats::VertexEncodings::GetSizeOfVertex(i_vertexEncoding) != 0);
+
+    // Every mesh with the same vertex encoding and index format shares buffers
+    return cGeometryPool::Get(i_vertexEncoding, i_indexFormat).Allocate(i_vertexCount, i_vertexData, i_indexCount, i_indices, m_geometry);
+}
+
+eae6320::cResult eae6320::Graphics::cMesh::CleanUp()
+{
+    if (m_geometry.IsValid())
+    {
+        m_geometry.pool->Free(m_geometry);
+    }
+
+    return Results::Success;
+}
+
+void eae6320::Graphics::cMesh::InitializeClusters(const MeshFormats::sCluster* i_clusters, const uint32_t i_clusterCount)
+{
+    m_clusterIndexRanges.resize(i_clusterCount);
+    // Any unused clusters in the last group of four are never drawn
+    m_clusterBounds.assign((i_clusterCount + 3) / 4, sClusterBounds{});
+
+    // The clusters are stored one after another in the file,
+    // but they are split into separate arrays so that culling can test four at a time
+    for (uint32_t i = 0; i < i_clusterCount; ++i)
+    {
+        const auto& cluster = i_clusters[i];
+        EAE6320_ASSERT((uint64_t(cluster.indexOffset) + cluster.indexCount) <= m_geometry.indexCount);
+
+        m_clusterIndexRanges[i] = { cluster.indexOffset, cluster.indexCount };
+
+        auto& bounds = m_clusterBounds[i / 4];
+        const auto j = i % 4;
+        bounds.boundingSphere_centerX[j] = cluster.boundingSphere_center[0];
+        bounds.boundingSphere_centerY[j] = cluster.boundingSphere_center[1];
+        bounds.boundingSphere_centerZ[j] = cluster.boundingSphere_center[2];
+        bounds.boundingSphere_radius[j] = cluster.boundingSphere_radius;
+        bounds.normalCone_axisX[j] = cluster.normalCone_axis[0];
+        bounds.normalCone_axisY[j] = cluster.normalCone_axis[1];
+        bounds.normalCone_axisZ[j] = cluster.normalCone_axis[2];
+        bounds.normalCone_cutoff[j] = cluster.normalCone_cutoff;
+    }
+
+    // The bounding sphere of the whole mesh is centered on the box around the clusters' spheres
+    // (it isn't the smallest possible sphere, but it only has to be good enough to estimate how big the mesh is on the screen)
+    if (i_clusterCount > 0)
+    {
+        float minimum[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, maximum[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (uint32_t i = 0; i < i_clusterCount; ++i)
+        {
+            const auto& cluster = i_clusters[i];
+            for (size_t k = 0; k < 3; ++k)
+            {
+                minimum[k] = std::min(minimum[k], cluster.boundingSphere_center[k] - cluster.boundingSphere_radius);
+                maximum[k] = std::max(maximum[k], cluster.boundingSphere_center[k] + cluster.boundingSphere_radius);
+            }
+        }
+        for (size_t k = 0; k < 3; ++k)
+        {
+            m_boundingSphere_center[k] = (minimum[k] + maximum[k]) * 0.5f;
+        }
+        m_boundingSphere_radius = 0.0f;
+        for (uint32_t i = 0; i < i_clusterCount; ++i)
+        {
+            const auto& cluster = i_clusters[i];
+            const auto x = cluster.boundingSphere_center[0] - m_boundingSphere_center[0];
+            const auto y = cluster.boundingSphere_center[1] - m_boundingSphere_center[1];
+            const auto z = cluster.boundingSphere_center[2] - m_boundingSphere_center[2];
+            m_boundingSphere_radius = std::max(m_boundingSphere_radius, std::sqrt((x * x) + (y * y) + (z * z)) + cluster.boundingSphere_radius);
+        }
+    }
+}
+
+// Render
+//-------
+
+void eae6320::Graphics::cMesh::DrawIndexRanges(const sIndexRange* i_indexRanges, const size_t i_indexRangeCount,
+    const ConstantBufferFormats::sPerDrawCall& i_drawData) const
+{
+    EAE6320_ASSERT(m_geometry.IsValid());
+    m_geometry.pool->Draw(m_geometry, i_indexRanges, i_indexRangeCount, i_drawData);
+}
@@ -8,23 +8,20 @@
 // Include Files
 //==============
 
+#include "cGeometryPool.h"
+#include "ConstantBufferFormats.h"
+#include "MeshFormats.h"
+
 #include <Engine/Assets/cHandle.h>
 #include <Engine/Assets/cManager.h>
 #include <Engine/Assets/ReferenceCountedAssets.h>
+#include <Engine/Memory/PooledAllocation.h>
 #include <Engine/Results/Results.h>
-
-#ifdef EAE6320_PLATFORM_GL
-#include "OpenGL/Includes.h"
-#endif
+#include <vector>
 
 // Forward Declarations
 //=====================
 
-#ifdef EAE6320_PLATFORM_D3D
-struct ID3D11Buffer;
-struct ID3D11InputLayout;
-#endif
-
 namespace eae6320
 {
     namespace Graphics
@@ -38,6 +35,7 @@ namespace eae6320
 
     namespace Math
     {
+        class cMatrix_transformation;
         struct sVector;
         struct sVector2d;
     }
@@ -60,11 +58,24 @@ namespace eae6320
             // Render
             //-------
 
-            void Draw() const;
+            // The draw data is only used if mesh draws are batched
+            // (otherwise it must already be in the per-draw-call constant buffer)
+            void Draw(const ConstantBufferFormats::sPerDrawCall& i_drawData) const;
+            // Only the clusters that are inside of the view frustum
+            // (and, if back faces are culled, that have triangles facing the camera) are drawn
+            void Draw(const Math::cMatrix_transformation& i_transform_localToProjected, const Math::sVector& i_cameraPosition_local,
+                const bool i_shouldCullBackFacingClusters, const ConstantBufferFormats::sPerDrawCall& i_drawData) const;
 
             // Access
             //-------
 
+            // A vertex shader needs these to calculate the local position of a quantized vertex
+            FORCEINLINE const MeshFormats::sPositionDequantization& GetPositionDequantization() const { return m_positionDequantization; }
+            // Every cluster is inside this sphere (in local space);
+            // the radius is zero if the mesh doesn't have any clusters
+            FORCEINLINE const float* GetBoundingSphereCenter() const { return m_boundingSphere_center; }
+            FORCEINLINE float GetBoundingSphereRadius() const { return m_boundingSphere_radius; }
+
             using Handle = Assets::cHandle<cMesh>;
             static Assets::cManager<cMesh> s_manager;
 
@@ -82,14 +93,33 @@ namespace eae6320
 
             EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS(cMesh);
 
+            // Memory Allocation
+            //------------------
+
+            EAE6320_MEMORY_DECLAREPOOLEDALLOCATION(cMesh);
+
         private:
 
-            cResult Initialize(const uint16_t i_vertexCount, const Graphics::VertexFormats::sMesh* i_vertexData, const uint16_t i_indexCount, const uint16_t* i_indices);
+            using sIndexRange = cGeometryPool::sIndexRange;
+
+            // The vertices must be in the given encoding (float or quantized)
+            // and the indices must be in the given format (16-bit or 32-bit)
+            cResult Initialize(const uint32_t i_vertexCount, const void* i_vertexData, const MeshFormats::VertexEncodings::eType i_vertexEncoding,
+                const uint32_t i_indexCount, const void* i_indices, const MeshFormats::IndexFormats::eType i_indexFormat);
             cResult CleanUp();
+            // The clusters are converted to the layout that culling uses
+            void InitializeClusters(const MeshFormats::sCluster* i_clusters, const uint32_t i_clusterCount);
 
             cMesh() = default;
             ~cMesh();
 
+            // Render
+            //-------
+
+            // Each range is a contiguous part of the mesh's indices
+            void DrawIndexRanges(const sIndexRange* i_indexRanges, const size_t i_indexRangeCount,
+                const ConstantBufferFormats::sPerDrawCall& i_drawData) const;
+
        private:
 
             // Data
@@ -97,29 +127,25 @@ namespace eae6320
 
             static const uint8_t s_indicesPerTriangle = 3;
 
-#if defined( EAE6320_PLATFORM_D3D )
-            // A vertex buffer holds the data for each vertex
-            ID3D11Buffer* m_vertexBuffer = nullptr;
-            // An index buffer holds the indices to vertex data
-            ID3D11Buffer* m_indexBuffer = nullptr;
-            // D3D has an "input layout" object that associates the layout of the vertex format struct
-            // with the input from a vertex shader
-            ID3D11InputLayout* m_vertexInputLayout = nullptr;
-#endif
-
-            uint16_t m_indexCount = 0;
+            // The bounds of the clusters are stored in groups of four
+            // so that four clusters can be culled at once with SIMD instructions
+            // (see MeshFormats::sCluster)
+            struct sClusterBounds
+            {
+                float boundingSphere_centerX[4], boundingSphere_centerY[4], boundingSphere_centerZ[4], boundingSphere_radius[4];
+                float normalCone_axisX[4], normalCone_axisY[4], normalCone_axisZ[4], normalCone_cutoff[4];
+            };
+
+            // The vertices and indices are stored in the geometry pool for the mesh's vertex encoding and index format
+            cGeometryPool::sAllocation m_geometry;
+            MeshFormats::sPositionDequantization m_positionDequantization = { { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } };
+            std::vector<sIndexRange> m_clusterIndexRanges;
+            std::vector<sClusterBounds> m_clusterBounds;
+            float m_boundingSphere_center[3] = { 0.0f, 0.0f, 0.0f };
+            float m_boundingSphere_radius = 0.0f;
 
             EAE6320_ASSETS_DECLAREREFERENCECOUNT();
 
-#if defined( EAE6320_PLATFORM_GL )
-            // A vertex buffer holds the data for each vertex
-            GLuint m_vertexBufferId = 0;
-            // An index buffer holds the indices to vertex data
-            GLuint m_indexBufferId = 0;
-            // A vertex array encapsulates the vertex data as well as the vertex input layout
-            GLuint m_vertexArrayId = 0;
-#endif
-
         }; // class cMesh
 
     } // namespace Graphics
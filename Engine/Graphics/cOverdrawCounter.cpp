@@ -0,0 +1,118 @@
+// Include Files
+//==============
+
+#include "cOverdrawCounter.h"
+
+#include <algorithm>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Interface
+//==========
+
+// Render
+//-------
+
+void eae6320::Graphics::cOverdrawCounter::BeginFrame()
+{
+	EAE6320_ASSERT( !m_isCounting );
+
+	auto& query = m_queries[m_nextQueryIndex];
+	// If the oldest query's result hasn't been read yet this frame isn't counted
+	// (waiting for it would stall the CPU until the GPU catches up)
+	if ( !query.isPending )
+	{
+		BeginQuery( query );
+		m_isCounting = true;
+	}
+}
+
+void eae6320::Graphics::cOverdrawCounter::EndFrame( const uint32_t i_pixelCount )
+{
+	if ( m_isCounting )
+	{
+		auto& query = m_queries[m_nextQueryIndex];
+		EndQuery( query );
+		query.pixelCount = i_pixelCount;
+		query.isPending = true;
+		m_nextQueryIndex = ( m_nextQueryIndex + 1 ) % s_queryCount;
+		m_isCounting = false;
+	}
+	// Read every result that is available
+	// (the GPU finishes queries in order, and so reading stops at the first one that isn't)
+	for ( size_t i = 0; i < s_queryCount; ++i )
+	{
+		auto& query = m_queries[( m_nextQueryIndex + i ) % s_queryCount];
+		if ( query.isPending )
+		{
+			uint64_t sampleCount;
+			if ( !GetQueryResult( query, sampleCount ) )
+			{
+				break;
+			}
+			query.isPending = false;
+			RecordResult( sampleCount, query.pixelCount );
+		}
+	}
+}
+
+// Statistics
+//-----------
+
+void eae6320::Graphics::cOverdrawCounter::OutputStatisticsToLog() const
+{
+	if ( m_statistics.frameCount > 0 )
+	{
+		const auto overdraw_average = static_cast<float>( static_cast<double>( m_statistics.sampleCount ) / static_cast<double>( m_statistics.pixelCount ) );
+		Logging::OutputMessage( "Each pixel was shaded %.2f times on average over %u frames (%.2f in the last frame, %.2f at most)",
+			overdraw_average, m_statistics.frameCount, m_statistics.overdraw_latest, m_statistics.overdraw_peak );
+	}
+	else
+	{
+		Logging::OutputMessage( "No frames were counted for overdraw" );
+	}
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Graphics::cOverdrawCounter::Initialize()
+{
+	m_nextQueryIndex = 0;
+	m_isCounting = false;
+	m_statistics = sStatistics();
+	return InitializePlatform();
+}
+
+eae6320::cResult eae6320::Graphics::cOverdrawCounter::CleanUp()
+{
+	// Results that haven't been read are lost
+	for ( auto& query : m_queries )
+	{
+		query.isPending = false;
+	}
+	m_isCounting = false;
+	return CleanUpPlatform();
+}
+
+eae6320::Graphics::cOverdrawCounter::~cOverdrawCounter()
+{
+	const auto result = CleanUp();
+	EAE6320_ASSERT( result );
+}
+
+// Implementation
+//===============
+
+void eae6320::Graphics::cOverdrawCounter::RecordResult( const uint64_t i_sampleCount, const uint32_t i_pixelCount )
+{
+	if ( i_pixelCount > 0 )
+	{
+		const auto overdraw = static_cast<float>( static_cast<double>( i_sampleCount ) / static_cast<double>( i_pixelCount ) );
+		++m_statistics.frameCount;
+		m_statistics.sampleCount += i_sampleCount;
+		m_statistics.pixelCount += i_pixelCount;
+		m_statistics.overdraw_latest = overdraw;
+		m_statistics.overdraw_peak = std::max( m_statistics.overdraw_peak, overdraw );
+	}
+}
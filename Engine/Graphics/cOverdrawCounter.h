@@ -0,0 +1,131 @@
+/*
+	An overdraw counter uses occlusion queries to count how many samples are written during a frame
+
+	Dividing the number of samples by the number of pixels gives the average number of times that each pixel was shaded
+	(1 means that nothing was drawn over anything else).
+	The GPU finishes a frame some time after it has been submitted,
+	and so the results are read a few frames later without waiting for them.
+*/
+
+#ifndef EAE6320_GRAPHICS_COVERDRAWCOUNTER_H
+#define EAE6320_GRAPHICS_COVERDRAWCOUNTER_H
+
+// Include Files
+//==============
+
+#include "Configuration.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+
+#ifdef EAE6320_PLATFORM_GL
+	#include "OpenGL/Includes.h"
+#endif
+
+// Forward Declarations
+//=====================
+
+#ifdef EAE6320_PLATFORM_D3D
+	struct ID3D11Query;
+#endif
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cOverdrawCounter
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Render
+			//-------
+
+			// Every sample that passes the depth test between these calls is counted
+			// (if the GPU is too far behind to have a free query the frame isn't counted)
+			void BeginFrame();
+			void EndFrame( const uint32_t i_pixelCount );
+
+			// Statistics
+			//-----------
+
+			struct sStatistics
+			{
+				// The number of frames whose results have been read
+				size_t frameCount = 0;
+				uint64_t sampleCount = 0;
+				uint64_t pixelCount = 0;
+				float overdraw_latest = 0.0f;
+				float overdraw_peak = 0.0f;
+			};
+			const sStatistics& GetStatistics() const { return m_statistics; }
+			void OutputStatisticsToLog() const;
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cResult Initialize();
+			cResult CleanUp();
+
+			cOverdrawCounter() = default;
+			~cOverdrawCounter();
+
+			// Data
+			//=====
+
+		private:
+
+			// This is how many frames the GPU can be behind before frames stop being counted
+			static constexpr size_t s_queryCount = 4;
+
+			struct sQuery
+			{
+#if defined( EAE6320_PLATFORM_D3D )
+				ID3D11Query* query = nullptr;
+#elif defined( EAE6320_PLATFORM_GL )
+				GLuint queryId = 0;
+#endif
+				uint32_t pixelCount = 0;
+				// This is true from when the query is ended until its result has been read
+				bool isPending = false;
+			};
+			// The queries are used in order,
+			// and so the next query is also the oldest one
+			sQuery m_queries[s_queryCount];
+			size_t m_nextQueryIndex = 0;
+			bool m_isCounting = false;
+
+			sStatistics m_statistics;
+
+			// Implementation
+			//===============
+
+		private:
+
+			void RecordResult( const uint64_t i_sampleCount, const uint32_t i_pixelCount );
+
+			// Platform-Specific
+			//------------------
+
+			cResult InitializePlatform();
+			cResult CleanUpPlatform();
+
+			void BeginQuery( sQuery& io_query );
+			void EndQuery( sQuery& io_query );
+			// This doesn't wait for the GPU:
+			// it returns false if the result isn't available yet
+			bool GetQueryResult( sQuery& io_query, uint64_t& o_sampleCount );
+
+			cOverdrawCounter( const cOverdrawCounter& i_instanceToBeCopied ) = delete;
+			cOverdrawCounter& operator =( const cOverdrawCounter& i_instanceToBeCopied ) = delete;
+		};
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_COVERDRAWCOUNTER_H
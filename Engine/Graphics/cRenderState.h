@@ -35,7 +35,10 @@ namespace eae6320
 				DepthBuffering = 1 << 1,
 				// Set to draw triangles regardless of whether they are front-facing or back-facing
 				// (set to disable culling)
-				DrawBothTriangleSides = 1 << 2
+				DrawBothTriangleSides = 1 << 2,
+				// Set to only write to the depth buffer and not to any colors
+				// (this is used for a depth prepass)
+				DepthOnly = 1 << 3
 			};
 
 			// Alpha Transparency
@@ -50,6 +53,11 @@ namespace eae6320
 			bool ShouldBothTriangleSidesBeDrawn( const uint8_t i_renderStateBits );
 			void EnableDrawingBothTriangleSides( uint8_t& io_renderStateBits );
 			void DisableDrawingBothTriangleSides( uint8_t& io_renderStateBits );
+
+			// Depth Only
+			bool IsDepthOnlyEnabled( const uint8_t i_renderStateBits );
+			void EnableDepthOnly( uint8_t& io_renderStateBits );
+			void DisableDepthOnly( uint8_t& io_renderStateBits );
 		}
 	}
 }
@@ -88,6 +96,7 @@ namespace eae6320
 			bool IsAlphaTransparencyEnabled() const;
 			bool IsDepthBufferingEnabled() const;
 			bool ShouldBothTriangleSidesBeDrawn() const;
+			bool IsDepthOnlyEnabled() const;
 
 			uint8_t GetRenderStateBits() const;
 
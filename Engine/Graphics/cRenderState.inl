@@ -51,6 +51,20 @@ inline void eae6320::Graphics::RenderStates::DisableDrawingBothTriangleSides( ui
 	io_renderStateBits &= ~DrawBothTriangleSides;
 }
 
+// Depth Only
+inline bool eae6320::Graphics::RenderStates::IsDepthOnlyEnabled( const uint8_t i_renderStateBits )
+{
+	return ( i_renderStateBits & DepthOnly ) != 0;
+}
+inline void eae6320::Graphics::RenderStates::EnableDepthOnly( uint8_t& io_renderStateBits )
+{
+	io_renderStateBits |= DepthOnly;
+}
+inline void eae6320::Graphics::RenderStates::DisableDepthOnly( uint8_t& io_renderStateBits )
+{
+	io_renderStateBits &= ~DepthOnly;
+}
+
 // Access
 //-------
 
@@ -69,6 +83,11 @@ inline bool eae6320::Graphics::cRenderState::ShouldBothTriangleSidesBeDrawn() co
 	return RenderStates::ShouldBothTriangleSidesBeDrawn( m_bits );
 }
 
+inline bool eae6320::Graphics::cRenderState::IsDepthOnlyEnabled() const
+{
+	return RenderStates::IsDepthOnlyEnabled( m_bits );
+}
+
 inline uint8_t eae6320::Graphics::cRenderState::GetRenderStateBits() const
 {
 	return m_bits;
@@ -5,6 +5,8 @@
 
 #include <cstring>
 #include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/LoadStatistics.h>
+#include <Engine/Assets/Prefetch.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/Platform/Platform.h>
 
@@ -43,7 +45,7 @@ eae6320::cResult eae6320::Graphics::cShader::Load( const char* const i_path, cSh
 	// Load the binary data
 	{
 		std::string errorMessage;
-		if ( !( result = Platform::LoadBinaryFile( i_path, dataFromFile, &errorMessage ) ) )
+		if ( !( result = Assets::LoadBinaryFile( i_path, dataFromFile, &errorMessage ) ) )
 		{
 			EAE6320_ASSERTF( false, errorMessage.c_str() );
 			Logging::OutputError( "Failed to load shader from file %s: %s", i_path, errorMessage.c_str() );
@@ -62,11 +64,15 @@ eae6320::cResult eae6320::Graphics::cShader::Load( const char* const i_path, cSh
 		}
 	}
 	// Initialize the platform-specific graphics API shader object
-	if ( !( result = newShader->Initialize( i_path, dataFromFile ) ) )
 	{
-		EAE6320_ASSERTF( false, "Initialization of new shader failed" );
-		goto OnExit;
+		Assets::cLoadPhaseTimer uploadTimer( Assets::LoadPhases::Upload );
+		if ( !( result = newShader->Initialize( i_path, dataFromFile ) ) )
+		{
+			EAE6320_ASSERTF( false, "Initialization of new shader failed" );
+			goto OnExit;
+		}
 	}
+	Assets::AddResidentBytesToCurrentLoad( dataFromFile.size );
 
 OnExit:
 
@@ -22,6 +22,8 @@
 
 #ifdef EAE6320_PLATFORM_GL
 	#include "OpenGL/Includes.h"
+
+	#include <string>
 #endif
 
 // Shader Types
@@ -100,6 +102,20 @@ namespace eae6320
 
 			EAE6320_ASSETS_DECLAREREFERENCECOUNTINGFUNCTIONS();
 
+#if defined( EAE6320_PLATFORM_GL )
+			// Compiling
+			//----------
+
+			// A shader isn't compiled when it is loaded
+			// because a program that is loaded from the program binary cache doesn't need it;
+			// a program that has to be linked calls this first
+			cResult CompileIfNecessary();
+			// A program that is loaded from the program binary cache calls this
+			// so that the source code isn't kept in memory
+			// (if another program that uses the shader isn't cached CompileIfNecessary() loads it again)
+			void FreeSource();
+#endif
+
 			// Data
 			//=====
 
@@ -116,10 +132,21 @@ namespace eae6320
 			} m_shaderObject;
 #elif defined( EAE6320_PLATFORM_GL )
 			GLuint m_shaderId = 0;
+			// This identifies the source code in program binary cache keys
+			uint64_t m_sourceHash = 0;
 #endif
 			EAE6320_ASSETS_DECLAREREFERENCECOUNT();
 			const ShaderTypes::eType m_type = ShaderTypes::Unknown;
 
+		private:
+
+#if defined( EAE6320_PLATFORM_GL )
+			// The source code is kept until the shader is compiled
+			// or until a program that uses it is loaded from the program binary cache
+			std::string m_path;
+			std::string m_source;
+#endif
+
 			// Implementation
 			//===============
 
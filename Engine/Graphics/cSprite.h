@@ -10,6 +10,7 @@
 
 #include <Engine/Assets/ReferenceCountedAssets.h>
 #include <Engine/Math/sVector2d.h>
+#include <Engine/Memory/PooledAllocation.h>
 #include <Engine/Results/Results.h>
 
 #ifdef EAE6320_PLATFORM_GL
@@ -68,6 +69,11 @@ namespace eae6320
 
             EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS(cSprite);
 
+            // Memory Allocation
+            //------------------
+
+            EAE6320_MEMORY_DECLAREPOOLEDALLOCATION(cSprite);
+
         private:
 
             cResult Initialize(const Math::sVector2d& i_origin, const Math::sVector2d& i_extents);
@@ -3,8 +3,13 @@
 
 #include "cTexture.h"
 
+#include "TextureStreaming.h"
+
+#include <algorithm>
 #include <cstring>
 #include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/LoadStatistics.h>
+#include <Engine/Assets/Prefetch.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/Platform/Platform.h>
 #include <new>
@@ -13,10 +18,26 @@
 //===========================
 
 eae6320::Assets::cManager<eae6320::Graphics::cTexture> eae6320::Graphics::cTexture::s_manager;
+std::vector<eae6320::Graphics::cTexture::sSharedArray*> eae6320::Graphics::cTexture::s_sharedArrays;
+
+namespace
+{
+    // A shared array can't grow once it has been created,
+    // and so a new one is created when every layer is in use
+    constexpr uint16_t s_layerCountPerSharedArray = 32;
+}
 
 // Interface
 //==========
 
+// Render
+//-------
+
+bool eae6320::Graphics::cTexture::IsInSameArrayAs( const cTexture& i_texture ) const
+{
+    return ( this == &i_texture ) || ( m_sharedArray && ( m_sharedArray == i_texture.m_sharedArray ) );
+}
+
 // Access
 //-------
 
@@ -30,6 +51,76 @@ uint16_t eae6320::Graphics::cTexture::GetHeight() const
     return m_info.height;
 }
 
+uint16_t eae6320::Graphics::cTexture::GetArrayLayer() const
+{
+    return m_arrayLayer;
+}
+
+// Streaming
+//----------
+
+uint8_t eae6320::Graphics::cTexture::GetMipMapCount() const
+{
+    return m_info.mipMapCount;
+}
+
+uint8_t eae6320::Graphics::cTexture::GetMostDetailedResidentMipLevel() const
+{
+    return m_mostDetailedResidentMipLevel;
+}
+
+size_t eae6320::Graphics::cTexture::GetMipLevelByteCount( const uint8_t i_mipLevel ) const
+{
+    const auto width = std::max( m_info.width >> i_mipLevel, 1 );
+    const auto height = std::max( m_info.height >> i_mipLevel, 1 );
+    const auto blockCount_singleRow = static_cast<size_t>( ( width + 3 ) / 4 );
+    const auto rowCount = static_cast<size_t>( ( height + 3 ) / 4 );
+    return blockCount_singleRow * rowCount * TextureFormats::Compression::GetSizeOfBlock( m_info.compressionType );
+}
+
+size_t eae6320::Graphics::cTexture::GetMipLevelOffset( const uint8_t i_mipLevel ) const
+{
+    size_t offset = 0;
+    for ( uint8_t i = 0; i < i_mipLevel; ++i )
+    {
+        offset += GetMipLevelByteCount( i );
+    }
+    return offset;
+}
+
+const char* eae6320::Graphics::cTexture::GetPath() const
+{
+    return m_path.c_str();
+}
+
+eae6320::cResult eae6320::Graphics::cTexture::SetMostDetailedResidentMipLevel( const uint8_t i_mipLevel,
+    const void* const i_textureData, const size_t i_textureDataSize )
+{
+    EAE6320_ASSERT( i_mipLevel < m_info.mipMapCount );
+    EAE6320_ASSERTF( ( TextureStreaming::GetValidMostDetailedMipLevels( m_info ) & ( 1u << i_mipLevel ) ) != 0,
+        "The texture %s can't start at MIP map #%u because its dimensions aren't multiples of 4", m_path.c_str(), i_mipLevel );
+    if ( i_mipLevel == m_mostDetailedResidentMipLevel )
+    {
+        return Results::Success;
+    }
+    // Only the levels that aren't resident yet are read from the data
+    if ( ( i_mipLevel < m_mostDetailedResidentMipLevel )
+        && ( !i_textureData || ( i_textureDataSize < GetMipLevelOffset( m_mostDetailedResidentMipLevel ) ) ) )
+    {
+        EAE6320_ASSERTF( false, "The texture data for %s is too small to contain MIP map #%u", m_path.c_str(), i_mipLevel );
+        Logging::OutputError( "The texture data for %s (%u bytes) is too small to contain MIP map #%u",
+            m_path.c_str(), i_textureDataSize, i_mipLevel );
+        return Results::InvalidFile;
+    }
+
+    const auto result = ChangeMostDetailedResidentMipLevel( i_mipLevel, i_textureData );
+    if ( result )
+    {
+        m_mostDetailedResidentMipLevel = i_mipLevel;
+    }
+    return result;
+}
+
 // Initialization / Clean Up
 //--------------------------
 
@@ -43,7 +134,7 @@ eae6320::cResult eae6320::Graphics::cTexture::Load( const char* const i_path, cT
     // Load the binary data
     {
         std::string errorMessage;
-        if ( !( result = Platform::LoadBinaryFile( i_path, dataFromFile, &errorMessage ) ) )
+        if ( !( result = Assets::LoadBinaryFile( i_path, dataFromFile, &errorMessage ) ) )
         {
             EAE6320_ASSERTF( false, errorMessage.c_str() );
             Logging::OutputError( "Failed to load texture data from file %s: %s", i_path, errorMessage.c_str() );
@@ -65,7 +156,7 @@ eae6320::cResult eae6320::Graphics::cTexture::Load( const char* const i_path, cT
             EAE6320_ASSERT( ( textureInfo->height % 4u ) == 0u );
             currentOffset = newOffset;
             // Allocate a new texture with the information
-            newTexture = new (std::nothrow) cTexture( *textureInfo );
+            newTexture = new (std::nothrow) cTexture( i_path, *textureInfo );
             if ( !newTexture )
             {
                 result = Results::OutOfMemory;
@@ -88,10 +179,45 @@ eae6320::cResult eae6320::Graphics::cTexture::Load( const char* const i_path, cT
     {
         const auto* const textureData = reinterpret_cast<void*>( currentOffset );
         const auto textureDataSize = static_cast<size_t>( finalOffset - currentOffset );
-        if ( !( result = newTexture->Initialize( i_path, textureData, textureDataSize ) ) )
         {
-            EAE6320_ASSERTF( false, "Initialization of new texture failed" );
-            goto OnExit;
+            const auto textureDataSize_expected = newTexture->GetMipLevelOffset( newTexture->m_info.mipMapCount );
+            if ( textureDataSize < textureDataSize_expected )
+            {
+                result = Results::InvalidFile;
+                EAE6320_ASSERTF( false, "The texture file %s is too small to contain every MIP map", i_path );
+                Logging::OutputError( "The texture file %s has less texture data (%u) than it should (%u)",
+                    i_path, textureDataSize, textureDataSize_expected );
+                goto OnExit;
+            }
+            EAE6320_ASSERTF( textureDataSize == textureDataSize_expected, "The texture file %s has more texture data (%u) than it should (%u)",
+                i_path, textureDataSize, textureDataSize_expected );
+        }
+        // Only the MIP tail is uploaded now
+        // (the more detailed levels are streamed in once the texture is drawn)
+        newTexture->m_mostDetailedResidentMipLevel = TextureStreaming::GetTailMipLevel( newTexture->m_info );
+        {
+            Assets::cLoadPhaseTimer uploadTimer( Assets::LoadPhases::Upload );
+#ifdef EAE6320_GRAPHICS_ARETEXTUREARRAYSSHARED
+            // A texture whose levels won't ever change can share an array with other textures
+            if ( newTexture->m_mostDetailedResidentMipLevel == 0 )
+            {
+                result = newTexture->InitializeInSharedArray( i_path, textureData );
+            }
+            else
+#endif
+            {
+                result = newTexture->Initialize( i_path, textureData, textureDataSize );
+            }
+            if ( !result )
+            {
+                EAE6320_ASSERTF( false, "Initialization of new texture failed" );
+                goto OnExit;
+            }
+        }
+        Assets::AddResidentBytesToCurrentLoad( textureDataSize - newTexture->GetMipLevelOffset( newTexture->m_mostDetailedResidentMipLevel ) );
+        if ( newTexture->m_mostDetailedResidentMipLevel > 0 )
+        {
+            TextureStreaming::Register( *newTexture );
         }
     }
 
@@ -122,7 +248,9 @@ OnExit:
 // Initialization / Clean Up
 //--------------------------
 
-eae6320::Graphics::cTexture::cTexture( const TextureFormats::sTextureInfo& i_info )
+eae6320::Graphics::cTexture::cTexture( const char* const i_path, const TextureFormats::sTextureInfo& i_info )
+    :
+    m_path( i_path )
 {
     // Copy the information from the file
     memcpy( &m_info, &i_info, sizeof( m_info ) );
@@ -130,5 +258,87 @@ eae6320::Graphics::cTexture::cTexture( const TextureFormats::sTextureInfo& i_inf
 
 eae6320::Graphics::cTexture::~cTexture()
 {
+    // Only textures that have levels more detailed than their tail are registered
+    if ( TextureStreaming::GetTailMipLevel( m_info ) > 0 )
+    {
+        TextureStreaming::Unregister( *this );
+    }
     CleanUp();
+    if ( m_sharedArray )
+    {
+        RemoveFromSharedArray();
+    }
+}
+
+// Shared Arrays
+//--------------
+
+eae6320::cResult eae6320::Graphics::cTexture::InitializeInSharedArray( const char* const i_path, const void* const i_textureData )
+{
+    auto result = Results::Success;
+
+    EAE6320_ASSERT( m_mostDetailedResidentMipLevel == 0 );
+    EAE6320_ASSERT( !m_sharedArray );
+
+    // Use a free layer in an array that has the same information
+    // or create a new array if there isn't one
+    for ( auto* const sharedArray : s_sharedArrays )
+    {
+        const auto& info = sharedArray->info;
+        if ( ( info.width == m_info.width ) && ( info.height == m_info.height ) && ( info.mipMapCount == m_info.mipMapCount )
+            && ( info.compressionType == m_info.compressionType ) && !sharedArray->freeLayers.empty() )
+        {
+            m_sharedArray = sharedArray;
+            break;
+        }
+    }
+    if ( !m_sharedArray )
+    {
+        auto* const newSharedArray = new (std::nothrow) sSharedArray;
+        if ( !newSharedArray )
+        {
+            result = Results::OutOfMemory;
+            EAE6320_ASSERTF( false, "Couldn't allocate memory for a shared texture array" );
+            Logging::OutputError( "Failed to allocate memory for a texture array to put %s in", i_path );
+            return result;
+        }
+        memcpy( &newSharedArray->info, &m_info, sizeof( m_info ) );
+        if ( !( result = CreateSharedArray( i_path, s_layerCountPerSharedArray, *newSharedArray ) ) )
+        {
+            delete newSharedArray;
+            return result;
+        }
+        // The lowest layers are used first
+        for ( auto i = s_layerCountPerSharedArray; i > 0; --i )
+        {
+            newSharedArray->freeLayers.push_back( static_cast<uint16_t>( i - 1 ) );
+        }
+        s_sharedArrays.push_back( newSharedArray );
+        m_sharedArray = newSharedArray;
+    }
+    m_arrayLayer = m_sharedArray->freeLayers.back();
+    m_sharedArray->freeLayers.pop_back();
+
+    if ( !( result = UploadToSharedArray( i_path, i_textureData ) ) )
+    {
+        RemoveFromSharedArray();
+    }
+
+    return result;
+}
+
+void eae6320::Graphics::cTexture::RemoveFromSharedArray()
+{
+    EAE6320_ASSERT( m_sharedArray );
+
+    m_sharedArray->freeLayers.push_back( m_arrayLayer );
+    // The array is destroyed once no texture uses it
+    if ( m_sharedArray->freeLayers.size() == s_layerCountPerSharedArray )
+    {
+        DestroySharedArray( *m_sharedArray );
+        s_sharedArrays.erase( std::find( s_sharedArrays.begin(), s_sharedArrays.end(), m_sharedArray ) );
+        delete m_sharedArray;
+    }
+    m_sharedArray = nullptr;
+    m_arrayLayer = 0;
 }
@@ -2,6 +2,10 @@
     A texture is an n-dimensional array of data
     (usually a 2-dimensional array of colors)
     that can be sampled in a shader
+
+    Every texture is stored in a layer of a texture array
+    (either an array of its own or one that it shares with textures that have the same size, format, and MIP count),
+    and so shaders sample it with the layer index that GetArrayLayer() returns
 */
 
 #ifndef EAE6320_GRAPHICS_CTEXTURE_H
@@ -16,13 +20,17 @@
 
 #include "TextureFormats.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <Engine/Assets/cHandle.h>
 #include <Engine/Assets/cManager.h>
 #include <Engine/Results/Results.h>
+#include <string>
+#include <vector>
 
 #ifdef EAE6320_PLATFORM_GL
     #include "OpenGL/Includes.h"
+    #include "OpenGL/UploadManager.h"
 #endif
 
 // Forward Declarations
@@ -55,6 +63,9 @@ namespace eae6320
             // (a single texture could be used by many different effects)
             // and so this is the caller's responsibility to pass in.
             void Bind( const unsigned int i_id ) const;
+            // If this returns true binding either texture binds the same array
+            // (and only the layer that is sampled is different)
+            bool IsInSameArrayAs( const cTexture& i_texture ) const;
 
             // Access
             //-------
@@ -64,6 +75,35 @@ namespace eae6320
 
             uint16_t GetWidth() const;
             uint16_t GetHeight() const;
+            uint16_t GetArrayLayer() const;
+
+            // Streaming
+            //----------
+
+            // Only the least detailed MIP levels are uploaded when a texture is loaded,
+            // and the more detailed ones are streamed in when they are needed
+            // (see TextureStreaming.h)
+
+            uint8_t GetMipMapCount() const;
+            uint8_t GetMostDetailedResidentMipLevel() const;
+            size_t GetMipLevelByteCount( const uint8_t i_mipLevel ) const;
+            // The texture data is every MIP level (the data in the file that follows the sTextureInfo),
+            // and so this is where the given level starts
+            size_t GetMipLevelOffset( const uint8_t i_mipLevel ) const;
+            const char* GetPath() const;
+
+            // Making the texture more detailed uploads the levels that aren't resident yet from the texture data;
+            // making it less detailed frees the levels that are no longer needed (and the data can be NULL).
+            // This must be called on the render thread
+            cResult SetMostDetailedResidentMipLevel( const uint8_t i_mipLevel, const void* const i_textureData, const size_t i_textureDataSize );
+#if defined( EAE6320_PLATFORM_GL )
+            // The streaming thread copies the texture data into the upload staging buffer when there is room,
+            // and then this only has to start the GPU copy
+            // (the allocation starts at the given offset in the texture data and must contain every level that isn't resident yet).
+            // The allocation is always released
+            cResult SetMostDetailedResidentMipLevel( const uint8_t i_mipLevel,
+                UploadManager::sAllocation& io_stagedTextureData, const size_t i_stagedTextureDataOffset );
+#endif
 
             // Initialization / Clean Up
             //--------------------------
@@ -82,15 +122,36 @@ namespace eae6320
 
         private:
 
+            // A texture array that textures with the same information share
+            struct sSharedArray
+            {
+                TextureFormats::sTextureInfo info;
+                // The layers that aren't used by any texture
+                std::vector<uint16_t> freeLayers;
 #if defined( EAE6320_PLATFORM_D3D )
+                ID3D11ShaderResourceView* textureView = nullptr;
+#elif defined( EAE6320_PLATFORM_GL )
+                GLuint textureId = 0;
+#endif
+            };
+
+#if defined( EAE6320_PLATFORM_D3D )
+            // If the texture is in a shared array this is a reference to the array's view
             ID3D11ShaderResourceView* m_textureView = nullptr;
 #elif defined( EAE6320_PLATFORM_GL )
+            // If the texture is in a shared array this is the array's ID
+            // (and the array is only deleted once every texture in it has been)
             GLuint m_textureId = 0;
 #endif
+            sSharedArray* m_sharedArray = nullptr;
+            uint16_t m_arrayLayer = 0;
 
             EAE6320_ASSETS_DECLAREREFERENCECOUNT();
 
             TextureFormats::sTextureInfo m_info;
+            // The path is kept so that more detailed MIP levels can be read from the file later
+            std::string m_path;
+            uint8_t m_mostDetailedResidentMipLevel = 0;
 
             // Implementation
             //===============
@@ -100,11 +161,34 @@ namespace eae6320
             // Initialization / Clean Up
             //--------------------------
 
+            // Only the levels from m_mostDetailedResidentMipLevel on are uploaded
             cResult Initialize( const char* const i_path, const void* const i_textureData, const size_t i_textureDataSize );
             cResult CleanUp();
 
-            cTexture( const TextureFormats::sTextureInfo& i_info );
+            // Shared Arrays
+            //--------------
+
+            // Every MIP level must be resident
+            cResult InitializeInSharedArray( const char* const i_path, const void* const i_textureData );
+            void RemoveFromSharedArray();
+            // The texture's layer has already been assigned
+            cResult UploadToSharedArray( const char* const i_path, const void* const i_textureData );
+            static cResult CreateSharedArray( const char* const i_path, const uint16_t i_layerCount, sSharedArray& io_array );
+            static void DestroySharedArray( sSharedArray& io_array );
+
+            cTexture( const char* const i_path, const TextureFormats::sTextureInfo& i_info );
             ~cTexture();
+
+            // Streaming
+            //----------
+
+            // The data has already been validated
+            cResult ChangeMostDetailedResidentMipLevel( const uint8_t i_mipLevel, const void* const i_textureData );
+
+            // Data
+            //=====
+
+            static std::vector<sSharedArray*> s_sharedArrays;
         };
     }
 }
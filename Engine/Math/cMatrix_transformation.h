@@ -66,6 +66,8 @@ namespace eae6320
 			const sVector& GetUpDirection() const;
 			const sVector& GetBackDirection() const;
 			const sVector& GetTranslation() const;
+			// The rows of a local-to-projected transform can be combined to calculate the planes of the view frustum in local space
+			void GetRow( const unsigned int i_rowIndex, float o_row[4] ) const;
 
 			// Camera
 			//-------
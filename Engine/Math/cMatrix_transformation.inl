@@ -32,6 +32,16 @@ inline const eae6320::Math::sVector& eae6320::Math::cMatrix_transformation::GetT
 	return *reinterpret_cast<const sVector*>( &m_03 );
 }
 
+inline void eae6320::Math::cMatrix_transformation::GetRow( const unsigned int i_rowIndex, float o_row[4] ) const
+{
+	// The storage is column-major, and so the elements of a row are four floats apart
+	const auto* const firstElement = &m_00 + i_rowIndex;
+	o_row[0] = firstElement[0];
+	o_row[1] = firstElement[4];
+	o_row[2] = firstElement[8];
+	o_row[3] = firstElement[12];
+}
+
 // Camera
 //-------
 
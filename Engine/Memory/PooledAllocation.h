@@ -0,0 +1,50 @@
+/*
+	A class can declare that its instances should be allocated from their own pool
+	(see cPoolAllocator.h) by using the macro below in the public part of its declaration:
+		* The class gets its own class-specific operator new and operator delete,
+			and so existing "new (std::nothrow) cClass()" and "delete" code doesn't need to change
+		* Each class has a separate pool,
+			and so instances of the same type end up next to each other in memory
+		* Only the non-throwing form of new is allowed
+			(the engine doesn't use exceptions, and the pool returns nullptr when it can't allocate)
+*/
+
+#ifndef EAE6320_MEMORY_POOLEDALLOCATION_H
+#define EAE6320_MEMORY_POOLEDALLOCATION_H
+
+// Include Files
+//==============
+
+#include "cPoolAllocator.h"
+
+#include <new>
+
+// Pooled Allocation
+//------------------
+
+// The pool is a function-local static
+// so that it is constructed the first time that it's needed
+// (and so that there is only a single pool no matter how many files include the class's header)
+#define EAE6320_MEMORY_DECLAREPOOLEDALLOCATION( tClassName )	\
+	static eae6320::Memory::cPoolAllocator& GetPoolAllocator()	\
+	{	\
+		static eae6320::Memory::cPoolAllocator s_poolAllocator( sizeof( tClassName ), alignof( tClassName ), #tClassName );	\
+		return s_poolAllocator;	\
+	}	\
+	static void* operator new( const size_t i_size, const std::nothrow_t& ) noexcept	\
+	{	\
+		return GetPoolAllocator().Allocate( i_size );	\
+	}	\
+	static void operator delete( void* const i_pointer ) noexcept	\
+	{	\
+		GetPoolAllocator().Deallocate( i_pointer );	\
+	}	\
+	static void operator delete( void* const i_pointer, const std::nothrow_t& ) noexcept	\
+	{	\
+		GetPoolAllocator().Deallocate( i_pointer );	\
+	}	\
+	static void* operator new( const size_t i_size ) = delete;	\
+	static void* operator new[]( const size_t i_size ) = delete;	\
+	static void* operator new[]( const size_t i_size, const std::nothrow_t& ) = delete;
+
+#endif	// EAE6320_MEMORY_POOLEDALLOCATION_H
@@ -0,0 +1,209 @@
+// Include Files
+//==============
+
+#include "cPoolAllocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+    // Every pool registers itself so that the statistics of all pools can be output together
+    // (function-local statics are used so that pools can be constructed during static initialization)
+    eae6320::Concurrency::cMutex& GetRegistryMutex();
+    std::vector<const eae6320::Memory::cPoolAllocator*>& GetRegistry();
+
+    constexpr size_t DefaultSlabSize = 16 * 1024;
+
+    size_t RoundUp( const size_t i_value, const size_t i_multiple );
+}
+
+// Interface
+//==========
+
+// Allocation
+//-----------
+
+void* eae6320::Memory::cPoolAllocator::Allocate( const size_t i_size )
+{
+    // A derived class that doesn't declare its own pooled allocation would be too big for its base class's pool
+    if ( i_size > m_blockSize )
+    {
+        EAE6320_ASSERTF( false, "%u bytes can't be allocated from the %s pool (its blocks are %u bytes)",
+            i_size, m_name, m_blockSize );
+        Logging::OutputError( "%u bytes can't be allocated from the %s pool (its blocks are %u bytes)",
+            i_size, m_name, m_blockSize );
+        return nullptr;
+    }
+
+    Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+    {
+        if ( !m_freeList && !AllocateSlab() )
+        {
+            ++m_statistics.failedAllocationCount;
+            return nullptr;
+        }
+        auto* const block = m_freeList;
+        m_freeList = block->next;
+        ++m_statistics.allocationCount;
+        m_statistics.blockCount_peak = std::max( m_statistics.blockCount_peak, ++m_statistics.blockCount_live );
+        return block;
+    }
+}
+
+void eae6320::Memory::cPoolAllocator::Deallocate( void* const i_block )
+{
+    if ( !i_block )
+    {
+        return;
+    }
+
+    Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+    {
+#ifdef EAE6320_ASSERTS_AREENABLED
+        {
+            auto isFromThisPool = false;
+            for ( auto* slab = m_newestSlab; slab && !isFromThisPool; slab = slab->previous )
+            {
+                const auto firstBlock = RoundUp( reinterpret_cast<uintptr_t>( slab + 1 ), m_blockAlignment );
+                const auto blockAddress = reinterpret_cast<uintptr_t>( i_block );
+                isFromThisPool = ( blockAddress >= firstBlock ) && ( blockAddress < ( firstBlock + ( m_blockSize * m_blockCountPerSlab ) ) )
+                    && ( ( ( blockAddress - firstBlock ) % m_blockSize ) == 0 );
+            }
+            EAE6320_ASSERTF( isFromThisPool, "A block that wasn't allocated from the %s pool is being deallocated", m_name );
+        }
+#endif
+        EAE6320_ASSERT( m_statistics.blockCount_live > 0 );
+        auto* const block = static_cast<sFreeBlock*>( i_block );
+        block->next = m_freeList;
+        m_freeList = block;
+        --m_statistics.blockCount_live;
+    }
+}
+
+// Statistics
+//-----------
+
+eae6320::Memory::cPoolAllocator::sStatistics eae6320::Memory::cPoolAllocator::GetStatistics() const
+{
+    Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+    return m_statistics;
+}
+
+void eae6320::Memory::cPoolAllocator::OutputStatisticsOfAllPoolsToLog()
+{
+    Concurrency::cMutex::cScopeLock autoLock( GetRegistryMutex() );
+    for ( const auto* const poolAllocator : GetRegistry() )
+    {
+        const auto statistics = poolAllocator->GetStatistics();
+        Logging::OutputMessage( "%s pool: %u live blocks of %u bytes (peak %u, capacity %u in %u slabs of %u bytes),"
+            " %u allocations (%u failed)",
+            poolAllocator->GetName(), statistics.blockCount_live, statistics.blockSize,
+            statistics.blockCount_peak, statistics.blockCount_capacity, statistics.slabCount, statistics.slabSize,
+            statistics.allocationCount, statistics.failedAllocationCount );
+    }
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Memory::cPoolAllocator::cPoolAllocator( const size_t i_blockSize, const size_t i_blockAlignment, const char* const i_name,
+    const uint32_t i_blockCountPerSlab )
+    :
+    m_name( i_name ),
+    // Every block must be able to hold a free list pointer
+    // and must keep the next block aligned
+    m_blockSize( RoundUp( std::max( i_blockSize, sizeof( sFreeBlock ) ), std::max( i_blockAlignment, alignof( sFreeBlock ) ) ) ),
+    m_blockAlignment( std::max( i_blockAlignment, alignof( sFreeBlock ) ) ),
+    m_blockCountPerSlab( ( i_blockCountPerSlab > 0 ) ? i_blockCountPerSlab
+        : static_cast<uint32_t>( std::max( DefaultSlabSize / m_blockSize, size_t( 16 ) ) ) )
+{
+    m_statistics.blockSize = m_blockSize;
+    m_statistics.slabSize = sizeof( sSlabHeader ) + ( m_blockAlignment - 1 ) + ( m_blockSize * m_blockCountPerSlab );
+
+    Concurrency::cMutex::cScopeLock autoLock( GetRegistryMutex() );
+    GetRegistry().push_back( this );
+}
+
+eae6320::Memory::cPoolAllocator::~cPoolAllocator()
+{
+    {
+        Concurrency::cMutex::cScopeLock autoLock( GetRegistryMutex() );
+        auto& registry = GetRegistry();
+        registry.erase( std::remove( registry.begin(), registry.end(), this ), registry.end() );
+    }
+
+    // If blocks are still live then something leaked;
+    // the slabs are intentionally not freed so that a late deallocation doesn't write to freed memory
+    EAE6320_ASSERTF( m_statistics.blockCount_live == 0, "%u blocks from the %s pool were never deallocated",
+        m_statistics.blockCount_live, m_name );
+    if ( m_statistics.blockCount_live == 0 )
+    {
+        while ( m_newestSlab )
+        {
+            auto* const previousSlab = m_newestSlab->previous;
+            std::free( m_newestSlab );
+            m_newestSlab = previousSlab;
+        }
+        m_freeList = nullptr;
+    }
+}
+
+// Implementation
+//===============
+
+bool eae6320::Memory::cPoolAllocator::AllocateSlab()
+{
+    auto* const slab = static_cast<sSlabHeader*>( std::malloc( m_statistics.slabSize ) );
+    if ( !slab )
+    {
+        EAE6320_ASSERTF( false, "Couldn't allocate a new slab for the %s pool", m_name );
+        Logging::OutputError( "Failed to allocate a new %u byte slab for the %s pool", m_statistics.slabSize, m_name );
+        return false;
+    }
+    slab->previous = m_newestSlab;
+    m_newestSlab = slab;
+
+    // Thread the new blocks onto the free list in address order
+    // so that consecutive allocations are next to each other in memory
+    auto* const firstBlock = reinterpret_cast<uint8_t*>( RoundUp( reinterpret_cast<uintptr_t>( slab + 1 ), m_blockAlignment ) );
+    for ( auto i = m_blockCountPerSlab; i > 0; --i )
+    {
+        auto* const block = reinterpret_cast<sFreeBlock*>( firstBlock + ( ( i - 1 ) * m_blockSize ) );
+        block->next = m_freeList;
+        m_freeList = block;
+    }
+
+    ++m_statistics.slabCount;
+    m_statistics.blockCount_capacity += m_blockCountPerSlab;
+    return true;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+    eae6320::Concurrency::cMutex& GetRegistryMutex()
+    {
+        static eae6320::Concurrency::cMutex s_mutex;
+        return s_mutex;
+    }
+
+    std::vector<const eae6320::Memory::cPoolAllocator*>& GetRegistry()
+    {
+        static std::vector<const eae6320::Memory::cPoolAllocator*> s_registry;
+        return s_registry;
+    }
+
+    size_t RoundUp( const size_t i_value, const size_t i_multiple )
+    {
+        return ( ( i_value + ( i_multiple - 1 ) ) / i_multiple ) * i_multiple;
+    }
+}
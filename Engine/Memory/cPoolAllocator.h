@@ -0,0 +1,120 @@
+/*
+    A pool allocator hands out fixed-size blocks of memory:
+        * Blocks are carved out of large slabs,
+            and so objects that are allocated from the same pool end up next to each other in memory
+        * Unused blocks are kept in an intrusive free list
+            (a free block stores the pointer to the next free block),
+            and so allocating and deallocating are both O(1)
+        * Every pool has its own lock,
+            and so threads allocating different types never contend with each other or with the global heap
+            (the global heap is only used when a new slab is needed)
+
+    Classes don't normally use a pool allocator directly;
+    instead they declare pooled allocation (see PooledAllocation.h)
+    and then the existing "new (std::nothrow)" and "delete" code uses the pool automatically
+*/
+
+#ifndef EAE6320_MEMORY_CPOOLALLOCATOR_H
+#define EAE6320_MEMORY_CPOOLALLOCATOR_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Concurrency/cMutex.h>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+    namespace Memory
+    {
+        class cPoolAllocator
+        {
+            // Interface
+            //==========
+
+        public:
+
+            struct sStatistics
+            {
+                size_t blockSize = 0;
+                size_t slabSize = 0;
+                uint32_t blockCount_live = 0;
+                uint32_t blockCount_peak = 0;
+                uint32_t blockCount_capacity = 0;
+                uint32_t slabCount = 0;
+                uint32_t allocationCount = 0;
+                uint32_t failedAllocationCount = 0;
+            };
+
+            // Allocation
+            //-----------
+
+            // This returns nullptr if a new slab was needed and couldn't be allocated
+            // (or if more memory was requested than the pool's block size)
+            void* Allocate( const size_t i_size );
+            // The memory must have been allocated from this pool
+            void Deallocate( void* const i_block );
+
+            // Statistics
+            //-----------
+
+            sStatistics GetStatistics() const;
+            const char* GetName() const { return m_name; }
+
+            // This outputs the statistics of every pool that has been constructed
+            static void OutputStatisticsOfAllPoolsToLog();
+
+            // Initialization / Clean Up
+            //--------------------------
+
+            // If a block count isn't specified then each slab will be roughly 16 KB
+            cPoolAllocator( const size_t i_blockSize, const size_t i_blockAlignment, const char* const i_name,
+                const uint32_t i_blockCountPerSlab = 0 );
+            // All blocks should have been deallocated before a pool is destroyed
+            ~cPoolAllocator();
+
+            cPoolAllocator( const cPoolAllocator& i_poolAllocator ) = delete;
+            cPoolAllocator& operator =( const cPoolAllocator& i_poolAllocator ) = delete;
+
+            // Data
+            //=====
+
+        private:
+
+            // A free block stores the pointer to the next free block
+            struct sFreeBlock
+            {
+                sFreeBlock* next;
+            };
+            // The first bytes of each slab store the pointer to the previously-allocated slab
+            // (the blocks follow, starting at the first suitably-aligned address)
+            struct sSlabHeader
+            {
+                sSlabHeader* previous;
+            };
+
+            mutable Concurrency::cMutex m_mutex;
+            sFreeBlock* m_freeList = nullptr;
+            sSlabHeader* m_newestSlab = nullptr;
+            const char* const m_name;
+            const size_t m_blockSize;
+            const size_t m_blockAlignment;
+            const uint32_t m_blockCountPerSlab;
+            sStatistics m_statistics;
+
+            // Implementation
+            //===============
+
+        private:
+
+            // This must be called while the mutex is held
+            bool AllocateSlab();
+        };
+    }
+}
+
+#endif	// EAE6320_MEMORY_CPOOLALLOCATOR_H
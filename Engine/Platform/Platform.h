@@ -50,8 +50,15 @@ namespace eae6320
 			const bool i_shouldFunctionFailIfTargetAlreadyExists = false, const bool i_shouldTargetFileTimeBeModified = false,
 			std::string* o_errorMessage = nullptr );
 		cResult CreateDirectoryIfItDoesntExist( const std::string& i_filePath, std::string* const o_errorMessage = nullptr );
+		// A hard link is a second path to the same file data (changing the file through either path changes both);
+		// it fails if the new path already exists or is on a different volume
+		cResult CreateHardLink( const char* const i_path_existingFile, const char* const i_path_newLink, std::string* const o_errorMessage = nullptr );
+		cResult DeleteFileIfItExists( const char* const i_path, std::string* const o_errorMessage = nullptr );
 		bool DoesFileExist( const char* const i_path, std::string* const o_errorMessage = nullptr );
 		cResult ExecuteCommand( const char* const i_command, int* const o_exitCode = nullptr, std::string* const o_errorMessage = nullptr );
+		// The command's standard output and standard error are returned in o_output instead of being shown in this process's console
+		cResult ExecuteCommandAndCaptureOutput( const char* const i_command, std::string& o_output,
+			int* const o_exitCode = nullptr, std::string* const o_errorMessage = nullptr );
 		cResult GetFilesInDirectory( const std::string& i_path, std::vector<std::string>& o_paths,
 			const bool i_shouldSubdirectoriesBeSearchedRecursively = true, std::string* const o_errorMessage = nullptr );
 		cResult GetEnvironmentVariable( const char* const i_key, std::string& o_value, std::string* const o_errorMessage = nullptr );
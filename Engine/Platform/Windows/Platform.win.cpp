@@ -22,6 +22,16 @@ eae6320::cResult eae6320::Platform::CreateDirectoryIfItDoesntExist( const std::s
 	return Windows::CreateDirectoryIfItDoesntExist( i_filePath, o_errorMessage );
 }
 
+eae6320::cResult eae6320::Platform::CreateHardLink( const char* const i_path_existingFile, const char* const i_path_newLink, std::string* const o_errorMessage )
+{
+	return Windows::CreateHardLink( i_path_existingFile, i_path_newLink, o_errorMessage );
+}
+
+eae6320::cResult eae6320::Platform::DeleteFileIfItExists( const char* const i_path, std::string* const o_errorMessage )
+{
+	return Windows::DeleteFileIfItExists( i_path, o_errorMessage );
+}
+
 bool eae6320::Platform::DoesFileExist( const char* const i_path, std::string* const o_errorMessage )
 {
 	return Windows::DoesFileExist( i_path, o_errorMessage );
@@ -39,6 +49,19 @@ eae6320::cResult eae6320::Platform::ExecuteCommand( const char* const i_command,
 	return result;
 }
 
+eae6320::cResult eae6320::Platform::ExecuteCommandAndCaptureOutput( const char* const i_command, std::string& o_output,
+	int* const o_exitCode, std::string* const o_errorMessage )
+{
+	DWORD exitCode_unsigned;
+	const auto result = Windows::ExecuteCommandAndCaptureOutput( i_command, o_output, &exitCode_unsigned, o_errorMessage );
+	if ( o_exitCode )
+	{
+		int32_t exitCode_signed = static_cast<int32_t>( exitCode_unsigned );
+		*o_exitCode = static_cast<int>( exitCode_signed );
+	}
+	return result;
+}
+
 eae6320::cResult eae6320::Platform::GetEnvironmentVariable( const char* const i_key, std::string& o_value, std::string* const o_errorMessage )
 {
 	return Windows::GetEnvironmentVariable( i_key, o_value, o_errorMessage );
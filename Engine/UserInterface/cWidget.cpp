@@ -22,7 +22,8 @@
 void eae6320::UserInterface::cWidget::SubmitDataToBeRendered(const float i_elapsedSecondCount_systemTime, const float i_elapsedSecondCount_sinceLastSimulationUpdate)
 {
     eae6320::Graphics::cTexture* texture = eae6320::Graphics::cTexture::s_manager.Get(m_texture);
-    eae6320::Graphics::SubmitSpriteToBeRendered(m_sprite, m_effect, texture);
+    eae6320::Graphics::cEffect* effect = eae6320::Graphics::cEffect::s_manager.Get(m_effect);
+    eae6320::Graphics::SubmitSpriteToBeRendered(m_sprite, effect, texture);
 }
 
 // Initialization / Clean Up
@@ -80,15 +81,15 @@ eae6320::cResult eae6320::UserInterface::cWidget::Initialize(const sInitializati
     // create the effect
     if (i_params.vertexShaderName && i_params.fragmentShaderName)
     {
-        eae6320::Graphics::cEffect* effect = nullptr;
-        if (!(result = eae6320::Graphics::cEffect::Create(effect, i_params.vertexShaderName, i_params.fragmentShaderName, Graphics::RenderStates::AlphaTransparency)))
+        eae6320::Graphics::cEffect::Handle effectHandle;
+        if (!(result = eae6320::Graphics::cEffect::Load(effectHandle, i_params.vertexShaderName, i_params.fragmentShaderName, Graphics::RenderStates::AlphaTransparency)))
         {
             EAE6320_ASSERT(false);
             goto OnExit;
         }
         else
         {
-            m_effect = effect;
+            m_effect = effectHandle;
         }
     }
     else
@@ -149,8 +150,15 @@ eae6320::cResult eae6320::UserInterface::cWidget::CleanUp()
 
     // Release the effect
     {
-        m_effect->DecrementReferenceCount();
-        m_effect = nullptr;
+        const auto localResult = eae6320::Graphics::cEffect::s_manager.Release(m_effect);
+        if (!localResult)
+        {
+            EAE6320_ASSERT(false);
+            if (result)
+            {
+                result = localResult;
+            }
+        }
     }
 
     // Release the texture
@@ -9,8 +9,10 @@
 //==============
 
 #include <Engine/Assets/ReferenceCountedAssets.h>
+#include <Engine/Graphics/cEffect.h>
 #include <Engine/Graphics/cTexture.h>
 #include <Engine/Math/sVector2d.h>
+#include <Engine/Memory/PooledAllocation.h>
 #include <Engine/Results/Results.h>
 
 // Forward Declarations
@@ -20,7 +22,6 @@ namespace eae6320
 {
     namespace Graphics
     {
-        class cEffect;
         class cSprite;
     }
 }
@@ -85,6 +86,11 @@ namespace eae6320
 
             EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS(cWidget);
 
+            // Memory Allocation
+            //------------------
+
+            EAE6320_MEMORY_DECLAREPOOLEDALLOCATION(cWidget);
+
         private:
 
             // Initialization / Clean Up
@@ -106,7 +112,7 @@ namespace eae6320
             //=====
 
         private:
-            Graphics::cEffect*                         m_effect = nullptr;
+            Graphics::cEffect::Handle                  m_effect;
             Graphics::cTexture::Handle                 m_texture;
             Graphics::cSprite*                         m_sprite = nullptr;
 
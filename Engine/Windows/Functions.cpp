@@ -192,6 +192,48 @@ OnExit:
 	return result;
 }
 
+eae6320::cResult eae6320::Windows::CreateHardLink( const char* const i_path_existingFile, const char* const i_path_newLink, std::string* const o_errorMessage )
+{
+	constexpr LPSECURITY_ATTRIBUTES reserved = NULL;
+	if ( ::CreateHardLink( i_path_newLink, i_path_existingFile, reserved ) != FALSE )
+	{
+		return Results::Success;
+	}
+	else
+	{
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = GetLastSystemError();
+		}
+		return Results::Failure;
+	}
+}
+
+eae6320::cResult eae6320::Windows::DeleteFileIfItExists( const char* const i_path, std::string* const o_errorMessage )
+{
+	if ( ::DeleteFile( i_path ) != FALSE )
+	{
+		return Results::Success;
+	}
+	else
+	{
+		DWORD errorCode;
+		const auto errorMessage = GetLastSystemError( &errorCode );
+		if ( ( errorCode == ERROR_FILE_NOT_FOUND ) || ( errorCode == ERROR_PATH_NOT_FOUND ) )
+		{
+			return Results::Success;
+		}
+		else
+		{
+			if ( o_errorMessage )
+			{
+				*o_errorMessage = errorMessage;
+			}
+			return Results::Failure;
+		}
+	}
+}
+
 bool eae6320::Windows::DoesFileExist( const char* const i_path, std::string* const o_errorMessage )
 {
 	// Try to get information about the file
@@ -427,6 +469,97 @@ eae6320::cResult eae6320::Windows::ExecuteCommand( const char* const i_path, con
 	}
 }
 
+eae6320::cResult eae6320::Windows::ExecuteCommandAndCaptureOutput( const char* const i_command, std::string& o_output,
+	DWORD* const o_exitCode, std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	o_output.clear();
+
+	HANDLE process = NULL;
+	HANDLE outputPipe_read = NULL;
+
+	// Start a new process
+	if ( !( result = StartProcessWithRedirectedIo( i_command, process, outputPipe_read, nullptr, o_errorMessage ) ) )
+	{
+		goto OnExit;
+	}
+	// Read the output until the pipe is closed
+	// (the pipe must be read while the process runs;
+	// otherwise the process would block once the pipe's buffer was full and never exit)
+	{
+		constexpr DWORD bufferSize = 4096;
+		char buffer[bufferSize];
+		DWORD readByteCount;
+		while ( ReadFile( outputPipe_read, buffer, bufferSize, &readByteCount, NULL ) != FALSE )
+		{
+			o_output.append( buffer, readByteCount );
+		}
+		DWORD windowsErrorCode;
+		const auto windowsErrorMessage = GetLastSystemError( &windowsErrorCode );
+		if ( windowsErrorCode != ERROR_BROKEN_PIPE )
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, "Couldn't read the output of a process: %s", windowsErrorMessage.c_str() );
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to read the output of the process \"" << i_command << "\": " << windowsErrorMessage;
+				*o_errorMessage = errorMessage.str();
+			}
+		}
+	}
+	// Wait for the process to finish
+	if ( WaitForSingleObject( process, INFINITE ) != WAIT_FAILED )
+	{
+		// Get the exit code
+		if ( o_exitCode )
+		{
+			if ( GetExitCodeProcess( process, o_exitCode ) == FALSE )
+			{
+				const auto windowsErrorMessage = GetLastSystemError();
+				result = Results::Failure;
+				EAE6320_ASSERTF( false, "Couldn't get exit code of a process: %s", windowsErrorMessage.c_str() );
+				if ( o_errorMessage )
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "Windows failed to get the exit code of the process \"" << i_command <<
+						"\": " << windowsErrorMessage;
+					*o_errorMessage = errorMessage.str();
+				}
+			}
+		}
+	}
+	else
+	{
+		const auto windowsErrorMessage = GetLastSystemError();
+		result = Results::Failure;
+		EAE6320_ASSERTF( false, "Didn't wait for a process to finish: %s", windowsErrorMessage.c_str() );
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "Windows failed to wait for the process \"" << i_command <<
+				"\" to finish: " << windowsErrorMessage;
+			*o_errorMessage = errorMessage.str();
+		}
+	}
+
+OnExit:
+
+	if ( process )
+	{
+		CloseHandle( process );
+		process = NULL;
+	}
+	if ( outputPipe_read )
+	{
+		CloseHandle( outputPipe_read );
+		outputPipe_read = NULL;
+	}
+
+	return result;
+}
+
 eae6320::cResult eae6320::Windows::GetFilesInDirectory( const std::string& i_path, std::vector<std::string>& o_paths,
 	const bool i_shouldSubdirectoriesBeSearchedRecursively, std::string* const o_errorMessage )
 {
@@ -936,6 +1069,239 @@ void eae6320::Windows::OutputWarningMessageForVisualStudio( const char* const i_
 	OutputMessageForVisualStudio( "warning", i_errorMessage, i_optionalFilePath, i_optionalLineNumber, i_optionalColumnNumber );
 }
 
+eae6320::cResult eae6320::Windows::StartProcessWithRedirectedIo( const char* const i_command, HANDLE& o_process, HANDLE& o_output_read,
+	HANDLE* const o_input_write, std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	o_process = NULL;
+	o_output_read = NULL;
+	if ( o_input_write )
+	{
+		*o_input_write = NULL;
+	}
+
+	HANDLE outputPipe_read = NULL;
+	HANDLE outputPipe_write = NULL;
+	HANDLE inputPipe_write = NULL;
+	HANDLE input = INVALID_HANDLE_VALUE;
+	std::vector<uint8_t> attributeListBuffer;
+	LPPROC_THREAD_ATTRIBUTE_LIST attributeList = NULL;
+	HANDLE handlesToInherit[2]{};
+	PROCESS_INFORMATION processInformation{};
+
+	// Create a pipe that the new process will write its output to
+	// and either a pipe or a handle to the null device that it will read its input from
+	{
+		SECURITY_ATTRIBUTES inheritableAttributes{};
+		{
+			inheritableAttributes.nLength = sizeof( inheritableAttributes );
+			inheritableAttributes.bInheritHandle = TRUE;
+		}
+		constexpr DWORD useDefaultBufferSize = 0;
+		if ( CreatePipe( &outputPipe_read, &outputPipe_write, &inheritableAttributes, useDefaultBufferSize ) == FALSE )
+		{
+			const auto windowsErrorMessage = GetLastSystemError();
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, "Couldn't create a pipe to capture output: %s", windowsErrorMessage.c_str() );
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to create a pipe to capture the output of \"" << i_command << "\": " << windowsErrorMessage;
+				*o_errorMessage = errorMessage.str();
+			}
+			goto OnExit;
+		}
+		// Only this process reads from the pipe
+		if ( SetHandleInformation( outputPipe_read, HANDLE_FLAG_INHERIT, 0 ) == FALSE )
+		{
+			const auto windowsErrorMessage = GetLastSystemError();
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, "Couldn't make the read end of a pipe uninheritable: %s", windowsErrorMessage.c_str() );
+			if ( o_errorMessage )
+			{
+				*o_errorMessage = windowsErrorMessage;
+			}
+			goto OnExit;
+		}
+		if ( o_input_write )
+		{
+			if ( CreatePipe( &input, &inputPipe_write, &inheritableAttributes, useDefaultBufferSize ) == FALSE )
+			{
+				const auto windowsErrorMessage = GetLastSystemError();
+				input = INVALID_HANDLE_VALUE;
+				result = Results::Failure;
+				EAE6320_ASSERTF( false, "Couldn't create a pipe to send input: %s", windowsErrorMessage.c_str() );
+				if ( o_errorMessage )
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "Windows failed to create a pipe to send input to \"" << i_command << "\": " << windowsErrorMessage;
+					*o_errorMessage = errorMessage.str();
+				}
+				goto OnExit;
+			}
+			// Only this process writes to the pipe
+			if ( SetHandleInformation( inputPipe_write, HANDLE_FLAG_INHERIT, 0 ) == FALSE )
+			{
+				const auto windowsErrorMessage = GetLastSystemError();
+				result = Results::Failure;
+				EAE6320_ASSERTF( false, "Couldn't make the write end of a pipe uninheritable: %s", windowsErrorMessage.c_str() );
+				if ( o_errorMessage )
+				{
+					*o_errorMessage = windowsErrorMessage;
+				}
+				goto OnExit;
+			}
+		}
+		else
+		{
+			input = CreateFile( "NUL", GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, &inheritableAttributes,
+				OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+			if ( input == INVALID_HANDLE_VALUE )
+			{
+				const auto windowsErrorMessage = GetLastSystemError();
+				result = Results::Failure;
+				EAE6320_ASSERTF( false, "Couldn't open the null device: %s", windowsErrorMessage.c_str() );
+				if ( o_errorMessage )
+				{
+					*o_errorMessage = windowsErrorMessage;
+				}
+				goto OnExit;
+			}
+		}
+	}
+	// Restrict the handles that the new process inherits to the ones that it needs
+	// (otherwise processes that are started at the same time from other threads
+	// would also inherit these pipes, and they wouldn't be closed until all of them had exited)
+	{
+		handlesToInherit[0] = outputPipe_write;
+		handlesToInherit[1] = input;
+		constexpr DWORD attributeCount = 1;
+		constexpr DWORD reserved = 0;
+		SIZE_T attributeListSize = 0;
+		InitializeProcThreadAttributeList( NULL, attributeCount, reserved, &attributeListSize );
+		attributeListBuffer.resize( attributeListSize );
+		attributeList = reinterpret_cast<LPPROC_THREAD_ATTRIBUTE_LIST>( attributeListBuffer.data() );
+		if ( InitializeProcThreadAttributeList( attributeList, attributeCount, reserved, &attributeListSize ) == FALSE )
+		{
+			const auto windowsErrorMessage = GetLastSystemError();
+			attributeList = NULL;
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, "Couldn't initialize a process attribute list: %s", windowsErrorMessage.c_str() );
+			if ( o_errorMessage )
+			{
+				*o_errorMessage = windowsErrorMessage;
+			}
+			goto OnExit;
+		}
+		if ( UpdateProcThreadAttribute( attributeList, reserved, PROC_THREAD_ATTRIBUTE_HANDLE_LIST,
+			handlesToInherit, sizeof( handlesToInherit ), NULL, NULL ) == FALSE )
+		{
+			const auto windowsErrorMessage = GetLastSystemError();
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, "Couldn't set the handles for a process to inherit: %s", windowsErrorMessage.c_str() );
+			if ( o_errorMessage )
+			{
+				*o_errorMessage = windowsErrorMessage;
+			}
+			goto OnExit;
+		}
+	}
+	// Start a new process
+	{
+		// CreateProcess() can modify the command line and so it must be non-const
+		// (the command line is used as-is, and so unlike ExecuteCommand() its length isn't limited)
+		std::vector<char> commandLine( i_command, i_command + strlen( i_command ) + 1 );
+		constexpr SECURITY_ATTRIBUTES* useDefaultAttributes = nullptr;
+		constexpr BOOL inheritHandles = TRUE;
+		constexpr DWORD createProcessWithExtendedStartupInfo = EXTENDED_STARTUPINFO_PRESENT;
+		constexpr void* const useCallingProcessEnvironment = nullptr;
+		constexpr char* const useCallingProcessCurrentDirectory = nullptr;
+		STARTUPINFOEX startupInfo{};
+		{
+			startupInfo.StartupInfo.cb = sizeof( startupInfo );
+			startupInfo.StartupInfo.dwFlags = STARTF_USESTDHANDLES;
+			startupInfo.StartupInfo.hStdInput = input;
+			// Both standard output and standard error are written to the pipe
+			// so that their messages stay in the order that they were output
+			startupInfo.StartupInfo.hStdOutput = outputPipe_write;
+			startupInfo.StartupInfo.hStdError = outputPipe_write;
+			startupInfo.lpAttributeList = attributeList;
+		}
+		if ( CreateProcess( NULL, commandLine.data(), useDefaultAttributes, useDefaultAttributes,
+			inheritHandles, createProcessWithExtendedStartupInfo, useCallingProcessEnvironment, useCallingProcessCurrentDirectory,
+			&startupInfo.StartupInfo, &processInformation ) == FALSE )
+		{
+			DWORD windowsErrorCode;
+			const auto windowsErrorMessage = GetLastSystemError( &windowsErrorCode );
+			result = ( ( windowsErrorCode == ERROR_FILE_NOT_FOUND ) || ( windowsErrorCode == ERROR_PATH_NOT_FOUND ) )
+				? Results::FileDoesntExist : Results::Failure;
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to start the process \"" << i_command << "\": " << windowsErrorMessage;
+				*o_errorMessage = errorMessage.str();
+			}
+			goto OnExit;
+		}
+	}
+	// The handles are given to the caller
+	{
+		o_process = processInformation.hProcess;
+		processInformation.hProcess = NULL;
+		o_output_read = outputPipe_read;
+		outputPipe_read = NULL;
+		if ( o_input_write )
+		{
+			*o_input_write = inputPipe_write;
+			inputPipe_write = NULL;
+		}
+	}
+
+OnExit:
+
+	// This process's copies of the ends of the pipes that the new process uses must be closed
+	// so that reading from the output pipe stops when the new process exits
+	// (and so that the new process's input ends when the caller closes its end)
+	if ( processInformation.hProcess )
+	{
+		CloseHandle( processInformation.hProcess );
+		processInformation.hProcess = NULL;
+	}
+	if ( processInformation.hThread )
+	{
+		CloseHandle( processInformation.hThread );
+		processInformation.hThread = NULL;
+	}
+	if ( attributeList )
+	{
+		DeleteProcThreadAttributeList( attributeList );
+		attributeList = NULL;
+	}
+	if ( input != INVALID_HANDLE_VALUE )
+	{
+		CloseHandle( input );
+		input = INVALID_HANDLE_VALUE;
+	}
+	if ( inputPipe_write )
+	{
+		CloseHandle( inputPipe_write );
+		inputPipe_write = NULL;
+	}
+	if ( outputPipe_write )
+	{
+		CloseHandle( outputPipe_write );
+		outputPipe_write = NULL;
+	}
+	if ( outputPipe_read )
+	{
+		CloseHandle( outputPipe_read );
+		outputPipe_read = NULL;
+	}
+
+	return result;
+}
+
 eae6320::cResult eae6320::Windows::WriteBinaryFile( const char* const i_path, const void* const i_data, const size_t i_size, std::string* const o_errorMessage )
 {
 	auto result = Results::Success;
@@ -42,10 +42,18 @@ namespace eae6320
 			const bool i_shouldFunctionFailIfTargetAlreadyExists = false, const bool i_shouldTargetFileTimeBeModified = false,
 			std::string* o_errorMessage = nullptr );
 		cResult CreateDirectoryIfItDoesntExist( const std::string& i_filePath, std::string* const o_errorMessage = nullptr );
+		// A hard link is a second path to the same file data (changing the file through either path changes both);
+		// it fails if the new path already exists or is on a different volume
+		cResult CreateHardLink( const char* const i_path_existingFile, const char* const i_path_newLink, std::string* const o_errorMessage = nullptr );
+		cResult DeleteFileIfItExists( const char* const i_path, std::string* const o_errorMessage = nullptr );
 		bool DoesFileExist( const char* const i_path, std::string* const o_errorMessage = nullptr );
 		cResult ExecuteCommand( const char* const i_command, DWORD* const o_exitCode = nullptr, std::string* const o_errorMessage = nullptr );
 		cResult ExecuteCommand( const char* const i_path, const char* const i_optionalArguments = nullptr,
 			DWORD* const o_exitCode = nullptr, std::string* const o_errorMessage = nullptr );
+		// The command's standard output and standard error are returned in o_output instead of being shown in this process's console
+		// (this is thread-safe, and so multiple commands can be executed at the same time without their output being interleaved)
+		cResult ExecuteCommandAndCaptureOutput( const char* const i_command, std::string& o_output,
+			DWORD* const o_exitCode = nullptr, std::string* const o_errorMessage = nullptr );
 		cResult GetFilesInDirectory( const std::string& i_path, std::vector<std::string>& o_paths,
 			const bool i_shouldSubdirectoriesBeSearchedRecursively = true, std::string* const o_errorMessage = nullptr );
 		cResult GetEnvironmentVariable( const char* const i_key, std::string& o_value, std::string* const o_errorMessage = nullptr );
@@ -58,6 +66,12 @@ namespace eae6320
 			const unsigned int* const i_optionalLineNumber = nullptr, const unsigned int* const i_optionalColumnNumber = nullptr );
 		void OutputWarningMessageForVisualStudio( const char* const i_errorMessage, const char* const i_optionalFilePath = nullptr,
 			const unsigned int* const i_optionalLineNumber = nullptr, const unsigned int* const i_optionalColumnNumber = nullptr );
+		// The new process's standard output and standard error are written to a pipe that the caller reads from o_output_read.
+		// If o_input_write is provided the new process's standard input is read from a pipe that the caller writes to
+		// (otherwise the new process gets no input).
+		// The caller must close every returned handle
+		cResult StartProcessWithRedirectedIo( const char* const i_command, HANDLE& o_process, HANDLE& o_output_read,
+			HANDLE* const o_input_write = nullptr, std::string* const o_errorMessage = nullptr );
 		cResult WriteBinaryFile( const char* const i_path, const void* const i_data, const size_t i_size, std::string* const o_errorMessage = nullptr );
 	}
 }
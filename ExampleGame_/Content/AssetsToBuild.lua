@@ -7,14 +7,16 @@ return
     meshes =
     {
         "Meshes/Ring.mesh",
-        "Meshes/Ship.mesh",
+        { path = "Meshes/Ship.mesh", arguments = { "optimizeOverdraw", "quantizeVertices" } },
         "Meshes/SkyBox.mesh"
     },
     shaders =
     {
         { path = "Shaders/Vertex/vertexInputLayout_mesh.xlsl", arguments = { "vertex" } },
         { path = "Shaders/Vertex/mesh.xlsl", arguments = { "vertex" } },
-        { path = "Shaders/Fragment/mesh.xlsl", arguments = { "fragment" } }
+        { path = "Shaders/Vertex/skyBox.xlsl", arguments = { "vertex" } },
+        { path = "Shaders/Fragment/mesh.xlsl", arguments = { "fragment" } },
+        { path = "Shaders/Fragment/depthOnly.xlsl", arguments = { "fragment" } }
     },
     textures =
     {
@@ -7,12 +7,14 @@
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Graphics/cEffect.h>
 #include <Engine/Graphics/cMesh.h>
+#include <Engine/Graphics/cShader.h>
 #include <Engine/Graphics/cSprite.h>
 #include <Engine/Graphics/Graphics.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/Math/cMatrix_transformation.h>
 #include <Engine/Math/sVector.h>
 #include <Engine/Math/sVector2d.h>
+#include <Engine/Memory/cPoolAllocator.h>
 #include <Engine/UserInput/UserInput.h>
 #include <Engine/UserInterface/cWidget.h>
 
@@ -80,11 +82,10 @@ void eae6320::cExampleGame::SubmitDataToBeRendered(const float i_elapsedSecondCo
 
         if (m_skyBoxEnabled)
         {
-            static const Math::cQuaternion skyBoxOrientation;
-
             Graphics::cMesh* mesh = Graphics::cMesh::s_manager.Get(m_skyBoxMesh);
             Graphics::cTexture* texture = Graphics::cTexture::s_manager.Get(m_skyBoxTexture);
-            Graphics::SubmitMeshToBeRendered(mesh, m_skyBoxEffect, texture, predictedPosition, skyBoxOrientation);
+            Graphics::cEffect* effect = Graphics::cEffect::s_manager.Get(m_skyBoxEffect);
+            Graphics::SubmitSkyBoxToBeRendered(mesh, effect, texture, predictedPosition);
         }
     }
 
@@ -160,6 +161,14 @@ eae6320::cResult eae6320::cExampleGame::Initialize()
         goto OnExit;
     }
 
+    // Report which assets were loaded and where the load time went
+    Graphics::cMesh::s_manager.OutputInventoryToLog("Mesh");
+    Graphics::cTexture::s_manager.OutputInventoryToLog("Texture");
+    Graphics::cShader::s_manager.OutputInventoryToLog("Shader");
+    Graphics::cEffect::s_manager.OutputInventoryToLog("Effect");
+    // and how full the object pools are
+    Memory::cPoolAllocator::OutputStatisticsOfAllPoolsToLog();
+
 OnExit:
 
     return result;
@@ -198,8 +207,12 @@ eae6320::cResult eae6320::cExampleGame::CleanUp()
         }
 
         {
-            m_skyBoxEffect->DecrementReferenceCount();
-            m_skyBoxEffect = nullptr;
+            const auto localResult = Graphics::cEffect::s_manager.Release(m_skyBoxEffect);
+            if (!localResult)
+            {
+                EAE6320_ASSERT(false);
+                result = result ? localResult : result;
+            }
         }
     }
 
@@ -313,7 +326,9 @@ eae6320::cResult eae6320::cExampleGame::InitializeSkyBox()
 {
     cResult result = Results::Success;
 
-    if (!(result = Graphics::cEffect::Create(m_skyBoxEffect, s_meshVertexShaderFilePath.c_str(), s_meshFragmentShaderFilePath.c_str(), 0)))
+    // The sky box's vertex shader puts it at the far plane,
+    // and so it is drawn after the other meshes and only where the depth test shows that nothing else was drawn
+    if (!(result = Graphics::cEffect::Load(m_skyBoxEffect, "data/Shaders/Vertex/skyBox.shd", s_meshFragmentShaderFilePath.c_str(), Graphics::RenderStates::DepthBuffering)))
     {
         EAE6320_ASSERT(false);
         goto OnExit;
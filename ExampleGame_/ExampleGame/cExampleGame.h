@@ -9,6 +9,7 @@
 //==============
 
 #include <Engine/Application/cbApplication.h>
+#include <Engine/Graphics/cEffect.h>
 #include <Engine/Graphics/cMesh.h>
 #include <Engine/Graphics/cTexture.h>
 #include <Engine/Graphics/sCamera.h>
@@ -29,7 +30,6 @@ namespace eae6320
 {
     namespace Graphics
     {
-        class cEffect;
         class cSprite;
     }
 
@@ -97,6 +97,9 @@ namespace eae6320
         virtual const WORD* GetLargeIconId() const override { static constexpr WORD iconId_large = IDI_EAEALIEN; return &iconId_large; }
         virtual const WORD* GetSmallIconId() const override { static constexpr WORD iconId_small = IDI_EAEALIEN; return &iconId_small; }
 #endif
+        // The assets that the game loads are the same every run,
+        // and so they are recorded and prefetched the next time that the game starts
+        virtual const char* GetAssetPrefetchManifestPath() const override { return "assetPrefetch.manifest"; }
 
         // Run
         //----
@@ -142,7 +145,7 @@ namespace eae6320
 
         bool                                                m_skyBoxEnabled = true;
         Graphics::cMesh::Handle                             m_skyBoxMesh;
-        Graphics::cEffect*                                  m_skyBoxEffect = nullptr;
+        Graphics::cEffect::Handle                           m_skyBoxEffect;
         Graphics::cTexture::Handle                          m_skyBoxTexture;
 
         const uint8_t                                       m_shipIndex = 0;
@@ -105,7 +105,7 @@ eae6320::cResult eae6320::cGameObject::Initialize(const sGameObjectinitializatio
 
     // Initialize the effect
     {
-        if (!(result = Graphics::cEffect::Create(m_effect, i_initializationParameters.vertexShaderFilePath->c_str(), i_initializationParameters.fragmentShaderFilePath->c_str(), Graphics::RenderStates::DepthBuffering)))
+        if (!(result = Graphics::cEffect::Load(m_effect, i_initializationParameters.vertexShaderFilePath->c_str(), i_initializationParameters.fragmentShaderFilePath->c_str(), Graphics::RenderStates::DepthBuffering)))
         {
             EAE6320_ASSERT(false);
             goto OnExit;
@@ -137,9 +137,7 @@ OnExit:
 
 eae6320::cResult eae6320::cGameObject::CleanUp()
 {
-    m_effect->DecrementReferenceCount();
-    m_effect = nullptr;
-
+    Graphics::cEffect::s_manager.Release(m_effect);
     Graphics::cTexture::s_manager.Release(m_texture);
     Graphics::cMesh::s_manager.Release(m_mesh);
 
@@ -204,6 +202,7 @@ void eae6320::cGameObject::SubmitDataToBeRendered(const float i_elapsedSecondCou
     
     Graphics::cMesh* mesh = Graphics::cMesh::s_manager.Get(m_mesh);
     Graphics::cTexture* texture = Graphics::cTexture::s_manager.Get(m_texture);
+    Graphics::cEffect* effect = Graphics::cEffect::s_manager.Get(m_effect);
     
-    Graphics::SubmitMeshToBeRendered(mesh, m_effect, texture, predictedPosition, predictedOrientation);
+    Graphics::SubmitMeshToBeRendered(mesh, effect, texture, predictedPosition, predictedOrientation);
 }
@@ -8,10 +8,12 @@
 // Include Files
 //==============
 
+#include <Engine/Graphics/cEffect.h>
 #include <Engine/Graphics/cMesh.h>
 #include <Engine/Graphics/cTexture.h>
 #include <Engine/Math/Constants.h>
 #include <Engine/Math/sVector2d.h>
+#include <Engine/Memory/PooledAllocation.h>
 #include <Engine/Physics/sRigidBodyState.h>
 #include <Engine/Results/Results.h>
 
@@ -22,7 +24,6 @@ namespace eae6320
 {
     namespace Graphics
     {
-        class cEffect;
         struct sColor;
     }
     namespace Math
@@ -70,6 +71,12 @@ namespace eae6320
         static cResult Create(cGameObject*& o_gameObject, const sGameObjectinitializationParameters& i_initializationParameters);
         static cResult Destroy(cGameObject*& i_gameObject);
 
+        // Memory Allocation
+        //------------------
+
+        // Game objects are allocated from a pool so that iterating over them is cache-friendly
+        EAE6320_MEMORY_DECLAREPOOLEDALLOCATION(cGameObject);
+
         // Behavior
         //---------
 
@@ -121,7 +128,7 @@ namespace eae6320
         static const float                  s_angularDamping;
 
     private:
-        Graphics::cEffect*                  m_effect = nullptr;
+        Graphics::cEffect::Handle           m_effect;
         Graphics::cMesh::Handle             m_mesh;
         Graphics::cTexture::Handle          m_texture;
         Physics::sRigidBodyState            m_rigidBodyState;
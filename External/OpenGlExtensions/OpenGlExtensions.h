@@ -28,6 +28,7 @@
 
 extern PFNGLACTIVETEXTUREPROC glActiveTexture;
 extern PFNGLATTACHSHADERPROC glAttachShader;
+extern PFNGLBEGINQUERYPROC glBeginQuery;
 extern PFNGLBINDBUFFERPROC glBindBuffer;
 extern PFNGLBINDBUFFERBASEPROC glBindBufferBase;
 extern PFNGLBINDSAMPLERPROC glBindSampler;
@@ -35,28 +36,46 @@ extern PFNGLBINDVERTEXARRAYPROC glBindVertexArray;
 extern PFNGLBLENDEQUATIONPROC glBlendEquation;
 extern PFNGLBUFFERDATAPROC glBufferData;
 extern PFNGLBUFFERSUBDATAPROC glBufferSubData;
+extern PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
 extern PFNGLCOMPILESHADERPROC glCompileShader;
 extern PFNGLCOMPRESSEDTEXIMAGE2DPROC glCompressedTexImage2D;
+extern PFNGLCOMPRESSEDTEXIMAGE3DPROC glCompressedTexImage3D;
+extern PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC glCompressedTexSubImage3D;
+extern PFNGLCOPYBUFFERSUBDATAPROC glCopyBufferSubData;
 extern PFNGLCREATEPROGRAMPROC glCreateProgram;
 extern PFNGLCREATESHADERPROC glCreateShader;
 extern PFNGLDELETEBUFFERSPROC glDeleteBuffers;
 extern PFNGLDELETEPROGRAMPROC glDeleteProgram;
+extern PFNGLDELETEQUERIESPROC glDeleteQueries;
 extern PFNGLDELETESAMPLERSPROC glDeleteSamplers;
 extern PFNGLDELETESHADERPROC glDeleteShader;
+extern PFNGLDELETESYNCPROC glDeleteSync;
 extern PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays;
+extern PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC glDrawElementsInstancedBaseVertexBaseInstance;
 extern PFNGLENABLEVERTEXATTRIBARRAYARBPROC glEnableVertexAttribArray;
+extern PFNGLENDQUERYPROC glEndQuery;
+extern PFNGLFENCESYNCPROC glFenceSync;
 extern PFNGLGENBUFFERSPROC glGenBuffers;
+extern PFNGLGENQUERIESPROC glGenQueries;
 extern PFNGLGENSAMPLERSPROC glGenSamplers;
 extern PFNGLGENVERTEXARRAYSPROC glGenVertexArrays;
+extern PFNGLGETPROGRAMBINARYPROC glGetProgramBinary;
 extern PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog;
 extern PFNGLGETPROGRAMIVPROC glGetProgramiv;
+extern PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v;
+extern PFNGLGETQUERYOBJECTUIVPROC glGetQueryObjectuiv;
 extern PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog;
 extern PFNGLGETSHADERIVPROC glGetShaderiv;
 extern PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation;
 extern PFNGLINVALIDATEBUFFERDATAPROC glInvalidateBufferData;
 extern PFNGLLINKPROGRAMPROC glLinkProgram;
+extern PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
+extern PFNGLPROGRAMBINARYPROC glProgramBinary;
+extern PFNGLPROGRAMPARAMETERIPROC glProgramParameteri;
 extern PFNGLSAMPLERPARAMETERIPROC glSamplerParameteri;
 extern PFNGLSHADERSOURCEPROC glShaderSource;
+extern PFNGLTEXIMAGE3DPROC glTexImage3D;
+extern PFNGLTEXSTORAGE3DPROC glTexStorage3D;
 extern PFNGLUNIFORM1FVPROC glUniform1fv;
 extern PFNGLUNIFORM1IPROC glUniform1i;
 extern PFNGLUNIFORM2FVPROC glUniform2fv;
@@ -64,8 +83,14 @@ extern PFNGLUNIFORM3FVPROC glUniform3fv;
 extern PFNGLUNIFORM4FVPROC glUniform4fv;
 extern PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBinding;
 extern PFNGLUNIFORMMATRIX4FVPROC glUniformMatrix4fv;
+extern PFNGLUNMAPBUFFERPROC glUnmapBuffer;
 extern PFNGLUSEPROGRAMPROC glUseProgram;
+extern PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor;
 extern PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer;
+// These are optional (they are newer than the version of OpenGL that is required)
+// and will be null if the driver doesn't support them
+extern PFNGLBUFFERSTORAGEPROC glBufferStorage;
+extern PFNGLMULTIDRAWELEMENTSINDIRECTPROC glMultiDrawElementsIndirect;
 #if defined( EAE6320_PLATFORM_WINDOWS )
 	extern PFNWGLCHOOSEPIXELFORMATARBPROC wglChoosePixelFormatARB;
 	extern PFNWGLCREATECONTEXTATTRIBSARBPROC wglCreateContextAttribsARB;
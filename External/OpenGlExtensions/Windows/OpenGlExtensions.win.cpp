@@ -14,6 +14,8 @@
 namespace
 {
 	const void* GetGlFunctionAddress( const char* const i_functionName, std::string* const o_errorMessage );
+	// This returns null without reporting an error if the function isn't found
+	const void* GetOptionalGlFunctionAddress( const char* const i_functionName );
 }
 
 // Interface
@@ -24,6 +26,7 @@ namespace
 
 PFNGLACTIVETEXTUREPROC glActiveTexture = nullptr;
 PFNGLATTACHSHADERPROC glAttachShader = nullptr;
+PFNGLBEGINQUERYPROC glBeginQuery = nullptr;
 PFNGLBINDBUFFERPROC glBindBuffer = nullptr;
 PFNGLBINDBUFFERBASEPROC glBindBufferBase = nullptr;
 PFNGLBINDSAMPLERPROC glBindSampler = nullptr;
@@ -31,28 +34,47 @@ PFNGLBINDVERTEXARRAYPROC glBindVertexArray = nullptr;
 PFNGLBLENDEQUATIONPROC glBlendEquation = nullptr;
 PFNGLBUFFERDATAPROC glBufferData = nullptr;
 PFNGLBUFFERSUBDATAPROC glBufferSubData = nullptr;
+PFNGLCLIENTWAITSYNCPROC glClientWaitSync = nullptr;
 PFNGLCOMPILESHADERPROC glCompileShader = nullptr;
 PFNGLCOMPRESSEDTEXIMAGE2DPROC glCompressedTexImage2D = nullptr;
+PFNGLCOMPRESSEDTEXIMAGE3DPROC glCompressedTexImage3D = nullptr;
+PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC glCompressedTexSubImage3D = nullptr;
+PFNGLCOPYBUFFERSUBDATAPROC glCopyBufferSubData = nullptr;
 PFNGLCREATEPROGRAMPROC glCreateProgram = nullptr;
 PFNGLCREATESHADERPROC glCreateShader = nullptr;
 PFNGLDELETEBUFFERSPROC glDeleteBuffers = nullptr;
 PFNGLDELETEPROGRAMPROC glDeleteProgram = nullptr;
+PFNGLDELETEQUERIESPROC glDeleteQueries = nullptr;
 PFNGLDELETESAMPLERSPROC glDeleteSamplers = nullptr;
 PFNGLDELETESHADERPROC glDeleteShader = nullptr;
+PFNGLDELETESYNCPROC glDeleteSync = nullptr;
 PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays = nullptr;
+PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC glDrawElementsInstancedBaseVertexBaseInstance = nullptr;
 PFNGLENABLEVERTEXATTRIBARRAYARBPROC glEnableVertexAttribArray = nullptr;
+PFNGLENDQUERYPROC glEndQuery = nullptr;
+PFNGLFENCESYNCPROC glFenceSync = nullptr;
 PFNGLGENBUFFERSPROC glGenBuffers = nullptr;
+PFNGLGENQUERIESPROC glGenQueries = nullptr;
 PFNGLGENSAMPLERSPROC glGenSamplers = nullptr;
 PFNGLGENVERTEXARRAYSPROC glGenVertexArrays = nullptr;
+PFNGLGETPROGRAMBINARYPROC glGetProgramBinary = nullptr;
 PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog = nullptr;
 PFNGLGETPROGRAMIVPROC glGetProgramiv = nullptr;
+PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v = nullptr;
+PFNGLGETQUERYOBJECTUIVPROC glGetQueryObjectuiv = nullptr;
 PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog = nullptr;
 PFNGLGETSHADERIVPROC glGetShaderiv = nullptr;
 PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation = nullptr;
 PFNGLINVALIDATEBUFFERDATAPROC glInvalidateBufferData = nullptr;
 PFNGLLINKPROGRAMPROC glLinkProgram = nullptr;
+PFNGLMAPBUFFERRANGEPROC glMapBufferRange = nullptr;
+PFNGLPROGRAMBINARYPROC glProgramBinary = nullptr;
+PFNGLPROGRAMPARAMETERIPROC glProgramParameteri = nullptr;
 PFNGLSAMPLERPARAMETERIPROC glSamplerParameteri = nullptr;
 PFNGLSHADERSOURCEPROC glShaderSource = nullptr;
+PFNGLTEXIMAGE3DPROC glTexImage3D = nullptr;
+PFNGLTEXSTORAGE3DPROC glTexStorage3D = nullptr;
+PFNGLUNMAPBUFFERPROC glUnmapBuffer = nullptr;
 PFNGLUSEPROGRAMPROC glUseProgram = nullptr;
 PFNGLUNIFORM1FVPROC glUniform1fv = nullptr;
 PFNGLUNIFORM1IPROC glUniform1i = nullptr;
@@ -61,7 +83,10 @@ PFNGLUNIFORM3FVPROC glUniform3fv = nullptr;
 PFNGLUNIFORM4FVPROC glUniform4fv = nullptr;
 PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBinding = nullptr;
 PFNGLUNIFORMMATRIX4FVPROC glUniformMatrix4fv = nullptr;
+PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor = nullptr;
 PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer = nullptr;
+PFNGLBUFFERSTORAGEPROC glBufferStorage = nullptr;
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC glMultiDrawElementsIndirect = nullptr;
 PFNWGLCHOOSEPIXELFORMATARBPROC wglChoosePixelFormatARB = nullptr;
 PFNWGLCREATECONTEXTATTRIBSARBPROC wglCreateContextAttribsARB = nullptr;
 
@@ -101,6 +126,7 @@ eae6320::cResult eae6320::OpenGlExtensions::Load( std::string* const o_errorMess
 
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glActiveTexture, PFNGLACTIVETEXTUREPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glAttachShader, PFNGLATTACHSHADERPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBeginQuery, PFNGLBEGINQUERYPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBindBuffer, PFNGLBINDBUFFERPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBindBufferBase, PFNGLBINDBUFFERBASEPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBindSampler, PFNGLBINDSAMPLERPROC );
@@ -108,28 +134,46 @@ eae6320::cResult eae6320::OpenGlExtensions::Load( std::string* const o_errorMess
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBlendEquation, PFNGLBLENDEQUATIONPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBufferData, PFNGLBUFFERDATAPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBufferSubData, PFNGLBUFFERSUBDATAPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glClientWaitSync, PFNGLCLIENTWAITSYNCPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glCompileShader, PFNGLCOMPILESHADERPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glCompressedTexImage2D, PFNGLCOMPRESSEDTEXIMAGE2DPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glCompressedTexImage3D, PFNGLCOMPRESSEDTEXIMAGE3DPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glCompressedTexSubImage3D, PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glCopyBufferSubData, PFNGLCOPYBUFFERSUBDATAPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glCreateProgram, PFNGLCREATEPROGRAMPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glCreateShader, PFNGLCREATESHADERPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDeleteBuffers, PFNGLDELETEBUFFERSPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDeleteProgram, PFNGLDELETEPROGRAMPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDeleteQueries, PFNGLDELETEQUERIESPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDeleteSync, PFNGLDELETESYNCPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDeleteVertexArrays, PFNGLDELETEVERTEXARRAYSPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDeleteSamplers, PFNGLDELETESAMPLERSPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDeleteShader, PFNGLDELETESHADERPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDrawElementsInstancedBaseVertexBaseInstance, PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glEnableVertexAttribArray, PFNGLENABLEVERTEXATTRIBARRAYARBPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glEndQuery, PFNGLENDQUERYPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glFenceSync, PFNGLFENCESYNCPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGenBuffers, PFNGLGENBUFFERSPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGenQueries, PFNGLGENQUERIESPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGenSamplers, PFNGLGENSAMPLERSPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGenVertexArrays, PFNGLGENVERTEXARRAYSPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGetProgramBinary, PFNGLGETPROGRAMBINARYPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGetProgramInfoLog, PFNGLGETPROGRAMINFOLOGPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGetProgramiv, PFNGLGETPROGRAMIVPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGetQueryObjectui64v, PFNGLGETQUERYOBJECTUI64VPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGetQueryObjectuiv, PFNGLGETQUERYOBJECTUIVPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGetShaderInfoLog, PFNGLGETSHADERINFOLOGPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGetShaderiv, PFNGLGETSHADERIVPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGetUniformLocation, PFNGLGETUNIFORMLOCATIONPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glInvalidateBufferData, PFNGLINVALIDATEBUFFERDATAPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glLinkProgram, PFNGLLINKPROGRAMPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glMapBufferRange, PFNGLMAPBUFFERRANGEPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glProgramBinary, PFNGLPROGRAMBINARYPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glProgramParameteri, PFNGLPROGRAMPARAMETERIPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glSamplerParameteri, PFNGLSAMPLERPARAMETERIPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glShaderSource, PFNGLSHADERSOURCEPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glTexImage3D, PFNGLTEXIMAGE3DPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glTexStorage3D, PFNGLTEXSTORAGE3DPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUniform1fv, PFNGLUNIFORM1FVPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUniform1i, PFNGLUNIFORM1IPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUniform2fv, PFNGLUNIFORM2FVPROC );
@@ -137,13 +181,25 @@ eae6320::cResult eae6320::OpenGlExtensions::Load( std::string* const o_errorMess
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUniform4fv, PFNGLUNIFORM4FVPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUniformBlockBinding, PFNGLUNIFORMBLOCKBINDINGPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUniformMatrix4fv, PFNGLUNIFORMMATRIX4FVPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUnmapBuffer, PFNGLUNMAPBUFFERPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUseProgram, PFNGLUSEPROGRAMPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glVertexAttribDivisor, PFNGLVERTEXATTRIBDIVISORPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glVertexAttribPointer, PFNGLVERTEXATTRIBPOINTERPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( wglChoosePixelFormatARB, PFNWGLCHOOSEPIXELFORMATARBPROC );
 	EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( wglCreateContextAttribsARB, PFNWGLCREATECONTEXTATTRIBSARBPROC );
 
 #undef EAE6320_OPENGLEXTENSIONS_LOADFUNCTION
 
+	// Load each optional extension
+	// (the code that uses these must check whether they were found)
+#define EAE6320_OPENGLEXTENSIONS_LOADOPTIONALFUNCTION( i_functionName, i_functionType )	\
+		i_functionName = static_cast<i_functionType>( GetOptionalGlFunctionAddress( #i_functionName ) );
+
+	EAE6320_OPENGLEXTENSIONS_LOADOPTIONALFUNCTION( glBufferStorage, PFNGLBUFFERSTORAGEPROC );
+	EAE6320_OPENGLEXTENSIONS_LOADOPTIONALFUNCTION( glMultiDrawElementsIndirect, PFNGLMULTIDRAWELEMENTSINDIRECTPROC );
+
+#undef EAE6320_OPENGLEXTENSIONS_LOADOPTIONALFUNCTION
+
 OnExit:
 
 	{
@@ -235,4 +291,17 @@ namespace
 
 		return nullptr;
 	}
+
+	const void* GetOptionalGlFunctionAddress( const char* const i_functionName )
+	{
+		const auto* const address = static_cast<void*>( wglGetProcAddress( i_functionName ) );
+		// See the comment in GetGlFunctionAddress() about the other invalid values
+		if ( ( address )
+			&& ( address != reinterpret_cast<void*>( 1 ) ) && ( address != reinterpret_cast<void*>( 2 ) )
+			&& ( address != reinterpret_cast<void*>( 3 ) ) && ( address != reinterpret_cast<void*>( -1 ) ) )
+		{
+			return address;
+		}
+		return nullptr;
+	}
 }
@@ -6,7 +6,7 @@
 --===========================
 
 -- Environment Variables
-local EngineSourceContentDir, GameSourceContentDir, GameInstallDir, OutputDir, LicenseDir, GameLicenseDir
+local EngineSourceContentDir, GameSourceContentDir, GameInstallDir, OutputDir, LicenseDir, GameLicenseDir, AssetBuildCacheDir
 do
     -- EngineSourceContentDir
     do
@@ -56,10 +56,54 @@ do
             error( errorMessage )
         end
     end
+    -- AssetBuildCacheDir
+    do
+        local errorMessage
+        AssetBuildCacheDir, errorMessage = GetEnvironmentVariable( "AssetBuildCacheDir" )
+        if not AssetBuildCacheDir then
+            error( errorMessage )
+        end
+    end
+end
+
+-- Built assets can optionally be compressed
+-- (the engine's asset loaders handle both compressed and uncompressed files,
+-- and so changing this doesn't require existing assets to be rebuilt)
+local shouldBuiltAssetsBeCompressed
+do
+    local value = GetEnvironmentVariable( "CompressBuiltAssets" )
+    shouldBuiltAssetsBeCompressed = ( value ~= nil ) and ( value ~= "" ) and ( value ~= "0" ) and ( value:lower() ~= "false" )
+end
+
+-- Assets are built in parallel,
+-- and by default as many builders are run at the same time as there are hardware threads
+-- (setting the AssetBuildJobCount environment variable to 1 builds the assets one at a time)
+local maxConcurrentBuildCount = 0
+do
+    local value = GetEnvironmentVariable( "AssetBuildJobCount" )
+    if ( value ~= nil ) and ( value ~= "" ) then
+        local jobCount = math.tointeger( tonumber( value ) )
+        if jobCount and ( jobCount >= 0 ) then
+            maxConcurrentBuildCount = jobCount
+        else
+            OutputWarningMessage( "The AssetBuildJobCount environment variable (\"" .. value .. "\") must be a non-negative integer" )
+        end
+    end
+end
+
+-- Builders are started as build hosts that stay running and build one asset after another
+-- (a builder is only started again if it has to build more than one asset at the same time),
+-- which is much faster than starting a new process for every asset
+-- (setting the UseAssetBuildHosts environment variable to 0 starts a new builder process for every asset instead)
+local shouldBuildHostsBeUsed
+do
+    local value = GetEnvironmentVariable( "UseAssetBuildHosts" )
+    shouldBuildHostsBeUsed = ( value == nil ) or ( value == "" ) or ( ( value ~= "0" ) and ( value:lower() ~= "false" ) )
 end
 
--- The last time that this file was modified
-local lastWriteTime_this
+-- The hash of this file's contents
+-- (changing how assets are built changes the build key of every asset)
+local hash_this
 do
     local path_this
     do
@@ -73,10 +117,14 @@ do
         path_this = sourceOfThisFunction:match( "^@(.*)" )
     end
     if path_this then
-        lastWriteTime_this = GetLastWriteTime( path_this )
+        local errorMessage
+        hash_this, errorMessage = CalculateFileHash( path_this )
+        if not hash_this then
+            error( errorMessage )
+        end
     else
         OutputWarningMessage( "The path for the Asset Build Functions script is unavailable" )
-        lastWriteTime_this = 0
+        hash_this = ""
     end
 end
 
@@ -106,6 +154,167 @@ local function CreateUniquePath( i_path )
     return uniquePath
 end
 
+-- Build Cache
+--============
+
+--[[
+    Whether an asset needs to be built is decided by its "build key",
+    which is a hash of everything that can change the built asset:
+        * The contents of the source file and of any other files that it depends on
+        * The contents of the builder and of this script
+        * The builder arguments and whether the built asset is compressed
+    Some builders record which files an asset depended on when it was built
+    (e.g. the shader builder records every file that a shader #included),
+    and for those assets the build key also includes the contents of every recorded file.
+    The recorded files are found using a "base key" that is calculated without them;
+    if they haven't been recorded yet the asset is always built.
+    (If an edit changes which files are included then one of the recorded files must have changed,
+    and so the asset is built again and the new files are recorded.)
+    Since only contents are hashed (not modification times)
+    touching a file or switching branches doesn't cause anything to be rebuilt unless the contents actually changed.
+
+    Every built asset is stored in the build cache using its build key as the file name,
+    and so if an asset's build key has been built before
+    (e.g. on a different branch, or for a different game that uses the same engine asset)
+    the built asset can be restored from the cache instead of being built again.
+    The cache is never trimmed automatically;
+    it is safe to delete the cache directory at any time.
+]]
+
+local path_buildCacheObjects = AssetBuildCacheDir .. "objects/"
+
+local function GetPathInBuildCache( i_buildKey )
+    -- The files are split into subdirectories so that no single directory gets too big
+    return path_buildCacheObjects .. i_buildKey:sub( 1, 2 ) .. "/" .. i_buildKey
+end
+
+-- The build manifest remembers which build key each target in the install directory was built (or restored) from
+-- so that a target that is already up-to-date doesn't even need to be restored
+-- (each install directory has its own manifest)
+local path_buildManifest = AssetBuildCacheDir .. "manifests/" .. CalculateHash( CreateUniquePath( GameInstallDir ) ) .. ".lua"
+local buildManifest = {}
+
+local function LoadBuildManifest()
+    buildManifest = {}
+    if DoesFileExist( path_buildManifest ) then
+        -- If the manifest can't be loaded then every target will be checked against the cache again,
+        -- which is slower but still correct
+        local result, manifest = pcall( dofile, path_buildManifest )
+        if result and ( type( manifest ) == "table" ) then
+            buildManifest = manifest
+        else
+            OutputWarningMessage( "The build manifest \"" .. path_buildManifest .. "\" couldn't be loaded: " .. tostring( manifest ) )
+        end
+    end
+end
+
+local function SaveBuildManifest()
+    CreateDirectoryIfItDoesntExist( path_buildManifest )
+    local file, errorMessage = io.open( path_buildManifest, "w" )
+    if file then
+        -- The targets are sorted so that the file doesn't change unless its contents do
+        local targets = {}
+        for path_target in pairs( buildManifest ) do
+            targets[#targets + 1] = path_target
+        end
+        table.sort( targets )
+        file:write( "return\n{\n" )
+        for i, path_target in ipairs( targets ) do
+            local entry = buildManifest[path_target]
+            file:write( ( "    [%q] = { buildKey = %q, lastWriteTime = %q },\n" ):format( path_target, entry.buildKey, entry.lastWriteTime ) )
+        end
+        file:write( "}\n" )
+        file:close()
+    else
+        OutputWarningMessage( "The build manifest \"" .. path_buildManifest .. "\" couldn't be saved: " .. tostring( errorMessage ) )
+    end
+end
+
+local function RecordTargetInBuildManifest( i_path_target, i_buildKey )
+    local lastWriteTime = GetLastWriteTime( i_path_target )
+    buildManifest[CreateUniquePath( i_path_target )] = { buildKey = i_buildKey, lastWriteTime = lastWriteTime }
+end
+
+local function IsTargetUpToDate( i_path_target, i_buildKey )
+    local entry = buildManifest[CreateUniquePath( i_path_target )]
+    -- If the target was changed by something other than the build (or deleted) then it isn't up-to-date
+    return ( entry ~= nil ) and ( entry.buildKey == i_buildKey )
+        and DoesFileExist( i_path_target ) and ( GetLastWriteTime( i_path_target ) == entry.lastWriteTime )
+end
+
+local function RestoreTargetFromBuildCache( i_path_target, i_buildKey )
+    local path_cached = GetPathInBuildCache( i_buildKey )
+    if not DoesFileExist( path_cached ) then
+        return false
+    end
+    if not DeleteFileIfItExists( i_path_target ) then
+        return false
+    end
+    -- A hard link is preferred because it doesn't copy any data,
+    -- but it isn't possible if the cache is on a different volume than the target
+    -- (targets are always deleted before they are built so that a builder can't write through a hard link into the cache)
+    if not CreateHardLink( path_cached, i_path_target ) then
+        if not CopyFile( path_cached, i_path_target ) then
+            return false
+        end
+    end
+    RecordTargetInBuildManifest( i_path_target, i_buildKey )
+    return true
+end
+
+local function StoreTargetInBuildCache( i_path_target, i_buildKey )
+    local path_cached = GetPathInBuildCache( i_buildKey )
+    CreateDirectoryIfItDoesntExist( path_cached )
+    -- The target is copied rather than linked so that the cached file can't be changed through the target
+    local result, errorMessage = CopyFile( i_path_target, path_cached )
+    if not result then
+        -- The asset was still built successfully, and so this is only a warning
+        OutputWarningMessage( "The built asset \"" .. i_path_target .. "\" couldn't be stored in the build cache: " .. tostring( errorMessage ) )
+    end
+    RecordTargetInBuildManifest( i_path_target, i_buildKey )
+end
+
+-- Files like builders are used by many assets, and so their hashes are only calculated once per build
+local fileHashes = {}
+local function GetFileHash( i_path )
+    local uniquePath = CreateUniquePath( i_path )
+    local hash = fileHashes[uniquePath]
+    if not hash then
+        -- If the file can't be read then it still gets a hash
+        -- so that the build key changes once the file can be read
+        -- (the builder will report an error if the file is actually needed)
+        hash = CalculateFileHash( i_path ) or "unreadable"
+        fileHashes[uniquePath] = hash
+    end
+    return hash
+end
+
+-- The files that a builder recorded are stored in the build cache next to the built assets
+-- (the base key includes the source path, and so every asset has its own file)
+local function GetPathOfRecordedDependencies( i_baseKey )
+    return GetPathInBuildCache( i_baseKey ) .. ".dependencies"
+end
+
+-- This returns nil if the dependencies haven't been recorded
+local function CalculateBuildKeyFromRecordedDependencies( i_baseKey )
+    local path_dependencies = GetPathOfRecordedDependencies( i_baseKey )
+    if not DoesFileExist( path_dependencies ) then
+        return nil
+    end
+    local keyParts = { i_baseKey }
+    local file = io.open( path_dependencies, "r" )
+    if not file then
+        return nil
+    end
+    for path_dependency in file:lines() do
+        if path_dependency ~= "" then
+            keyParts[#keyParts + 1] = CreateUniquePath( path_dependency ) .. "=" .. GetFileHash( path_dependency )
+        end
+    end
+    file:close()
+    return CalculateHash( table.concat( keyParts, "\n" ) )
+end
+
 -- Asset Types
 --============
 
@@ -152,6 +361,10 @@ end
 
 -- In order to be built an asset must be "registered"
 local registeredAssetsToBuild = {}
+-- While an asset's referenced assets are being registered
+-- every asset that gets registered is a dependency of it
+-- (i.e. it must be built before the referencing asset)
+local assetWhoseReferencesAreBeingRegistered = nil
 --
 local function RegisterAssetToBeBuilt( i_sourceAssetRelativePath, i_assetType, i_optionalCommandLineArguments )
     -- Get the asset type info
@@ -187,12 +400,17 @@ local function RegisterAssetToBeBuilt( i_sourceAssetRelativePath, i_assetType, i
         registrationInfo = registeredAssetsToBuild[uniquePath]
         if not registrationInfo then
             -- If this source asset hasn't been registered yet then register it now
-            registrationInfo = { path = uniquePath, assetTypeInfo = assetTypeInfo, arguments = arguments }
+            registrationInfo = { path = uniquePath, assetTypeInfo = assetTypeInfo, arguments = arguments, dependencies = {} }
             -- (This table is simultaneously used as a dictionary and an array)
             registeredAssetsToBuild[uniquePath] = registrationInfo
             registeredAssetsToBuild[#registeredAssetsToBuild + 1] = registrationInfo
             -- And also register any assets that are referenced by this asset
-            assetTypeInfo.RegisterReferencedAssets( uniquePath )
+            do
+                local assetWhoseReferencesWereBeingRegistered = assetWhoseReferencesAreBeingRegistered
+                assetWhoseReferencesAreBeingRegistered = registrationInfo
+                assetTypeInfo.RegisterReferencedAssets( uniquePath )
+                assetWhoseReferencesAreBeingRegistered = assetWhoseReferencesWereBeingRegistered
+            end
         else
             -- If this source asset has already been registered then the information must be identical
             if assetTypeInfo ~= registrationInfo.assetTypeInfo then
@@ -211,6 +429,13 @@ local function RegisterAssetToBeBuilt( i_sourceAssetRelativePath, i_assetType, i
                     .. tostring( #arguments ) .. ") than it was already registered with (" .. #registrationInfo.arguments .. ")" ) 
             end
         end
+        -- If this asset is referenced by another asset then the other asset depends on it
+        -- (Like registeredAssetsToBuild the dependencies table is simultaneously used as a dictionary and an array)
+        local dependentAsset = assetWhoseReferencesAreBeingRegistered
+        if dependentAsset and ( dependentAsset ~= registrationInfo ) and not dependentAsset.dependencies[registrationInfo] then
+            dependentAsset.dependencies[registrationInfo] = true
+            dependentAsset.dependencies[#dependentAsset.dependencies + 1] = registrationInfo
+        end
     end
 end
 
@@ -239,13 +464,32 @@ function cbAssetTypeInfo.RegisterReferencedAssets( i_sourceRelativePath )
 end
 
 -- You may need to override the following function for some new asset types, but not for many
-function cbAssetTypeInfo.ShouldTargetBeBuilt( i_lastWriteTime_builtAsset )
-    -- By default this returns false,
+function cbAssetTypeInfo.GetAdditionalDependencies( i_path_source )
+    -- This function should return an array of the absolute paths of any files
+    -- (other than the source asset itself)
+    -- whose contents affect the built asset.
+    -- By default this returns an empty array,
     -- because there are no special dependencies for this asset type
     -- that need to be taken into account
+    return {}
+end
+
+-- You will need to override the following function for asset types whose builders record dependencies
+function cbAssetTypeInfo.DoesBuilderRecordDependencies()
+    -- If this returns true the builder is passed an argument telling it where to write
+    -- the files that the built asset depended on (see cbBuilder.h),
+    -- and those files are used to decide whether the asset needs to be built again
+    -- (this is better than returning every file that might be used from GetAdditionalDependencies()
+    -- because only files that actually were used cause an asset to be built again)
     return false
 end
 
+-- You may want to override the following function for asset types whose built files don't compress well
+function cbAssetTypeInfo.ShouldTargetBeCompressed()
+    -- By default targets are compressed if the CompressBuiltAssets environment variable is set
+    return shouldBuiltAssetsBeCompressed
+end
+
 -- Mesh Asset Type
 --------------------
 
@@ -277,11 +521,10 @@ NewAssetTypeInfo( "shaders",
         GetBuilderRelativePath = function()
             return "ShaderBuilder.exe"
         end,
-        ShouldTargetBeBuilt = function( i_lastWriteTime_builtAsset )
-            -- If the shaders.inc file has changed since the last time this shader was built
-            -- then it should be built again
-            local lastWriteTime_includeFile = GetLastWriteTime( EngineSourceContentDir .. "Shaders/shaders.inc" )
-            return lastWriteTime_includeFile > i_lastWriteTime_builtAsset
+        DoesBuilderRecordDependencies = function()
+            -- The shader builder records every file that a shader #includes
+            -- (and so changing an included file only builds the shaders that include it again)
+            return true
         end
     }
 )
@@ -306,7 +549,10 @@ NewAssetTypeInfo( "textures",
 -- Local Function Definitions
 --===========================
 
-local function BuildAsset( i_assetInfo )
+-- This decides whether an asset needs to be built (restoring it from the build cache if possible),
+-- and if it does it stores the information needed to build it in the asset info
+-- (the builders are run later so that independent assets can be built at the same time)
+local function PrepareToBuildAsset( i_assetInfo )
     local assetTypeInfo = i_assetInfo.assetTypeInfo
 
     -- Get the absolute path to the source
@@ -347,93 +593,166 @@ local function BuildAsset( i_assetInfo )
             return false
         end
     end
+    local shouldTargetBeCompressed = assetTypeInfo.ShouldTargetBeCompressed()
+    local shouldDependenciesBeRecorded = assetTypeInfo.DoesBuilderRecordDependencies()
+    -- Calculate the build key
+    local baseKey, buildKey
+    do
+        local keyParts = {
+            -- The version must be changed if the way that build keys are calculated changes
+            "AssetBuildKey2",
+            assetTypeInfo.type,
+            i_assetInfo.path,
+            GetFileHash( path_source ),
+            GetFileHash( path_builder ),
+            hash_this,
+            table.concat( i_assetInfo.arguments, " " ),
+            tostring( shouldTargetBeCompressed ),
+        }
+        local additionalDependencies = assetTypeInfo.GetAdditionalDependencies( path_source )
+        for i, path_dependency in ipairs( additionalDependencies ) do
+            keyParts[#keyParts + 1] = CreateUniquePath( path_dependency ) .. "=" .. GetFileHash( path_dependency )
+        end
+        -- The parts are separated by a character that can't be in any of them
+        baseKey = CalculateHash( table.concat( keyParts, "\n" ) )
+        if shouldDependenciesBeRecorded then
+            -- If the dependencies haven't been recorded then there is no build key
+            -- (and the target must be built)
+            buildKey = CalculateBuildKeyFromRecordedDependencies( baseKey )
+        else
+            buildKey = baseKey
+        end
+    end
     -- Decide if the target needs to be built
     local shouldTargetBeBuilt
     do
-        -- The simplest reason a target should be built is if it doesn't exist
-        local doesTargetExist = DoesFileExist( path_target )
-        if doesTargetExist then
-            -- Even if the target exists it may be out-of-date.
-            -- If the source has been modified more recently than the target
-            -- then the target should be re-built.
-            local lastWriteTime_source = GetLastWriteTime( path_source )
-            local lastWriteTime_target = GetLastWriteTime( path_target )
-            shouldTargetBeBuilt = lastWriteTime_source > lastWriteTime_target
-            if not shouldTargetBeBuilt then
-                -- Even if the target is newer than the source
-                -- the builder EXE may have been updated
-                -- which could result in a different target being made
-                -- (e.g. if you fix a bug in the builder code)
-                local lastWriteTime_builder = GetLastWriteTime( path_builder )
-                shouldTargetBeBuilt = lastWriteTime_builder > lastWriteTime_target
-                if not shouldTargetBeBuilt then
-                    -- Even if the builder EXE hasn't changed this script file (AssetBuildFunctions.lua) may have been updated
-                    -- which could result in a different target being made
-                    -- (e.g. if you change an AssetTypeInfo function)
-                    shouldTargetBeBuilt = lastWriteTime_this > lastWriteTime_target
-                    if not shouldTargetBeBuilt then
-                        -- Even if there is no reason that a general asset shouldn't be built
-                        -- the specific asset type may have specialized dependencies
-                        shouldTargetBeBuilt = assetTypeInfo.ShouldTargetBeBuilt( lastWriteTime_target )
-                    end
-                end
-            end
+        if not buildKey then
+            shouldTargetBeBuilt = true
+        elseif IsTargetUpToDate( path_target, buildKey ) then
+            -- The target was already built from exactly the same inputs
+            shouldTargetBeBuilt = false
         else
-            shouldTargetBeBuilt = true;
+            CreateDirectoryIfItDoesntExist( path_target )
+            if RestoreTargetFromBuildCache( path_target, buildKey ) then
+                -- The same inputs were built before (e.g. on a different branch)
+                print( "Restored " .. path_source .. " from the build cache" )
+                shouldTargetBeBuilt = false
+            else
+                shouldTargetBeBuilt = true
+            end
         end
     end
 
-    -- Build the target if necessary
+    -- Prepare to build the target if necessary
     if shouldTargetBeBuilt then
-        -- Create the target directory if necessary
-        CreateDirectoryIfItDoesntExist( path_target )
-        -- Build
+        -- The old target must be deleted
+        -- because it may be a hard link to a file in the build cache
+        -- (and the builder would write the new target into the cached file)
         do
-            -- The command starts with the builder
-            local command = "\"" .. path_builder .. "\""
-            -- The source and target path must always be passed in
-            local arguments = "\"" .. path_source .. "\" \"" .. path_target .. "\""
-            -- Some asset types may have optional arguments
-            if #i_assetInfo.arguments > 0 then
-                arguments = arguments .. " " .. table.concat( i_assetInfo.arguments, " " )
+            local result, errorMessage = DeleteFileIfItExists( path_target )
+            if not result then
+                OutputErrorMessage( "The old target \"" .. path_target .. "\" couldn't be deleted: " .. tostring( errorMessage ), path_source )
+                return false
             end
-            -- Execute the command
-            local commandLine = command .. " " .. arguments
-            local result, exitCode = ExecuteCommand( commandLine )
-            if result then
-                if exitCode == 0 then
-                    -- Display a message for each asset
-                    print( "Built " .. path_source )
-                    -- Return success, and the exit code for informational purposes
-                    return true, exitCode
+        end
+        -- The command starts with the builder
+        local command = "\"" .. path_builder .. "\""
+        -- The source and target path must always be passed in
+        local arguments = "\"" .. path_source .. "\" \"" .. path_target .. "\""
+        -- Some asset types may have optional arguments
+        if #i_assetInfo.arguments > 0 then
+            arguments = arguments .. " " .. table.concat( i_assetInfo.arguments, " " )
+        end
+        -- A build host is sent the same arguments
+        local builderArguments = { path_source, path_target }
+        for i, argument in ipairs( i_assetInfo.arguments ) do
+            builderArguments[#builderArguments + 1] = tostring( argument )
+        end
+        -- The builder writes the files that the asset depended on into the build cache
+        -- (the build key is calculated from them after the asset has been built)
+        if shouldDependenciesBeRecorded then
+            local path_dependencies = GetPathOfRecordedDependencies( baseKey )
+            CreateDirectoryIfItDoesntExist( path_dependencies )
+            local argument = "-dependencies=" .. path_dependencies
+            arguments = arguments .. " \"" .. argument .. "\""
+            builderArguments[#builderArguments + 1] = argument
+        end
+        i_assetInfo.build = {
+            path_source = path_source,
+            path_target = path_target,
+            path_builder = path_builder,
+            builderArguments = builderArguments,
+            commandLine = command .. " " .. arguments,
+            shouldTargetBeCompressed = shouldTargetBeCompressed,
+            baseKey = baseKey,
+            shouldDependenciesBeRecorded = shouldDependenciesBeRecorded,
+        }
+    end
+    return true
+end
+
+-- This is called after an asset's builder has finished (in the same order that the assets were registered)
+local function FinishBuildingAsset( i_assetInfo, i_result )
+    local path_source = i_assetInfo.build.path_source
+    local path_target = i_assetInfo.build.path_target
+    local commandLine = i_assetInfo.build.commandLine
+
+    -- The builder's output was captured while it was running
+    -- so that the output of builders running at the same time doesn't get mixed together
+    if #i_result.output > 0 then
+        io.write( i_result.output )
+        io.flush()
+    end
+
+    if i_result.wasSkipped then
+        OutputErrorMessage( "The asset wasn't built: " .. tostring( i_result.errorMessage ), path_source )
+    elseif i_result.wasExecuted then
+        if i_result.exitCode == 0 then
+            if i_result.wasCompressionSuccessful then
+                -- If the builder recorded dependencies the build key can only be calculated now
+                -- (the previous key, if there was one, might have been calculated from different files)
+                local buildKey = i_assetInfo.build.baseKey
+                if i_assetInfo.build.shouldDependenciesBeRecorded then
+                    buildKey = CalculateBuildKeyFromRecordedDependencies( buildKey )
+                end
+                if buildKey then
+                    StoreTargetInBuildCache( path_target, buildKey )
                 else
-                    -- The builder should already output a descriptive error message if there was an error
-                    -- (remember that you write the builder code,
-                    -- and so if the build process failed it means that _your_ code has returned an error code)
-                    -- but it can be helpful to still return an additional vague error message here
-                    -- in case there is a bug in the specific builder that doesn't output an error message.
-                    OutputErrorMessage( "The command " .. commandLine .. " failed with exit code " .. tostring( exitCode ), path_source )
+                    -- The asset was still built successfully, but it will be built again next time
+                    OutputWarningMessage( "The builder didn't record the dependencies of \"" .. path_target .. "\"", path_source )
+                    buildManifest[CreateUniquePath( path_target )] = nil
                 end
+                -- Display a message for each asset
+                print( "Built " .. path_source )
+                return true
             else
-                -- If the command wasn't executed then the second return value is an error message
-                OutputErrorMessage( "The command " .. commandLine .. " couldn't be executed: " .. tostring( exitCode ), path_source )
+                OutputErrorMessage( "The built asset \"" .. path_target .. "\" couldn't be compressed: " .. tostring( i_result.errorMessage ), path_source )
             end
-
-            -- There's a chance that the builder already created the target file even though the build failed,
-            -- in which case it currently exists with a new time stamp
-            -- and the next time a build is run no attempt to build it again would be made even though the build failed.
-            if DoesFileExist( path_target ) then
-                -- Setting the time stamp to an invalid date in far in the past
-                -- allows you to look at the generated file if you wish
-                -- but still ensures that the build process will attempt to build it again
-                InvalidateLastWriteTime( path_target )
-            end
-
-            return false
+        else
+            -- The builder should already output a descriptive error message if there was an error
+            -- (remember that you write the builder code,
+            -- and so if the build process failed it means that _your_ code has returned an error code)
+            -- but it can be helpful to still return an additional vague error message here
+            -- in case there is a bug in the specific builder that doesn't output an error message.
+            OutputErrorMessage( "The command " .. commandLine .. " failed with exit code " .. tostring( i_result.exitCode ), path_source )
         end
     else
-        return true
+        OutputErrorMessage( "The command " .. commandLine .. " couldn't be executed: " .. tostring( i_result.errorMessage ), path_source )
+    end
+
+    -- The next build must try to build the target again
+    buildManifest[CreateUniquePath( path_target )] = nil
+    -- There's a chance that the builder already created the target file even though the build failed,
+    -- in which case it currently exists with a new time stamp
+    -- and the next time a build is run no attempt to build it again would be made even though the build failed.
+    if DoesFileExist( path_target ) then
+        -- Setting the time stamp to an invalid date in far in the past
+        -- allows you to look at the generated file if you wish
+        -- but still ensures that the build process will attempt to build it again
+        InvalidateLastWriteTime( path_target )
     end
+
+    return false
 end
 
 function CopyLicencesAndSettings()
@@ -530,7 +849,16 @@ function BuildAssets( i_path_assetsToBuild )
         return false
     end
 
+    -- Load what was built the last time
+    do
+        local startTime = GetTraceTimestamp()
+        LoadBuildManifest()
+        RecordTraceSpan( "Load build manifest", "BuildAssets", startTime, GetTraceTimestamp() )
+    end
+    fileHashes = {}
+
     -- Register every asset that needs to be built
+    local startTime_registration = GetTraceTimestamp()
     registeredAssetsToBuild = {}    -- Clear the table
     -- Iterate through every type of asset in the file
     for assetType, assetsToBuild_specificType in pairs( assetsToBuild ) do
@@ -556,10 +884,68 @@ function BuildAssets( i_path_assetsToBuild )
         end
     end
 
+    RecordTraceSpan( "Register assets", "BuildAssets", startTime_registration, GetTraceTimestamp(),
+        { assetCount = #registeredAssetsToBuild } )
+
     -- Build every asset that was registered
-    for i, assetInfo in ipairs( registeredAssetsToBuild ) do
-        if not BuildAsset( assetInfo ) then
+    do
+        -- Decide which assets need to be built
+        local assetsThatNeedToBeBuilt = {}
+        for i, assetInfo in ipairs( registeredAssetsToBuild ) do
+            assetInfo.build = nil
+            local startTime = GetTraceTimestamp()
+            if PrepareToBuildAsset( assetInfo ) then
+                if assetInfo.build then
+                    assetsThatNeedToBeBuilt[#assetsThatNeedToBeBuilt + 1] = assetInfo
+                    assetInfo.build.jobIndex = #assetsThatNeedToBeBuilt
+                end
+            else
+                wereThereErrors = true
+            end
+            -- The check includes hashing the asset's inputs and restoring it from the build cache
+            RecordTraceSpan( assetInfo.path, "UpToDateCheck", startTime, GetTraceTimestamp(),
+                { needsToBeBuilt = assetInfo.build and 1 or 0 } )
+        end
+        -- Each asset that needs to be built is a job for the build scheduler,
+        -- which must wait for the job of every asset that an asset depends on
+        -- (assets that don't need to be built are already up-to-date, and so nothing has to wait for them)
+        local jobs = {}
+        for i, assetInfo in ipairs( assetsThatNeedToBeBuilt ) do
+            local dependencies = {}
+            for j, dependency in ipairs( assetInfo.dependencies ) do
+                if dependency.build then
+                    dependencies[#dependencies + 1] = dependency.build.jobIndex
+                end
+            end
+            jobs[i] = {
+                name = assetInfo.path,
+                command = assetInfo.build.commandLine,
+                path_builder = shouldBuildHostsBeUsed and assetInfo.build.path_builder or nil,
+                builderArguments = shouldBuildHostsBeUsed and assetInfo.build.builderArguments or nil,
+                path_fileToCompress = assetInfo.build.shouldTargetBeCompressed and assetInfo.build.path_target or nil,
+                dependencies = dependencies,
+            }
+        end
+        -- Run the builders
+        -- (the results are reported in the same order as the jobs no matter what order the builders finish in)
+        -- (the scheduler can fail before any job is reported,
+        -- in which case no callback reports the error)
+        local wereBuildCommandsExecuted = ExecuteBuildCommands( jobs, maxConcurrentBuildCount,
+            function( i_jobIndex, i_result )
+                if not FinishBuildingAsset( assetsThatNeedToBeBuilt[i_jobIndex], i_result ) then
+                    wereThereErrors = true
+                end
+            end )
+        if not wereBuildCommandsExecuted then
             wereThereErrors = true
+            OutputErrorMessage( "The build scheduler failed to run the build commands" )
+        end
+        -- Remember what was built for the next time
+        -- (unless the scheduler failed, because then assets that weren't built would be recorded as up-to-date)
+        if wereBuildCommandsExecuted then
+            local startTime = GetTraceTimestamp()
+            SaveBuildManifest()
+            RecordTraceSpan( "Save build manifest", "BuildAssets", startTime, GetTraceTimestamp() )
         end
     end
 
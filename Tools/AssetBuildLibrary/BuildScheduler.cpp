@@ -0,0 +1,315 @@
+// Include Files
+//==============
+
+#include "BuildScheduler.h"
+
+#include "BuildTrace.h"
+#include "cBuildHost.h"
+
+#include <algorithm>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/Compression.h>
+#include <Engine/Concurrency/cEvent.h>
+#include <Engine/Concurrency/cMutex.h>
+#include <Engine/Concurrency/cThread.h>
+#include <Engine/Platform/Platform.h>
+#include <map>
+#include <memory>
+#include <set>
+#include <thread>
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+	// The build hosts that aren't currently building anything are kept here
+	// so that later jobs for the same builder can use them
+	// (the hosts exit when the pool is destroyed)
+	class cBuildHostPool
+	{
+	public:
+
+		// If there is no idle host for the builder a new one is started;
+		// if that fails nullptr is returned (and no more hosts are started for that builder)
+		std::unique_ptr<eae6320::Assets::cBuildHost> Acquire( const std::string& i_path_builder );
+		void Release( const std::string& i_path_builder, std::unique_ptr<eae6320::Assets::cBuildHost> i_buildHost );
+
+	private:
+
+		eae6320::Concurrency::cMutex m_mutex;
+		std::map<std::string, std::vector<std::unique_ptr<eae6320::Assets::cBuildHost>>> m_idleBuildHosts;
+		std::set<std::string> m_buildersThatCantBeHosted;
+	};
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	void RunJob( const eae6320::Assets::BuildScheduler::sJob& i_job, cBuildHostPool& io_buildHostPool,
+		eae6320::Assets::BuildScheduler::sJobResult& o_result );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Assets::BuildScheduler::RunJobs( const std::vector<sJob>& i_jobs, const unsigned int i_maxConcurrentJobCount,
+	const fOnJobFinished& i_onJobFinished )
+{
+	auto result = Results::Success;
+
+	const auto jobCount = i_jobs.size();
+	const auto maxConcurrentJobCount = ( i_maxConcurrentJobCount > 0 ) ? i_maxConcurrentJobCount
+		: std::max( std::thread::hardware_concurrency(), 1u );
+
+	// A job is waiting until it has been started,
+	// and it is running from when it has been started until it has finished
+	std::vector<bool> haveJobsStarted( jobCount, false );
+	std::vector<bool> haveJobsFinished( jobCount, false );
+	std::vector<sJobResult> jobResults( jobCount );
+	// Every job uses the same pool,
+	// and so a host that finishes one job can be used for the next job that its builder builds
+	// (the pool must outlive the job threads, which is guaranteed because every thread is waited for before returning)
+	cBuildHostPool buildHostPool;
+	// Each job is run in its own thread
+	// (starting a thread is cheap compared to building an asset)
+	std::unique_ptr<Concurrency::cThread[]> jobThreads( new Concurrency::cThread[jobCount] );
+	// Job threads add their index to this list when they finish
+	// and the scheduling thread removes them
+	Concurrency::cMutex finishedJobsMutex;
+	std::vector<size_t> finishedJobIndices;
+	// This is signaled whenever a job finishes
+	Concurrency::cEvent whenAJobFinishes;
+	unsigned int runningJobCount = 0;
+	size_t nextJobToReport = 0;
+	bool shouldJobsStopBeingStarted = false;
+
+	for ( size_t i = 0; i < jobCount; ++i )
+	{
+		for ( const auto dependency : i_jobs[i].dependencies )
+		{
+			if ( dependency >= jobCount )
+			{
+				EAE6320_ASSERTF( false, "Job %zu depends on job %zu which doesn't exist", i, dependency );
+				return Results::Failure;
+			}
+		}
+	}
+	if ( !( result = whenAJobFinishes.Initialize( Concurrency::EventType::ResetAutomaticallyAfterBeingSignaled ) ) )
+	{
+		EAE6320_ASSERTF( false, "Couldn't initialize the event that signals finished jobs" );
+		return result;
+	}
+
+	while ( nextJobToReport < jobCount )
+	{
+		// Start every job that can be started
+		if ( !shouldJobsStopBeingStarted )
+		{
+			// Skipping a job (or breaking a cycle) can make other jobs ready,
+			// and so this repeats until nothing changes
+			bool didAnyJobFinish;
+			bool shouldACycleBeBroken = false;
+			do
+			{
+				didAnyJobFinish = false;
+				for ( size_t i = 0; ( i < jobCount ) && ( runningJobCount < maxConcurrentJobCount ); ++i )
+				{
+					if ( haveJobsStarted[i] )
+					{
+						continue;
+					}
+					bool areDependenciesFinished = true;
+					bool didADependencyFail = false;
+					for ( const auto dependency : i_jobs[i].dependencies )
+					{
+						if ( haveJobsFinished[dependency] )
+						{
+							didADependencyFail = didADependencyFail || !jobResults[dependency].DidJobSucceed();
+						}
+						else
+						{
+							areDependenciesFinished = false;
+						}
+					}
+					if ( !areDependenciesFinished )
+					{
+						if ( shouldACycleBeBroken )
+						{
+							shouldACycleBeBroken = false;
+						}
+						else
+						{
+							continue;
+						}
+					}
+					if ( didADependencyFail )
+					{
+						haveJobsStarted[i] = true;
+						haveJobsFinished[i] = true;
+						jobResults[i].wasSkipped = true;
+						jobResults[i].errorMessage = "An asset that it depends on failed to build";
+						didAnyJobFinish = true;
+						continue;
+					}
+					// Start the job
+					{
+						const auto& job = i_jobs[i];
+						auto& jobResult = jobResults[i];
+						const auto jobIndex = i;
+						haveJobsStarted[i] = true;
+						const auto startResult = jobThreads[i].Start(
+							[&job, &jobResult, &buildHostPool, &finishedJobsMutex, &finishedJobIndices, &whenAJobFinishes, jobIndex]( void* const )
+							{
+								RunJob( job, buildHostPool, jobResult );
+								{
+									Concurrency::cMutex::cScopeLock scopeLock( finishedJobsMutex );
+									finishedJobIndices.push_back( jobIndex );
+								}
+								const auto signalResult = whenAJobFinishes.Signal();
+								EAE6320_ASSERT( signalResult );
+							} );
+						if ( startResult )
+						{
+							++runningJobCount;
+						}
+						else
+						{
+							// If a thread can't be started the job is run on this thread instead
+							RunJob( job, buildHostPool, jobResult );
+							haveJobsFinished[i] = true;
+							didAnyJobFinish = true;
+						}
+					}
+				}
+				// If nothing is running but jobs are still waiting then they depend on each other in a cycle
+				// (e.g. two assets that reference each other),
+				// and the first waiting job is started without waiting for its dependencies
+				// (which is how it would have been built if the jobs were run one after the other)
+				if ( !didAnyJobFinish && ( runningJobCount == 0 ) )
+				{
+					shouldACycleBeBroken = std::find( haveJobsStarted.begin(), haveJobsStarted.end(), false ) != haveJobsStarted.end();
+					didAnyJobFinish = shouldACycleBeBroken;
+				}
+			} while ( didAnyJobFinish );
+		}
+		if ( runningJobCount > 0 )
+		{
+			// Wait for at least one running job to finish
+			{
+				const auto waitResult = Concurrency::WaitForEvent( whenAJobFinishes );
+				EAE6320_ASSERT( waitResult );
+			}
+			std::vector<size_t> newlyFinishedJobIndices;
+			{
+				Concurrency::cMutex::cScopeLock scopeLock( finishedJobsMutex );
+				newlyFinishedJobIndices.swap( finishedJobIndices );
+			}
+			for ( const auto jobIndex : newlyFinishedJobIndices )
+			{
+				const auto waitResult = Concurrency::WaitForThreadToStop( jobThreads[jobIndex] );
+				EAE6320_ASSERT( waitResult );
+				haveJobsFinished[jobIndex] = true;
+				--runningJobCount;
+			}
+		}
+		// Report the finished jobs in order
+		if ( !shouldJobsStopBeingStarted )
+		{
+			while ( ( nextJobToReport < jobCount ) && haveJobsFinished[nextJobToReport] )
+			{
+				if ( !( result = i_onJobFinished( nextJobToReport, jobResults[nextJobToReport] ) ) )
+				{
+					shouldJobsStopBeingStarted = true;
+					break;
+				}
+				++nextJobToReport;
+			}
+		}
+		// Once jobs stop being started it is only necessary to wait for the running jobs to finish
+		if ( shouldJobsStopBeingStarted && ( runningJobCount == 0 ) )
+		{
+			break;
+		}
+	}
+
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	std::unique_ptr<eae6320::Assets::cBuildHost> cBuildHostPool::Acquire( const std::string& i_path_builder )
+	{
+		{
+			eae6320::Concurrency::cMutex::cScopeLock scopeLock( m_mutex );
+			if ( m_buildersThatCantBeHosted.find( i_path_builder ) != m_buildersThatCantBeHosted.end() )
+			{
+				return nullptr;
+			}
+			auto& idleBuildHosts = m_idleBuildHosts[i_path_builder];
+			if ( !idleBuildHosts.empty() )
+			{
+				auto buildHost = std::move( idleBuildHosts.back() );
+				idleBuildHosts.pop_back();
+				return buildHost;
+			}
+		}
+		// The new host is started without the mutex being locked
+		// so that other jobs don't have to wait for it
+		std::unique_ptr<eae6320::Assets::cBuildHost> buildHost( new eae6320::Assets::cBuildHost );
+		if ( buildHost->Start( i_path_builder.c_str() ) )
+		{
+			return buildHost;
+		}
+		else
+		{
+			eae6320::Concurrency::cMutex::cScopeLock scopeLock( m_mutex );
+			m_buildersThatCantBeHosted.insert( i_path_builder );
+			return nullptr;
+		}
+	}
+
+	void cBuildHostPool::Release( const std::string& i_path_builder, std::unique_ptr<eae6320::Assets::cBuildHost> i_buildHost )
+	{
+		eae6320::Concurrency::cMutex::cScopeLock scopeLock( m_mutex );
+		m_idleBuildHosts[i_path_builder].push_back( std::move( i_buildHost ) );
+	}
+
+	void RunJob( const eae6320::Assets::BuildScheduler::sJob& i_job, cBuildHostPool& io_buildHostPool,
+		eae6320::Assets::BuildScheduler::sJobResult& o_result )
+	{
+		const auto* const traceName = i_job.name.empty() ? i_job.command.c_str() : i_job.name.c_str();
+		eae6320::Assets::BuildTrace::cScope traceScope( traceName, "Job" );
+		bool wasJobBuiltByAHost = false;
+		if ( !i_job.path_builder.empty() )
+		{
+			if ( auto buildHost = io_buildHostPool.Acquire( i_job.path_builder ) )
+			{
+				o_result.executionResult = buildHost->Build( i_job.builderArguments, o_result.exitCode, o_result.output, &o_result.errorMessage );
+				// A host that failed has already stopped and can't be reused
+				if ( buildHost->IsRunning() )
+				{
+					io_buildHostPool.Release( i_job.path_builder, std::move( buildHost ) );
+				}
+				wasJobBuiltByAHost = true;
+			}
+		}
+		if ( !wasJobBuiltByAHost )
+		{
+			o_result.executionResult = eae6320::Platform::ExecuteCommandAndCaptureOutput( i_job.command.c_str(), o_result.output,
+				&o_result.exitCode, &o_result.errorMessage );
+		}
+		traceScope.AddArgument( "builtByHost", wasJobBuiltByAHost ? 1 : 0 );
+		traceScope.AddArgument( "exitCode", static_cast<uint64_t>( static_cast<uint32_t>( o_result.exitCode ) ) );
+		if ( o_result.executionResult && ( o_result.exitCode == 0 ) && !i_job.path_fileToCompress.empty() )
+		{
+			eae6320::Assets::BuildTrace::cScope compressionTraceScope( traceName, "Compress" );
+			o_result.compressionResult = eae6320::Assets::Compression::CompressFile( i_job.path_fileToCompress.c_str(), &o_result.errorMessage );
+		}
+	}
+}
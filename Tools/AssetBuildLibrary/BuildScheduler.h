@@ -0,0 +1,82 @@
+/*
+	The build scheduler executes asset build commands in parallel:
+		* Each command is a job that may depend on other jobs
+			(e.g. an asset must be built after the assets that it references)
+		* A job is started as soon as every job that it depends on has succeeded,
+			and at most a configurable number of jobs run at the same time
+			(if jobs depend on each other in a cycle the cycle is broken by starting the first of them anyway)
+		* If a job says which builder its command runs the job is sent to a build host for that builder (see cBuildHost.h)
+			instead of starting a new process,
+			and the hosts are reused by later jobs until all of the jobs have finished
+		* The output of each command is captured
+			and the results are reported in the order that the jobs were given,
+			and so the build output looks the same as if the jobs had been run one after the other
+*/
+
+#ifndef EAE6320_ASSETBUILD_BUILDSCHEDULER_H
+#define EAE6320_ASSETBUILD_BUILDSCHEDULER_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <Engine/Results/Results.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace BuildScheduler
+		{
+			struct sJob
+			{
+				// This identifies the job in the build trace
+				// (the command is used if it is empty)
+				std::string name;
+				std::string command;
+				// If the path to a builder is provided the job is built by a build host
+				// with these arguments instead of executing the command
+				// (the command is still executed if the build host can't be started)
+				std::string path_builder;
+				std::vector<std::string> builderArguments;
+				// If this isn't empty the file will be compressed after the command succeeds
+				std::string path_fileToCompress;
+				// These are indices of other jobs that must succeed before this job can start
+				std::vector<size_t> dependencies;
+			};
+
+			struct sJobResult
+			{
+				// If the command couldn't be executed this will fail
+				// (if it could be executed but the build failed the exit code will be non-zero)
+				cResult executionResult = Results::Success;
+				int exitCode = 0;
+				// Anything that the command output to standard output or standard error
+				std::string output;
+				// If the command couldn't be executed or the compression failed this explains why
+				std::string errorMessage;
+				cResult compressionResult = Results::Success;
+				// A job is skipped (without its command being executed) if a job that it depends on fails
+				bool wasSkipped = false;
+
+				bool DidJobSucceed() const { return !wasSkipped && executionResult && ( exitCode == 0 ) && compressionResult; }
+			};
+
+			// This is called on the thread that called RunJobs() once for each job, in the order of the jobs.
+			// If it returns a failure no more jobs are started
+			// (the jobs that are already running finish, but aren't reported)
+			using fOnJobFinished = std::function<cResult( const size_t i_jobIndex, const sJobResult& i_result )>;
+
+			// If the job count is zero the number of hardware threads is used
+			cResult RunJobs( const std::vector<sJob>& i_jobs, const unsigned int i_maxConcurrentJobCount, const fOnJobFinished& i_onJobFinished );
+		}
+	}
+}
+
+#endif	// EAE6320_ASSETBUILD_BUILDSCHEDULER_H
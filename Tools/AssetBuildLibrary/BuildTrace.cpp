@@ -0,0 +1,371 @@
+// Include Files
+//==============
+
+#include "BuildTrace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <Engine/Concurrency/cMutex.h>
+#include <Engine/Platform/Platform.h>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#if defined( EAE6320_PLATFORM_WINDOWS )
+	#include <Engine/Windows/Includes.h>
+#endif
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+	struct sTrace
+	{
+		bool isEnabled = false;
+		std::string path_trace;
+		// Each process writes its spans to a file in this directory named after its process ID
+		std::string path_partsDirectory;
+		std::string path_part;
+		uint32_t processId = 0;
+		std::string processName;
+
+		eae6320::Concurrency::cMutex mutex;
+		// Each span is a JSON object followed by a comma and a newline
+		// (only the spans that haven't been flushed to the part file yet are kept)
+		std::string spans;
+		// The first flush replaces any existing part file and later flushes append to it
+		bool hasPartBeenStarted = false;
+		bool hasProcessNameBeenWritten = false;
+
+		sTrace();
+	};
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	sTrace& GetTrace();
+	// The IDs are small numbers (rather than the OS's thread IDs) so that the trace viewer sorts them in the order they were used
+	uint32_t GetThreadId();
+	void AppendJsonString( const char* const i_string, std::string& io_json );
+}
+
+// Interface
+//==========
+
+bool eae6320::Assets::BuildTrace::IsEnabled()
+{
+	return GetTrace().isEnabled;
+}
+
+void eae6320::Assets::BuildTrace::SetProcessName( const char* const i_name )
+{
+	auto& trace = GetTrace();
+	// Only the file name of a path is used
+	const auto* name = i_name;
+	for ( const auto* c = i_name; *c != '\0'; ++c )
+	{
+		if ( ( *c == '/' ) || ( *c == '\\' ) )
+		{
+			name = c + 1;
+		}
+	}
+	Concurrency::cMutex::cScopeLock scopeLock( trace.mutex );
+	trace.processName = name;
+}
+
+uint64_t eae6320::Assets::BuildTrace::GetTimestamp()
+{
+	// The steady clock uses the performance counter on Windows,
+	// which is the same for every process
+	return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now().time_since_epoch() ).count() );
+}
+
+void eae6320::Assets::BuildTrace::RecordSpan( const char* const i_name, const char* const i_category,
+	const uint64_t i_startTime, const uint64_t i_endTime, const std::string& i_arguments )
+{
+	auto& trace = GetTrace();
+	if ( !trace.isEnabled )
+	{
+		return;
+	}
+
+	std::string span;
+	{
+		span += "{\"name\":";
+		AppendJsonString( i_name, span );
+		span += ",\"cat\":";
+		AppendJsonString( i_category, span );
+		std::ostringstream times;
+		times << ",\"ph\":\"X\",\"ts\":" << i_startTime << ",\"dur\":" << ( ( i_endTime > i_startTime ) ? ( i_endTime - i_startTime ) : 0 )
+			<< ",\"pid\":" << trace.processId << ",\"tid\":" << GetThreadId();
+		span += times.str();
+		if ( !i_arguments.empty() )
+		{
+			span += ",\"args\":{";
+			span += i_arguments;
+			span += "}";
+		}
+		span += "},\n";
+	}
+	Concurrency::cMutex::cScopeLock scopeLock( trace.mutex );
+	trace.spans += span;
+}
+
+eae6320::cResult eae6320::Assets::BuildTrace::Flush()
+{
+	auto& trace = GetTrace();
+	if ( !trace.isEnabled )
+	{
+		return Results::Success;
+	}
+
+	// The file is written while the lock is held so that flushes from different threads can't interleave their spans
+	Concurrency::cMutex::cScopeLock scopeLock( trace.mutex );
+	const auto shouldProcessNameBeWritten = !trace.hasProcessNameBeenWritten && !trace.processName.empty();
+	if ( trace.spans.empty() && !shouldProcessNameBeWritten )
+	{
+		return Results::Success;
+	}
+	std::string part;
+	// Name the process
+	if ( shouldProcessNameBeWritten )
+	{
+		std::ostringstream metadata;
+		metadata << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << trace.processId << ",\"args\":{\"name\":";
+		part += metadata.str();
+		AppendJsonString( trace.processName.c_str(), part );
+		part += "}},\n";
+	}
+	part += trace.spans;
+	// A builder that is a build host flushes after each asset,
+	// and so only the spans that it has recorded since the previous flush are appended
+	// (rewriting everything each time would make a long build quadratic)
+	if ( !trace.hasPartBeenStarted )
+	{
+		const auto result = Platform::CreateDirectoryIfItDoesntExist( trace.path_part );
+		if ( !result )
+		{
+			return result;
+		}
+	}
+	{
+		std::ofstream partFile( trace.path_part, std::ofstream::binary |
+			( trace.hasPartBeenStarted ? std::ofstream::app : std::ofstream::trunc ) );
+		if ( !partFile.is_open() )
+		{
+			return Results::Failure;
+		}
+		partFile.write( part.data(), static_cast<std::streamsize>( part.size() ) );
+		partFile.close();
+		if ( partFile.fail() )
+		{
+			return Results::Failure;
+		}
+	}
+	trace.hasPartBeenStarted = true;
+	trace.hasProcessNameBeenWritten = trace.hasProcessNameBeenWritten || shouldProcessNameBeWritten;
+	trace.spans.clear();
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Assets::BuildTrace::DeletePreviousParts( std::string* const o_errorMessage )
+{
+	auto& trace = GetTrace();
+	if ( !trace.isEnabled )
+	{
+		return Results::Success;
+	}
+
+	// If the directory doesn't exist there is nothing to delete
+	std::vector<std::string> paths_part;
+	constexpr bool dontSearchSubdirectories = false;
+	Platform::GetFilesInDirectory( trace.path_partsDirectory, paths_part, dontSearchSubdirectories );
+	for ( const auto& path_part : paths_part )
+	{
+		if ( !Platform::DeleteFileIfItExists( path_part.c_str(), o_errorMessage ) )
+		{
+			return Results::Failure;
+		}
+	}
+	// If this process's own part file was deleted the next flush must start it again
+	{
+		Concurrency::cMutex::cScopeLock scopeLock( trace.mutex );
+		trace.hasPartBeenStarted = false;
+		trace.hasProcessNameBeenWritten = false;
+	}
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Assets::BuildTrace::CombineParts( std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	auto& trace = GetTrace();
+	if ( !trace.isEnabled )
+	{
+		return result;
+	}
+
+	// This process's spans must be in its part file first
+	if ( !( result = Flush() ) )
+	{
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = "The asset build's spans couldn't be written to \"" + trace.path_part + "\"";
+		}
+		return result;
+	}
+
+	std::vector<std::string> paths_part;
+	{
+		constexpr bool dontSearchSubdirectories = false;
+		if ( !( result = Platform::GetFilesInDirectory( trace.path_partsDirectory, paths_part, dontSearchSubdirectories, o_errorMessage ) ) )
+		{
+			return result;
+		}
+	}
+	std::string spans;
+	for ( const auto& path_part : paths_part )
+	{
+		Platform::sDataFromFile dataFromFile;
+		if ( !( result = Platform::LoadBinaryFile( path_part.c_str(), dataFromFile, o_errorMessage ) ) )
+		{
+			return result;
+		}
+		spans.append( static_cast<const char*>( dataFromFile.data ), dataFromFile.size );
+		dataFromFile.Free();
+	}
+	// The last span isn't followed by a comma
+	{
+		const auto lastBrace = spans.find_last_of( '}' );
+		spans.resize( ( lastBrace != std::string::npos ) ? ( lastBrace + 1 ) : 0 );
+	}
+	const auto json = "{\"traceEvents\":[\n" + spans + "\n],\"displayTimeUnit\":\"ms\"}\n";
+	if ( !( result = Platform::WriteBinaryFile( trace.path_trace.c_str(), json.data(), json.size(), o_errorMessage ) ) )
+	{
+		return result;
+	}
+
+	return DeletePreviousParts( o_errorMessage );
+}
+
+void eae6320::Assets::BuildTrace::AppendArgument( const char* const i_name, const uint64_t i_value, std::string& io_arguments )
+{
+	if ( !io_arguments.empty() )
+	{
+		io_arguments += ",";
+	}
+	AppendJsonString( i_name, io_arguments );
+	io_arguments += ":" + std::to_string( i_value );
+}
+
+void eae6320::Assets::BuildTrace::AppendArgument( const char* const i_name, const char* const i_value, std::string& io_arguments )
+{
+	if ( !io_arguments.empty() )
+	{
+		io_arguments += ",";
+	}
+	AppendJsonString( i_name, io_arguments );
+	io_arguments += ":";
+	AppendJsonString( i_value, io_arguments );
+}
+
+// cScope
+//-------
+
+void eae6320::Assets::BuildTrace::cScope::AddArgument( const char* const i_name, const uint64_t i_value )
+{
+	AppendArgument( i_name, i_value, m_arguments );
+}
+
+void eae6320::Assets::BuildTrace::cScope::AddArgument( const char* const i_name, const char* const i_value )
+{
+	AppendArgument( i_name, i_value, m_arguments );
+}
+
+eae6320::Assets::BuildTrace::cScope::cScope( const char* const i_name, const char* const i_category )
+	:
+	m_name( i_name ), m_category( i_category ), m_startTime( GetTimestamp() )
+{
+
+}
+
+eae6320::Assets::BuildTrace::cScope::~cScope()
+{
+	RecordSpan( m_name, m_category, m_startTime, GetTimestamp(), m_arguments );
+}
+
+// Helper Class Definition
+//========================
+
+namespace
+{
+	sTrace::sTrace()
+	{
+		if ( eae6320::Platform::GetEnvironmentVariable( "AssetBuildTrace", path_trace ) && !path_trace.empty() )
+		{
+			isEnabled = true;
+			path_partsDirectory = path_trace + ".parts/";
+#if defined( EAE6320_PLATFORM_WINDOWS )
+			processId = static_cast<uint32_t>( GetCurrentProcessId() );
+#endif
+			path_part = path_partsDirectory + std::to_string( processId ) + ".json";
+		}
+	}
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	sTrace& GetTrace()
+	{
+		// This is created the first time that it is used
+		// (which is thread-safe)
+		static sTrace s_trace;
+		return s_trace;
+	}
+
+	uint32_t GetThreadId()
+	{
+		static std::atomic<uint32_t> s_nextThreadId( 1 );
+		thread_local const uint32_t threadId = s_nextThreadId++;
+		return threadId;
+	}
+
+	void AppendJsonString( const char* const i_string, std::string& io_json )
+	{
+		io_json += '"';
+		for ( auto* c = i_string; *c != '\0'; ++c )
+		{
+			switch ( *c )
+			{
+			case '"': io_json += "\\\""; break;
+			// Windows paths are full of backslashes
+			case '\\': io_json += "\\\\"; break;
+			case '\n': io_json += "\\n"; break;
+			case '\r': io_json += "\\r"; break;
+			case '\t': io_json += "\\t"; break;
+			default:
+				if ( static_cast<unsigned char>( *c ) < 0x20 )
+				{
+					char escaped[8];
+					snprintf( escaped, sizeof( escaped ), "\\u%04x", static_cast<unsigned int>( *c ) );
+					io_json += escaped;
+				}
+				else
+				{
+					io_json += *c;
+				}
+			}
+		}
+		io_json += '"';
+	}
+}
@@ -0,0 +1,85 @@
+/*
+	The build trace records how long each part of the asset build takes
+	so that it is easy to find which assets (or which builder phases) make the build slow:
+		* Tracing is enabled by setting the AssetBuildTrace environment variable
+			to the path of the JSON file that should be written
+		* The file uses the Chrome trace event format,
+			and so it can be viewed by loading it in chrome://tracing or https://ui.perfetto.dev
+		* The asset build and every builder (which are separate processes) record their own spans
+			into their own part file in a temporary directory next to the trace file,
+			and the asset build combines the parts into the trace file when it finishes
+		* Timestamps come from a clock that is shared by every process,
+			and so the spans of a builder line up with the asset build job that ran it
+*/
+
+#ifndef EAE6320_ASSETBUILD_BUILDTRACE_H
+#define EAE6320_ASSETBUILD_BUILDTRACE_H
+
+// Include Files
+//==============
+
+#include <cstdint>
+#include <Engine/Results/Results.h>
+#include <string>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace BuildTrace
+		{
+			bool IsEnabled();
+
+			// The process name is shown instead of its ID in the trace viewer
+			// (if it is a path only the file name is shown)
+			void SetProcessName( const char* const i_name );
+
+			// Microseconds (on a clock that every process shares)
+			uint64_t GetTimestamp();
+
+			// The arguments are shown when a span is selected in the trace viewer;
+			// they are a JSON object's members without the braces (e.g. "\"bytesRead\":123"),
+			// which AppendArgument() creates
+			void RecordSpan( const char* const i_name, const char* const i_category,
+				const uint64_t i_startTime, const uint64_t i_endTime, const std::string& i_arguments = std::string() );
+			void AppendArgument( const char* const i_name, const uint64_t i_value, std::string& io_arguments );
+			void AppendArgument( const char* const i_name, const char* const i_value, std::string& io_arguments );
+
+			// A scope records a span from when it is constructed until it is destroyed
+			class cScope
+			{
+			public:
+
+				void AddArgument( const char* const i_name, const uint64_t i_value );
+				void AddArgument( const char* const i_name, const char* const i_value );
+
+				cScope( const char* const i_name, const char* const i_category );
+				~cScope();
+
+			private:
+
+				const char* const m_name;
+				const char* const m_category;
+				const uint64_t m_startTime;
+				std::string m_arguments;
+
+				cScope( const cScope& ) = delete;
+				cScope& operator =( const cScope& ) = delete;
+			};
+
+			// Appends the spans that this process has recorded since the previous flush to its part file
+			// (a builder does this after each asset that it builds)
+			cResult Flush();
+
+			// The asset build deletes the part files from previous builds before it starts
+			// and combines the part files into the trace file when it is finished
+			cResult DeletePreviousParts( std::string* const o_errorMessage = nullptr );
+			cResult CombineParts( std::string* const o_errorMessage = nullptr );
+		}
+	}
+}
+
+#endif	// EAE6320_ASSETBUILD_BUILDTRACE_H
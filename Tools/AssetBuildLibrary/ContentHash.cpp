@@ -0,0 +1,161 @@
+// Include Files
+//==============
+
+#include "ContentHash.h"
+
+#include <cstdint>
+#include <cstring>
+#include <Engine/Platform/Platform.h>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// XXH64
+	constexpr uint64_t s_prime1 = 0x9E3779B185EBCA87ull;
+	constexpr uint64_t s_prime2 = 0xC2B2AE3D27D4EB4Full;
+	constexpr uint64_t s_prime3 = 0x165667B19E3779F9ull;
+	constexpr uint64_t s_prime4 = 0x85EBCA77C2B2AE63ull;
+	constexpr uint64_t s_prime5 = 0x27D4EB2F165667C5ull;
+
+	// The two halves of the hash use different seeds
+	constexpr uint64_t s_seeds[] = { 0x0ull, 0x6561653633323021ull };
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	uint64_t CalculateXxh64( const uint8_t* const i_data, const size_t i_size, const uint64_t i_seed );
+}
+
+// Interface
+//==========
+
+std::string eae6320::Assets::ContentHash::CalculateHash( const void* const i_data, const size_t i_size )
+{
+	constexpr char hexDigits[] = "0123456789abcdef";
+	constexpr size_t digitsPerHalf = sizeof( uint64_t ) * 2;
+
+	std::string hash( sizeof( s_seeds ) * 2, '0' );
+	for ( size_t i = 0; i < ( sizeof( s_seeds ) / sizeof( s_seeds[0] ) ); ++i )
+	{
+		auto half = CalculateXxh64( static_cast<const uint8_t*>( i_data ), i_size, s_seeds[i] );
+		for ( size_t j = 0; j < digitsPerHalf; ++j )
+		{
+			hash[( ( i + 1 ) * digitsPerHalf ) - 1 - j] = hexDigits[half & 0xf];
+			half >>= 4;
+		}
+	}
+	return hash;
+}
+
+eae6320::cResult eae6320::Assets::ContentHash::CalculateFileHash( const char* const i_path, std::string& o_hash, std::string* const o_errorMessage )
+{
+	Platform::sDataFromFile fileData;
+	const auto result = Platform::LoadBinaryFile( i_path, fileData, o_errorMessage );
+	if ( result )
+	{
+		o_hash = CalculateHash( fileData.data, fileData.size );
+	}
+	fileData.Free();
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	uint64_t RotateLeft( const uint64_t i_value, const unsigned int i_bitCount )
+	{
+		return ( i_value << i_bitCount ) | ( i_value >> ( 64 - i_bitCount ) );
+	}
+
+	uint64_t Read64( const uint8_t* const i_data )
+	{
+		uint64_t value;
+		memcpy( &value, i_data, sizeof( value ) );
+		return value;
+	}
+
+	uint32_t Read32( const uint8_t* const i_data )
+	{
+		uint32_t value;
+		memcpy( &value, i_data, sizeof( value ) );
+		return value;
+	}
+
+	uint64_t Round( uint64_t i_accumulator, const uint64_t i_input )
+	{
+		i_accumulator += i_input * s_prime2;
+		i_accumulator = RotateLeft( i_accumulator, 31 );
+		return i_accumulator * s_prime1;
+	}
+
+	uint64_t MergeRound( uint64_t i_accumulator, const uint64_t i_value )
+	{
+		i_accumulator ^= Round( 0, i_value );
+		return ( i_accumulator * s_prime1 ) + s_prime4;
+	}
+
+	uint64_t CalculateXxh64( const uint8_t* const i_data, const size_t i_size, const uint64_t i_seed )
+	{
+		const auto* data = i_data;
+		const auto* const end = i_data + i_size;
+
+		uint64_t hash;
+		if ( i_size >= 32 )
+		{
+			// Most of the data is hashed in four independent lanes
+			uint64_t lanes[] = { i_seed + s_prime1 + s_prime2, i_seed + s_prime2, i_seed, i_seed - s_prime1 };
+			const auto* const end_stripes = end - 32;
+			do
+			{
+				lanes[0] = Round( lanes[0], Read64( data ) );
+				lanes[1] = Round( lanes[1], Read64( data + 8 ) );
+				lanes[2] = Round( lanes[2], Read64( data + 16 ) );
+				lanes[3] = Round( lanes[3], Read64( data + 24 ) );
+				data += 32;
+			} while ( data <= end_stripes );
+			hash = RotateLeft( lanes[0], 1 ) + RotateLeft( lanes[1], 7 ) + RotateLeft( lanes[2], 12 ) + RotateLeft( lanes[3], 18 );
+			for ( const auto lane : lanes )
+			{
+				hash = MergeRound( hash, lane );
+			}
+		}
+		else
+		{
+			hash = i_seed + s_prime5;
+		}
+		hash += static_cast<uint64_t>( i_size );
+
+		// The remaining bytes
+		for ( ; ( data + 8 ) <= end; data += 8 )
+		{
+			hash ^= Round( 0, Read64( data ) );
+			hash = ( RotateLeft( hash, 27 ) * s_prime1 ) + s_prime4;
+		}
+		if ( ( data + 4 ) <= end )
+		{
+			hash ^= static_cast<uint64_t>( Read32( data ) ) * s_prime1;
+			hash = ( RotateLeft( hash, 23 ) * s_prime2 ) + s_prime3;
+			data += 4;
+		}
+		for ( ; data < end; ++data )
+		{
+			hash ^= static_cast<uint64_t>( *data ) * s_prime5;
+			hash = RotateLeft( hash, 11 ) * s_prime1;
+		}
+
+		// Avalanche
+		hash ^= hash >> 33;
+		hash *= s_prime2;
+		hash ^= hash >> 29;
+		hash *= s_prime3;
+		hash ^= hash >> 32;
+		return hash;
+	}
+}
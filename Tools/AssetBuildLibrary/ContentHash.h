@@ -0,0 +1,38 @@
+/*
+	A content hash identifies data by its bytes rather than by where it came from or when it was written:
+		* The asset build uses content hashes to decide whether an asset has to be built
+			(touching a file or switching branches doesn't change its hash if its contents are the same)
+		* Built assets are stored in the build cache using the hash of everything that went into building them
+
+	The hash is 128 bits (two 64-bit XXH64 hashes with different seeds),
+	which is fast to calculate and makes accidental collisions between different contents negligible.
+	It is represented as a string of 32 lowercase hexadecimal digits
+	so that it can be used in file names and compared in Lua
+*/
+
+#ifndef EAE6320_ASSETBUILD_CONTENTHASH_H
+#define EAE6320_ASSETBUILD_CONTENTHASH_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <Engine/Results/Results.h>
+#include <string>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace ContentHash
+		{
+			std::string CalculateHash( const void* const i_data, const size_t i_size );
+			cResult CalculateFileHash( const char* const i_path, std::string& o_hash, std::string* const o_errorMessage = nullptr );
+		}
+	}
+}
+
+#endif	// EAE6320_ASSETBUILD_CONTENTHASH_H
@@ -3,9 +3,14 @@
 
 #include "Functions.h"
 
+#include "BuildScheduler.h"
+#include "BuildTrace.h"
+#include "ContentHash.h"
+
 #include <cstdarg>
 #include <cstdio>
 #include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/Compression.h>
 #include <Engine/Platform/Platform.h>
 #include <External/Lua/Includes.h>
 #include <iostream>
@@ -89,16 +94,24 @@ namespace
 	// Lua Wrapper Functions
 	//----------------------
 
+	int luaCalculateFileHash( lua_State* io_luaState );
+	int luaCalculateHash( lua_State* io_luaState );
+	int luaCompressFile( lua_State* io_luaState );
 	int luaCopyFile( lua_State* io_luaState );
 	int luaCreateDirectoryIfItDoesntExist( lua_State* io_luaState );
+	int luaCreateHardLink( lua_State* io_luaState );
+	int luaDeleteFileIfItExists( lua_State* io_luaState );
 	int luaDoesFileExist( lua_State* io_luaState );
+	int luaExecuteBuildCommands( lua_State* io_luaState );
 	int luaExecuteCommand( lua_State* io_luaState );
 	int luaGetEnvironmentVariable( lua_State* io_luaState );
 	int LuaGetFilesInDirectory( lua_State* io_luaState );
 	int luaGetLastWriteTime( lua_State* io_luaState );
+	int luaGetTraceTimestamp( lua_State* io_luaState );
 	int luaInvalidateLastWriteTime( lua_State* io_luaState );
 	int luaOutputErrorMessage( lua_State* io_luaState );
 	int luaOutputWarningMessage( lua_State* io_luaState );
+	int luaRecordTraceSpan( lua_State* io_luaState );
 }
 
 // Interface
@@ -106,7 +119,32 @@ namespace
 
 eae6320::cResult eae6320::Assets::BuildAssets( const char* const i_path_assetsToBuild )
 {
-	return s_luaState.BuildAssets( i_path_assetsToBuild );
+	BuildTrace::SetProcessName( "AssetBuildExe" );
+	{
+		std::string errorMessage;
+		if ( !BuildTrace::DeletePreviousParts( &errorMessage ) )
+		{
+			OutputWarningMessage( "The parts of the previous build trace couldn't be deleted: %s", errorMessage.c_str() );
+		}
+	}
+
+	cResult result;
+	{
+		BuildTrace::cScope traceScope( i_path_assetsToBuild, "BuildAssets" );
+		result = s_luaState.BuildAssets( i_path_assetsToBuild );
+	}
+
+	// The builders have all exited by now,
+	// and so every part of the trace has been written
+	{
+		std::string errorMessage;
+		if ( !BuildTrace::CombineParts( &errorMessage ) )
+		{
+			OutputWarningMessage( "The build trace couldn't be written: %s", errorMessage.c_str() );
+		}
+	}
+
+	return result;
 }
 
 eae6320::cResult eae6320::Assets::ConvertSourceRelativePathToBuiltRelativePath( const char* const i_sourceRelativePath, const char* const i_assetType,
@@ -115,6 +153,25 @@ eae6320::cResult eae6320::Assets::ConvertSourceRelativePathToBuiltRelativePath(
 	return s_luaState.ConvertSourceRelativePathToBuiltRelativePath( i_sourceRelativePath, i_assetType, o_builtRelativePath, o_errorMessage );
 }
 
+// Message Output
+//---------------
+
+void eae6320::Assets::OutputInformationalMessage( const char* const i_message, ... )
+{
+	std::string formattedMessage;
+	eae6320::cResult result;
+	{
+		va_list insertions;
+		va_start( insertions, i_message );
+		result = FormatErrorOrWarningMessage( i_message, formattedMessage, insertions );
+		va_end( insertions );
+	}
+	if ( result )
+	{
+		std::cout << formattedMessage << std::endl;
+	}
+}
+
 // Error / Warning Output
 //-----------------------
 
@@ -548,16 +605,24 @@ namespace
 		luaL_openlibs( luaState );
 		// Register the custom functions
 		{
+			lua_register( luaState, "CalculateFileHash", luaCalculateFileHash );
+			lua_register( luaState, "CalculateHash", luaCalculateHash );
+			lua_register( luaState, "CompressFile", luaCompressFile );
 			lua_register( luaState, "CopyFile", luaCopyFile );
 			lua_register( luaState, "CreateDirectoryIfItDoesntExist", luaCreateDirectoryIfItDoesntExist );
+			lua_register( luaState, "CreateHardLink", luaCreateHardLink );
+			lua_register( luaState, "DeleteFileIfItExists", luaDeleteFileIfItExists );
 			lua_register( luaState, "DoesFileExist", luaDoesFileExist );
+			lua_register( luaState, "ExecuteBuildCommands", luaExecuteBuildCommands );
 			lua_register( luaState, "ExecuteCommand", luaExecuteCommand );
 			lua_register( luaState, "GetEnvironmentVariable", luaGetEnvironmentVariable );
 			lua_register( luaState, "GetFilesInDirectory", LuaGetFilesInDirectory );
 			lua_register( luaState, "GetLastWriteTime", luaGetLastWriteTime );
+			lua_register( luaState, "GetTraceTimestamp", luaGetTraceTimestamp );
 			lua_register( luaState, "InvalidateLastWriteTime", luaInvalidateLastWriteTime );
 			lua_register( luaState, "OutputErrorMessage", luaOutputErrorMessage );
 			lua_register( luaState, "OutputWarningMessage", luaOutputWarningMessage );
+			lua_register( luaState, "RecordTraceSpan", luaRecordTraceSpan );
 		}
 		// Set the platform #defines
 		{
@@ -806,6 +871,92 @@ namespace
 	// Lua Wrapper Functions
 	//----------------------
 
+	int luaCalculateFileHash( lua_State* io_luaState )
+	{
+		// Argument #1: The path
+		const char* i_path;
+		if ( lua_isstring( io_luaState, 1 ) )
+		{
+			i_path = lua_tostring( io_luaState, 1 );
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #1 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 1 ) );
+		}
+
+		std::string hash;
+		std::string errorMessage;
+		if ( eae6320::Assets::ContentHash::CalculateFileHash( i_path, hash, &errorMessage ) )
+		{
+			lua_pushstring( io_luaState, hash.c_str() );
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		}
+		else
+		{
+			lua_pushnil( io_luaState );
+			lua_pushstring( io_luaState, errorMessage.c_str() );
+			constexpr int returnValueCount = 2;
+			return returnValueCount;
+		}
+	}
+
+	int luaCalculateHash( lua_State* io_luaState )
+	{
+		// Argument #1: The data
+		const char* i_data;
+		size_t i_size;
+		if ( lua_isstring( io_luaState, 1 ) )
+		{
+			i_data = lua_tolstring( io_luaState, 1, &i_size );
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #1 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 1 ) );
+		}
+
+		const auto hash = eae6320::Assets::ContentHash::CalculateHash( i_data, i_size );
+		lua_pushstring( io_luaState, hash.c_str() );
+		constexpr int returnValueCount = 1;
+		return returnValueCount;
+	}
+
+	int luaCompressFile( lua_State* io_luaState )
+	{
+		// Argument #1: The path
+		const char* i_path;
+		if ( lua_isstring( io_luaState, 1 ) )
+		{
+			i_path = lua_tostring( io_luaState, 1 );
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #1 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 1 ) );
+		}
+
+		// Compress the file in place
+		std::string errorMessage;
+		if ( eae6320::Assets::Compression::CompressFile( i_path, &errorMessage ) )
+		{
+			lua_pushboolean( io_luaState, true );
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		}
+		else
+		{
+			lua_pushboolean( io_luaState, false );
+			lua_pushstring( io_luaState, errorMessage.c_str() );
+			constexpr int returnValueCount = 2;
+			return returnValueCount;
+		}
+	}
+
 	int luaCopyFile( lua_State* io_luaState )
 	{
 		// Argument #1: The source path
@@ -885,6 +1036,80 @@ namespace
 		}
 	}
 
+	int luaCreateHardLink( lua_State* io_luaState )
+	{
+		// Argument #1: The path of the existing file
+		const char* i_path_existingFile;
+		if ( lua_isstring( io_luaState, 1 ) )
+		{
+			i_path_existingFile = lua_tostring( io_luaState, 1 );
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #1 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 1 ) );
+		}
+		// Argument #2: The path of the new link
+		const char* i_path_newLink;
+		if ( lua_isstring( io_luaState, 2 ) )
+		{
+			i_path_newLink = lua_tostring( io_luaState, 2 );
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #2 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 2 ) );
+		}
+
+		std::string errorMessage;
+		if ( eae6320::Platform::CreateHardLink( i_path_existingFile, i_path_newLink, &errorMessage ) )
+		{
+			lua_pushboolean( io_luaState, true );
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		}
+		else
+		{
+			lua_pushboolean( io_luaState, false );
+			lua_pushstring( io_luaState, errorMessage.c_str() );
+			constexpr int returnValueCount = 2;
+			return returnValueCount;
+		}
+	}
+
+	int luaDeleteFileIfItExists( lua_State* io_luaState )
+	{
+		// Argument #1: The path
+		const char* i_path;
+		if ( lua_isstring( io_luaState, 1 ) )
+		{
+			i_path = lua_tostring( io_luaState, 1 );
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #1 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 1 ) );
+		}
+
+		std::string errorMessage;
+		if ( eae6320::Platform::DeleteFileIfItExists( i_path, &errorMessage ) )
+		{
+			lua_pushboolean( io_luaState, true );
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		}
+		else
+		{
+			lua_pushboolean( io_luaState, false );
+			lua_pushstring( io_luaState, errorMessage.c_str() );
+			constexpr int returnValueCount = 2;
+			return returnValueCount;
+		}
+	}
+
 	int luaDoesFileExist( lua_State* io_luaState )
 	{
 		// Argument #1: The path
@@ -916,6 +1141,225 @@ namespace
 		}
 	}
 
+	int luaExecuteBuildCommands( lua_State* io_luaState )
+	{
+		// Argument #1: An array of jobs
+		// (each job is a table with a "command" string,
+		// an optional "name" string to identify it in the build trace,
+		// an optional "path_builder" string and "builderArguments" array to build the job with a build host,
+		// an optional "path_fileToCompress" string,
+		// and an optional "dependencies" array of the indices of jobs that must succeed first)
+		std::vector<eae6320::Assets::BuildScheduler::sJob> i_jobs;
+		if ( lua_istable( io_luaState, 1 ) )
+		{
+			const auto jobCount = luaL_len( io_luaState, 1 );
+			i_jobs.resize( static_cast<size_t>( jobCount ) );
+			for ( lua_Integer i = 1; i <= jobCount; ++i )
+			{
+				auto& job = i_jobs[static_cast<size_t>( i - 1 )];
+				if ( lua_geti( io_luaState, 1, i ) != LUA_TTABLE )
+				{
+					return luaL_error( io_luaState,
+						"Job #%d must be a table (instead of a %s)",
+						static_cast<int>( i ), luaL_typename( io_luaState, -1 ) );
+				}
+				// name
+				{
+					const auto type = lua_getfield( io_luaState, -1, "name" );
+					if ( type == LUA_TSTRING )
+					{
+						job.name = lua_tostring( io_luaState, -1 );
+					}
+					else if ( type != LUA_TNIL )
+					{
+						return luaL_error( io_luaState,
+							"Job #%d's name must be a string (instead of a %s)",
+							static_cast<int>( i ), luaL_typename( io_luaState, -1 ) );
+					}
+					lua_pop( io_luaState, 1 );
+				}
+				// command
+				if ( lua_getfield( io_luaState, -1, "command" ) == LUA_TSTRING )
+				{
+					job.command = lua_tostring( io_luaState, -1 );
+					lua_pop( io_luaState, 1 );
+				}
+				else
+				{
+					return luaL_error( io_luaState,
+						"Job #%d must have a command string (instead of a %s)",
+						static_cast<int>( i ), luaL_typename( io_luaState, -1 ) );
+				}
+				// path_builder
+				{
+					const auto type = lua_getfield( io_luaState, -1, "path_builder" );
+					if ( type == LUA_TSTRING )
+					{
+						job.path_builder = lua_tostring( io_luaState, -1 );
+					}
+					else if ( type != LUA_TNIL )
+					{
+						return luaL_error( io_luaState,
+							"Job #%d's path_builder must be a string (instead of a %s)",
+							static_cast<int>( i ), luaL_typename( io_luaState, -1 ) );
+					}
+					lua_pop( io_luaState, 1 );
+				}
+				// builderArguments
+				{
+					const auto type = lua_getfield( io_luaState, -1, "builderArguments" );
+					if ( type == LUA_TTABLE )
+					{
+						const auto argumentCount = luaL_len( io_luaState, -1 );
+						for ( lua_Integer j = 1; j <= argumentCount; ++j )
+						{
+							if ( lua_geti( io_luaState, -1, j ) != LUA_TSTRING )
+							{
+								return luaL_error( io_luaState,
+									"Job #%d's builder argument #%d must be a string (instead of a %s)",
+									static_cast<int>( i ), static_cast<int>( j ), luaL_typename( io_luaState, -1 ) );
+							}
+							job.builderArguments.push_back( lua_tostring( io_luaState, -1 ) );
+							lua_pop( io_luaState, 1 );
+						}
+					}
+					else if ( type != LUA_TNIL )
+					{
+						return luaL_error( io_luaState,
+							"Job #%d's builderArguments must be a table (instead of a %s)",
+							static_cast<int>( i ), luaL_typename( io_luaState, -1 ) );
+					}
+					lua_pop( io_luaState, 1 );
+				}
+				// path_fileToCompress
+				{
+					const auto type = lua_getfield( io_luaState, -1, "path_fileToCompress" );
+					if ( type == LUA_TSTRING )
+					{
+						job.path_fileToCompress = lua_tostring( io_luaState, -1 );
+					}
+					else if ( type != LUA_TNIL )
+					{
+						return luaL_error( io_luaState,
+							"Job #%d's path_fileToCompress must be a string (instead of a %s)",
+							static_cast<int>( i ), luaL_typename( io_luaState, -1 ) );
+					}
+					lua_pop( io_luaState, 1 );
+				}
+				// dependencies
+				{
+					const auto type = lua_getfield( io_luaState, -1, "dependencies" );
+					if ( type == LUA_TTABLE )
+					{
+						const auto dependencyCount = luaL_len( io_luaState, -1 );
+						for ( lua_Integer j = 1; j <= dependencyCount; ++j )
+						{
+							lua_geti( io_luaState, -1, j );
+							int isInteger;
+							const auto dependency = lua_tointegerx( io_luaState, -1, &isInteger );
+							if ( !isInteger || ( dependency < 1 ) || ( dependency > jobCount ) )
+							{
+								return luaL_error( io_luaState,
+									"Job #%d's dependency #%d must be the index of a job",
+									static_cast<int>( i ), static_cast<int>( j ) );
+							}
+							job.dependencies.push_back( static_cast<size_t>( dependency - 1 ) );
+							lua_pop( io_luaState, 1 );
+						}
+					}
+					else if ( type != LUA_TNIL )
+					{
+						return luaL_error( io_luaState,
+							"Job #%d's dependencies must be a table (instead of a %s)",
+							static_cast<int>( i ), luaL_typename( io_luaState, -1 ) );
+					}
+					lua_pop( io_luaState, 1 );
+				}
+				lua_pop( io_luaState, 1 );
+			}
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #1 must be a table (instead of a %s)",
+				luaL_typename( io_luaState, 1 ) );
+		}
+		// Argument #2: The maximum number of jobs to run at the same time
+		// (zero means to use the number of hardware threads)
+		unsigned int i_maxConcurrentJobCount;
+		{
+			int isInteger;
+			const auto maxConcurrentJobCount = lua_tointegerx( io_luaState, 2, &isInteger );
+			if ( isInteger && ( maxConcurrentJobCount >= 0 ) )
+			{
+				i_maxConcurrentJobCount = static_cast<unsigned int>( maxConcurrentJobCount );
+			}
+			else
+			{
+				return luaL_error( io_luaState,
+					"Argument #2 must be a non-negative integer (instead of a %s)",
+					luaL_typename( io_luaState, 2 ) );
+			}
+		}
+		// Argument #3: The function to call when each job finishes
+		// (it is called in the order of the jobs with the job's index and a table describing the result)
+		constexpr int i_onJobFinished = 3;
+		if ( !lua_isfunction( io_luaState, i_onJobFinished ) )
+		{
+			return luaL_error( io_luaState,
+				"Argument #3 must be a function (instead of a %s)",
+				luaL_typename( io_luaState, i_onJobFinished ) );
+		}
+
+		// Run the jobs
+		// (a Lua error can't be raised until the scheduler returns
+		// because it would skip waiting for the jobs that are still running,
+		// and so an error in the callback is saved and raised afterwards)
+		std::string callbackErrorMessage;
+		const auto result = eae6320::Assets::BuildScheduler::RunJobs( i_jobs, i_maxConcurrentJobCount,
+			[io_luaState, &callbackErrorMessage]( const size_t i_jobIndex, const eae6320::Assets::BuildScheduler::sJobResult& i_result )
+			{
+				lua_pushvalue( io_luaState, i_onJobFinished );
+				lua_pushinteger( io_luaState, static_cast<lua_Integer>( i_jobIndex + 1 ) );
+				lua_createtable( io_luaState, 0, 6 );
+				{
+					lua_pushboolean( io_luaState, i_result.wasSkipped );
+					lua_setfield( io_luaState, -2, "wasSkipped" );
+					lua_pushboolean( io_luaState, !i_result.wasSkipped && i_result.executionResult );
+					lua_setfield( io_luaState, -2, "wasExecuted" );
+					lua_pushinteger( io_luaState, i_result.exitCode );
+					lua_setfield( io_luaState, -2, "exitCode" );
+					lua_pushlstring( io_luaState, i_result.output.data(), i_result.output.size() );
+					lua_setfield( io_luaState, -2, "output" );
+					lua_pushstring( io_luaState, i_result.errorMessage.c_str() );
+					lua_setfield( io_luaState, -2, "errorMessage" );
+					lua_pushboolean( io_luaState, i_result.compressionResult );
+					lua_setfield( io_luaState, -2, "wasCompressionSuccessful" );
+				}
+				constexpr int argumentCount = 2;
+				constexpr int returnValueCount = 0;
+				constexpr int noErrorHandler = 0;
+				if ( lua_pcall( io_luaState, argumentCount, returnValueCount, noErrorHandler ) == LUA_OK )
+				{
+					return eae6320::Results::Success;
+				}
+				else
+				{
+					callbackErrorMessage = lua_tostring( io_luaState, -1 );
+					lua_pop( io_luaState, 1 );
+					return eae6320::Results::Failure;
+				}
+			} );
+		if ( !callbackErrorMessage.empty() )
+		{
+			return luaL_error( io_luaState, "%s", callbackErrorMessage.c_str() );
+		}
+
+		lua_pushboolean( io_luaState, result );
+		constexpr int returnValueCount = 1;
+		return returnValueCount;
+	}
+
 	int luaExecuteCommand( lua_State* io_luaState )
 	{
 		// Argument #1: The command
@@ -1064,6 +1508,13 @@ namespace
 		}
 	}
 
+	int luaGetTraceTimestamp( lua_State* io_luaState )
+	{
+		lua_pushinteger( io_luaState, static_cast<lua_Integer>( eae6320::Assets::BuildTrace::GetTimestamp() ) );
+		constexpr int returnValueCount = 1;
+		return returnValueCount;
+	}
+
 	int luaInvalidateLastWriteTime( lua_State* io_luaState )
 	{
 		// Argument #1: The path
@@ -1179,4 +1630,89 @@ namespace
 		constexpr int returnValueCount = 0;
 		return returnValueCount;
 	}
+
+	int luaRecordTraceSpan( lua_State* io_luaState )
+	{
+		// Argument #1: The name
+		const char* i_name;
+		if ( lua_isstring( io_luaState, 1 ) )
+		{
+			i_name = lua_tostring( io_luaState, 1 );
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #1 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 1 ) );
+		}
+		// Argument #2: The category
+		const char* i_category;
+		if ( lua_isstring( io_luaState, 2 ) )
+		{
+			i_category = lua_tostring( io_luaState, 2 );
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #2 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 2 ) );
+		}
+		// Arguments #3 and #4: The start and end times (from GetTraceTimestamp())
+		uint64_t i_startTime, i_endTime;
+		{
+			int isInteger;
+			i_startTime = static_cast<uint64_t>( lua_tointegerx( io_luaState, 3, &isInteger ) );
+			if ( !isInteger )
+			{
+				return luaL_error( io_luaState,
+					"Argument #3 must be a timestamp (instead of a %s)",
+					luaL_typename( io_luaState, 3 ) );
+			}
+			i_endTime = static_cast<uint64_t>( lua_tointegerx( io_luaState, 4, &isInteger ) );
+			if ( !isInteger )
+			{
+				return luaL_error( io_luaState,
+					"Argument #4 must be a timestamp (instead of a %s)",
+					luaL_typename( io_luaState, 4 ) );
+			}
+		}
+		// Argument #5: An optional table of arguments to show with the span
+		// (the keys must be strings, and the values can be integers or strings)
+		std::string i_arguments;
+		if ( !lua_isnoneornil( io_luaState, 5 ) )
+		{
+			if ( !lua_istable( io_luaState, 5 ) )
+			{
+				return luaL_error( io_luaState,
+					"Argument #5 must be a table (instead of a %s)",
+					luaL_typename( io_luaState, 5 ) );
+			}
+			lua_pushnil( io_luaState );
+			while ( lua_next( io_luaState, 5 ) != 0 )
+			{
+				if ( lua_type( io_luaState, -2 ) != LUA_TSTRING )
+				{
+					return luaL_error( io_luaState, "The keys of argument #5 must be strings" );
+				}
+				const auto* const key = lua_tostring( io_luaState, -2 );
+				if ( lua_isinteger( io_luaState, -1 ) )
+				{
+					eae6320::Assets::BuildTrace::AppendArgument( key, static_cast<uint64_t>( lua_tointeger( io_luaState, -1 ) ), i_arguments );
+				}
+				else
+				{
+					eae6320::Assets::BuildTrace::AppendArgument( key, luaL_tolstring( io_luaState, -1, nullptr ), i_arguments );
+					// Pop the converted string
+					lua_pop( io_luaState, 1 );
+				}
+				// Pop the value
+				lua_pop( io_luaState, 1 );
+			}
+		}
+
+		eae6320::Assets::BuildTrace::RecordSpan( i_name, i_category, i_startTime, i_endTime, i_arguments );
+
+		constexpr int returnValueCount = 0;
+		return returnValueCount;
+	}
 }
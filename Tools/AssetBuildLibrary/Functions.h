@@ -26,6 +26,13 @@ namespace eae6320
 		eae6320::cResult ConvertSourceRelativePathToBuiltRelativePath( const char* const i_sourceRelativePath, const char* const i_assetType,
 			std::string& o_builtRelativePath, std::string* o_errorMessage = nullptr );
 
+		// Message Output
+		//---------------
+
+		// This outputs an informational message (e.g. statistics about a built asset) to the build output
+		// without it showing up in Visual Studio's Error List window
+		void OutputInformationalMessage( const char* const i_message, ... );
+
 		// Error / Warning Output
 		//-----------------------
 
@@ -0,0 +1,137 @@
+// Include Files
+//==============
+
+#include "../cBuildHost.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Windows/Functions.h>
+#include <sstream>
+
+// Interface
+//==========
+
+bool eae6320::Assets::cBuildHost::IsRunning() const
+{
+	return m_process != NULL;
+}
+
+eae6320::cResult eae6320::Assets::cBuildHost::Start( const char* const i_path_builder, std::string* const o_errorMessage )
+{
+	if ( IsRunning() )
+	{
+		EAE6320_ASSERTF( false, "The build host for \"%s\" is already running", m_path_builder.c_str() );
+		return Results::Failure;
+	}
+
+	m_path_builder = i_path_builder;
+	std::string command;
+	{
+		std::ostringstream commandLine;
+		commandLine << "\"" << i_path_builder << "\" " << BuildHost::CommandArgument;
+		command = commandLine.str();
+	}
+	return Windows::StartProcessWithRedirectedIo( command.c_str(), m_process, m_output_read, &m_input_write, o_errorMessage );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Assets::cBuildHost::Stop()
+{
+	auto result = Results::Success;
+
+	// Closing the input tells the host to exit
+	if ( m_input_write )
+	{
+		if ( CloseHandle( m_input_write ) == FALSE )
+		{
+			const auto windowsErrorMessage = Windows::GetLastSystemError();
+			EAE6320_ASSERTF( false, "Couldn't close the input of a build host: %s", windowsErrorMessage.c_str() );
+			result = Results::Failure;
+		}
+		m_input_write = NULL;
+	}
+	// The output must be closed before waiting
+	// so that the host doesn't block forever if it tries to output anything else
+	if ( m_output_read )
+	{
+		if ( CloseHandle( m_output_read ) == FALSE )
+		{
+			const auto windowsErrorMessage = Windows::GetLastSystemError();
+			EAE6320_ASSERTF( false, "Couldn't close the output of a build host: %s", windowsErrorMessage.c_str() );
+			result = Results::Failure;
+		}
+		m_output_read = NULL;
+	}
+	if ( m_process )
+	{
+		if ( WaitForSingleObject( m_process, INFINITE ) == WAIT_FAILED )
+		{
+			const auto windowsErrorMessage = Windows::GetLastSystemError();
+			EAE6320_ASSERTF( false, "Didn't wait for a build host to exit: %s", windowsErrorMessage.c_str() );
+			result = Results::Failure;
+		}
+		if ( CloseHandle( m_process ) == FALSE )
+		{
+			const auto windowsErrorMessage = Windows::GetLastSystemError();
+			EAE6320_ASSERTF( false, "Couldn't close a build host process: %s", windowsErrorMessage.c_str() );
+			result = Results::Failure;
+		}
+		m_process = NULL;
+	}
+
+	return result;
+}
+
+// Implementation
+//===============
+
+eae6320::cResult eae6320::Assets::cBuildHost::WriteInput( const std::string& i_input, std::string* const o_errorMessage )
+{
+	auto* data = i_input.data();
+	auto remainingByteCount = static_cast<DWORD>( i_input.size() );
+	while ( remainingByteCount > 0 )
+	{
+		DWORD writtenByteCount;
+		if ( WriteFile( m_input_write, data, remainingByteCount, &writtenByteCount, NULL ) != FALSE )
+		{
+			data += writtenByteCount;
+			remainingByteCount -= writtenByteCount;
+		}
+		else
+		{
+			const auto windowsErrorMessage = Windows::GetLastSystemError();
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to send a build to the build host for \"" << m_path_builder << "\": " << windowsErrorMessage;
+				*o_errorMessage = errorMessage.str();
+			}
+			return Results::Failure;
+		}
+	}
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Assets::cBuildHost::ReadOutput( std::string& io_output, std::string* const o_errorMessage )
+{
+	constexpr DWORD bufferSize = 4096;
+	char buffer[bufferSize];
+	DWORD readByteCount;
+	if ( ReadFile( m_output_read, buffer, bufferSize, &readByteCount, NULL ) != FALSE )
+	{
+		io_output.append( buffer, readByteCount );
+		return Results::Success;
+	}
+	else
+	{
+		// If the pipe is broken the host has exited
+		DWORD windowsErrorCode;
+		const auto windowsErrorMessage = Windows::GetLastSystemError( &windowsErrorCode );
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = ( windowsErrorCode == ERROR_BROKEN_PIPE ) ? "The builder exited" : windowsErrorMessage;
+		}
+		return Results::Failure;
+	}
+}
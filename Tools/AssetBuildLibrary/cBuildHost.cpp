@@ -0,0 +1,91 @@
+// Include Files
+//==============
+
+#include "cBuildHost.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <sstream>
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Assets::cBuildHost::Build( const std::vector<std::string>& i_arguments, int& o_exitCode, std::string& o_output,
+	std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	o_exitCode = EXIT_FAILURE;
+	o_output.clear();
+
+	if ( !IsRunning() )
+	{
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = "The build host isn't running";
+		}
+		return Results::Failure;
+	}
+
+	// Send the build
+	{
+		std::ostringstream input;
+		input << i_arguments.size() << "\n";
+		for ( const auto& argument : i_arguments )
+		{
+			input << argument << "\n";
+		}
+		if ( !( result = WriteInput( input.str(), o_errorMessage ) ) )
+		{
+			Stop();
+			return result;
+		}
+	}
+	// Read the output until the result is found
+	{
+		const auto markerLength = strlen( BuildHost::ResultMarker );
+		size_t searchStart = 0;
+		size_t markerPosition = std::string::npos;
+		size_t lineEndPosition = std::string::npos;
+		do
+		{
+			if ( !( result = ReadOutput( o_output, o_errorMessage ) ) )
+			{
+				if ( o_errorMessage )
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "The build host for \"" << m_path_builder << "\" stopped without finishing the build: " << *o_errorMessage;
+					*o_errorMessage = errorMessage.str();
+				}
+				Stop();
+				return result;
+			}
+			if ( markerPosition == std::string::npos )
+			{
+				markerPosition = o_output.find( BuildHost::ResultMarker, searchStart );
+				// The start of the marker may have been read without the rest of it
+				searchStart = ( o_output.size() > markerLength ) ? ( o_output.size() - markerLength ) : 0;
+			}
+			if ( markerPosition != std::string::npos )
+			{
+				lineEndPosition = o_output.find( '\n', markerPosition + markerLength );
+			}
+		} while ( lineEndPosition == std::string::npos );
+		o_exitCode = static_cast<int>( strtol( o_output.c_str() + markerPosition + markerLength, nullptr, 10 ) );
+		// The marker isn't part of the build's output
+		// (and nothing else is output until the next build is sent)
+		o_output.resize( markerPosition );
+	}
+
+	return result;
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Assets::cBuildHost::~cBuildHost()
+{
+	const auto result = Stop();
+	EAE6320_ASSERT( result );
+}
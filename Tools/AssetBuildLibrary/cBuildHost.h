@@ -0,0 +1,116 @@
+/*
+	A build host is a builder process that stays running and builds one asset after another:
+		* Starting a new builder process for every asset is slow
+			(and a builder that has to set up something expensive, like a Lua state or an OpenGL context,
+			would have to do it again for every asset)
+		* A builder is started as a build host by passing BuildHost::CommandArgument as its only argument
+			(see cbBuilder::RunAsBuildHost()),
+			and then the same builder object builds every asset that the host is sent
+		* A build host only builds one asset at a time,
+			and so to build assets in parallel a separate host is started for each of them
+			(each host then has its own copy of whatever the builder reuses)
+
+	Each build is sent to a host's standard input as the number of arguments on a line
+	followed by each argument on its own line.
+	Anything that the builder outputs while building is returned as the build's output,
+	and when the build is finished the host outputs BuildHost::ResultMarker followed by the exit code on a line.
+	When the host's standard input is closed it exits.
+*/
+
+#ifndef EAE6320_ASSETBUILD_CBUILDHOST_H
+#define EAE6320_ASSETBUILD_CBUILDHOST_H
+
+// Include Files
+//==============
+
+#include <Engine/Results/Results.h>
+#include <string>
+#include <vector>
+
+#if defined( EAE6320_PLATFORM_WINDOWS )
+	#include <Engine/Windows/Includes.h>
+#endif
+
+// Protocol
+//=========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace BuildHost
+		{
+			constexpr const char* const CommandArgument = "-buildHost";
+			// This starts with an ASCII record separator so that it can't be confused with a builder's output
+			constexpr const char* const ResultMarker = "\x1e" "EAE6320BuildHostResult:";
+		}
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		class cBuildHost
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Starts the builder as a build host
+			cResult Start( const char* const i_path_builder, std::string* const o_errorMessage = nullptr );
+
+			// The arguments are the same as the builder's command line arguments would be (without the builder itself).
+			// If the build host couldn't build the asset (e.g. because the builder crashed) this returns a failure
+			// and the host can't be used again;
+			// if the build itself fails this succeeds and the exit code is non-zero
+			cResult Build( const std::vector<std::string>& i_arguments, int& o_exitCode, std::string& o_output,
+				std::string* const o_errorMessage = nullptr );
+
+			bool IsRunning() const;
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// This tells the host to exit and waits for it
+			cResult Stop();
+
+			cBuildHost() = default;
+			~cBuildHost();
+
+			// Data
+			//=====
+
+		private:
+
+			std::string m_path_builder;
+#if defined( EAE6320_PLATFORM_WINDOWS )
+			HANDLE m_process = NULL;
+			HANDLE m_input_write = NULL;
+			HANDLE m_output_read = NULL;
+#endif
+
+			// Implementation
+			//===============
+
+		private:
+
+			// These are implemented for each platform
+			cResult WriteInput( const std::string& i_input, std::string* const o_errorMessage );
+			// This waits until there is some output and then appends it
+			cResult ReadOutput( std::string& io_output, std::string* const o_errorMessage );
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cBuildHost( const cBuildHost& ) = delete;
+			cBuildHost& operator =( const cBuildHost& ) = delete;
+		};
+	}
+}
+
+#endif	// EAE6320_ASSETBUILD_CBUILDHOST_H
@@ -3,13 +3,25 @@
 
 #include "cbBuilder.h"
 
+#include "BuildTrace.h"
+#include "cBuildHost.h"
 #include "Functions.h"
 
+#include <cstdio>
+#include <cstring>
+#include <Engine/Platform/Platform.h>
+#include <iostream>
 #include <sstream>
 
 // Interface
 //==========
 
+bool eae6320::Assets::IsBuildHostCommand( char* const* i_arguments, const unsigned int i_argumentCount )
+{
+	constexpr unsigned int commandCount = 1;
+	return ( i_argumentCount == ( commandCount + 1 ) ) && ( strcmp( i_arguments[commandCount], BuildHost::CommandArgument ) == 0 );
+}
+
 // Build
 //------
 
@@ -24,11 +36,45 @@ eae6320::cResult eae6320::Assets::cbBuilder::ParseCommandArgumentsAndBuild( char
 		m_path_target = i_arguments[commandCount + 1];
 
 		std::vector<std::string> optionalArguments;
+		const char* path_dependencies = nullptr;
 		for ( auto i = ( commandCount + requiredArgumentCount ); i < i_argumentCount; ++i )
 		{
-			optionalArguments.push_back( i_arguments[i] );
+			const auto prefixLength = strlen( DependencyFileArgumentPrefix );
+			if ( strncmp( i_arguments[i], DependencyFileArgumentPrefix, prefixLength ) == 0 )
+			{
+				path_dependencies = i_arguments[i] + prefixLength;
+			}
+			else
+			{
+				optionalArguments.push_back( i_arguments[i] );
+			}
+		}
+		m_dependencies.clear();
+		cResult result;
+		{
+			BuildTrace::cScope traceScope( m_path_source, "Builder" );
+			traceScope.AddArgument( "target", m_path_target );
+			result = Build( optionalArguments );
+			traceScope.AddArgument( "succeeded", result ? 1 : 0 );
 		}
-		return Build( optionalArguments );
+		if ( result && path_dependencies )
+		{
+			std::string dependencies;
+			for ( const auto& dependency : m_dependencies )
+			{
+				dependencies += dependency + "\n";
+			}
+			std::string errorMessage;
+			if ( !( result = Platform::WriteBinaryFile( path_dependencies, dependencies.data(), dependencies.size(), &errorMessage ) ) )
+			{
+				OutputErrorMessageWithFileInfo( m_path_source, "The dependencies couldn't be written to \"%s\": %s",
+					path_dependencies, errorMessage.c_str() );
+			}
+		}
+		// The spans are written after every asset
+		// so that they aren't lost if a build host is killed
+		BuildTrace::Flush();
+		return result;
 	}
 	else
 	{
@@ -53,3 +99,75 @@ eae6320::cResult eae6320::Assets::cbBuilder::ParseCommandArgumentsAndBuild( char
 		return Results::Failure;
 	}
 }
+
+eae6320::cResult eae6320::Assets::cbBuilder::RunAsBuildHost()
+{
+	// Each build is the number of arguments followed by the arguments
+	// (see cBuildHost.h)
+	std::string line;
+	while ( std::getline( std::cin, line ) )
+	{
+		std::vector<std::string> arguments;
+		{
+			char* end;
+			const auto argumentCount = strtoul( line.c_str(), &end, 10 );
+			if ( ( end == line.c_str() ) || ( ( *end != '\0' ) && ( *end != '\r' ) ) )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "A build host expected the number of arguments but was sent \"" << line << "\"";
+				eae6320::Assets::OutputErrorMessage( errorMessage.str().c_str() );
+				return Results::Failure;
+			}
+			arguments.resize( argumentCount );
+		}
+		for ( auto& argument : arguments )
+		{
+			if ( !std::getline( std::cin, argument ) )
+			{
+				eae6320::Assets::OutputErrorMessage( "A build host's input ended in the middle of a build" );
+				return Results::Failure;
+			}
+			if ( !argument.empty() && ( argument.back() == '\r' ) )
+			{
+				argument.pop_back();
+			}
+		}
+		// The arguments are passed in the same way that they would be from main()
+		cResult result;
+		{
+			std::vector<char*> argumentPointers;
+			argumentPointers.push_back( const_cast<char*>( BuildHost::CommandArgument ) );
+			for ( auto& argument : arguments )
+			{
+				argumentPointers.push_back( &argument[0] );
+			}
+			result = ParseCommandArgumentsAndBuild( argumentPointers.data(), static_cast<unsigned int>( argumentPointers.size() ) );
+			// The paths point at this build's arguments
+			m_path_source = nullptr;
+			m_path_target = nullptr;
+		}
+		// Everything that was output during the build must come before the result
+		std::cerr.flush();
+		std::cout.flush();
+		fflush( nullptr );
+		std::cout << BuildHost::ResultMarker << ( result ? EXIT_SUCCESS : EXIT_FAILURE ) << std::endl;
+	}
+	return Results::Success;
+}
+
+// Implementation
+//===============
+
+void eae6320::Assets::cbBuilder::AddDependency( const std::string& i_path )
+{
+	// A file can be included more than once,
+	// but each dependency only needs to be written once
+	for ( const auto& dependency : m_dependencies )
+	{
+		if ( dependency == i_path )
+		{
+			return;
+		}
+	}
+	m_dependencies.push_back( i_path );
+}
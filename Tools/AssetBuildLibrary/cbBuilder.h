@@ -10,6 +10,8 @@
 // Include Files
 //==============
 
+#include "BuildTrace.h"
+
 #include <cstdlib>
 #include <Engine/Results/Results.h>
 #include <string>
@@ -22,13 +24,30 @@ namespace eae6320
 {
 	namespace Assets
 	{
+		// This is true if a builder was started as a build host (see cBuildHost.h)
+		bool IsBuildHostCommand( char* const* i_arguments, const unsigned int i_argumentCount );
+
+		// If one of a builder's optional arguments starts with this
+		// the rest of the argument is the path of a file
+		// that every file that the built asset depended on is written to (one path per line)
+		// when the asset is built successfully
+		// (the argument isn't passed on to the derived builder)
+		constexpr auto* const DependencyFileArgumentPrefix = "-dependencies=";
+
 		// This only thing that a specific builder project's main() entry point should do
 		// is to call the following function with the derived builder class
-		// as the template argument:
+		// as the template argument.
+		// If the builder is started as a build host the same builder object builds every asset that the host is sent,
+		// and so a derived builder can keep anything that is expensive to set up in its member variables:
 		template<class tBuilder>
 			int Build( char* const* i_arguments, const unsigned int i_argumentCount )
 		{
+			BuildTrace::SetProcessName( i_arguments[0] );
 			tBuilder builder;
+			if ( IsBuildHostCommand( i_arguments, i_argumentCount ) )
+			{
+				return builder.RunAsBuildHost() ? EXIT_SUCCESS : EXIT_FAILURE;
+			}
 			return builder.ParseCommandArgumentsAndBuild( i_arguments, i_argumentCount ) ? EXIT_SUCCESS : EXIT_FAILURE;
 		}
 
@@ -45,6 +64,10 @@ namespace eae6320
 			// The following function will be called from the templated Build<> function above
 			// with the command line arguments directly from the main() entry point:
 			cResult ParseCommandArgumentsAndBuild( char* const* i_arguments, const unsigned int i_argumentCount );
+			// This builds each asset that is read from standard input until standard input is closed
+			cResult RunAsBuildHost();
+
+			virtual ~cbBuilder() = default;
 
 			// Data
 			//=====
@@ -54,6 +77,20 @@ namespace eae6320
 			const char* m_path_source = nullptr;
 			const char* m_path_target = nullptr;
 
+		private:
+
+			// The files that the asset that is being built depends on
+			std::vector<std::string> m_dependencies;
+
+			// Implementation
+			//===============
+
+		protected:
+
+			// A derived builder calls this for every file that the built asset depends on
+			// (e.g. every file that a shader #includes)
+			void AddDependency( const std::string& i_path );
+
 			// Inheritable Implementation
 			//===========================
 
@@ -0,0 +1,185 @@
+// Include Files
+//==============
+
+#include "MeshClusters.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Engine/Graphics/VertexFormats.h>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+    constexpr uint32_t s_indicesPerTriangle = 3;
+    constexpr uint32_t s_invalidIndex = ~uint32_t(0u);
+
+    // If the triangles of a cluster face directions that are more than this far apart
+    // then the cluster would almost never be culled for facing away from the camera
+    // (the value is the cosine of the largest angle between a triangle's normal and the cone's axis)
+    constexpr float s_minNormalConeDotProduct = 0.1f;
+
+    eae6320::Graphics::MeshFormats::sCluster CalculateClusterBounds(const eae6320::Graphics::VertexFormats::sMesh* i_vertexData,
+        const uint32_t* i_indices, const uint32_t i_indexOffset, const uint32_t i_indexCount);
+}
+
+// Interface
+//==========
+
+void eae6320::Assets::MeshClusters::BuildClusters(const Graphics::VertexFormats::sMesh* i_vertexData, const uint32_t i_vertexCount,
+    const uint32_t* i_indices, const uint32_t i_indexCount, std::vector<Graphics::MeshFormats::sCluster>& o_clusters)
+{
+    o_clusters.clear();
+    const auto triangleCount = i_indexCount / s_indicesPerTriangle;
+    if (triangleCount == 0)
+    {
+        return;
+    }
+
+    // Each vertex remembers the last cluster that used it
+    // so that the number of unique vertices in the current cluster can be tracked without clearing anything
+    std::vector<uint32_t> clusterOfVertex(i_vertexCount, s_invalidIndex);
+    uint32_t clusterIndex = 0;
+    uint32_t clusterFirstTriangle = 0;
+    uint32_t clusterVertexCount = 0;
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        const auto* const triangle = i_indices + (t * s_indicesPerTriangle);
+        uint32_t newVertexCount = 0;
+        for (uint32_t i = 0; i < s_indicesPerTriangle; ++i)
+        {
+            // A degenerate triangle can use the same vertex more than once
+            const auto isRepeated = ((i > 0) && (triangle[i] == triangle[0])) || ((i > 1) && (triangle[i] == triangle[1]));
+            if ((clusterOfVertex[triangle[i]] != clusterIndex) && !isRepeated)
+            {
+                ++newVertexCount;
+            }
+        }
+
+        const auto clusterTriangleCount = t - clusterFirstTriangle;
+        if (((clusterVertexCount + newVertexCount) > MaxVertexCountPerCluster) || (clusterTriangleCount >= MaxTriangleCountPerCluster))
+        {
+            o_clusters.push_back(CalculateClusterBounds(i_vertexData, i_indices,
+                clusterFirstTriangle * s_indicesPerTriangle, clusterTriangleCount * s_indicesPerTriangle));
+            ++clusterIndex;
+            clusterFirstTriangle = t;
+            clusterVertexCount = 0;
+        }
+
+        for (uint32_t i = 0; i < s_indicesPerTriangle; ++i)
+        {
+            if (clusterOfVertex[triangle[i]] != clusterIndex)
+            {
+                clusterOfVertex[triangle[i]] = clusterIndex;
+                ++clusterVertexCount;
+            }
+        }
+    }
+    o_clusters.push_back(CalculateClusterBounds(i_vertexData, i_indices,
+        clusterFirstTriangle * s_indicesPerTriangle, (triangleCount - clusterFirstTriangle) * s_indicesPerTriangle));
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+    eae6320::Graphics::MeshFormats::sCluster CalculateClusterBounds(const eae6320::Graphics::VertexFormats::sMesh* i_vertexData,
+        const uint32_t* i_indices, const uint32_t i_indexOffset, const uint32_t i_indexCount)
+    {
+        eae6320::Graphics::MeshFormats::sCluster cluster{};
+        cluster.indexOffset = i_indexOffset;
+        cluster.indexCount = i_indexCount;
+
+        const auto* const indices = i_indices + i_indexOffset;
+
+        // The bounding sphere is centered on the cluster's bounding box
+        {
+            float minimum[3] = { 0.0f, 0.0f, 0.0f };
+            float maximum[3] = { 0.0f, 0.0f, 0.0f };
+            for (uint32_t i = 0; i < i_indexCount; ++i)
+            {
+                const auto& vertex = i_vertexData[indices[i]];
+                const float position[3] = { vertex.x, vertex.y, vertex.z };
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    minimum[j] = (i == 0) ? position[j] : std::min(minimum[j], position[j]);
+                    maximum[j] = (i == 0) ? position[j] : std::max(maximum[j], position[j]);
+                }
+            }
+            for (size_t j = 0; j < 3; ++j)
+            {
+                cluster.boundingSphere_center[j] = (minimum[j] + maximum[j]) * 0.5f;
+            }
+            auto radiusSquared = 0.0f;
+            for (uint32_t i = 0; i < i_indexCount; ++i)
+            {
+                const auto& vertex = i_vertexData[indices[i]];
+                const float offset[3] = { vertex.x - cluster.boundingSphere_center[0],
+                    vertex.y - cluster.boundingSphere_center[1], vertex.z - cluster.boundingSphere_center[2] };
+                radiusSquared = std::max(radiusSquared, (offset[0] * offset[0]) + (offset[1] * offset[1]) + (offset[2] * offset[2]));
+            }
+            cluster.boundingSphere_radius = std::sqrt(radiusSquared);
+        }
+
+        // The normal cone's axis is the average of the triangles' normals,
+        // and its cutoff is the sine of the angle between the axis and the triangle normal furthest from it
+        // (a camera can only be behind all of the triangles if it is outside of the cone rotated by 90 degrees)
+        {
+            cluster.normalCone_axis[0] = cluster.normalCone_axis[1] = cluster.normalCone_axis[2] = 0.0f;
+            cluster.normalCone_cutoff = 1.0f;
+
+            const auto triangleCount = i_indexCount / s_indicesPerTriangle;
+            std::vector<float> normals;
+            normals.reserve(triangleCount * 3);
+            float axis[3] = { 0.0f, 0.0f, 0.0f };
+            for (uint32_t t = 0; t < triangleCount; ++t)
+            {
+                const auto& vertex0 = i_vertexData[indices[(t * s_indicesPerTriangle) + 0]];
+                const auto& vertex1 = i_vertexData[indices[(t * s_indicesPerTriangle) + 1]];
+                const auto& vertex2 = i_vertexData[indices[(t * s_indicesPerTriangle) + 2]];
+                const float edge1[3] = { vertex1.x - vertex0.x, vertex1.y - vertex0.y, vertex1.z - vertex0.z };
+                const float edge2[3] = { vertex2.x - vertex0.x, vertex2.y - vertex0.y, vertex2.z - vertex0.z };
+                // The triangles are counter-clockwise, and so the cross product points in the direction that they face
+                float normal[3] = { (edge1[1] * edge2[2]) - (edge1[2] * edge2[1]),
+                    (edge1[2] * edge2[0]) - (edge1[0] * edge2[2]), (edge1[0] * edge2[1]) - (edge1[1] * edge2[0]) };
+                const auto length = std::sqrt((normal[0] * normal[0]) + (normal[1] * normal[1]) + (normal[2] * normal[2]));
+                // Degenerate triangles aren't drawn, and so it doesn't matter which way they face
+                if (length > 0.0f)
+                {
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        normal[j] /= length;
+                        axis[j] += normal[j];
+                        normals.push_back(normal[j]);
+                    }
+                }
+            }
+
+            const auto axisLength = std::sqrt((axis[0] * axis[0]) + (axis[1] * axis[1]) + (axis[2] * axis[2]));
+            if ((axisLength > 0.0f) && !normals.empty())
+            {
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    axis[j] /= axisLength;
+                }
+                auto minDotProduct = 1.0f;
+                for (size_t n = 0; n < normals.size(); n += 3)
+                {
+                    minDotProduct = std::min(minDotProduct, (normals[n] * axis[0]) + (normals[n + 1] * axis[1]) + (normals[n + 2] * axis[2]));
+                }
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    cluster.normalCone_axis[j] = axis[j];
+                }
+                if (minDotProduct > s_minNormalConeDotProduct)
+                {
+                    cluster.normalCone_cutoff = std::sqrt(1.0f - (minDotProduct * minDotProduct));
+                }
+            }
+        }
+
+        return cluster;
+    }
+}
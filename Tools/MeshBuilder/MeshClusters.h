@@ -0,0 +1,45 @@
+/*
+    These functions split a mesh's triangles into small clusters
+    (sometimes called "meshlets")
+    that can be culled individually at run-time:
+        * Clusters that are outside of the view frustum don't need to be drawn
+        * Clusters whose triangles all face away from the camera don't need to be drawn
+
+    This should be done after the mesh has been optimized (see MeshOptimization.h)
+    because the clusters are made from consecutive triangles,
+    and so triangles that are near each other in the index buffer should also be near each other in space
+*/
+
+#ifndef EAE6320_MESHCLUSTERS_H
+#define EAE6320_MESHCLUSTERS_H
+
+// Include Files
+//==============
+
+#include <cstdint>
+#include <Engine/Graphics/MeshFormats.h>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+    namespace Assets
+    {
+        namespace MeshClusters
+        {
+            // A cluster is small enough that its vertices stay in the GPU's vertex cache
+            // and that a big mesh close to the camera is split into many independently culled pieces
+            constexpr uint32_t MaxVertexCountPerCluster = 64;
+            constexpr uint32_t MaxTriangleCountPerCluster = 124;
+
+            // The triangles aren't reordered:
+            // A new cluster is started whenever adding the next triangle would make the current one too big
+            void BuildClusters(const Graphics::VertexFormats::sMesh* i_vertexData, const uint32_t i_vertexCount,
+                const uint32_t* i_indices, const uint32_t i_indexCount, std::vector<Graphics::MeshFormats::sCluster>& o_clusters);
+        }
+    }
+}
+
+#endif // EAE6320_MESHCLUSTERS_H
@@ -0,0 +1,405 @@
+// Include Files
+//==============
+
+#include "MeshOptimization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Engine/Graphics/VertexFormats.h>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+    constexpr uint32_t s_indicesPerTriangle = 3;
+    constexpr uint32_t s_invalidIndex = ~uint32_t(0u);
+
+    // The size of the cache that the vertex cache optimization scores vertices against
+    // (this is bigger than the simulated cache used for the ACMR
+    // because it produces orders that also work well with small caches)
+    constexpr int s_maxCacheSizeForScoring = 32;
+
+    float ScoreVertex(const int i_cachePosition, const uint32_t i_remainingTriangleCount);
+
+    // This returns the number of vertices that each triangle needs to transform
+    // when the triangles are drawn in the given order (0, 1, 2, or 3)
+    void SimulateCache(const uint32_t* i_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount, const unsigned int i_cacheSize,
+        std::vector<uint8_t>& o_missCountPerTriangle);
+}
+
+// Interface
+//==========
+
+float eae6320::Assets::MeshOptimization::CalculateAcmr(const uint32_t* i_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount,
+    const unsigned int i_cacheSize)
+{
+    const auto triangleCount = i_indexCount / s_indicesPerTriangle;
+    if (triangleCount == 0)
+    {
+        return 0.0f;
+    }
+
+    std::vector<uint8_t> missCountPerTriangle;
+    SimulateCache(i_indices, i_indexCount, i_vertexCount, i_cacheSize, missCountPerTriangle);
+    uint64_t missCount = 0;
+    for (const auto missCountForTriangle : missCountPerTriangle)
+    {
+        missCount += missCountForTriangle;
+    }
+    return static_cast<float>(missCount) / static_cast<float>(triangleCount);
+}
+
+void eae6320::Assets::MeshOptimization::OptimizeVertexCache(uint32_t* io_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount)
+{
+    const auto triangleCount = i_indexCount / s_indicesPerTriangle;
+    if (triangleCount == 0)
+    {
+        return;
+    }
+
+    // Build the list of triangles that use each vertex
+    // (the triangles of vertex v are stored in [triangleOffsets[v], triangleOffsets[v] + remainingTriangleCounts[v]),
+    // and when a triangle is drawn it is swapped out of the remaining range)
+    std::vector<uint32_t> remainingTriangleCounts(i_vertexCount, 0);
+    std::vector<uint32_t> triangleOffsets(i_vertexCount, 0);
+    std::vector<uint32_t> vertexTriangles(i_indexCount);
+    {
+        for (uint32_t i = 0; i < i_indexCount; ++i)
+        {
+            ++remainingTriangleCounts[io_indices[i]];
+        }
+        uint32_t offset = 0;
+        for (uint32_t v = 0; v < i_vertexCount; ++v)
+        {
+            triangleOffsets[v] = offset;
+            offset += remainingTriangleCounts[v];
+        }
+        std::vector<uint32_t> writtenCounts(i_vertexCount, 0);
+        for (uint32_t i = 0; i < i_indexCount; ++i)
+        {
+            const auto vertexIndex = io_indices[i];
+            vertexTriangles[triangleOffsets[vertexIndex] + writtenCounts[vertexIndex]++] = i / s_indicesPerTriangle;
+        }
+    }
+
+    // Calculate the initial scores
+    std::vector<float> vertexScores(i_vertexCount);
+    for (uint32_t v = 0; v < i_vertexCount; ++v)
+    {
+        vertexScores[v] = ScoreVertex(-1, remainingTriangleCounts[v]);
+    }
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<bool> wasTriangleAdded(triangleCount, false);
+    uint32_t bestTriangle = 0;
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        const auto* const triangle = io_indices + (t * s_indicesPerTriangle);
+        triangleScores[t] = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+        if (triangleScores[t] > triangleScores[bestTriangle])
+        {
+            bestTriangle = t;
+        }
+    }
+
+    // Add triangles one at a time,
+    // always choosing the best-scoring triangle that uses a vertex in the cache
+    std::vector<uint32_t> optimizedIndices(i_indexCount);
+    std::vector<uint32_t> cache, newCache;
+    cache.reserve(s_maxCacheSizeForScoring + s_indicesPerTriangle);
+    newCache.reserve(s_maxCacheSizeForScoring + s_indicesPerTriangle);
+    uint32_t nextUnaddedTriangle = 0;
+    for (uint32_t addedTriangleCount = 0; addedTriangleCount < triangleCount; ++addedTriangleCount)
+    {
+        // If none of the vertices in the cache have any triangles left
+        // then continue with the next triangle that hasn't been added yet
+        if (bestTriangle == s_invalidIndex)
+        {
+            while (wasTriangleAdded[nextUnaddedTriangle])
+            {
+                ++nextUnaddedTriangle;
+            }
+            bestTriangle = nextUnaddedTriangle;
+        }
+
+        // Add the triangle
+        const auto* const triangle = io_indices + (bestTriangle * s_indicesPerTriangle);
+        std::copy(triangle, triangle + s_indicesPerTriangle, optimizedIndices.data() + (addedTriangleCount * s_indicesPerTriangle));
+        wasTriangleAdded[bestTriangle] = true;
+        for (uint32_t i = 0; i < s_indicesPerTriangle; ++i)
+        {
+            const auto vertexIndex = triangle[i];
+            auto* const triangles = vertexTriangles.data() + triangleOffsets[vertexIndex];
+            auto& remainingTriangleCount = remainingTriangleCounts[vertexIndex];
+            const auto position = std::find(triangles, triangles + remainingTriangleCount, bestTriangle) - triangles;
+            std::swap(triangles[position], triangles[remainingTriangleCount - 1]);
+            --remainingTriangleCount;
+        }
+
+        // The triangle's vertices move to the front of the cache
+        newCache.clear();
+        newCache.insert(newCache.end(), triangle, triangle + s_indicesPerTriangle);
+        for (const auto vertexIndex : cache)
+        {
+            if ((vertexIndex != triangle[0]) && (vertexIndex != triangle[1]) && (vertexIndex != triangle[2]))
+            {
+                newCache.push_back(vertexIndex);
+            }
+        }
+
+        // Update the scores of every vertex whose cache position changed
+        // (including any that were pushed out of the cache)
+        for (size_t i = 0; i < newCache.size(); ++i)
+        {
+            const auto vertexIndex = newCache[i];
+            const auto cachePosition = (i < s_maxCacheSizeForScoring) ? static_cast<int>(i) : -1;
+            const auto newScore = ScoreVertex(cachePosition, remainingTriangleCounts[vertexIndex]);
+            const auto scoreDelta = newScore - vertexScores[vertexIndex];
+            vertexScores[vertexIndex] = newScore;
+
+            const auto* const triangles = vertexTriangles.data() + triangleOffsets[vertexIndex];
+            for (uint32_t j = 0; j < remainingTriangleCounts[vertexIndex]; ++j)
+            {
+                triangleScores[triangles[j]] += scoreDelta;
+            }
+        }
+        if (newCache.size() > s_maxCacheSizeForScoring)
+        {
+            newCache.resize(s_maxCacheSizeForScoring);
+        }
+        std::swap(cache, newCache);
+
+        // Find the best triangle that uses a vertex which is still in the cache
+        bestTriangle = s_invalidIndex;
+        auto bestTriangleScore = -1.0f;
+        for (const auto vertexIndex : cache)
+        {
+            const auto* const triangles = vertexTriangles.data() + triangleOffsets[vertexIndex];
+            for (uint32_t j = 0; j < remainingTriangleCounts[vertexIndex]; ++j)
+            {
+                if (triangleScores[triangles[j]] > bestTriangleScore)
+                {
+                    bestTriangle = triangles[j];
+                    bestTriangleScore = triangleScores[triangles[j]];
+                }
+            }
+        }
+    }
+    std::copy(optimizedIndices.begin(), optimizedIndices.end(), io_indices);
+}
+
+void eae6320::Assets::MeshOptimization::OptimizeOverdraw(uint32_t* io_indices, const uint32_t i_indexCount,
+    const Graphics::VertexFormats::sMesh* i_vertexData, const uint32_t i_vertexCount, const float i_acmrThreshold)
+{
+    const auto triangleCount = i_indexCount / s_indicesPerTriangle;
+    if (triangleCount == 0)
+    {
+        return;
+    }
+
+    // Split the triangles into clusters:
+    // A new cluster starts wherever the vertex cache optimization had to start over somewhere new
+    // (i.e. at a triangle whose vertices all miss the cache),
+    // and big clusters are also split when a triangle misses the cache more than once
+    // so that there is something to reorder even for well-connected meshes
+    std::vector<uint32_t> clusterStarts;
+    {
+        constexpr uint32_t softSplitTriangleCount = 64;
+        std::vector<uint8_t> missCountPerTriangle;
+        SimulateCache(io_indices, i_indexCount, i_vertexCount, MeshOptimization::DefaultSimulatedCacheSize, missCountPerTriangle);
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            const auto clusterSize = clusterStarts.empty() ? 0 : (t - clusterStarts.back());
+            if (clusterStarts.empty() || (missCountPerTriangle[t] == 3)
+                || ((clusterSize >= softSplitTriangleCount) && (missCountPerTriangle[t] >= 2)))
+            {
+                clusterStarts.push_back(t);
+            }
+        }
+    }
+    if (clusterStarts.size() < 2)
+    {
+        return;
+    }
+    const auto clusterCount = static_cast<uint32_t>(clusterStarts.size());
+    clusterStarts.push_back(triangleCount);
+
+    // Calculate the area-weighted centroid and normal of each cluster and of the whole mesh
+    struct sVector { float x = 0.0f, y = 0.0f, z = 0.0f; };
+    std::vector<sVector> clusterCentroids(clusterCount), clusterNormals(clusterCount);
+    std::vector<float> clusterAreas(clusterCount, 0.0f);
+    sVector meshCentroid;
+    auto meshArea = 0.0f;
+    for (uint32_t c = 0; c < clusterCount; ++c)
+    {
+        for (auto t = clusterStarts[c]; t < clusterStarts[c + 1]; ++t)
+        {
+            const auto& vertex0 = i_vertexData[io_indices[(t * s_indicesPerTriangle) + 0]];
+            const auto& vertex1 = i_vertexData[io_indices[(t * s_indicesPerTriangle) + 1]];
+            const auto& vertex2 = i_vertexData[io_indices[(t * s_indicesPerTriangle) + 2]];
+            const sVector edge1{ vertex1.x - vertex0.x, vertex1.y - vertex0.y, vertex1.z - vertex0.z };
+            const sVector edge2{ vertex2.x - vertex0.x, vertex2.y - vertex0.y, vertex2.z - vertex0.z };
+            // The length of the cross product is twice the triangle's area
+            // (and since the triangles are counter-clockwise it points outward)
+            const sVector normal{ (edge1.y * edge2.z) - (edge1.z * edge2.y), (edge1.z * edge2.x) - (edge1.x * edge2.z), (edge1.x * edge2.y) - (edge1.y * edge2.x) };
+            const auto area = std::sqrt((normal.x * normal.x) + (normal.y * normal.y) + (normal.z * normal.z)) * 0.5f;
+            const sVector centroid{ (vertex0.x + vertex1.x + vertex2.x) / 3.0f, (vertex0.y + vertex1.y + vertex2.y) / 3.0f, (vertex0.z + vertex1.z + vertex2.z) / 3.0f };
+
+            auto& clusterCentroid = clusterCentroids[c];
+            clusterCentroid.x += centroid.x * area;
+            clusterCentroid.y += centroid.y * area;
+            clusterCentroid.z += centroid.z * area;
+            auto& clusterNormal = clusterNormals[c];
+            clusterNormal.x += normal.x;
+            clusterNormal.y += normal.y;
+            clusterNormal.z += normal.z;
+            clusterAreas[c] += area;
+        }
+        meshCentroid.x += clusterCentroids[c].x;
+        meshCentroid.y += clusterCentroids[c].y;
+        meshCentroid.z += clusterCentroids[c].z;
+        meshArea += clusterAreas[c];
+    }
+    if (meshArea <= 0.0f)
+    {
+        return;
+    }
+    meshCentroid.x /= meshArea;
+    meshCentroid.y /= meshArea;
+    meshCentroid.z /= meshArea;
+
+    // Clusters that face away from the center of the mesh are more likely to occlude other clusters,
+    // and so they should be drawn first
+    std::vector<float> sortKeys(clusterCount, 0.0f);
+    for (uint32_t c = 0; c < clusterCount; ++c)
+    {
+        if (clusterAreas[c] > 0.0f)
+        {
+            const auto& normal = clusterNormals[c];
+            const auto normalLength = std::sqrt((normal.x * normal.x) + (normal.y * normal.y) + (normal.z * normal.z));
+            if (normalLength > 0.0f)
+            {
+                const sVector offset{ (clusterCentroids[c].x / clusterAreas[c]) - meshCentroid.x,
+                    (clusterCentroids[c].y / clusterAreas[c]) - meshCentroid.y, (clusterCentroids[c].z / clusterAreas[c]) - meshCentroid.z };
+                sortKeys[c] = ((offset.x * normal.x) + (offset.y * normal.y) + (offset.z * normal.z)) / normalLength;
+            }
+        }
+    }
+    std::vector<uint32_t> clusterOrder(clusterCount);
+    for (uint32_t c = 0; c < clusterCount; ++c)
+    {
+        clusterOrder[c] = c;
+    }
+    std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&sortKeys](const uint32_t i_lhs, const uint32_t i_rhs)
+    {
+        return sortKeys[i_lhs] > sortKeys[i_rhs];
+    });
+
+    std::vector<uint32_t> sortedIndices;
+    sortedIndices.reserve(i_indexCount);
+    for (const auto c : clusterOrder)
+    {
+        sortedIndices.insert(sortedIndices.end(), io_indices + (clusterStarts[c] * s_indicesPerTriangle), io_indices + (clusterStarts[c + 1] * s_indicesPerTriangle));
+    }
+
+    // Only keep the new order if it doesn't undo too much of the vertex cache optimization
+    const auto acmr_before = CalculateAcmr(io_indices, i_indexCount, i_vertexCount);
+    const auto acmr_after = CalculateAcmr(sortedIndices.data(), i_indexCount, i_vertexCount);
+    if (acmr_after <= (acmr_before * i_acmrThreshold))
+    {
+        std::copy(sortedIndices.begin(), sortedIndices.end(), io_indices);
+    }
+}
+
+uint32_t eae6320::Assets::MeshOptimization::OptimizeVertexFetch(Graphics::VertexFormats::sMesh* io_vertexData, const uint32_t i_vertexCount,
+    uint32_t* io_indices, const uint32_t i_indexCount)
+{
+    std::vector<uint32_t> newVertexIndices(i_vertexCount, s_invalidIndex);
+    uint32_t newVertexCount = 0;
+    for (uint32_t i = 0; i < i_indexCount; ++i)
+    {
+        auto& newVertexIndex = newVertexIndices[io_indices[i]];
+        if (newVertexIndex == s_invalidIndex)
+        {
+            newVertexIndex = newVertexCount++;
+        }
+        io_indices[i] = newVertexIndex;
+    }
+
+    std::vector<Graphics::VertexFormats::sMesh> reorderedVertexData(newVertexCount);
+    for (uint32_t v = 0; v < i_vertexCount; ++v)
+    {
+        if (newVertexIndices[v] != s_invalidIndex)
+        {
+            reorderedVertexData[newVertexIndices[v]] = io_vertexData[v];
+        }
+    }
+    std::copy(reorderedVertexData.begin(), reorderedVertexData.end(), io_vertexData);
+
+    return newVertexCount;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+    float ScoreVertex(const int i_cachePosition, const uint32_t i_remainingTriangleCount)
+    {
+        // A vertex without any triangles left to draw doesn't matter
+        if (i_remainingTriangleCount == 0)
+        {
+            return -1.0f;
+        }
+
+        constexpr float lastTriangleScore = 0.75f;
+        constexpr float cacheDecayPower = 1.5f;
+        constexpr float valenceBoostScale = 2.0f;
+        constexpr float valenceBoostPower = 0.5f;
+
+        auto score = 0.0f;
+        if (i_cachePosition >= 0)
+        {
+            // The vertices of the triangle that was just drawn get a fixed score
+            // so that the next triangle doesn't favor one of its edges over another
+            if (i_cachePosition < 3)
+            {
+                score = lastTriangleScore;
+            }
+            else
+            {
+                const auto scaler = 1.0f / (s_maxCacheSizeForScoring - 3);
+                score = std::pow(1.0f - ((i_cachePosition - 3) * scaler), cacheDecayPower);
+            }
+        }
+        // Vertices with only a few triangles left get a boost
+        // so that they are finished off instead of leaving lone triangles that would need to be transformed again later
+        score += valenceBoostScale * std::pow(static_cast<float>(i_remainingTriangleCount), -valenceBoostPower);
+
+        return score;
+    }
+
+    void SimulateCache(const uint32_t* i_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount, const unsigned int i_cacheSize,
+        std::vector<uint8_t>& o_missCountPerTriangle)
+    {
+        // A FIFO cache only changes when there is a miss,
+        // and so a vertex is in the cache if fewer than i_cacheSize misses have happened since it was added
+        std::vector<uint32_t> timeStamps(i_vertexCount, 0);
+        uint32_t time = i_cacheSize + 1;
+        const auto triangleCount = i_indexCount / s_indicesPerTriangle;
+        o_missCountPerTriangle.assign(triangleCount, 0);
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            for (uint32_t i = 0; i < s_indicesPerTriangle; ++i)
+            {
+                const auto vertexIndex = i_indices[(t * s_indicesPerTriangle) + i];
+                if ((time - timeStamps[vertexIndex]) > i_cacheSize)
+                {
+                    timeStamps[vertexIndex] = time++;
+                    ++o_missCountPerTriangle[t];
+                }
+            }
+        }
+    }
+}
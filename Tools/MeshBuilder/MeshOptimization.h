@@ -0,0 +1,73 @@
+/*
+    These functions reorder a mesh's triangles and vertices
+    so that it is faster for the GPU to render:
+        * Triangles are reordered so that vertices which have just been transformed
+            are likely to still be in the GPU's post-transform cache
+            (using Tom Forsyth's "Linear-Speed Vertex Cache Optimisation")
+        * Optionally, groups of triangles are then reordered so that triangles facing outward from the mesh's center
+            are drawn first, which makes it more likely that hidden pixels are rejected by the depth test
+        * Finally, vertices are reordered to match the order that the triangles first use them
+            so that fetching vertex data from memory is as sequential as possible
+
+    The average cache miss ratio (ACMR) is the number of vertices that must be transformed per triangle;
+    it can't be less than 0.5 for a closed mesh, and an unoptimized mesh is often close to 3.0
+*/
+
+#ifndef EAE6320_MESHOPTIMIZATION_H
+#define EAE6320_MESHOPTIMIZATION_H
+
+// Include Files
+//==============
+
+#include <cstdint>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+    namespace Graphics
+    {
+        namespace VertexFormats
+        {
+            struct sMesh;
+        }
+    }
+}
+
+// Interface
+//==========
+
+namespace eae6320
+{
+    namespace Assets
+    {
+        namespace MeshOptimization
+        {
+            // The ACMR is calculated by simulating a FIFO cache
+            // (a small cache size gives a conservative estimate across different GPUs)
+            constexpr unsigned int DefaultSimulatedCacheSize = 16;
+            float CalculateAcmr(const uint32_t* i_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount,
+                const unsigned int i_cacheSize = DefaultSimulatedCacheSize);
+
+            // The triangles are reordered in place
+            void OptimizeVertexCache(uint32_t* io_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount);
+
+            // This should be called after OptimizeVertexCache().
+            // Triangles are reordered in clusters (so that most of the vertex cache optimization is kept),
+            // and the new order is only kept if it doesn't make the ACMR worse than the given threshold
+            // (e.g. 1.05 allows the ACMR to get 5% worse)
+            void OptimizeOverdraw(uint32_t* io_indices, const uint32_t i_indexCount,
+                const Graphics::VertexFormats::sMesh* i_vertexData, const uint32_t i_vertexCount, const float i_acmrThreshold = 1.05f);
+
+            // The vertices are reordered in place to match the order that the indices first use them
+            // and the indices are remapped to match.
+            // Vertices that aren't used by any triangle are removed,
+            // and the new vertex count is returned
+            uint32_t OptimizeVertexFetch(Graphics::VertexFormats::sMesh* io_vertexData, const uint32_t i_vertexCount,
+                uint32_t* io_indices, const uint32_t i_indexCount);
+        }
+    }
+}
+
+#endif // EAE6320_MESHOPTIMIZATION_H
@@ -0,0 +1,594 @@
+// Include Files
+//==============
+
+#include "MeshSourceParser.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <Engine/Graphics/VertexFormats.h>
+#include <limits>
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+    // A Lua number is either an integer or a float,
+    // and the distinction matters because indices must be integers
+    struct sNumber
+    {
+        bool isInteger;
+        int64_t integer;
+        double number;
+    };
+
+    // Every function returns false as soon as it finds something that it doesn't understand
+    class cParser
+    {
+    public:
+
+        cParser(const char* i_source, const size_t i_sourceSize) : m_current(i_source), m_end(i_source + i_sourceSize) {}
+
+        bool ParseMesh(std::vector<eae6320::Graphics::VertexFormats::sMesh>& o_vertexData, std::vector<uint32_t>& o_indices);
+
+    private:
+
+        bool ParseVertexDataTable(std::vector<eae6320::Graphics::VertexFormats::sMesh>& o_vertexData);
+        bool ParseVertex(eae6320::Graphics::VertexFormats::sMesh& o_vertex);
+        bool ParseIndexDataTable(std::vector<uint32_t>& o_indices);
+        bool ParseFloatArray(const size_t i_floatCount, float* o_floatArray);
+        bool ParseNumber(sNumber& o_number);
+        bool ParseKey(const char*& o_key, size_t& o_keyLength);
+        // Returns true if the table has another field
+        // (after the opening brace or a separator)
+        bool IsAtAnotherField();
+        bool SkipFieldSeparator();
+        bool SkipCharacter(const char i_character);
+        bool SkipWhitespaceAndComments();
+        bool SkipLongBracket();
+
+        const char* m_current;
+        const char* const m_end;
+    };
+
+    bool IsKey(const char* i_key, const size_t i_keyLength, const char* i_expectedKey);
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Assets::MeshSourceParser::ParseMeshSource(const char* i_source, const size_t i_sourceSize,
+    std::vector<Graphics::VertexFormats::sMesh>& o_vertexData, std::vector<uint32_t>& o_indices)
+{
+    o_vertexData.clear();
+    o_indices.clear();
+
+    cParser parser(i_source, i_sourceSize);
+    if (!parser.ParseMesh(o_vertexData, o_indices))
+    {
+        o_vertexData.clear();
+        o_indices.clear();
+        return Results::Failure;
+    }
+
+    // The Lua loader reports these errors
+    if ((o_vertexData.size() < 3) || (o_vertexData.size() > std::numeric_limits<uint32_t>::max())
+        || ((o_indices.size() % 3) != 0) || (o_indices.size() > std::numeric_limits<uint32_t>::max()))
+    {
+        o_vertexData.clear();
+        o_indices.clear();
+        return Results::Failure;
+    }
+
+    return Results::Success;
+}
+
+// Helper Class Definition
+//========================
+
+namespace
+{
+    bool cParser::ParseMesh(std::vector<eae6320::Graphics::VertexFormats::sMesh>& o_vertexData, std::vector<uint32_t>& o_indices)
+    {
+        if (!SkipWhitespaceAndComments())
+        {
+            return false;
+        }
+        constexpr char returnKeyword[] = "return";
+        constexpr size_t returnKeywordLength = sizeof(returnKeyword) - 1;
+        if (((m_end - m_current) < static_cast<ptrdiff_t>(returnKeywordLength)) || (memcmp(m_current, returnKeyword, returnKeywordLength) != 0))
+        {
+            return false;
+        }
+        m_current += returnKeywordLength;
+        // "return" must be followed by a separate token
+        if ((m_current < m_end) && (isalnum(static_cast<unsigned char>(*m_current)) || (*m_current == '_')))
+        {
+            return false;
+        }
+
+        if (!SkipCharacter('{'))
+        {
+            return false;
+        }
+        bool wasVertexDataFound = false;
+        bool wasIndexDataFound = false;
+        while (IsAtAnotherField())
+        {
+            const char* key;
+            size_t keyLength;
+            if (!ParseKey(key, keyLength))
+            {
+                return false;
+            }
+            // Lua would use the last of any repeated keys,
+            // but it's simpler to let it handle such unusual files
+            if (IsKey(key, keyLength, "vertexData") && !wasVertexDataFound)
+            {
+                if (!ParseVertexDataTable(o_vertexData))
+                {
+                    return false;
+                }
+                wasVertexDataFound = true;
+            }
+            else if (IsKey(key, keyLength, "indexData") && !wasIndexDataFound)
+            {
+                if (!ParseIndexDataTable(o_indices))
+                {
+                    return false;
+                }
+                wasIndexDataFound = true;
+            }
+            else
+            {
+                return false;
+            }
+            if (!SkipFieldSeparator())
+            {
+                return false;
+            }
+        }
+        if (!SkipCharacter('}'))
+        {
+            return false;
+        }
+
+        // A return statement can end with a semicolon,
+        // but nothing else can come after it
+        if (!SkipWhitespaceAndComments())
+        {
+            return false;
+        }
+        if ((m_current < m_end) && (*m_current == ';'))
+        {
+            ++m_current;
+            if (!SkipWhitespaceAndComments())
+            {
+                return false;
+            }
+        }
+        return wasVertexDataFound && wasIndexDataFound && (m_current == m_end);
+    }
+
+    bool cParser::ParseVertexDataTable(std::vector<eae6320::Graphics::VertexFormats::sMesh>& o_vertexData)
+    {
+        if (!SkipCharacter('{'))
+        {
+            return false;
+        }
+        while (IsAtAnotherField())
+        {
+            eae6320::Graphics::VertexFormats::sMesh vertex;
+            if (!ParseVertex(vertex))
+            {
+                return false;
+            }
+            o_vertexData.push_back(vertex);
+            if (!SkipFieldSeparator())
+            {
+                return false;
+            }
+        }
+        return SkipCharacter('}');
+    }
+
+    bool cParser::ParseVertex(eae6320::Graphics::VertexFormats::sMesh& o_vertex)
+    {
+        if (!SkipCharacter('{'))
+        {
+            return false;
+        }
+        bool wasPositionFound = false;
+        bool wasUvFound = false;
+        bool wasColorFound = false;
+        while (IsAtAnotherField())
+        {
+            const char* key;
+            size_t keyLength;
+            if (!ParseKey(key, keyLength))
+            {
+                return false;
+            }
+            if (IsKey(key, keyLength, "position") && !wasPositionFound)
+            {
+                float position[3];
+                if (!ParseFloatArray(3, position))
+                {
+                    return false;
+                }
+                o_vertex.x = position[0];
+                o_vertex.y = position[1];
+                o_vertex.z = position[2];
+                wasPositionFound = true;
+            }
+            else if (IsKey(key, keyLength, "uv") && !wasUvFound)
+            {
+                float uv[2];
+                if (!ParseFloatArray(2, uv))
+                {
+                    return false;
+                }
+                o_vertex.u = uv[0];
+                o_vertex.v = uv[1];
+                wasUvFound = true;
+            }
+            else if (IsKey(key, keyLength, "color") && !wasColorFound)
+            {
+                // This must match how the Lua loader converts colors
+                float color[4];
+                if (!ParseFloatArray(4, color))
+                {
+                    return false;
+                }
+                o_vertex.r = static_cast<uint8_t>(color[0] * 255.0f);
+                o_vertex.g = static_cast<uint8_t>(color[1] * 255.0f);
+                o_vertex.b = static_cast<uint8_t>(color[2] * 255.0f);
+                o_vertex.a = static_cast<uint8_t>(color[3] * 255.0f);
+                wasColorFound = true;
+            }
+            else
+            {
+                return false;
+            }
+            if (!SkipFieldSeparator())
+            {
+                return false;
+            }
+        }
+        return SkipCharacter('}') && wasPositionFound && wasUvFound && wasColorFound;
+    }
+
+    bool cParser::ParseIndexDataTable(std::vector<uint32_t>& o_indices)
+    {
+        if (!SkipCharacter('{'))
+        {
+            return false;
+        }
+        while (IsAtAnotherField())
+        {
+            sNumber index;
+            if (!ParseNumber(index) || !index.isInteger
+                || (index.integer < 0) || (index.integer > std::numeric_limits<uint32_t>::max()))
+            {
+                return false;
+            }
+            o_indices.push_back(static_cast<uint32_t>(index.integer));
+            if (!SkipFieldSeparator())
+            {
+                return false;
+            }
+        }
+        return SkipCharacter('}');
+    }
+
+    bool cParser::ParseFloatArray(const size_t i_floatCount, float* o_floatArray)
+    {
+        if (!SkipCharacter('{'))
+        {
+            return false;
+        }
+        size_t floatCount = 0;
+        while (IsAtAnotherField())
+        {
+            sNumber number;
+            if ((floatCount >= i_floatCount) || !ParseNumber(number))
+            {
+                return false;
+            }
+            // This matches static_cast<float>(lua_tonumber())
+            o_floatArray[floatCount++] = static_cast<float>(number.number);
+            if (!SkipFieldSeparator())
+            {
+                return false;
+            }
+        }
+        return SkipCharacter('}') && (floatCount == i_floatCount);
+    }
+
+    bool cParser::ParseNumber(sNumber& o_number)
+    {
+        if (!SkipWhitespaceAndComments())
+        {
+            return false;
+        }
+        // Lua doesn't have negative numerals;
+        // a minus sign is a unary operator that can be separated from the numeral
+        bool isNegative = false;
+        if ((m_current < m_end) && (*m_current == '-'))
+        {
+            // Two minus signs would start a comment
+            if (((m_current + 1) < m_end) && (m_current[1] == '-'))
+            {
+                return false;
+            }
+            isNegative = true;
+            ++m_current;
+            if (!SkipWhitespaceAndComments())
+            {
+                return false;
+            }
+        }
+
+        // Only decimal numerals are handled.
+        // While the numeral is scanned its significant digits and decimal exponent are also calculated
+        // so that most floats can be converted without calling strtod()
+        const auto* const numeralStart = m_current;
+        bool isInteger = true;
+        uint64_t significand = 0;
+        int significantDigitCount = 0;
+        int exponent = 0;
+        {
+            bool isAfterDecimalPoint = false;
+            while ((m_current < m_end) && (((*m_current >= '0') && (*m_current <= '9')) || (*m_current == '.')))
+            {
+                const auto character = *m_current++;
+                if (character == '.')
+                {
+                    if (isAfterDecimalPoint)
+                    {
+                        return false;
+                    }
+                    isInteger = false;
+                    isAfterDecimalPoint = true;
+                }
+                else if ((significand != 0) || (character != '0'))
+                {
+                    // Any digits that don't fit are still counted so that strtod() will be used
+                    if (significantDigitCount < 19)
+                    {
+                        significand = (significand * 10) + (character - '0');
+                    }
+                    ++significantDigitCount;
+                    exponent -= isAfterDecimalPoint ? 1 : 0;
+                }
+                else
+                {
+                    exponent -= isAfterDecimalPoint ? 1 : 0;
+                }
+            }
+            if ((m_current < m_end) && ((*m_current == 'e') || (*m_current == 'E')))
+            {
+                isInteger = false;
+                ++m_current;
+                bool isExponentNegative = false;
+                if ((m_current < m_end) && ((*m_current == '+') || (*m_current == '-')))
+                {
+                    isExponentNegative = *m_current++ == '-';
+                }
+                int explicitExponent = 0;
+                const auto* const exponentStart = m_current;
+                while ((m_current < m_end) && (*m_current >= '0') && (*m_current <= '9'))
+                {
+                    explicitExponent = std::min((explicitExponent * 10) + (*m_current++ - '0'), 100000);
+                }
+                if (m_current == exponentStart)
+                {
+                    return false;
+                }
+                exponent += isExponentNegative ? -explicitExponent : explicitExponent;
+            }
+        }
+        const auto numeralLength = static_cast<size_t>(m_current - numeralStart);
+        if ((numeralLength == 0) || ((numeralLength == 1) && (*numeralStart == '.'))
+            || ((m_current < m_end) && (isalnum(static_cast<unsigned char>(*m_current)) || (*m_current == '_') || (*m_current == '.'))))
+        {
+            return false;
+        }
+
+        if (isInteger)
+        {
+            // Lua would make a numeral that doesn't fit in an integer into a float,
+            // but mesh files don't have such numbers
+            constexpr int maxIntegerDigitCount = 18;
+            if (significantDigitCount > maxIntegerDigitCount)
+            {
+                return false;
+            }
+            const auto integer = static_cast<int64_t>(significand);
+            // Negating an integer zero is still zero
+            // (unlike negating a float zero)
+            o_number.isInteger = true;
+            o_number.integer = isNegative ? -integer : integer;
+            o_number.number = static_cast<double>(o_number.integer);
+        }
+        else
+        {
+            double number;
+            // If the significant digits and the power of ten can both be represented exactly as doubles
+            // then a single multiplication or division is correctly rounded,
+            // which gives exactly the same result as strtod() (which Lua uses)
+            constexpr int maxExactSignificantDigitCount = 15;
+            constexpr int maxExactPowerOfTen = 22;
+            if ((significantDigitCount <= maxExactSignificantDigitCount) && (exponent >= -maxExactPowerOfTen) && (exponent <= maxExactPowerOfTen))
+            {
+                static const double s_powersOfTen[maxExactPowerOfTen + 1] =
+                {
+                    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+                };
+                number = static_cast<double>(significand);
+                number = (exponent < 0) ? (number / s_powersOfTen[-exponent]) : (number * s_powersOfTen[exponent]);
+            }
+            else
+            {
+                char numeral[64];
+                if (numeralLength >= sizeof(numeral))
+                {
+                    return false;
+                }
+                memcpy(numeral, numeralStart, numeralLength);
+                numeral[numeralLength] = '\0';
+                char* numeralEnd = nullptr;
+                number = strtod(numeral, &numeralEnd);
+                if (numeralEnd != (numeral + numeralLength))
+                {
+                    return false;
+                }
+            }
+            o_number.isInteger = false;
+            o_number.integer = 0;
+            o_number.number = isNegative ? -number : number;
+        }
+        return true;
+    }
+
+    bool cParser::ParseKey(const char*& o_key, size_t& o_keyLength)
+    {
+        if (!SkipWhitespaceAndComments())
+        {
+            return false;
+        }
+        o_key = m_current;
+        if ((m_current >= m_end) || !(isalpha(static_cast<unsigned char>(*m_current)) || (*m_current == '_')))
+        {
+            return false;
+        }
+        while ((m_current < m_end) && (isalnum(static_cast<unsigned char>(*m_current)) || (*m_current == '_')))
+        {
+            ++m_current;
+        }
+        o_keyLength = static_cast<size_t>(m_current - o_key);
+        return SkipCharacter('=');
+    }
+
+    bool cParser::IsAtAnotherField()
+    {
+        return SkipWhitespaceAndComments() && (m_current < m_end) && (*m_current != '}');
+    }
+
+    bool cParser::SkipFieldSeparator()
+    {
+        if (!SkipWhitespaceAndComments())
+        {
+            return false;
+        }
+        if ((m_current < m_end) && ((*m_current == ',') || (*m_current == ';')))
+        {
+            ++m_current;
+            return true;
+        }
+        // The last field doesn't need a separator
+        return (m_current < m_end) && (*m_current == '}');
+    }
+
+    bool cParser::SkipCharacter(const char i_character)
+    {
+        if (!SkipWhitespaceAndComments() || (m_current >= m_end) || (*m_current != i_character))
+        {
+            return false;
+        }
+        ++m_current;
+        return true;
+    }
+
+    bool cParser::SkipWhitespaceAndComments()
+    {
+        while (m_current < m_end)
+        {
+            const auto character = *m_current;
+            if ((character == ' ') || (character == '\t') || (character == '\r') || (character == '\n')
+                || (character == '\v') || (character == '\f'))
+            {
+                ++m_current;
+            }
+            else if ((character == '-') && ((m_current + 1) < m_end) && (m_current[1] == '-'))
+            {
+                m_current += 2;
+                // A comment is either a long bracket (e.g. "--[[ ... ]]")
+                // or goes until the end of the line
+                if ((m_current < m_end) && (*m_current == '['))
+                {
+                    const auto* const commentStart = m_current;
+                    if (SkipLongBracket())
+                    {
+                        continue;
+                    }
+                    else if (m_current != commentStart)
+                    {
+                        // The long bracket was never closed
+                        return false;
+                    }
+                }
+                while ((m_current < m_end) && (*m_current != '\n') && (*m_current != '\r'))
+                {
+                    ++m_current;
+                }
+            }
+            else
+            {
+                break;
+            }
+        }
+        return true;
+    }
+
+    bool cParser::SkipLongBracket()
+    {
+        // An opening long bracket is "[", any number of "=", and then "[";
+        // if this isn't one then nothing is skipped
+        const auto* const bracketStart = m_current;
+        auto* current = m_current + 1;
+        size_t level = 0;
+        while ((current < m_end) && (*current == '='))
+        {
+            ++level;
+            ++current;
+        }
+        if ((current >= m_end) || (*current != '['))
+        {
+            return false;
+        }
+        ++current;
+
+        // The closing bracket must have the same number of "="
+        while (current < m_end)
+        {
+            if (*current == ']')
+            {
+                auto* closing = current + 1;
+                size_t closingLevel = 0;
+                while ((closing < m_end) && (*closing == '='))
+                {
+                    ++closingLevel;
+                    ++closing;
+                }
+                if ((closingLevel == level) && (closing < m_end) && (*closing == ']'))
+                {
+                    m_current = closing + 1;
+                    return true;
+                }
+            }
+            ++current;
+        }
+        // Moving past the start of the bracket tells the caller that it was never closed
+        m_current = bracketStart + 1;
+        return false;
+    }
+
+    bool IsKey(const char* i_key, const size_t i_keyLength, const char* i_expectedKey)
+    {
+        return (strlen(i_expectedKey) == i_keyLength) && (memcmp(i_key, i_expectedKey, i_keyLength) == 0);
+    }
+}
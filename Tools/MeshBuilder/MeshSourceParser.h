@@ -0,0 +1,58 @@
+/*
+    This function parses a human-readable mesh file
+    without running it as a Lua script:
+        * Running a big mesh file with Lua means that the whole file must be compiled
+            and then every number must be read back out of Lua tables one at a time,
+            which is very slow for meshes with many vertices
+        * This parser reads the numbers straight into the vertex and index arrays,
+            converting them exactly the way that Lua does
+            (and so the built mesh is identical no matter which way the file was loaded)
+
+    Only the subset of Lua that mesh files are written in is understood
+    (a returned table with vertexData and indexData tables containing plain numbers, and comments).
+    If a file uses anything else (or is invalid) parsing fails without reporting an error,
+    and the file should then be loaded with Lua, which will either understand it or report what is wrong
+*/
+
+#ifndef EAE6320_MESHSOURCEPARSER_H
+#define EAE6320_MESHSOURCEPARSER_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+    namespace Graphics
+    {
+        namespace VertexFormats
+        {
+            struct sMesh;
+        }
+    }
+}
+
+// Interface
+//==========
+
+namespace eae6320
+{
+    namespace Assets
+    {
+        namespace MeshSourceParser
+        {
+            // The source doesn't need to be null-terminated
+            cResult ParseMeshSource(const char* i_source, const size_t i_sourceSize,
+                std::vector<Graphics::VertexFormats::sMesh>& o_vertexData, std::vector<uint32_t>& o_indices);
+        }
+    }
+}
+
+#endif // EAE6320_MESHSOURCEPARSER_H
@@ -0,0 +1,224 @@
+// Include Files
+//==============
+
+#include "MeshWelding.h"
+
+#include <cmath>
+#include <cstring>
+#include <Engine/Graphics/VertexFormats.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+    constexpr uint32_t s_indicesPerTriangle = 3;
+    constexpr uint32_t s_invalidIndex = ~uint32_t(0u);
+
+    // The vertices are compared as raw bytes,
+    // which only works if there is no padding in the struct
+    static_assert(sizeof(eae6320::Graphics::VertexFormats::sMesh) == ((5 * sizeof(float)) + (4 * sizeof(uint8_t))),
+        "sMesh must not have any padding");
+
+    struct sVertexHasher
+    {
+        const eae6320::Graphics::VertexFormats::sMesh* vertexData;
+        size_t operator ()(const uint32_t i_vertexIndex) const;
+    };
+    struct sVertexComparer
+    {
+        const eae6320::Graphics::VertexFormats::sMesh* vertexData;
+        bool operator ()(const uint32_t i_lhs, const uint32_t i_rhs) const;
+    };
+
+    // Welding only has to compare a vertex with the vertices in the neighboring cells of a grid
+    // whose cells are as big as the epsilon
+    struct sGridCell
+    {
+        int64_t x, y, z;
+
+        bool operator ==(const sGridCell& i_other) const { return (x == i_other.x) && (y == i_other.y) && (z == i_other.z); }
+    };
+    struct sGridCellHasher
+    {
+        size_t operator ()(const sGridCell& i_cell) const;
+    };
+    int64_t CalculateGridCoordinate(const float i_position, const float i_cellSize);
+
+    // Each vertex's representative is either itself or a vertex that comes before it in the array
+    uint32_t RemapVertices(eae6320::Graphics::VertexFormats::sMesh* io_vertexData, const uint32_t i_vertexCount,
+        uint32_t* io_indices, const uint32_t i_indexCount, const std::vector<uint32_t>& i_representatives);
+}
+
+// Interface
+//==========
+
+uint32_t eae6320::Assets::MeshWelding::DeduplicateVertices(Graphics::VertexFormats::sMesh* io_vertexData, const uint32_t i_vertexCount,
+    uint32_t* io_indices, const uint32_t i_indexCount)
+{
+    std::vector<uint32_t> representatives(i_vertexCount);
+    std::unordered_set<uint32_t, sVertexHasher, sVertexComparer> uniqueVertices(i_vertexCount,
+        sVertexHasher{ io_vertexData }, sVertexComparer{ io_vertexData });
+    for (uint32_t v = 0; v < i_vertexCount; ++v)
+    {
+        // If an identical vertex was already found then it is the representative
+        representatives[v] = *uniqueVertices.insert(v).first;
+    }
+
+    return RemapVertices(io_vertexData, i_vertexCount, io_indices, i_indexCount, representatives);
+}
+
+uint32_t eae6320::Assets::MeshWelding::WeldVertices(Graphics::VertexFormats::sMesh* io_vertexData, const uint32_t i_vertexCount,
+    uint32_t* io_indices, const uint32_t i_indexCount, const float i_epsilon)
+{
+    if (!(i_epsilon > 0.0f))
+    {
+        return i_vertexCount;
+    }
+
+    // Only representatives are added to the grid
+    // so that a chain of vertices that are each close to the next one isn't welded into a single vertex
+    // (the vertices in each cell are a linked list)
+    std::vector<uint32_t> representatives(i_vertexCount);
+    std::vector<uint32_t> nextVertexInCell(i_vertexCount, s_invalidIndex);
+    std::unordered_map<sGridCell, uint32_t, sGridCellHasher> firstVertexInCells(i_vertexCount);
+    for (uint32_t v = 0; v < i_vertexCount; ++v)
+    {
+        const auto& vertex = io_vertexData[v];
+        const sGridCell cell = { CalculateGridCoordinate(vertex.x, i_epsilon),
+            CalculateGridCoordinate(vertex.y, i_epsilon), CalculateGridCoordinate(vertex.z, i_epsilon) };
+
+        representatives[v] = v;
+        for (int64_t offsetX = -1; (offsetX <= 1) && (representatives[v] == v); ++offsetX)
+        {
+            for (int64_t offsetY = -1; (offsetY <= 1) && (representatives[v] == v); ++offsetY)
+            {
+                for (int64_t offsetZ = -1; (offsetZ <= 1) && (representatives[v] == v); ++offsetZ)
+                {
+                    const auto neighbor = firstVertexInCells.find(sGridCell{ cell.x + offsetX, cell.y + offsetY, cell.z + offsetZ });
+                    if (neighbor == firstVertexInCells.end())
+                    {
+                        continue;
+                    }
+                    for (auto candidate = neighbor->second; candidate != s_invalidIndex; candidate = nextVertexInCell[candidate])
+                    {
+                        const auto& candidateVertex = io_vertexData[candidate];
+                        if ((std::abs(vertex.x - candidateVertex.x) <= i_epsilon) && (std::abs(vertex.y - candidateVertex.y) <= i_epsilon)
+                            && (std::abs(vertex.z - candidateVertex.z) <= i_epsilon)
+                            && (std::abs(vertex.u - candidateVertex.u) <= i_epsilon) && (std::abs(vertex.v - candidateVertex.v) <= i_epsilon)
+                            && (vertex.r == candidateVertex.r) && (vertex.g == candidateVertex.g)
+                            && (vertex.b == candidateVertex.b) && (vertex.a == candidateVertex.a))
+                        {
+                            representatives[v] = candidate;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (representatives[v] == v)
+        {
+            auto& firstVertexInCell = firstVertexInCells.insert({ cell, s_invalidIndex }).first->second;
+            nextVertexInCell[v] = firstVertexInCell;
+            firstVertexInCell = v;
+        }
+    }
+
+    return RemapVertices(io_vertexData, i_vertexCount, io_indices, i_indexCount, representatives);
+}
+
+uint32_t eae6320::Assets::MeshWelding::RemoveDegenerateTriangles(uint32_t* io_indices, const uint32_t i_indexCount, const uint32_t* i_indices_beforeWelding)
+{
+    const auto IsDegenerate = [](const uint32_t* i_triangle)
+    {
+        return (i_triangle[0] == i_triangle[1]) || (i_triangle[1] == i_triangle[2]) || (i_triangle[2] == i_triangle[0]);
+    };
+
+    const auto triangleCount = i_indexCount / s_indicesPerTriangle;
+    uint32_t newIndexCount = 0;
+    for (uint32_t t = 0; t < triangleCount; ++t)
+    {
+        const auto* const triangle = io_indices + (t * s_indicesPerTriangle);
+        const auto index0 = triangle[0], index1 = triangle[1], index2 = triangle[2];
+        if (!IsDegenerate(triangle) || IsDegenerate(i_indices_beforeWelding + (t * s_indicesPerTriangle)))
+        {
+            io_indices[newIndexCount++] = index0;
+            io_indices[newIndexCount++] = index1;
+            io_indices[newIndexCount++] = index2;
+        }
+    }
+    return newIndexCount;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+    size_t sVertexHasher::operator ()(const uint32_t i_vertexIndex) const
+    {
+        // FNV-1a
+        const auto* const bytes = reinterpret_cast<const uint8_t*>(vertexData + i_vertexIndex);
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < sizeof(eae6320::Graphics::VertexFormats::sMesh); ++i)
+        {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+
+    bool sVertexComparer::operator ()(const uint32_t i_lhs, const uint32_t i_rhs) const
+    {
+        return memcmp(vertexData + i_lhs, vertexData + i_rhs, sizeof(eae6320::Graphics::VertexFormats::sMesh)) == 0;
+    }
+
+    size_t sGridCellHasher::operator ()(const sGridCell& i_cell) const
+    {
+        auto hash = static_cast<uint64_t>(i_cell.x) * 73856093ull;
+        hash ^= static_cast<uint64_t>(i_cell.y) * 19349663ull;
+        hash ^= static_cast<uint64_t>(i_cell.z) * 83492791ull;
+        return static_cast<size_t>(hash);
+    }
+
+    int64_t CalculateGridCoordinate(const float i_position, const float i_cellSize)
+    {
+        // The coordinate is clamped so that huge positions or tiny cells can't overflow
+        // (neighboring cells must still be representable, and so the range leaves room for them),
+        // and a NaN position ends up in the lowest cell
+        constexpr double maxCoordinate = 1.0e15;
+        const auto coordinate = std::floor(static_cast<double>(i_position) / static_cast<double>(i_cellSize));
+        return static_cast<int64_t>((coordinate >= -maxCoordinate) ? ((coordinate <= maxCoordinate) ? coordinate : maxCoordinate) : -maxCoordinate);
+    }
+
+    uint32_t RemapVertices(eae6320::Graphics::VertexFormats::sMesh* io_vertexData, const uint32_t i_vertexCount,
+        uint32_t* io_indices, const uint32_t i_indexCount, const std::vector<uint32_t>& i_representatives)
+    {
+        // Since a representative always comes before the vertices that it represents
+        // the vertices can be moved forward in place
+        std::vector<uint32_t> newVertexIndices(i_vertexCount);
+        uint32_t newVertexCount = 0;
+        for (uint32_t v = 0; v < i_vertexCount; ++v)
+        {
+            if (i_representatives[v] == v)
+            {
+                newVertexIndices[v] = newVertexCount;
+                io_vertexData[newVertexCount++] = io_vertexData[v];
+            }
+            else
+            {
+                newVertexIndices[v] = newVertexIndices[i_representatives[v]];
+            }
+        }
+
+        for (uint32_t i = 0; i < i_indexCount; ++i)
+        {
+            io_indices[i] = newVertexIndices[io_indices[i]];
+        }
+
+        return newVertexCount;
+    }
+}
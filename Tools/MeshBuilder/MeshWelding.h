@@ -0,0 +1,71 @@
+/*
+    These functions merge a mesh's duplicate vertices:
+        * Exporters often write a separate copy of a vertex for every triangle that uses it,
+            which makes the vertex buffer bigger and stops the GPU's post-transform cache from reusing the vertex
+        * Vertices that are bitwise identical can always be merged without changing how the mesh looks
+        * Vertices that are only nearly identical (e.g. because of floating point error in the exporter)
+            can optionally be welded together
+
+    This should be done before the mesh is optimized (see MeshOptimization.h)
+    so that the optimizations can take advantage of the shared vertices
+*/
+
+#ifndef EAE6320_MESHWELDING_H
+#define EAE6320_MESHWELDING_H
+
+// Include Files
+//==============
+
+#include <cstdint>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+    namespace Graphics
+    {
+        namespace VertexFormats
+        {
+            struct sMesh;
+        }
+    }
+}
+
+// Interface
+//==========
+
+namespace eae6320
+{
+    namespace Assets
+    {
+        namespace MeshWelding
+        {
+            // Vertices that are bitwise identical are merged,
+            // the remaining vertices are moved to the front of the array (keeping their order),
+            // and the indices are remapped to match.
+            // The new vertex count is returned
+            uint32_t DeduplicateVertices(Graphics::VertexFormats::sMesh* io_vertexData, const uint32_t i_vertexCount,
+                uint32_t* io_indices, const uint32_t i_indexCount);
+
+            // Vertices are welded if each component of their positions and UVs are within the epsilon of each other
+            // and their colors are identical;
+            // a welded vertex uses the position and UV of the first of the vertices in the array.
+            // The new vertex count is returned
+            constexpr float DefaultWeldEpsilon = 1.0e-5f;
+            uint32_t WeldVertices(Graphics::VertexFormats::sMesh* io_vertexData, const uint32_t i_vertexCount,
+                uint32_t* io_indices, const uint32_t i_indexCount, const float i_epsilon = DefaultWeldEpsilon);
+
+            // Triangles that use the same vertex more than once don't cover any pixels
+            // (welding vertices can create these).
+            // Only triangles that became degenerate are removed:
+            // a triangle that already used the same vertex more than once in the indices from before welding
+            // (which must have the same triangles in the same order) was authored that way and is kept.
+            // The remaining triangles are moved to the front of the array (keeping their order),
+            // and the new index count is returned
+            uint32_t RemoveDegenerateTriangles(uint32_t* io_indices, const uint32_t i_indexCount, const uint32_t* i_indices_beforeWelding);
+        }
+    }
+}
+
+#endif // EAE6320_MESHWELDING_H
@@ -8,5 +8,5 @@
 // Implementation
 //===============
 
-void eae6320::Assets::cMeshBuilder::PerformPlatformSpecificFixup(const uint16_t i_vertexCount, eae6320::Graphics::VertexFormats::sMesh* io_vertexData, const uint16_t i_indexCount, uint16_t* io_indexData)
+void eae6320::Assets::cMeshBuilder::PerformPlatformSpecificFixup(const uint32_t i_vertexCount, eae6320::Graphics::VertexFormats::sMesh* io_vertexData, const uint32_t i_indexCount, uint32_t* io_indexData)
 {}
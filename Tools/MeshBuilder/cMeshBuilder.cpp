@@ -2,8 +2,13 @@
 //==============
 
 #include "cMeshBuilder.h"
+#include "MeshClusters.h"
+#include "MeshOptimization.h"
+#include "MeshSourceParser.h"
+#include "MeshWelding.h"
 
 #include <Engine/Math/Functions.h>
+#include <Engine/Graphics/MeshFormats.h>
 #include <Engine/Graphics/sColor.h>
 #include <Engine/Graphics/VertexFormats.h>
 #include <Engine/Logging/Logging.h>
@@ -11,26 +16,56 @@
 #include <Engine/Math/sVector2d.h>
 #include <Engine/Platform/Platform.h>
 #include <External/Lua/Includes.h>
+#include <Tools/AssetBuildLibrary/BuildTrace.h>
 #include <Tools/AssetBuildLibrary/Functions.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <limits>
 #include <string>
+#include <vector>
 
 // Helper Function Declarations
 //=============================
 
 namespace
 {
-    eae6320::cResult LoadIntegerArray(lua_State& io_luaState, const uint16_t i_integerCount, uint16_t* o_integerArray);
+    eae6320::cResult LoadMeshSourceWithLua(lua_State*& io_luaState, const char* i_path, uint32_t& o_vertexCount, eae6320::Graphics::VertexFormats::sMesh*& o_vertexData,
+        uint32_t& o_indexCount, uint32_t*& o_indices);
+    eae6320::cResult LoadIntegerArray(lua_State& io_luaState, const uint32_t i_integerCount, uint32_t* o_integerArray);
     eae6320::cResult LoadFloatArray(lua_State& io_luaState, const uint16_t i_floatCount, float* o_floatArray);
     eae6320::cResult LoadPosition(lua_State& io_luaState, eae6320::Math::sVector& o_position);
     eae6320::cResult LoadColor(lua_State& io_luaState, eae6320::Graphics::sColor& o_color);
     eae6320::cResult LoadUV(lua_State& io_luaState, eae6320::Math::sVector2d& o_position);
-    eae6320::cResult LoadVertexDataArray(lua_State& io_luaState, uint16_t& o_vertexCount, eae6320::Graphics::VertexFormats::sMesh*& o_vertexData);
-    eae6320::cResult LoadVertexData(lua_State& io_luaState, uint16_t& o_vertexCount, eae6320::Graphics::VertexFormats::sMesh*& o_vertexData);
-    eae6320::cResult LoadIndexDataArray(lua_State& io_luaState, uint16_t& o_indexCount, uint16_t*& o_indices);
-    eae6320::cResult LoadIndexData(lua_State& io_luaState, uint16_t& o_indexCount, uint16_t*& o_indices);
-    eae6320::cResult WriteBuiltMesh(const char* i_path, const uint16_t i_vertexCount, const eae6320::Graphics::VertexFormats::sMesh* i_vertexData, const uint16_t i_indexCount, const uint16_t* i_indices);
+    eae6320::cResult LoadVertexDataArray(lua_State& io_luaState, uint32_t& o_vertexCount, eae6320::Graphics::VertexFormats::sMesh*& o_vertexData);
+    eae6320::cResult LoadVertexData(lua_State& io_luaState, uint32_t& o_vertexCount, eae6320::Graphics::VertexFormats::sMesh*& o_vertexData);
+    eae6320::cResult LoadIndexDataArray(lua_State& io_luaState, uint32_t& o_indexCount, uint32_t*& o_indices);
+    eae6320::cResult LoadIndexData(lua_State& io_luaState, uint32_t& o_indexCount, uint32_t*& o_indices);
+    eae6320::cResult ValidateIndices(const uint32_t i_vertexCount, const uint32_t i_indexCount, const uint32_t* i_indices);
+    eae6320::cResult WriteBuiltMesh(const char* i_path, const uint32_t i_vertexCount, const eae6320::Graphics::VertexFormats::sMesh* i_vertexData, const uint32_t i_indexCount, const uint32_t* i_indices,
+        const eae6320::Graphics::MeshFormats::VertexEncodings::eType i_vertexEncoding, const std::vector<eae6320::Graphics::MeshFormats::sCluster>& i_clusters);
+
+    // Quantized positions are relative to the mesh's bounding box, and UVs are converted to 16-bit floats
+    void QuantizeVertices(const uint32_t i_vertexCount, const eae6320::Graphics::VertexFormats::sMesh* i_vertexData,
+        std::vector<eae6320::Graphics::VertexFormats::sMeshQuantized>& o_vertexData, eae6320::Graphics::MeshFormats::sPositionDequantization& o_positionDequantization);
+    uint16_t ConvertFloatToHalf(const float i_value);
+}
+
+// Interface
+//==========
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Assets::cMeshBuilder::~cMeshBuilder()
+{
+    if (m_luaState)
+    {
+        lua_close(m_luaState);
+        m_luaState = nullptr;
+    }
 }
 
 // Inherited Implementation
@@ -43,107 +78,172 @@ eae6320::cResult eae6320::Assets::cMeshBuilder::Build(const std::vector<std::str
 {
     auto result = eae6320::Results::Success;
 
-    // Create a new Lua state
-    lua_State* luaState = nullptr;
-    {
-        luaState = luaL_newstate();
-        if (!luaState)
-        {
-            result = eae6320::Results::OutOfMemory;
-            OutputErrorMessageWithFileInfo(m_path_source, "Failed to create a new Lua state while loading %s", m_path_source);
-            goto OnExit;
-        }
-    }
+    uint32_t vertexCount = 0;
+    eae6320::Graphics::VertexFormats::sMesh* vertexData = nullptr;
+    uint32_t indexCount = 0;
+    uint32_t* indices = nullptr;
 
-    // Load the asset file as a "chunk",
-    // meaning there will be a callable function at the top of the stack
-    const auto stackTopBeforeLoad = lua_gettop(luaState);
+    // Load the source mesh
     {
-        const auto luaResult = luaL_loadfile(luaState, m_path_source);
-        if (luaResult != LUA_OK)
+        BuildTrace::cScope traceScope("Load", "BuilderPhase");
+        // Running a big mesh file with Lua is very slow,
+        // and so the file is parsed natively whenever it only uses the syntax that mesh files are written in;
+        // anything else is left to Lua (which will also report any errors in the file)
+        std::vector<eae6320::Graphics::VertexFormats::sMesh> parsedVertexData;
+        std::vector<uint32_t> parsedIndices;
         {
-            result = eae6320::Results::Failure;
-            OutputErrorMessageWithFileInfo(m_path_source, "%s while loading %s", lua_tostring(luaState, -1), m_path_source);
-            // Pop the error message
-            lua_pop(luaState, 1);
-            goto OnExit;
-        }
-    }
-
-    // Execute the "chunk", which should load the asset
-    // into a table at the top of the stack
-    {
-        constexpr int argumentCount = 0;
-        constexpr int returnValueCount = LUA_MULTRET;	// Return _everything_ that the file returns
-        constexpr int noMessageHandler = 0;
-        const auto luaResult = lua_pcall(luaState, argumentCount, returnValueCount, noMessageHandler);
-        if (luaResult == LUA_OK)
-        {
-            // A well-behaved asset file will only return a single value
-            const auto returnedValueCount = lua_gettop(luaState) - stackTopBeforeLoad;
-            if (returnedValueCount == 1)
+            eae6320::Platform::sDataFromFile dataFromFile;
+            if (eae6320::Platform::LoadBinaryFile(m_path_source, dataFromFile)
+                && MeshSourceParser::ParseMeshSource(static_cast<const char*>(dataFromFile.data), dataFromFile.size, parsedVertexData, parsedIndices))
             {
-                // A correct asset file _must_ return a table
-                if (!lua_istable(luaState, -1))
-                {
-                    result = eae6320::Results::InvalidFile;
-                    OutputErrorMessageWithFileInfo(m_path_source, "Asset files must return a table (instead of a %s)", luaL_typename(luaState, -1));
-                    // Pop the returned non-table value
-                    lua_pop(luaState, 1);
-                    goto OnExit;
-                }
+                traceScope.AddArgument("bytesRead", static_cast<uint64_t>(dataFromFile.size));
+                vertexCount = static_cast<uint32_t>(parsedVertexData.size());
+                indexCount = static_cast<uint32_t>(parsedIndices.size());
             }
-            else
+            dataFromFile.Free();
+        }
+        if (!parsedVertexData.empty())
+        {
+            // The rest of the build expects the same allocations that the Lua loader makes
+            vertexData = static_cast<eae6320::Graphics::VertexFormats::sMesh*>(malloc(vertexCount * sizeof(eae6320::Graphics::VertexFormats::sMesh)));
+            indices = static_cast<uint32_t*>(malloc(std::max(indexCount, 1u) * sizeof(uint32_t)));
+            if (!vertexData || !indices)
             {
-                result = eae6320::Results::InvalidFile;
-                OutputErrorMessageWithFileInfo(m_path_source, "Asset files must return a single table (instead of %d values)", returnedValueCount);
-                // Pop every value that was returned
-                lua_pop(luaState, returnedValueCount);
+                result = Results::OutOfMemory;
+                OutputErrorMessageWithFileInfo(m_path_source, "Couldn't allocate memory for %u vertices and %u indices", vertexCount, indexCount);
                 goto OnExit;
             }
+            memcpy(vertexData, parsedVertexData.data(), vertexCount * sizeof(eae6320::Graphics::VertexFormats::sMesh));
+            memcpy(indices, parsedIndices.data(), indexCount * sizeof(uint32_t));
         }
         else
         {
-            result = eae6320::Results::InvalidFile;
-            OutputErrorMessageWithFileInfo(m_path_source, lua_tostring(luaState, -1));
-            // Pop the error message
-            lua_pop(luaState, 1);
-            goto OnExit;
+            traceScope.AddArgument("loader", "Lua");
+            if (!(result = LoadMeshSourceWithLua(m_luaState, m_path_source, vertexCount, vertexData, indexCount, indices)))
+            {
+                goto OnExit;
+            }
         }
+        traceScope.AddArgument("vertexCount", vertexCount);
+        traceScope.AddArgument("indexCount", indexCount);
     }
 
-    // If this code is reached the asset file was loaded successfully,
-    // and its table is now at index -1
-    uint16_t vertexCount = 0;
-    eae6320::Graphics::VertexFormats::sMesh* vertexData = nullptr;
-
-    if (!(result = LoadVertexData(*luaState, vertexCount, vertexData)))
+    if (!(result = ValidateIndices(vertexCount, indexCount, indices)))
     {
-        result = Results::Failure;
-        OutputErrorMessageWithFileInfo(m_path_source, "Couldn't parse vertex data for file %s", m_path_source);
+        OutputErrorMessageWithFileInfo(m_path_source, "Invalid index data in file %s", m_path_source);
         goto OnExit;
     }
 
-    uint16_t indexCount = 0;
-    uint16_t* indices = nullptr;
+    // Overdraw optimization trades a little vertex cache efficiency for less overdraw,
+    // and quantization trades a little precision for smaller vertices,
+    // and so they are only done for meshes that ask for them
+    bool shouldOptimizeOverdraw = false;
+    bool shouldQuantizeVertices = false;
+    // Welding changes the mesh slightly, and so it is also optional
+    // ("weldVertices" uses the default epsilon, and "weldVertices=<epsilon>" uses the given one)
+    float weldEpsilon = 0.0f;
+    for (const auto& argument : i_arguments)
+    {
+        constexpr char weldVerticesArgument[] = "weldVertices";
+        constexpr size_t weldVerticesArgumentLength = sizeof(weldVerticesArgument) - 1;
+        if (argument == "optimizeOverdraw")
+        {
+            shouldOptimizeOverdraw = true;
+        }
+        else if (argument == weldVerticesArgument)
+        {
+            weldEpsilon = MeshWelding::DefaultWeldEpsilon;
+        }
+        else if ((argument.compare(0, weldVerticesArgumentLength, weldVerticesArgument) == 0) && (argument[weldVerticesArgumentLength] == '='))
+        {
+            const auto* const epsilonString = argument.c_str() + weldVerticesArgumentLength + 1;
+            char* epsilonStringEnd = nullptr;
+            weldEpsilon = strtof(epsilonString, &epsilonStringEnd);
+            if ((epsilonStringEnd == epsilonString) || (*epsilonStringEnd != '\0') || !(weldEpsilon > 0.0f))
+            {
+                OutputWarningMessageWithFileInfo(m_path_source, "The weld epsilon in \"%s\" must be a positive number (vertices won't be welded)",
+                    argument.c_str());
+                weldEpsilon = 0.0f;
+            }
+        }
+        else if (argument == "quantizeVertices")
+        {
+            shouldQuantizeVertices = true;
+        }
+        else
+        {
+            OutputWarningMessageWithFileInfo(m_path_source, "Unknown mesh builder argument \"%s\"", argument.c_str());
+        }
+    }
 
-    if (!(result = LoadIndexData(*luaState, indexCount, indices)))
+    // Merge vertices that are the same
     {
-        result = Results::Failure;
-        OutputErrorMessageWithFileInfo(m_path_source, "Couldn't parse index data for file %s", m_path_source);
-        goto OnExit;
+        BuildTrace::cScope traceScope("Weld", "BuilderPhase");
+        const auto vertexCount_original = vertexCount;
+        const auto indexCount_original = indexCount;
+
+        // Merging exact duplicates can't change what is drawn,
+        // and so any triangles that were authored as degenerate are kept
+        vertexCount = MeshWelding::DeduplicateVertices(vertexData, vertexCount, indices, indexCount);
+        const auto vertexCount_deduplicated = vertexCount;
+        if (weldEpsilon > 0.0f)
+        {
+            // Welding can collapse a thin triangle, though,
+            // and only the triangles that it collapses are removed
+            const std::vector<uint32_t> indices_beforeWelding(indices, indices + indexCount);
+            vertexCount = MeshWelding::WeldVertices(vertexData, vertexCount, indices, indexCount, weldEpsilon);
+            indexCount = MeshWelding::RemoveDegenerateTriangles(indices, indexCount, indices_beforeWelding.data());
+        }
+
+        OutputInformationalMessage("%s: %u duplicate vertices merged, %u vertices welded (epsilon %g), %u degenerate triangles removed",
+            m_path_source, vertexCount_original - vertexCount_deduplicated, vertexCount_deduplicated - vertexCount, weldEpsilon,
+            (indexCount_original - indexCount) / 3);
     }
 
-    // Pop the table
-    lua_pop(luaState, 1);
+    // Reorder the triangles and vertices so that the mesh is faster to render
+    {
+        BuildTrace::cScope traceScope("Optimize", "BuilderPhase");
+        const auto triangleCount = indexCount / 3;
+        const auto vertexCount_original = vertexCount;
+        const auto acmr_original = MeshOptimization::CalculateAcmr(indices, indexCount, vertexCount);
+
+        MeshOptimization::OptimizeVertexCache(indices, indexCount, vertexCount);
+        const auto acmr_vertexCache = MeshOptimization::CalculateAcmr(indices, indexCount, vertexCount);
+
+        if (shouldOptimizeOverdraw)
+        {
+            MeshOptimization::OptimizeOverdraw(indices, indexCount, vertexData, vertexCount);
+        }
 
-    PerformPlatformSpecificFixup(vertexCount, vertexData, indexCount, indices);
+        vertexCount = MeshOptimization::OptimizeVertexFetch(vertexData, vertexCount, indices, indexCount);
+        const auto acmr_optimized = MeshOptimization::CalculateAcmr(indices, indexCount, vertexCount);
 
-    if (!(result = WriteBuiltMesh(m_path_target, vertexCount, vertexData, indexCount, indices)))
+        OutputInformationalMessage("%s: %u triangles, %u vertices (%u unused removed), ACMR %.3f -> %.3f (vertex cache) -> %.3f (final%s)",
+            m_path_source, triangleCount, vertexCount, vertexCount_original - vertexCount,
+            acmr_original, acmr_vertexCache, acmr_optimized, shouldOptimizeOverdraw ? ", overdraw optimized" : "");
+    }
+
+    // Split the triangles into clusters that can be culled individually
     {
-        result = Results::Failure;
-        OutputErrorMessageWithFileInfo(m_path_source, "Couldn't write built mesh for file %s", m_path_source);
-        goto OnExit;
+        // This must be done before the platform-specific fixup
+        // because the clusters' normal cones are calculated from counter-clockwise triangles
+        std::vector<eae6320::Graphics::MeshFormats::sCluster> clusters;
+        {
+            BuildTrace::cScope traceScope("Cluster", "BuilderPhase");
+            MeshClusters::BuildClusters(vertexData, vertexCount, indices, indexCount, clusters);
+        }
+        OutputInformationalMessage("%s: %u clusters", m_path_source, static_cast<unsigned int>(clusters.size()));
+
+        PerformPlatformSpecificFixup(vertexCount, vertexData, indexCount, indices);
+
+        if (!(result = WriteBuiltMesh(m_path_target, vertexCount, vertexData, indexCount, indices,
+            shouldQuantizeVertices ? eae6320::Graphics::MeshFormats::VertexEncodings::Quantized : eae6320::Graphics::MeshFormats::VertexEncodings::Float,
+            clusters)))
+        {
+            result = Results::Failure;
+            OutputErrorMessageWithFileInfo(m_path_source, "Couldn't write built mesh for file %s", m_path_source);
+            goto OnExit;
+        }
     }
 
 OnExit:
@@ -163,20 +263,6 @@ OnExit:
         }
     }
 
-    if (luaState)
-    {
-        // If I haven't made any mistakes
-        // there shouldn't be anything on the stack,
-        // regardless of any errors encountered while loading the file:
-        if (lua_gettop(luaState) != 0)
-        {
-            OutputErrorMessageWithFileInfo(m_path_source, "Lua stack wasn't empty when finished building mesh");
-        }
-
-        lua_close(luaState);
-        luaState = nullptr;
-    }
-
     return result;
 }
 
@@ -185,7 +271,121 @@ OnExit:
 
 namespace
 {
-    eae6320::cResult LoadIntegerArray(lua_State& io_luaState, const uint16_t i_integerCount, uint16_t* o_integerArray)
+    eae6320::cResult LoadMeshSourceWithLua(lua_State*& io_luaState, const char* i_path, uint32_t& o_vertexCount, eae6320::Graphics::VertexFormats::sMesh*& o_vertexData,
+        uint32_t& o_indexCount, uint32_t*& o_indices)
+    {
+        auto result = eae6320::Results::Success;
+
+        // Create a new Lua state if there isn't one from a previous mesh
+        if (!io_luaState)
+        {
+            io_luaState = luaL_newstate();
+            if (!io_luaState)
+            {
+                result = eae6320::Results::OutOfMemory;
+                eae6320::Assets::OutputErrorMessageWithFileInfo(i_path, "Failed to create a new Lua state while loading %s", i_path);
+                return result;
+            }
+        }
+        lua_State* const luaState = io_luaState;
+
+        // Load the asset file as a "chunk",
+        // meaning there will be a callable function at the top of the stack
+        const auto stackTopBeforeLoad = lua_gettop(luaState);
+        {
+            const auto luaResult = luaL_loadfile(luaState, i_path);
+            if (luaResult != LUA_OK)
+            {
+                result = eae6320::Results::Failure;
+                eae6320::Assets::OutputErrorMessageWithFileInfo(i_path, "%s while loading %s", lua_tostring(luaState, -1), i_path);
+                // Pop the error message
+                lua_pop(luaState, 1);
+                goto OnExit;
+            }
+        }
+
+        // Execute the "chunk", which should load the asset
+        // into a table at the top of the stack
+        {
+            constexpr int argumentCount = 0;
+            constexpr int returnValueCount = LUA_MULTRET;	// Return _everything_ that the file returns
+            constexpr int noMessageHandler = 0;
+            const auto luaResult = lua_pcall(luaState, argumentCount, returnValueCount, noMessageHandler);
+            if (luaResult == LUA_OK)
+            {
+                // A well-behaved asset file will only return a single value
+                const auto returnedValueCount = lua_gettop(luaState) - stackTopBeforeLoad;
+                if (returnedValueCount == 1)
+                {
+                    // A correct asset file _must_ return a table
+                    if (!lua_istable(luaState, -1))
+                    {
+                        result = eae6320::Results::InvalidFile;
+                        eae6320::Assets::OutputErrorMessageWithFileInfo(i_path, "Asset files must return a table (instead of a %s)", luaL_typename(luaState, -1));
+                        // Pop the returned non-table value
+                        lua_pop(luaState, 1);
+                        goto OnExit;
+                    }
+                }
+                else
+                {
+                    result = eae6320::Results::InvalidFile;
+                    eae6320::Assets::OutputErrorMessageWithFileInfo(i_path, "Asset files must return a single table (instead of %d values)", returnedValueCount);
+                    // Pop every value that was returned
+                    lua_pop(luaState, returnedValueCount);
+                    goto OnExit;
+                }
+            }
+            else
+            {
+                result = eae6320::Results::InvalidFile;
+                eae6320::Assets::OutputErrorMessageWithFileInfo(i_path, lua_tostring(luaState, -1));
+                // Pop the error message
+                lua_pop(luaState, 1);
+                goto OnExit;
+            }
+        }
+
+        // If this code is reached the asset file was loaded successfully,
+        // and its table is now at index -1
+        if (!(result = LoadVertexData(*luaState, o_vertexCount, o_vertexData)))
+        {
+            result = eae6320::Results::Failure;
+            eae6320::Assets::OutputErrorMessageWithFileInfo(i_path, "Couldn't parse vertex data for file %s", i_path);
+            goto OnExit;
+        }
+
+        if (!(result = LoadIndexData(*luaState, o_indexCount, o_indices)))
+        {
+            result = eae6320::Results::Failure;
+            eae6320::Assets::OutputErrorMessageWithFileInfo(i_path, "Couldn't parse index data for file %s", i_path);
+            goto OnExit;
+        }
+
+        // Pop the table
+        lua_pop(luaState, 1);
+
+    OnExit:
+
+        {
+            // If I haven't made any mistakes
+            // there shouldn't be anything on the stack,
+            // regardless of any errors encountered while loading the file:
+            if (lua_gettop(luaState) != 0)
+            {
+                eae6320::Assets::OutputErrorMessageWithFileInfo(i_path, "Lua stack wasn't empty when finished building mesh");
+                // The state is reused for the next mesh
+                lua_settop(luaState, 0);
+            }
+
+            // The mesh's tables aren't needed anymore
+            lua_gc(luaState, LUA_GCCOLLECT, 0);
+        }
+
+        return result;
+    }
+
+    eae6320::cResult LoadIntegerArray(lua_State& io_luaState, const uint32_t i_integerCount, uint32_t* o_integerArray)
     {
         // Check that the table we're about to read has the desired number of elements
         const auto intArraySize = luaL_len(&io_luaState, -1);
@@ -205,7 +405,15 @@ namespace
             // Check if the value in the int array is an integer
             if (lua_isinteger(&io_luaState, -1))
             {
-                uint16_t valueAtI = static_cast<uint16_t>(lua_tointeger(&io_luaState, -1));
+                const auto integerAtI = lua_tointeger(&io_luaState, -1);
+                if ((integerAtI < 0) || (integerAtI > std::numeric_limits<uint32_t>::max()))
+                {
+                    lua_pop(&io_luaState, 1);
+
+                    eae6320::Assets::OutputErrorMessage("Element %d in an int array is out of range (%lld)", i, integerAtI);
+                    return eae6320::Results::InvalidFile;
+                }
+                uint32_t valueAtI = static_cast<uint32_t>(integerAtI);
                 o_integerArray[i - 1] = valueAtI;
                 lua_pop(&io_luaState, 1);
             }
@@ -408,7 +616,7 @@ namespace
         return result;
     }
 
-    eae6320::cResult LoadVertexDataArray(lua_State& io_luaState, uint16_t& o_vertexCount, eae6320::Graphics::VertexFormats::sMesh*& o_vertexData)
+    eae6320::cResult LoadVertexDataArray(lua_State& io_luaState, uint32_t& o_vertexCount, eae6320::Graphics::VertexFormats::sMesh*& o_vertexData)
     {
         auto result = eae6320::Results::Success;
 
@@ -422,9 +630,22 @@ namespace
             goto OnExit;
         }
 
-        o_vertexCount = static_cast<uint16_t>(vertexDataArraySize);
+        if (vertexDataArraySize > std::numeric_limits<uint32_t>::max())
+        {
+            result = eae6320::Results::InvalidFile;
+            eae6320::Assets::OutputErrorMessage("The vertexData has too many elements (%lld)", vertexDataArraySize);
+            goto OnExit;
+        }
+
+        o_vertexCount = static_cast<uint32_t>(vertexDataArraySize);
         // reserve memory for the vertex data
         o_vertexData = static_cast<eae6320::Graphics::VertexFormats::sMesh*>(malloc(o_vertexCount * sizeof(eae6320::Graphics::VertexFormats::sMesh)));
+        if (!o_vertexData)
+        {
+            result = eae6320::Results::OutOfMemory;
+            eae6320::Assets::OutputErrorMessage("Couldn't allocate memory for %u vertices", o_vertexCount);
+            goto OnExit;
+        }
 
         for (auto i = 1; i <= vertexDataArraySize; ++i)
         {
@@ -514,7 +735,7 @@ namespace
         return result;
     }
 
-    eae6320::cResult LoadVertexData(lua_State& io_luaState, uint16_t& o_vertexCount, eae6320::Graphics::VertexFormats::sMesh*& o_vertexData)
+    eae6320::cResult LoadVertexData(lua_State& io_luaState, uint32_t& o_vertexCount, eae6320::Graphics::VertexFormats::sMesh*& o_vertexData)
     {
         auto result = eae6320::Results::Success;
 
@@ -551,7 +772,7 @@ namespace
         return result;
     }
 
-    eae6320::cResult LoadIndexDataArray(lua_State& io_luaState, uint16_t& o_indexCount, uint16_t*& o_indices)
+    eae6320::cResult LoadIndexDataArray(lua_State& io_luaState, uint32_t& o_indexCount, uint32_t*& o_indices)
     {
         auto result = eae6320::Results::Success;
 
@@ -565,10 +786,23 @@ namespace
             goto OnExit;
         }
 
-        o_indexCount = static_cast<uint16_t>(indexDataArraySize);
+        if (indexDataArraySize > std::numeric_limits<uint32_t>::max())
+        {
+            result = eae6320::Results::InvalidFile;
+            eae6320::Assets::OutputErrorMessage("The indexData has too many elements (%lld)", indexDataArraySize);
+            goto OnExit;
+        }
+
+        o_indexCount = static_cast<uint32_t>(indexDataArraySize);
         // reserve memory for the indices
         {
-            o_indices = static_cast<uint16_t*>(malloc(o_indexCount * sizeof(uint16_t)));
+            o_indices = static_cast<uint32_t*>(malloc(o_indexCount * sizeof(uint32_t)));
+            if (!o_indices)
+            {
+                result = eae6320::Results::OutOfMemory;
+                eae6320::Assets::OutputErrorMessage("Couldn't allocate memory for %u indices", o_indexCount);
+                goto OnExit;
+            }
         }
 
         if (!(result = LoadIntegerArray(io_luaState, o_indexCount, o_indices)))
@@ -583,7 +817,7 @@ namespace
         return result;
     }
 
-    eae6320::cResult LoadIndexData(lua_State& io_luaState, uint16_t& o_indexCount, uint16_t*& o_indices)
+    eae6320::cResult LoadIndexData(lua_State& io_luaState, uint32_t& o_indexCount, uint32_t*& o_indices)
     {
         auto result = eae6320::Results::Success;
 
@@ -620,27 +854,235 @@ namespace
         return result;
     }
 
-    eae6320::cResult WriteBuiltMesh(const char* i_path, const uint16_t i_vertexCount, const eae6320::Graphics::VertexFormats::sMesh* i_vertexData, const uint16_t i_indexCount, const uint16_t* i_indices)
+    eae6320::cResult ValidateIndices(const uint32_t i_vertexCount, const uint32_t i_indexCount, const uint32_t* i_indices)
+    {
+        for (uint32_t i = 0; i < i_indexCount; ++i)
+        {
+            if (i_indices[i] >= i_vertexCount)
+            {
+                eae6320::Assets::OutputErrorMessage("Index %u refers to vertex %u (but there are only %u vertices)", i, i_indices[i], i_vertexCount);
+                return eae6320::Results::InvalidFile;
+            }
+        }
+
+        return eae6320::Results::Success;
+    }
+
+    eae6320::cResult WriteBuiltMesh(const char* i_path, const uint32_t i_vertexCount, const eae6320::Graphics::VertexFormats::sMesh* i_vertexData, const uint32_t i_indexCount, const uint32_t* i_indices,
+        const eae6320::Graphics::MeshFormats::VertexEncodings::eType i_vertexEncoding, const std::vector<eae6320::Graphics::MeshFormats::sCluster>& i_clusters)
     {
         auto result = eae6320::Results::Success;
 
-        std::ofstream outFile(i_path, std::ofstream::binary);
-        const char* buffer = nullptr;
+        // 32-bit indices are only used when a mesh has too many vertices for 16-bit indices
+        eae6320::Graphics::MeshFormats::sMeshInfo meshInfo{};
+        meshInfo.vertexCount = i_vertexCount;
+        meshInfo.indexCount = i_indexCount;
+        meshInfo.clusterCount = static_cast<uint32_t>(i_clusters.size());
+        meshInfo.indexFormat = eae6320::Graphics::MeshFormats::IndexFormats::GetSmallestFormat(i_vertexCount);
+        meshInfo.vertexEncoding = i_vertexEncoding;
+
+        // Float positions don't need to be dequantized
+        std::vector<eae6320::Graphics::VertexFormats::sMeshQuantized> quantizedVertexData;
+        if (i_vertexEncoding == eae6320::Graphics::MeshFormats::VertexEncodings::Quantized)
+        {
+            QuantizeVertices(i_vertexCount, i_vertexData, quantizedVertexData, meshInfo.positionDequantization);
+        }
+        else
+        {
+            meshInfo.positionDequantization = { { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } };
+        }
+
+        // Each section's payload is gathered first so that the section table can be written before any of them
+        struct sSection
+        {
+            eae6320::Graphics::MeshFormats::Container::SectionTypes::eType type;
+            const void* data;
+            uint32_t size;
+        };
+        std::vector<sSection> sections;
+        sections.push_back({ eae6320::Graphics::MeshFormats::Container::SectionTypes::Info, &meshInfo, static_cast<uint32_t>(sizeof(meshInfo)) });
+        if (i_vertexEncoding == eae6320::Graphics::MeshFormats::VertexEncodings::Quantized)
+        {
+            sections.push_back({ eae6320::Graphics::MeshFormats::Container::SectionTypes::Vertices, quantizedVertexData.data(),
+                static_cast<uint32_t>(i_vertexCount * sizeof(eae6320::Graphics::VertexFormats::sMeshQuantized)) });
+        }
+        else
+        {
+            sections.push_back({ eae6320::Graphics::MeshFormats::Container::SectionTypes::Vertices, i_vertexData,
+                static_cast<uint32_t>(i_vertexCount * sizeof(eae6320::Graphics::VertexFormats::sMesh)) });
+        }
+        std::vector<uint16_t> indices16;
+        if (meshInfo.indexFormat == eae6320::Graphics::MeshFormats::IndexFormats::Index16)
+        {
+            indices16.assign(i_indices, i_indices + i_indexCount);
+            sections.push_back({ eae6320::Graphics::MeshFormats::Container::SectionTypes::Indices, indices16.data(),
+                static_cast<uint32_t>(i_indexCount * sizeof(uint16_t)) });
+        }
+        else
+        {
+            sections.push_back({ eae6320::Graphics::MeshFormats::Container::SectionTypes::Indices, i_indices,
+                static_cast<uint32_t>(i_indexCount * sizeof(uint32_t)) });
+        }
+        if (!i_clusters.empty())
+        {
+            sections.push_back({ eae6320::Graphics::MeshFormats::Container::SectionTypes::Clusters, i_clusters.data(),
+                static_cast<uint32_t>(i_clusters.size() * sizeof(eae6320::Graphics::MeshFormats::sCluster)) });
+        }
 
-        buffer = reinterpret_cast<const char*>(&i_vertexCount);
-        outFile.write(buffer, sizeof(uint16_t));
+        eae6320::Graphics::MeshFormats::Container::sFileHeader fileHeader{};
+        fileHeader.magic = eae6320::Graphics::MeshFormats::Container::FileMagic;
+        fileHeader.version = eae6320::Graphics::MeshFormats::Container::FileVersion;
+        fileHeader.sectionCount = static_cast<uint16_t>(sections.size());
 
-        buffer = reinterpret_cast<const char*>(i_vertexData);
-        outFile.write(buffer, i_vertexCount * sizeof(eae6320::Graphics::VertexFormats::sMesh));
+        std::vector<eae6320::Graphics::MeshFormats::Container::sSectionInfo> sectionTable(sections.size());
+        {
+            auto currentOffset = static_cast<uint32_t>(sizeof(fileHeader) + (sections.size() * sizeof(eae6320::Graphics::MeshFormats::Container::sSectionInfo)));
+            for (size_t i = 0; i < sections.size(); ++i)
+            {
+                currentOffset = eae6320::Graphics::MeshFormats::Container::AlignOffset(currentOffset);
+                sectionTable[i].type = sections[i].type;
+                sectionTable[i].offset = currentOffset;
+                sectionTable[i].size = sections[i].size;
+                sectionTable[i].padding = 0;
+                currentOffset += sections[i].size;
+            }
+        }
 
-        buffer = reinterpret_cast<const char*>(&i_indexCount);
-        outFile.write(buffer, sizeof(uint16_t));
+        eae6320::Assets::BuildTrace::cScope traceScope("Write", "BuilderPhase");
+        std::ofstream outFile(i_path, std::ofstream::binary);
+        if (!outFile.is_open())
+        {
+            eae6320::Assets::OutputErrorMessage("Couldn't open %s for writing", i_path);
+            return eae6320::Results::Failure;
+        }
+
+        outFile.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+        outFile.write(reinterpret_cast<const char*>(sectionTable.data()),
+            sectionTable.size() * sizeof(eae6320::Graphics::MeshFormats::Container::sSectionInfo));
+        {
+            auto currentOffset = static_cast<uint32_t>(sizeof(fileHeader) + (sectionTable.size() * sizeof(eae6320::Graphics::MeshFormats::Container::sSectionInfo)));
+            constexpr char padding[eae6320::Graphics::MeshFormats::Container::PayloadAlignment] = {};
+            for (size_t i = 0; i < sections.size(); ++i)
+            {
+                outFile.write(padding, sectionTable[i].offset - currentOffset);
+                outFile.write(reinterpret_cast<const char*>(sections[i].data), sections[i].size);
+                currentOffset = sectionTable[i].offset + sectionTable[i].size;
+            }
+        }
+
+        if (outFile.good())
+        {
+            traceScope.AddArgument("bytesWritten", static_cast<uint64_t>(outFile.tellp()));
+        }
+        else
+        {
+            result = eae6320::Results::Failure;
+            eae6320::Assets::OutputErrorMessage("Failed to write the built mesh to %s", i_path);
+        }
 
-        buffer = reinterpret_cast<const char*>(i_indices);
-        outFile.write(buffer, i_indexCount * sizeof(uint16_t));
-        
         outFile.close();
 
         return result;
     }
+
+    void QuantizeVertices(const uint32_t i_vertexCount, const eae6320::Graphics::VertexFormats::sMesh* i_vertexData,
+        std::vector<eae6320::Graphics::VertexFormats::sMeshQuantized>& o_vertexData, eae6320::Graphics::MeshFormats::sPositionDequantization& o_positionDequantization)
+    {
+        // Find the bounding box
+        float minimum[3] = { 0.0f, 0.0f, 0.0f };
+        float maximum[3] = { 0.0f, 0.0f, 0.0f };
+        for (uint32_t i = 0; i < i_vertexCount; ++i)
+        {
+            const float position[3] = { i_vertexData[i].x, i_vertexData[i].y, i_vertexData[i].z };
+            for (size_t j = 0; j < 3; ++j)
+            {
+                minimum[j] = (i == 0) ? position[j] : std::min(minimum[j], position[j]);
+                maximum[j] = (i == 0) ? position[j] : std::max(maximum[j], position[j]);
+            }
+        }
+
+        // The GPU converts each quantized value to [0,1],
+        // and so the vertex shader must scale it by the size of the bounding box and offset it by the minimum
+        for (size_t j = 0; j < 3; ++j)
+        {
+            o_positionDequantization.offset[j] = minimum[j];
+            o_positionDequantization.scale[j] = maximum[j] - minimum[j];
+        }
+
+        constexpr float maxQuantizedValue = static_cast<float>(std::numeric_limits<uint16_t>::max());
+        o_vertexData.resize(i_vertexCount);
+        for (uint32_t i = 0; i < i_vertexCount; ++i)
+        {
+            const auto& vertex = i_vertexData[i];
+            auto& quantizedVertex = o_vertexData[i];
+
+            const float position[3] = { vertex.x, vertex.y, vertex.z };
+            uint16_t quantizedPosition[3] = { 0, 0, 0 };
+            for (size_t j = 0; j < 3; ++j)
+            {
+                const auto extent = o_positionDequantization.scale[j];
+                const auto normalized = (extent > 0.0f) ? ((position[j] - minimum[j]) / extent) : 0.0f;
+                quantizedPosition[j] = static_cast<uint16_t>((std::min(std::max(normalized, 0.0f), 1.0f) * maxQuantizedValue) + 0.5f);
+            }
+            quantizedVertex.x = quantizedPosition[0];
+            quantizedVertex.y = quantizedPosition[1];
+            quantizedVertex.z = quantizedPosition[2];
+            quantizedVertex.w = 0;
+
+            // UVs can be outside of [0,1] (for tiling), and so they are stored as floats instead of normalized ints
+            quantizedVertex.u = ConvertFloatToHalf(vertex.u);
+            quantizedVertex.v = ConvertFloatToHalf(vertex.v);
+
+            quantizedVertex.r = vertex.r;
+            quantizedVertex.g = vertex.g;
+            quantizedVertex.b = vertex.b;
+            quantizedVertex.a = vertex.a;
+        }
+    }
+
+    uint16_t ConvertFloatToHalf(const float i_value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &i_value, sizeof(bits));
+
+        const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+        const auto floatExponent = static_cast<int32_t>((bits >> 23) & 0xff);
+        auto mantissa = bits & 0x7fffff;
+
+        // Infinity and NaN
+        if (floatExponent == 0xff)
+        {
+            return static_cast<uint16_t>(sign | 0x7c00 | ((mantissa != 0) ? 0x200 : 0));
+        }
+        const auto exponent = floatExponent - 127 + 15;
+        // Too big to be represented (so infinity is used)
+        if (exponent >= 0x1f)
+        {
+            return static_cast<uint16_t>(sign | 0x7c00);
+        }
+        // Too small to be normalized (so a denormalized value is used)
+        if (exponent <= 0)
+        {
+            if (exponent < -10)
+            {
+                return sign;
+            }
+            mantissa |= 0x800000;
+            const auto shift = static_cast<uint32_t>(14 - exponent);
+            auto half = static_cast<uint16_t>(mantissa >> shift);
+            if ((mantissa >> (shift - 1)) & 1)
+            {
+                ++half;
+            }
+            return static_cast<uint16_t>(sign | half);
+        }
+        // Round to nearest
+        // (if the mantissa overflows it correctly carries into the exponent)
+        auto half = static_cast<uint16_t>((exponent << 10) | (mantissa >> 13));
+        if (mantissa & 0x1000)
+        {
+            ++half;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
 }
@@ -13,6 +13,8 @@
 // Forward Declarations
 //=====================
 
+struct lua_State;
+
 namespace eae6320
 {
     namespace Graphics
@@ -33,6 +35,26 @@ namespace eae6320
     {
         class cMeshBuilder : public cbBuilder
         {
+            // Interface
+            //==========
+
+        public:
+
+            // Initialization / Clean Up
+            //--------------------------
+
+            virtual ~cMeshBuilder();
+
+            // Data
+            //=====
+
+        private:
+
+            // The Lua state is only created if a mesh has to be loaded with Lua,
+            // and is then reused for every mesh that the builder builds
+            // (a build host builds many meshes with the same builder)
+            lua_State* m_luaState = nullptr;
+
             // Inherited Implementation
             //=========================
 
@@ -43,7 +65,7 @@ namespace eae6320
 
             virtual cResult Build(const std::vector<std::string>& i_arguments) override;
 
-            void PerformPlatformSpecificFixup(const uint16_t i_vertexCount, eae6320::Graphics::VertexFormats::sMesh* io_vertexData, const uint16_t i_indexCount, uint16_t* io_indexData);
+            void PerformPlatformSpecificFixup(const uint32_t i_vertexCount, eae6320::Graphics::VertexFormats::sMesh* io_vertexData, const uint32_t i_indexCount, uint32_t* io_indexData);
         };
     }
 }
@@ -5,11 +5,21 @@
 
 #include <Engine/Platform/Platform.h>
 #include <sstream>
+#include <Tools/AssetBuildLibrary/BuildTrace.h>
 #include <Tools/AssetBuildLibrary/Functions.h>
 
 // Interface
 //==========
 
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Assets::cShaderBuilder::~cShaderBuilder()
+{
+	// Nothing is reused between builds
+	// (each shader is compiled by a separate fxc.exe process)
+}
+
 // Build
 //------
 
@@ -17,8 +27,12 @@ eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const Graphics::ShaderT
 {
 	auto result = Results::Success;
 
-	// Create the command to run
-	std::string command;
+	// fxc.exe can't report which files a shader includes,
+	// but it can write the preprocessed source (which has #line directives that name them) to a temporary file
+	const auto path_preProcessed = std::string( m_path_target ) + ".preprocessed";
+
+	// Create the commands to run
+	std::string command_preProcess, command_compile;
 	{
 		std::ostringstream commandToBuild;
 		// Get the path to the shader compiler
@@ -83,8 +97,6 @@ eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const Graphics::ShaderT
 			// Enable debugging
 			<< " /Zi"
 #endif
-			// Target file
-			<< " /Fo\"" << m_path_target << "\""
 			// Additional #include paths
 			// (list the game's content path before the engine's
 			// so that if there are identically-named files
@@ -96,13 +108,54 @@ eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const Graphics::ShaderT
 			// Source file
 			<< " \"" << m_path_source << "\""
 		;
-		command = commandToBuild.str();
+		const auto command_shared = commandToBuild.str();
+		// Preprocessing must be done by itself
+		command_preProcess = command_shared + " /P\"" + path_preProcessed + "\"";
+		// Target file
+		command_compile = command_shared + " /Fo\"" + m_path_target + "\"";
+	}
+	// Find the included files
+	{
+		BuildTrace::cScope traceScope( "Preprocess", "BuilderPhase" );
+		{
+			int exitCode;
+			std::string errorMessage;
+			if ( result = Platform::ExecuteCommand( command_preProcess.c_str(), &exitCode, &errorMessage ) )
+			{
+				if ( exitCode != EXIT_SUCCESS )
+				{
+					// fxc.exe outputs its own error messages
+					result = Results::Failure;
+					goto OnExit;
+				}
+			}
+			else
+			{
+				OutputErrorMessageWithFileInfo( m_path_source, errorMessage.c_str() );
+				goto OnExit;
+			}
+		}
+		Platform::sDataFromFile dataFromFile;
+		{
+			std::string errorMessage;
+			if ( !( result = Platform::LoadBinaryFile( path_preProcessed.c_str(), dataFromFile, &errorMessage ) ) )
+			{
+				OutputErrorMessageWithFileInfo( path_preProcessed.c_str(), errorMessage.c_str() );
+				goto OnExit;
+			}
+		}
+		std::string shaderSource_preProcessed( static_cast<const char*>( dataFromFile.data ), dataFromFile.size );
+		dataFromFile.Free();
+		AddIncludedFilesAsDependencies( shaderSource_preProcessed );
+		traceScope.AddArgument( "bytesPreprocessed", static_cast<uint64_t>( shaderSource_preProcessed.length() ) );
 	}
-	// Execute the command
+	// Compile the shader
 	{
+		// fxc.exe preprocesses (again), compiles, and writes the shader all at once
+		BuildTrace::cScope traceScope( "Compile", "BuilderPhase" );
 		int exitCode;
 		std::string errorMessage;
-		if ( result = Platform::ExecuteCommand( command.c_str(), &exitCode, &errorMessage ) )
+		if ( result = Platform::ExecuteCommand( command_compile.c_str(), &exitCode, &errorMessage ) )
 		{
 			result = ( exitCode == EXIT_SUCCESS ) ? Results::Success : Results::Failure;
 		}
@@ -115,5 +168,8 @@ eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const Graphics::ShaderT
 
 OnExit:
 
+	// The preprocessed source is only needed to find the included files
+	Platform::DeleteFileIfItExists( path_preProcessed.c_str() );
+
 	return result;
 }
@@ -13,6 +13,7 @@
 #include <regex>
 #include <sstream>
 #include <string>
+#include <Tools/AssetBuildLibrary/BuildTrace.h>
 #include <Tools/AssetBuildLibrary/Functions.h>
 
 // Static Data Initialization
@@ -32,6 +33,13 @@ namespace
 		};
 	}
 	GlVendors::eGlVendor s_glVendor = GlVendors::Other;
+
+	// Creating an OpenGL context is slow,
+	// and so it is only done for the first shader that a builder builds
+	// (a build host builds many shaders)
+	HINSTANCE s_hInstance = NULL;
+	eae6320::Windows::OpenGl::sHiddenWindowInfo s_hiddenWindowInfo;
+	bool s_isHiddenContextCreated = false;
 }
 
 // Helper Function Declarations
@@ -41,6 +49,9 @@ namespace
 {
 	eae6320::cResult BuildAndVerifyGeneratedShaderSource( const char* const i_path_source, const char* const i_path_target,
 		const eae6320::Graphics::ShaderTypes::eType i_shaderType, const std::string& i_source );
+	// This also determines which vendor makes the GPU
+	eae6320::cResult CreateHiddenContextIfNecessary( const char* const i_path_source );
+	void FreeHiddenContextIfNecessary();
 	eae6320::cResult PreProcessShaderSource( const char* const i_path_source, std::string& o_shaderSource_preProcessed );
 	eae6320::cResult SaveGeneratedShaderSource( const char* const i_path, const std::string& i_source );
 
@@ -57,6 +68,14 @@ namespace
 // Interface
 //==========
 
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Assets::cShaderBuilder::~cShaderBuilder()
+{
+	FreeHiddenContextIfNecessary();
+}
+
 // Build
 //------
 
@@ -65,17 +84,32 @@ eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const Graphics::ShaderT
 	auto result = Results::Success;
 
 	std::string shaderSource_preProcessed;
-	if ( !( result = PreProcessShaderSource( m_path_source, shaderSource_preProcessed ) ) )
 	{
-		goto OnExit;
+		BuildTrace::cScope traceScope( "Preprocess", "BuilderPhase" );
+		if ( !( result = PreProcessShaderSource( m_path_source, shaderSource_preProcessed ) ) )
+		{
+			goto OnExit;
+		}
+		// mcpp's #line directives name every file that was included
+		// (the asset build uses them to decide when the shader must be built again)
+		// and are then removed
+		AddIncludedFilesAsDependencies( shaderSource_preProcessed );
+		traceScope.AddArgument( "bytesPreprocessed", static_cast<uint64_t>( shaderSource_preProcessed.length() ) );
 	}
-	if ( !( result = SaveGeneratedShaderSource( m_path_target, shaderSource_preProcessed ) ) )
 	{
-		goto OnExit;
+		BuildTrace::cScope traceScope( "Write", "BuilderPhase" );
+		if ( !( result = SaveGeneratedShaderSource( m_path_target, shaderSource_preProcessed ) ) )
+		{
+			goto OnExit;
+		}
+		traceScope.AddArgument( "bytesWritten", static_cast<uint64_t>( shaderSource_preProcessed.length() ) );
 	}
-	if ( !( result = BuildAndVerifyGeneratedShaderSource( m_path_source, m_path_target, i_shaderType, shaderSource_preProcessed ) ) )
 	{
-		goto OnExit;
+		BuildTrace::cScope traceScope( "Verify", "BuilderPhase" );
+		if ( !( result = BuildAndVerifyGeneratedShaderSource( m_path_source, m_path_target, i_shaderType, shaderSource_preProcessed ) ) )
+		{
+			goto OnExit;
+		}
 	}
 
 OnExit:
@@ -93,66 +127,10 @@ namespace
 	{
 		auto result = eae6320::Results::Success;
 
-		HINSTANCE hInstance = NULL;
-		eae6320::Windows::OpenGl::sHiddenWindowInfo hiddenWindowInfo;
-
-		// Load any required OpenGL extensions
+		// Make sure that there is an OpenGL context
+		if ( !( result = CreateHiddenContextIfNecessary( i_path_source ) ) )
 		{
-			std::string errorMessage;
-			if ( !( result = eae6320::OpenGlExtensions::Load( &errorMessage ) ) )
-			{
-				eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_source, errorMessage.c_str() );
-				goto OnExit;
-			}
-		}
-
-		// Create a hidden OpenGL window
-		{
-			std::string errorMessage;
-			if ( !( result = eae6320::Windows::OpenGl::CreateHiddenContextWindow( hInstance, hiddenWindowInfo, &errorMessage ) ) )
-			{
-				eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_source, errorMessage.c_str() );
-				goto OnExit;
-			}
-		}
-		// Determine which vendor makes the GPU
-		{
-			const auto* const glString = glGetString( GL_VENDOR );
-			const auto errorCode = glGetError();
-			if ( glString && ( errorCode == GL_NO_ERROR ) )
-			{
-				const auto* const glVendor = reinterpret_cast<const char*>( glString );
-				if ( strcmp( glVendor, "NVIDIA Corporation" ) == 0 )
-				{
-					s_glVendor = GlVendors::NVIDIA;
-				}
-				else if ( strcmp( glVendor, "ATI Technologies Inc." ) == 0 )
-				{
-					s_glVendor = GlVendors::AMD;
-				}
-				else if ( strcmp( glVendor, "Intel" ) == 0 )
-				{
-					s_glVendor = GlVendors::Intel;
-				}
-				else
-				{
-					s_glVendor = GlVendors::Other;
-				}
-			}
-			else
-			{
-				result = eae6320::Results::Failure;
-				{
-					std::ostringstream errorMessage;
-					errorMessage << "OpenGL failed to return a string identifying the GPU vendor";
-					if ( errorCode != GL_NO_ERROR )
-					{
-						errorMessage << ": " << reinterpret_cast<const char*>( gluErrorString( errorCode ) );
-					}
-					eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_source, errorMessage.str().c_str() );
-				}
-				goto OnExit;
-			}
+			goto OnExit;
 		}
 		// Verify that compiling shaders at run-time is supported
 		{
@@ -381,22 +359,98 @@ namespace
 			shaderId = 0;
 		}
 
+		return result;
+	}
+
+	eae6320::cResult CreateHiddenContextIfNecessary( const char* const i_path_source )
+	{
+		auto result = eae6320::Results::Success;
+
+		if ( s_isHiddenContextCreated )
+		{
+			return result;
+		}
+
+		// Load any required OpenGL extensions
 		{
 			std::string errorMessage;
-			const auto localResult = eae6320::Windows::OpenGl::FreeHiddenContextWindow( hInstance, hiddenWindowInfo, &errorMessage );
-			if ( !localResult )
+			if ( !( result = eae6320::OpenGlExtensions::Load( &errorMessage ) ) )
 			{
-				if ( result )
+				eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_source, errorMessage.c_str() );
+				goto OnExit;
+			}
+		}
+
+		// Create a hidden OpenGL window
+		{
+			std::string errorMessage;
+			if ( !( result = eae6320::Windows::OpenGl::CreateHiddenContextWindow( s_hInstance, s_hiddenWindowInfo, &errorMessage ) ) )
+			{
+				eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_source, errorMessage.c_str() );
+				goto OnExit;
+			}
+		}
+		// Determine which vendor makes the GPU
+		{
+			const auto* const glString = glGetString( GL_VENDOR );
+			const auto errorCode = glGetError();
+			if ( glString && ( errorCode == GL_NO_ERROR ) )
+			{
+				const auto* const glVendor = reinterpret_cast<const char*>( glString );
+				if ( strcmp( glVendor, "NVIDIA Corporation" ) == 0 )
 				{
-					result = localResult;
+					s_glVendor = GlVendors::NVIDIA;
 				}
-				eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_source, errorMessage.c_str() );
+				else if ( strcmp( glVendor, "ATI Technologies Inc." ) == 0 )
+				{
+					s_glVendor = GlVendors::AMD;
+				}
+				else if ( strcmp( glVendor, "Intel" ) == 0 )
+				{
+					s_glVendor = GlVendors::Intel;
+				}
+				else
+				{
+					s_glVendor = GlVendors::Other;
+				}
+			}
+			else
+			{
+				result = eae6320::Results::Failure;
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "OpenGL failed to return a string identifying the GPU vendor";
+					if ( errorCode != GL_NO_ERROR )
+					{
+						errorMessage << ": " << reinterpret_cast<const char*>( gluErrorString( errorCode ) );
+					}
+					eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_source, errorMessage.str().c_str() );
+				}
+				goto OnExit;
 			}
 		}
+		s_isHiddenContextCreated = true;
+
+	OnExit:
+
+		if ( !result )
+		{
+			FreeHiddenContextIfNecessary();
+		}
 
 		return result;
 	}
 
+	void FreeHiddenContextIfNecessary()
+	{
+		std::string errorMessage;
+		if ( !eae6320::Windows::OpenGl::FreeHiddenContextWindow( s_hInstance, s_hiddenWindowInfo, &errorMessage ) )
+		{
+			eae6320::Assets::OutputErrorMessage( errorMessage.c_str() );
+		}
+		s_isHiddenContextCreated = false;
+	}
+
 	eae6320::cResult PreProcessShaderSource( const char* const i_path_source, std::string& o_shaderSource_preProcessed )
 	{
 		auto result = eae6320::Results::Success;
@@ -453,8 +507,6 @@ namespace
 			// Keep comments
 			"-C",
 #endif
-			// Don't output #line number information
-			"-P",
 			// Treat unknown directives (like #version and #extension) as warnings instead of errors
 			"-a",
 			// The input file to pre-process
@@ -3,6 +3,8 @@
 
 #include "cShaderBuilder.h"
 
+#include <cctype>
+#include <cstring>
 #include <Tools/AssetBuildLibrary/Functions.h>
 
 // Inherited Implementation
@@ -44,3 +46,70 @@ eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const std::vector<std::
 
 	return Build( shaderType, i_arguments );
 }
+
+// Implementation
+//===============
+
+void eae6320::Assets::cShaderBuilder::AddIncludedFilesAsDependencies( std::string& io_shaderSource_preProcessed )
+{
+	std::string shaderSource;
+	shaderSource.reserve( io_shaderSource_preProcessed.length() );
+	size_t lineStart = 0;
+	while ( lineStart < io_shaderSource_preProcessed.length() )
+	{
+		auto lineEnd = io_shaderSource_preProcessed.find( '\n', lineStart );
+		lineEnd = ( lineEnd != std::string::npos ) ? ( lineEnd + 1 ) : io_shaderSource_preProcessed.length();
+		// A line directive is "#line", a line number, and a quoted path
+		// (with optional white space between each, and "line" is optional for some preprocessors)
+		auto isLineDirective = false;
+		{
+			const auto* c = io_shaderSource_preProcessed.c_str() + lineStart;
+			const auto* const end = io_shaderSource_preProcessed.c_str() + lineEnd;
+			const auto SkipWhiteSpace = [&c, end]() { while ( ( c < end ) && ( ( *c == ' ' ) || ( *c == '\t' ) ) ) { ++c; } };
+			SkipWhiteSpace();
+			if ( ( c < end ) && ( *c == '#' ) )
+			{
+				++c;
+				SkipWhiteSpace();
+				if ( ( ( end - c ) >= 4 ) && ( strncmp( c, "line", 4 ) == 0 ) )
+				{
+					c += 4;
+				}
+				SkipWhiteSpace();
+				const auto* const lineNumber = c;
+				while ( ( c < end ) && isdigit( static_cast<unsigned char>( *c ) ) )
+				{
+					++c;
+				}
+				if ( c != lineNumber )
+				{
+					isLineDirective = true;
+					SkipWhiteSpace();
+					if ( ( c < end ) && ( *c == '"' ) )
+					{
+						std::string path;
+						for ( ++c; ( c < end ) && ( *c != '"' ); ++c )
+						{
+							// Backslashes in the path may be escaped
+							if ( ( *c == '\\' ) && ( ( c + 1 ) < end ) && ( c[1] == '\\' ) )
+							{
+								++c;
+							}
+							path += *c;
+						}
+						if ( !path.empty() )
+						{
+							AddDependency( path );
+						}
+					}
+				}
+			}
+		}
+		if ( !isLineDirective )
+		{
+			shaderSource.append( io_shaderSource_preProcessed, lineStart, lineEnd - lineStart );
+		}
+		lineStart = lineEnd;
+	}
+	io_shaderSource_preProcessed.swap( shaderSource );
+}
@@ -22,6 +22,17 @@ namespace eae6320
 	{
 		class cShaderBuilder : public cbBuilder
 		{
+			// Interface
+			//==========
+
+		public:
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// Anything that the platform-specific builder reuses between builds is freed here
+			virtual ~cShaderBuilder();
+
 			// Inherited Implementation
 			//=========================
 
@@ -41,6 +52,12 @@ namespace eae6320
 			//------
 
 			cResult Build( const Graphics::ShaderTypes::eType i_shaderType, const std::vector<std::string>& i_arguments );
+
+			// Preprocessors mark where the contents of each file start with a #line directive
+			// (e.g. #line 1 "C:/Engine/Content/Shaders/shaders.inc"):
+			// every file that is named by one is added as a dependency,
+			// and the directives are removed
+			void AddIncludedFilesAsDependencies( std::string& io_shaderSource_preProcessed );
 		};
 	}
 }
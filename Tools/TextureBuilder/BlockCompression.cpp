@@ -0,0 +1,481 @@
+// Include Files
+//==============
+
+#include "BlockCompression.h"
+
+#include "ParallelFor.h"
+#include "sImage.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+#if defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) ) || defined( __SSE2__ )
+	#define EAE6320_TEXTUREBUILDER_SSE2
+	#include <emmintrin.h>
+#endif
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+	constexpr unsigned int s_pixelsPerBlock = 16;
+
+	// The channels of a block's pixels are stored in separate arrays
+	// so that four pixels can be processed at once
+	struct sBlockChannels
+	{
+		float values[3][s_pixelsPerBlock];
+	};
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// This returns the total squared error
+	float FindClosestPaletteEntries( const sBlockChannels& i_block, const unsigned int i_channelCount,
+		const float i_palette[][8], const unsigned int i_paletteEntryCount, uint8_t* const o_indices );
+
+	// Color
+	void CompressColorBlock( const uint8_t* const i_pixels, uint8_t* const o_block );
+	float EncodeColorEndpoints( const sBlockChannels& i_block, const float* const i_endpoint0, const float* const i_endpoint1,
+		uint16_t& o_color0, uint16_t& o_color1, uint8_t* const o_indices );
+	void ExpandFrom565( const uint16_t i_color, float* const o_color );
+	uint16_t QuantizeTo565( const float* const i_color );
+
+	// Single channel
+	void CompressSingleChannelBlock( const uint8_t* const i_pixels, const unsigned int i_channel, uint8_t* const o_block );
+}
+
+// Interface
+//==========
+
+void eae6320::Assets::BlockCompression::CompressBlock_BC1( const uint8_t* const i_pixels, uint8_t* const o_block )
+{
+	CompressColorBlock( i_pixels, o_block );
+}
+
+void eae6320::Assets::BlockCompression::CompressBlock_BC3( const uint8_t* const i_pixels, uint8_t* const o_block )
+{
+	// The alpha block comes first
+	CompressSingleChannelBlock( i_pixels, 3, o_block );
+	CompressColorBlock( i_pixels, o_block + 8 );
+}
+
+void eae6320::Assets::BlockCompression::CompressBlock_BC4( const uint8_t* const i_pixels, uint8_t* const o_block )
+{
+	CompressSingleChannelBlock( i_pixels, 0, o_block );
+}
+
+void eae6320::Assets::BlockCompression::CompressBlock_BC5( const uint8_t* const i_pixels, uint8_t* const o_block )
+{
+	CompressSingleChannelBlock( i_pixels, 0, o_block );
+	CompressSingleChannelBlock( i_pixels, 1, o_block + 8 );
+}
+
+eae6320::cResult eae6320::Assets::BlockCompression::Compress( const std::vector<sImage>& i_mipMaps,
+	const Graphics::TextureFormats::Compression::eType i_compressionType, std::vector<uint8_t>& o_compressedData, std::string* const o_errorMessage )
+{
+	void ( *CompressBlock )( const uint8_t* const, uint8_t* const ) = nullptr;
+	switch ( i_compressionType )
+	{
+	case Graphics::TextureFormats::Compression::BC1: CompressBlock = CompressBlock_BC1; break;
+	case Graphics::TextureFormats::Compression::BC3: CompressBlock = CompressBlock_BC3; break;
+	case Graphics::TextureFormats::Compression::BC4: CompressBlock = CompressBlock_BC4; break;
+	case Graphics::TextureFormats::Compression::BC5: CompressBlock = CompressBlock_BC5; break;
+	default:
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The texture builder can't compress to the format " << static_cast<int>( i_compressionType );
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::Failure;
+	}
+	const auto blockSize = Graphics::TextureFormats::Compression::GetSizeOfBlock( i_compressionType );
+
+	// Every row of blocks (in every MIP level) is compressed independently
+	struct sBlockRow
+	{
+		const sImage* mipMap;
+		uint32_t y;
+		size_t offset;
+	};
+	std::vector<sBlockRow> blockRows;
+	size_t compressedSize = 0;
+	for ( const auto& mipMap : i_mipMaps )
+	{
+		const auto blockCount_singleRow = static_cast<size_t>( ( mipMap.width + 3 ) / 4 );
+		const auto rowCount = ( mipMap.height + 3 ) / 4;
+		for ( uint32_t y = 0; y < rowCount; ++y )
+		{
+			blockRows.push_back( { &mipMap, y * 4, compressedSize } );
+			compressedSize += blockCount_singleRow * blockSize;
+		}
+	}
+	o_compressedData.resize( compressedSize );
+	ParallelFor( blockRows.size(), [&]( const size_t i_rowIndex )
+	{
+		const auto& blockRow = blockRows[i_rowIndex];
+		const auto& mipMap = *blockRow.mipMap;
+		auto* block = o_compressedData.data() + blockRow.offset;
+		for ( uint32_t x_block = 0; x_block < mipMap.width; x_block += 4, block += blockSize )
+		{
+			// MIP levels that are smaller than a block repeat their last row and column
+			uint8_t pixels[s_pixelsPerBlock * 4];
+			for ( uint32_t y = 0; y < 4; ++y )
+			{
+				const auto y_image = std::min( blockRow.y + y, mipMap.height - 1 );
+				for ( uint32_t x = 0; x < 4; ++x )
+				{
+					const auto x_image = std::min( x_block + x, mipMap.width - 1 );
+					memcpy( pixels + ( ( ( y * 4 ) + x ) * 4 ), mipMap.GetPixel( x_image, y_image ), 4 );
+				}
+			}
+			CompressBlock( pixels, block );
+		}
+	} );
+
+	return Results::Success;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	float FindClosestPaletteEntries( const sBlockChannels& i_block, const unsigned int i_channelCount,
+		const float i_palette[][8], const unsigned int i_paletteEntryCount, uint8_t* const o_indices )
+	{
+#if defined( EAE6320_TEXTUREBUILDER_SSE2 )
+		auto totalError = _mm_setzero_ps();
+		for ( unsigned int i = 0; i < s_pixelsPerBlock; i += 4 )
+		{
+			auto closestError = _mm_set1_ps( FLT_MAX );
+			auto closestIndex = _mm_setzero_si128();
+			for ( unsigned int j = 0; j < i_paletteEntryCount; ++j )
+			{
+				auto error = _mm_setzero_ps();
+				for ( unsigned int c = 0; c < i_channelCount; ++c )
+				{
+					const auto difference = _mm_sub_ps( _mm_loadu_ps( i_block.values[c] + i ), _mm_set1_ps( i_palette[c][j] ) );
+					error = _mm_add_ps( error, _mm_mul_ps( difference, difference ) );
+				}
+				const auto isCloser = _mm_castps_si128( _mm_cmplt_ps( error, closestError ) );
+				closestError = _mm_min_ps( error, closestError );
+				closestIndex = _mm_or_si128( _mm_and_si128( isCloser, _mm_set1_epi32( static_cast<int>( j ) ) ), _mm_andnot_si128( isCloser, closestIndex ) );
+			}
+			totalError = _mm_add_ps( totalError, closestError );
+			alignas( 16 ) int32_t indices[4];
+			_mm_store_si128( reinterpret_cast<__m128i*>( indices ), closestIndex );
+			for ( unsigned int k = 0; k < 4; ++k )
+			{
+				o_indices[i + k] = static_cast<uint8_t>( indices[k] );
+			}
+		}
+		alignas( 16 ) float errors[4];
+		_mm_store_ps( errors, totalError );
+		return errors[0] + errors[1] + errors[2] + errors[3];
+#else
+		auto totalError = 0.0f;
+		for ( unsigned int i = 0; i < s_pixelsPerBlock; ++i )
+		{
+			auto closestError = FLT_MAX;
+			uint8_t closestIndex = 0;
+			for ( unsigned int j = 0; j < i_paletteEntryCount; ++j )
+			{
+				auto error = 0.0f;
+				for ( unsigned int c = 0; c < i_channelCount; ++c )
+				{
+					const auto difference = i_block.values[c][i] - i_palette[c][j];
+					error += difference * difference;
+				}
+				if ( error < closestError )
+				{
+					closestError = error;
+					closestIndex = static_cast<uint8_t>( j );
+				}
+			}
+			totalError += closestError;
+			o_indices[i] = closestIndex;
+		}
+		return totalError;
+#endif
+	}
+
+	// Color
+	//------
+
+	void CompressColorBlock( const uint8_t* const i_pixels, uint8_t* const o_block )
+	{
+		sBlockChannels block;
+		float mean[3] = {};
+		for ( unsigned int i = 0; i < s_pixelsPerBlock; ++i )
+		{
+			for ( unsigned int c = 0; c < 3; ++c )
+			{
+				block.values[c][i] = i_pixels[( i * 4 ) + c];
+				mean[c] += block.values[c][i];
+			}
+		}
+		for ( auto& channelMean : mean )
+		{
+			channelMean /= s_pixelsPerBlock;
+		}
+
+		// Find the axis that the colors vary the most along
+		float axis[3];
+		{
+			float covariance[6] = {};	// rr, rg, rb, gg, gb, bb
+			float minimum[3] = { 255.0f, 255.0f, 255.0f }, maximum[3] = {};
+			for ( unsigned int i = 0; i < s_pixelsPerBlock; ++i )
+			{
+				const float r = block.values[0][i] - mean[0], g = block.values[1][i] - mean[1], b = block.values[2][i] - mean[2];
+				covariance[0] += r * r; covariance[1] += r * g; covariance[2] += r * b;
+				covariance[3] += g * g; covariance[4] += g * b; covariance[5] += b * b;
+				for ( unsigned int c = 0; c < 3; ++c )
+				{
+					minimum[c] = std::min( minimum[c], block.values[c][i] );
+					maximum[c] = std::max( maximum[c], block.values[c][i] );
+				}
+			}
+			// The principal axis is found with power iteration,
+			// starting with the diagonal of the colors' bounding box
+			for ( unsigned int c = 0; c < 3; ++c )
+			{
+				axis[c] = maximum[c] - minimum[c];
+			}
+			for ( unsigned int iteration = 0; iteration < 8; ++iteration )
+			{
+				const float r = ( covariance[0] * axis[0] ) + ( covariance[1] * axis[1] ) + ( covariance[2] * axis[2] );
+				const float g = ( covariance[1] * axis[0] ) + ( covariance[3] * axis[1] ) + ( covariance[4] * axis[2] );
+				const float b = ( covariance[2] * axis[0] ) + ( covariance[4] * axis[1] ) + ( covariance[5] * axis[2] );
+				const auto length = std::max( std::max( std::abs( r ), std::abs( g ) ), std::abs( b ) );
+				if ( length < 1.0e-6f )
+				{
+					break;
+				}
+				axis[0] = r / length; axis[1] = g / length; axis[2] = b / length;
+			}
+		}
+		// The endpoints are the extremes of the colors along the axis
+		float endpoints[2][3];
+		{
+			const auto lengthSquared = ( axis[0] * axis[0] ) + ( axis[1] * axis[1] ) + ( axis[2] * axis[2] );
+			auto minimumProjection = 0.0f, maximumProjection = 0.0f;
+			if ( lengthSquared > 1.0e-12f )
+			{
+				for ( unsigned int i = 0; i < s_pixelsPerBlock; ++i )
+				{
+					const auto projection = ( ( ( block.values[0][i] - mean[0] ) * axis[0] ) + ( ( block.values[1][i] - mean[1] ) * axis[1] )
+						+ ( ( block.values[2][i] - mean[2] ) * axis[2] ) ) / lengthSquared;
+					minimumProjection = std::min( minimumProjection, projection );
+					maximumProjection = std::max( maximumProjection, projection );
+				}
+			}
+			for ( unsigned int c = 0; c < 3; ++c )
+			{
+				endpoints[0][c] = std::min( std::max( mean[c] + ( axis[c] * maximumProjection ), 0.0f ), 255.0f );
+				endpoints[1][c] = std::min( std::max( mean[c] + ( axis[c] * minimumProjection ), 0.0f ), 255.0f );
+			}
+		}
+
+		uint16_t colors[2];
+		uint8_t indices[s_pixelsPerBlock];
+		auto error = EncodeColorEndpoints( block, endpoints[0], endpoints[1], colors[0], colors[1], indices );
+		// The endpoints are refined by solving for the colors that best fit the chosen indices
+		// (the weight of the first endpoint for each index)
+		constexpr float weights[] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+		for ( unsigned int iteration = 0; ( iteration < 2 ) && ( colors[0] != colors[1] ); ++iteration )
+		{
+			float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+			float ax[3] = {}, bx[3] = {};
+			for ( unsigned int i = 0; i < s_pixelsPerBlock; ++i )
+			{
+				const auto a = weights[indices[i]];
+				const auto b = 1.0f - a;
+				aa += a * a; ab += a * b; bb += b * b;
+				for ( unsigned int c = 0; c < 3; ++c )
+				{
+					ax[c] += a * block.values[c][i];
+					bx[c] += b * block.values[c][i];
+				}
+			}
+			const auto determinant = ( aa * bb ) - ( ab * ab );
+			if ( std::abs( determinant ) < 1.0e-6f )
+			{
+				break;
+			}
+			float refinedEndpoints[2][3];
+			for ( unsigned int c = 0; c < 3; ++c )
+			{
+				refinedEndpoints[0][c] = std::min( std::max( ( ( bb * ax[c] ) - ( ab * bx[c] ) ) / determinant, 0.0f ), 255.0f );
+				refinedEndpoints[1][c] = std::min( std::max( ( ( aa * bx[c] ) - ( ab * ax[c] ) ) / determinant, 0.0f ), 255.0f );
+			}
+			uint16_t refinedColors[2];
+			uint8_t refinedIndices[s_pixelsPerBlock];
+			const auto refinedError = EncodeColorEndpoints( block, refinedEndpoints[0], refinedEndpoints[1], refinedColors[0], refinedColors[1], refinedIndices );
+			if ( refinedError >= error )
+			{
+				break;
+			}
+			error = refinedError;
+			colors[0] = refinedColors[0];
+			colors[1] = refinedColors[1];
+			memcpy( indices, refinedIndices, sizeof( indices ) );
+		}
+
+		// The colors are stored little-endian followed by the 2-bit indices (the first pixel in the lowest bits)
+		uint32_t packedIndices = 0;
+		for ( unsigned int i = 0; i < s_pixelsPerBlock; ++i )
+		{
+			packedIndices |= static_cast<uint32_t>( indices[i] ) << ( i * 2 );
+		}
+		o_block[0] = static_cast<uint8_t>( colors[0] ); o_block[1] = static_cast<uint8_t>( colors[0] >> 8 );
+		o_block[2] = static_cast<uint8_t>( colors[1] ); o_block[3] = static_cast<uint8_t>( colors[1] >> 8 );
+		for ( unsigned int i = 0; i < 4; ++i )
+		{
+			o_block[4 + i] = static_cast<uint8_t>( packedIndices >> ( i * 8 ) );
+		}
+	}
+
+	float EncodeColorEndpoints( const sBlockChannels& i_block, const float* const i_endpoint0, const float* const i_endpoint1,
+		uint16_t& o_color0, uint16_t& o_color1, uint8_t* const o_indices )
+	{
+		o_color0 = QuantizeTo565( i_endpoint0 );
+		o_color1 = QuantizeTo565( i_endpoint1 );
+		// The first color must be greater than the second for the block to use four colors
+		// (otherwise the fourth color is transparent black)
+		if ( o_color0 < o_color1 )
+		{
+			std::swap( o_color0, o_color1 );
+		}
+		float palette[3][8];
+		{
+			float color0[3], color1[3];
+			ExpandFrom565( o_color0, color0 );
+			ExpandFrom565( o_color1, color1 );
+			for ( unsigned int c = 0; c < 3; ++c )
+			{
+				palette[c][0] = color0[c];
+				palette[c][1] = color1[c];
+				palette[c][2] = ( ( 2.0f * color0[c] ) + color1[c] ) / 3.0f;
+				palette[c][3] = ( color0[c] + ( 2.0f * color1[c] ) ) / 3.0f;
+			}
+		}
+		// If the colors are the same the block only has a single color
+		const auto paletteEntryCount = ( o_color0 != o_color1 ) ? 4u : 1u;
+		return FindClosestPaletteEntries( i_block, 3, palette, paletteEntryCount, o_indices );
+	}
+
+	void ExpandFrom565( const uint16_t i_color, float* const o_color )
+	{
+		const auto r = ( i_color >> 11 ) & 0x1f, g = ( i_color >> 5 ) & 0x3f, b = i_color & 0x1f;
+		o_color[0] = static_cast<float>( ( r << 3 ) | ( r >> 2 ) );
+		o_color[1] = static_cast<float>( ( g << 2 ) | ( g >> 4 ) );
+		o_color[2] = static_cast<float>( ( b << 3 ) | ( b >> 2 ) );
+	}
+
+	uint16_t QuantizeTo565( const float* const i_color )
+	{
+		const auto r = static_cast<uint16_t>( ( i_color[0] * ( 31.0f / 255.0f ) ) + 0.5f );
+		const auto g = static_cast<uint16_t>( ( i_color[1] * ( 63.0f / 255.0f ) ) + 0.5f );
+		const auto b = static_cast<uint16_t>( ( i_color[2] * ( 31.0f / 255.0f ) ) + 0.5f );
+		return static_cast<uint16_t>( ( r << 11 ) | ( g << 5 ) | b );
+	}
+
+	// Single channel
+	//---------------
+
+	void CompressSingleChannelBlock( const uint8_t* const i_pixels, const unsigned int i_channel, uint8_t* const o_block )
+	{
+		sBlockChannels block;
+		uint8_t minimum = 255, maximum = 0;
+		// The 6-value mode has exact values for 0 and 255,
+		// and so its endpoints only need to cover the other values
+		uint8_t minimum_without0Or255 = 255, maximum_without0Or255 = 0;
+		auto isThere0Or255 = false;
+		for ( unsigned int i = 0; i < s_pixelsPerBlock; ++i )
+		{
+			const auto value = i_pixels[( i * 4 ) + i_channel];
+			block.values[0][i] = value;
+			minimum = std::min( minimum, value );
+			maximum = std::max( maximum, value );
+			if ( ( value == 0 ) || ( value == 255 ) )
+			{
+				isThere0Or255 = true;
+			}
+			else
+			{
+				minimum_without0Or255 = std::min( minimum_without0Or255, value );
+				maximum_without0Or255 = std::max( maximum_without0Or255, value );
+			}
+		}
+
+		uint8_t endpoints[2];
+		uint8_t indices[s_pixelsPerBlock];
+		if ( minimum == maximum )
+		{
+			endpoints[0] = endpoints[1] = minimum;
+			memset( indices, 0, sizeof( indices ) );
+		}
+		else
+		{
+			// 8-value mode: the first endpoint is greater than the second
+			float palette[1][8];
+			{
+				endpoints[0] = maximum;
+				endpoints[1] = minimum;
+				palette[0][0] = maximum;
+				palette[0][1] = minimum;
+				for ( unsigned int i = 1; i < 7; ++i )
+				{
+					palette[0][1 + i] = ( ( ( 7 - i ) * static_cast<float>( maximum ) ) + ( i * static_cast<float>( minimum ) ) ) / 7.0f;
+				}
+			}
+			const auto error = FindClosestPaletteEntries( block, 1, palette, 8, indices );
+			// 6-value mode: the first endpoint isn't greater than the second
+			if ( isThere0Or255 )
+			{
+				if ( minimum_without0Or255 > maximum_without0Or255 )
+				{
+					// Every value is 0 or 255
+					minimum_without0Or255 = maximum_without0Or255 = 0;
+				}
+				palette[0][0] = minimum_without0Or255;
+				palette[0][1] = maximum_without0Or255;
+				for ( unsigned int i = 1; i < 5; ++i )
+				{
+					palette[0][1 + i] = ( ( ( 5 - i ) * static_cast<float>( minimum_without0Or255 ) ) + ( i * static_cast<float>( maximum_without0Or255 ) ) ) / 5.0f;
+				}
+				palette[0][6] = 0.0f;
+				palette[0][7] = 255.0f;
+				uint8_t indices_6Values[s_pixelsPerBlock];
+				if ( FindClosestPaletteEntries( block, 1, palette, 8, indices_6Values ) < error )
+				{
+					endpoints[0] = minimum_without0Or255;
+					endpoints[1] = maximum_without0Or255;
+					memcpy( indices, indices_6Values, sizeof( indices ) );
+				}
+			}
+		}
+
+		// The endpoints are followed by the 3-bit indices (the first pixel in the lowest bits)
+		o_block[0] = endpoints[0];
+		o_block[1] = endpoints[1];
+		uint64_t packedIndices = 0;
+		for ( unsigned int i = 0; i < s_pixelsPerBlock; ++i )
+		{
+			packedIndices |= static_cast<uint64_t>( indices[i] ) << ( i * 3 );
+		}
+		for ( unsigned int i = 0; i < 6; ++i )
+		{
+			o_block[2 + i] = static_cast<uint8_t>( packedIndices >> ( i * 8 ) );
+		}
+	}
+}
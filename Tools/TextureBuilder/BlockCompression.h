@@ -0,0 +1,66 @@
+/*
+	Block compression encodes each 4x4 block of a texture's pixels independently
+	(see TextureFormats::Compression):
+		* BC1 and the color of BC3 store two 5:6:5 endpoint colors
+			and a 2-bit index for each pixel that chooses a color between them;
+			the endpoints are found along the principal axis of the block's colors
+			and then refined with a least-squares fit to the chosen indices
+		* BC4 (and the alpha of BC3 and both channels of BC5) stores two 8-bit endpoints
+			and a 3-bit index for each pixel;
+			both the 8-value mode and the 6-value mode (which has exact 0 and 255) are tried
+		* Finding the closest palette entry for each pixel is where most of the time is spent,
+			and it is done for 4 pixels at a time with SSE2 when it is available
+		* The blocks of every MIP level are compressed on every hardware thread
+*/
+
+#ifndef EAE6320_TEXTUREBUILDER_BLOCKCOMPRESSION_H
+#define EAE6320_TEXTUREBUILDER_BLOCKCOMPRESSION_H
+
+// Include Files
+//==============
+
+#include <cstdint>
+#include <Engine/Graphics/TextureFormats.h>
+#include <Engine/Results/Results.h>
+#include <string>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		struct sImage;
+	}
+}
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace BlockCompression
+		{
+			// Each function compresses a single block,
+			// where the pixels are 16 RGBA pixels (4 rows of 4)
+			void CompressBlock_BC1( const uint8_t* const i_pixels, uint8_t* const o_block );
+			void CompressBlock_BC3( const uint8_t* const i_pixels, uint8_t* const o_block );
+			// BC4 uses the red channel
+			void CompressBlock_BC4( const uint8_t* const i_pixels, uint8_t* const o_block );
+			// BC5 uses the red and green channels
+			void CompressBlock_BC5( const uint8_t* const i_pixels, uint8_t* const o_block );
+
+			// The MIP maps are compressed one after the other
+			// with the blocks of each one in rows from the top
+			// (which is how the engine expects the texture data to be laid out)
+			cResult Compress( const std::vector<sImage>& i_mipMaps, const Graphics::TextureFormats::Compression::eType i_compressionType,
+				std::vector<uint8_t>& o_compressedData, std::string* const o_errorMessage = nullptr );
+		}
+	}
+}
+
+#endif	// EAE6320_TEXTUREBUILDER_BLOCKCOMPRESSION_H
@@ -0,0 +1,197 @@
+// Include Files
+//==============
+
+#include "MipMaps.h"
+
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+	// Each pixel of a resized row (or column) is a weighted sum of a range of source pixels
+	struct sContributions
+	{
+		// The contributions of output pixel i are [offsets[i], offsets[i + 1])
+		std::vector<size_t> offsets;
+		std::vector<uint32_t> sourceIndices;
+		std::vector<float> weights;
+	};
+}
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	constexpr float s_lobeCount = 3.0f;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	sContributions CalculateContributions( const uint32_t i_sourceSize, const uint32_t i_resizedSize );
+	float Lanczos( const float i_x );
+}
+
+// Interface
+//==========
+
+uint32_t eae6320::Assets::MipMaps::CalculateMipLevelCount( const uint32_t i_width, const uint32_t i_height )
+{
+	uint32_t mipLevelCount = 1;
+	for ( auto size = std::max( i_width, i_height ); size > 1; size /= 2 )
+	{
+		++mipLevelCount;
+	}
+	return mipLevelCount;
+}
+
+void eae6320::Assets::MipMaps::Resize( const sImage& i_image, const uint32_t i_width, const uint32_t i_height, sImage& o_image )
+{
+	const auto sourceWidth = i_image.width;
+	const auto sourceHeight = i_image.height;
+	const auto contributions_horizontal = CalculateContributions( sourceWidth, i_width );
+	const auto contributions_vertical = CalculateContributions( sourceHeight, i_height );
+
+	// Resize each row (from the source image with premultiplied alpha)
+	std::vector<float> resizedRows( static_cast<size_t>( i_width ) * sourceHeight * 4 );
+	ParallelFor( sourceHeight, [&]( const size_t i_y )
+	{
+		const auto* const sourceRow = i_image.GetPixel( 0, static_cast<uint32_t>( i_y ) );
+		auto* const resizedRow = resizedRows.data() + ( i_y * i_width * 4 );
+		for ( uint32_t x = 0; x < i_width; ++x )
+		{
+			float pixel[4] = {};
+			for ( auto i = contributions_horizontal.offsets[x]; i < contributions_horizontal.offsets[x + 1]; ++i )
+			{
+				const auto* const sourcePixel = sourceRow + ( contributions_horizontal.sourceIndices[i] * 4 );
+				const auto weight = contributions_horizontal.weights[i];
+				const auto weight_premultiplied = weight * ( sourcePixel[3] * ( 1.0f / 255.0f ) );
+				pixel[0] += sourcePixel[0] * weight_premultiplied;
+				pixel[1] += sourcePixel[1] * weight_premultiplied;
+				pixel[2] += sourcePixel[2] * weight_premultiplied;
+				pixel[3] += sourcePixel[3] * weight;
+			}
+			std::copy( pixel, pixel + 4, resizedRow + ( x * 4 ) );
+		}
+	} );
+	// Resize each column of the resized rows
+	// (and undo the alpha premultiplication)
+	o_image.Resize( i_width, i_height );
+	ParallelFor( i_height, [&]( const size_t i_y )
+	{
+		const auto begin = contributions_vertical.offsets[i_y];
+		const auto end = contributions_vertical.offsets[i_y + 1];
+		for ( uint32_t x = 0; x < i_width; ++x )
+		{
+			float pixel[4] = {};
+			for ( auto i = begin; i < end; ++i )
+			{
+				const auto* const sourcePixel = resizedRows.data() + ( ( ( static_cast<size_t>( contributions_vertical.sourceIndices[i] ) * i_width ) + x ) * 4 );
+				const auto weight = contributions_vertical.weights[i];
+				for ( unsigned int c = 0; c < 4; ++c )
+				{
+					pixel[c] += sourcePixel[c] * weight;
+				}
+			}
+			// The negative lobes of the filter can overshoot
+			const auto alpha = std::min( std::max( pixel[3], 0.0f ), 255.0f );
+			const auto unpremultiplier = ( alpha > 0.0f ) ? ( 255.0f / alpha ) : 0.0f;
+			auto* const resizedPixel = o_image.GetPixel( x, static_cast<uint32_t>( i_y ) );
+			for ( unsigned int c = 0; c < 3; ++c )
+			{
+				resizedPixel[c] = static_cast<uint8_t>( std::min( std::max( pixel[c] * unpremultiplier, 0.0f ), 255.0f ) + 0.5f );
+			}
+			resizedPixel[3] = static_cast<uint8_t>( alpha + 0.5f );
+		}
+	} );
+}
+
+void eae6320::Assets::MipMaps::Generate( sImage&& i_image, std::vector<sImage>& o_mipMaps )
+{
+	const auto mipLevelCount = CalculateMipLevelCount( i_image.width, i_image.height );
+	o_mipMaps.clear();
+	o_mipMaps.reserve( mipLevelCount );
+	o_mipMaps.push_back( std::move( i_image ) );
+	// Each level is filtered from the previous one
+	// (filtering every level from the first one would be sharper but much slower)
+	for ( uint32_t i = 1; i < mipLevelCount; ++i )
+	{
+		sImage mipMap;
+		{
+			const auto& previousMipMap = o_mipMaps.back();
+			Resize( previousMipMap, std::max( previousMipMap.width / 2, 1u ), std::max( previousMipMap.height / 2, 1u ), mipMap );
+		}
+		o_mipMaps.push_back( std::move( mipMap ) );
+	}
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	sContributions CalculateContributions( const uint32_t i_sourceSize, const uint32_t i_resizedSize )
+	{
+		sContributions contributions;
+		contributions.offsets.reserve( i_resizedSize + 1 );
+		// When an image is made smaller the filter is widened
+		// so that every source pixel contributes
+		const auto scale = static_cast<float>( i_sourceSize ) / static_cast<float>( i_resizedSize );
+		const auto filterScale = std::max( scale, 1.0f );
+		const auto radius = s_lobeCount * filterScale;
+		for ( uint32_t i = 0; i < i_resizedSize; ++i )
+		{
+			contributions.offsets.push_back( contributions.weights.size() );
+			// The center of the resized pixel in source pixel coordinates
+			const auto center = ( static_cast<float>( i ) + 0.5f ) * scale;
+			const auto first = static_cast<int>( std::floor( center - radius ) );
+			const auto last = static_cast<int>( std::ceil( center + radius ) );
+			auto weightSum = 0.0f;
+			const auto firstContribution = contributions.weights.size();
+			for ( auto j = first; j <= last; ++j )
+			{
+				const auto weight = Lanczos( ( ( static_cast<float>( j ) + 0.5f ) - center ) / filterScale );
+				if ( weight == 0.0f )
+				{
+					continue;
+				}
+				const auto sourceIndex = static_cast<uint32_t>( std::min( std::max( j, 0 ), static_cast<int>( i_sourceSize ) - 1 ) );
+				contributions.sourceIndices.push_back( sourceIndex );
+				contributions.weights.push_back( weight );
+				weightSum += weight;
+			}
+			// The weights must add up to one so that a solid color stays the same
+			for ( auto j = firstContribution; j < contributions.weights.size(); ++j )
+			{
+				contributions.weights[j] /= weightSum;
+			}
+		}
+		contributions.offsets.push_back( contributions.weights.size() );
+		return contributions;
+	}
+
+	float Lanczos( const float i_x )
+	{
+		const auto x = std::abs( i_x );
+		if ( x < 1.0e-6f )
+		{
+			return 1.0f;
+		}
+		if ( x >= s_lobeCount )
+		{
+			return 0.0f;
+		}
+		constexpr auto pi = 3.14159265358979f;
+		const auto piX = pi * x;
+		return ( s_lobeCount * std::sin( piX ) * std::sin( piX / s_lobeCount ) ) / ( piX * piX );
+	}
+}
@@ -0,0 +1,43 @@
+/*
+	MIP maps are smaller versions of a texture that the GPU uses when the texture is far away:
+		* Each MIP level is half the size of the previous one (rounded down) until it is 1x1
+		* Images are resized with a Lanczos filter (three lobes),
+			which keeps much more detail than averaging each 2x2 square of pixels
+			without making the smaller levels blurry
+		* Colors are filtered with premultiplied alpha
+			so that the colors of transparent pixels don't bleed into the visible ones
+		* Pixels outside of the image are treated as if they were the closest edge pixel
+*/
+
+#ifndef EAE6320_TEXTUREBUILDER_MIPMAPS_H
+#define EAE6320_TEXTUREBUILDER_MIPMAPS_H
+
+// Include Files
+//==============
+
+#include "sImage.h"
+
+#include <cstdint>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace MipMaps
+		{
+			uint32_t CalculateMipLevelCount( const uint32_t i_width, const uint32_t i_height );
+
+			// The rows of the image are filtered on every hardware thread
+			void Resize( const sImage& i_image, const uint32_t i_width, const uint32_t i_height, sImage& o_image );
+
+			// The first MIP map is the given image
+			void Generate( sImage&& i_image, std::vector<sImage>& o_mipMaps );
+		}
+	}
+}
+
+#endif	// EAE6320_TEXTUREBUILDER_MIPMAPS_H
@@ -0,0 +1,41 @@
+// Include Files
+//==============
+
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Interface
+//==========
+
+void eae6320::Assets::ParallelFor( const size_t i_count, const std::function<void( const size_t i_index )>& i_function )
+{
+	std::atomic<size_t> nextIndex( 0 );
+	const auto DoWork = [&nextIndex, i_count, &i_function]()
+	{
+		for ( auto index = nextIndex++; index < i_count; index = nextIndex++ )
+		{
+			i_function( index );
+		}
+	};
+
+	// hardware_concurrency() can return zero if the count isn't known
+	const auto threadCount = static_cast<size_t>( std::max( std::thread::hardware_concurrency(), 1u ) );
+	std::vector<std::thread> otherThreads;
+	{
+		const auto otherThreadCount = std::min( threadCount, i_count ) - ( ( i_count > 0 ) ? 1 : 0 );
+		otherThreads.reserve( otherThreadCount );
+		for ( size_t i = 0; i < otherThreadCount; ++i )
+		{
+			otherThreads.emplace_back( DoWork );
+		}
+	}
+	DoWork();
+	for ( auto& otherThread : otherThreads )
+	{
+		otherThread.join();
+	}
+}
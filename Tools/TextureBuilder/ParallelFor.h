@@ -0,0 +1,32 @@
+/*
+	The texture builder's expensive steps (generating MIP maps and compressing blocks)
+	do the same work independently for many rows or blocks,
+	and so they are split between every hardware thread
+*/
+
+#ifndef EAE6320_TEXTUREBUILDER_PARALLELFOR_H
+#define EAE6320_TEXTUREBUILDER_PARALLELFOR_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <functional>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		// The function is called once for every index in [0, i_count)
+		// from as many threads as the hardware has (including the calling thread),
+		// and this returns when every call has returned.
+		// The indices are handed out in order, one at a time,
+		// and so each one should be a reasonable amount of work (e.g. a row rather than a pixel)
+		void ParallelFor( const size_t i_count, const std::function<void( const size_t i_index )>& i_function );
+	}
+}
+
+#endif	// EAE6320_TEXTUREBUILDER_PARALLELFOR_H
@@ -0,0 +1,935 @@
+// Include Files
+//==============
+
+#include "PngDecoder.h"
+
+#include "sImage.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+	// Deflate streams are read starting with the least significant bit of each byte
+	class cBitReader
+	{
+	public:
+
+		uint32_t ReadBits( const unsigned int i_bitCount );
+		uint32_t PeekBits( const unsigned int i_bitCount );
+		void ConsumeBits( const unsigned int i_bitCount );
+		void SkipToNextByte();
+		// Reading past the end of the data returns zeros,
+		// and so this must be checked to know whether the stream was truncated
+		bool HasReadPastEnd() const { return ( ( m_position * 8 ) - m_bitCount ) > ( m_size * 8 ); }
+
+		cBitReader( const uint8_t* const i_data, const size_t i_size ) : m_data( i_data ), m_size( i_size ) {}
+
+	private:
+
+		void Refill();
+
+		const uint8_t* const m_data;
+		const size_t m_size;
+		size_t m_position = 0;
+		uint64_t m_bits = 0;
+		unsigned int m_bitCount = 0;
+	};
+
+	struct sHuffmanTable
+	{
+		// Codes that are this short are decoded with a single lookup,
+		// and longer ones are decoded one bit at a time
+		static constexpr unsigned int FastBitCount = 9;
+		// Each entry is the symbol shifted left by 4 bits and the code length,
+		// or zero if the code is longer than FastBitCount
+		uint16_t fastLookup[1u << FastBitCount];
+		// How many codes have each length
+		uint16_t counts[16];
+		// The symbols sorted by their codes
+		uint16_t symbols[288];
+	};
+
+	struct sPngHeader
+	{
+		uint32_t width = 0, height = 0;
+		uint8_t bitDepth = 0;
+		uint8_t colorType = 0;
+		uint8_t interlaceMethod = 0;
+	};
+
+	struct sPngPalette
+	{
+		uint8_t colors[256][4];
+		unsigned int colorCount = 0;
+		// For gray and RGB images a tRNS chunk specifies a single color that is transparent
+		bool hasTransparentColor = false;
+		uint16_t transparentColor[3] = {};
+	};
+
+	// Adam7 interlacing stores seven smaller images one after the other,
+	// each of which has every dx-th pixel of every dy-th row starting at (x, y)
+	struct sAdam7Pass
+	{
+		uint32_t x, y, dx, dy;
+	};
+}
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	constexpr uint8_t s_pngSignature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+
+	namespace ColorTypes
+	{
+		enum eColorType : uint8_t
+		{
+			Gray = 0,
+			Rgb = 2,
+			Palette = 3,
+			GrayAlpha = 4,
+			Rgba = 6,
+		};
+	}
+
+	// Deflate
+	constexpr uint16_t s_lengthBases[] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	constexpr uint8_t s_lengthExtraBits[] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	constexpr uint16_t s_distanceBases[] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+		4097, 6145, 8193, 12289, 16385, 24577 };
+	constexpr uint8_t s_distanceExtraBits[] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+	constexpr uint8_t s_codeLengthOrder[] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+	constexpr unsigned int s_endOfBlockSymbol = 256;
+
+	// PNG
+	constexpr sAdam7Pass s_adam7Passes[] = { { 0, 0, 8, 8 }, { 4, 0, 8, 8 }, { 0, 4, 4, 8 }, { 2, 0, 4, 4 }, { 0, 2, 2, 4 }, { 1, 0, 2, 2 }, { 0, 1, 1, 2 } };
+	// Images with more pixels than this are rejected before any memory is allocated for them
+	// (it is the size of the largest 2D texture that Direct3D 11 supports)
+	constexpr uint64_t s_maxPixelCount = uint64_t( 16384 ) * 16384;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Deflate
+	bool BuildHuffmanTable( const uint8_t* const i_codeLengths, const unsigned int i_symbolCount, sHuffmanTable& o_table );
+	bool DecodeSymbol( cBitReader& io_bitReader, const sHuffmanTable& i_table, unsigned int& o_symbol );
+	bool InflateBlock( cBitReader& io_bitReader, const sHuffmanTable& i_literalLengthTable, const sHuffmanTable& i_distanceTable,
+		std::vector<uint8_t>& io_data, std::string& o_errorMessage );
+	bool InflateZlibStream( const uint8_t* const i_data, const size_t i_size, std::vector<uint8_t>& o_data, std::string& o_errorMessage );
+	bool ReadDynamicHuffmanTables( cBitReader& io_bitReader, sHuffmanTable& o_literalLengthTable, sHuffmanTable& o_distanceTable,
+		std::string& o_errorMessage );
+
+	// PNG
+	void GetAdam7PassSize( const sPngHeader& i_header, const sAdam7Pass& i_pass, uint32_t& o_width, uint32_t& o_height );
+	unsigned int GetChannelCount( const uint8_t i_colorType );
+	// This is how many bytes the decompressed data must have for the header's size, bit depth, and interlacing
+	uint64_t GetFilteredDataSize( const sPngHeader& i_header );
+	size_t GetRowSize( const sPngHeader& i_header, const uint32_t i_width );
+	uint32_t ReadBigEndian32( const uint8_t* const i_data );
+	uint16_t ReadSample( const uint8_t* const i_row, const size_t i_sampleIndex, const uint8_t i_bitDepth );
+	void ConvertRow( const sPngHeader& i_header, const sPngPalette& i_palette, const uint8_t* const i_row, const uint32_t i_width,
+		uint8_t* o_pixels, const size_t i_pixelStride );
+	bool UnfilterRows( const sPngHeader& i_header, const uint32_t i_width, const uint32_t i_height,
+		uint8_t* io_data, const size_t i_size, std::string& o_errorMessage );
+}
+
+// Interface
+//==========
+
+bool eae6320::Assets::PngDecoder::IsPng( const void* const i_data, const size_t i_size )
+{
+	return ( i_size >= sizeof( s_pngSignature ) ) && ( memcmp( i_data, s_pngSignature, sizeof( s_pngSignature ) ) == 0 );
+}
+
+eae6320::cResult eae6320::Assets::PngDecoder::Decode( const void* const i_data, const size_t i_size, sImage& o_image, std::string* const o_errorMessage )
+{
+	std::string errorMessage;
+	sPngHeader header;
+	sPngPalette palette;
+	std::vector<uint8_t> compressedData;
+	std::vector<uint8_t> filteredData;
+
+	if ( !IsPng( i_data, i_size ) )
+	{
+		errorMessage = "The file doesn't start with the PNG signature";
+		goto OnError;
+	}
+	// Read the chunks
+	{
+		const auto* const data = static_cast<const uint8_t*>( i_data );
+		auto hasHeaderBeenRead = false;
+		auto hasEndBeenRead = false;
+		// Each chunk is its length, its type, its data, and a CRC
+		constexpr size_t chunkOverheadSize = 4 + 4 + 4;
+		for ( auto offset = sizeof( s_pngSignature ); !hasEndBeenRead; )
+		{
+			if ( ( i_size - offset ) < chunkOverheadSize )
+			{
+				errorMessage = "The file ends before the IEND chunk";
+				goto OnError;
+			}
+			const auto chunkSize = static_cast<size_t>( ReadBigEndian32( data + offset ) );
+			const auto* const chunkType = data + offset + 4;
+			const auto* const chunkData = chunkType + 4;
+			if ( chunkSize > ( i_size - offset - chunkOverheadSize ) )
+			{
+				errorMessage = "A chunk is bigger than the rest of the file";
+				goto OnError;
+			}
+			offset += chunkOverheadSize + chunkSize;
+
+			if ( memcmp( chunkType, "IHDR", 4 ) == 0 )
+			{
+				if ( chunkSize < 13 )
+				{
+					errorMessage = "The IHDR chunk is too small";
+					goto OnError;
+				}
+				header.width = ReadBigEndian32( chunkData );
+				header.height = ReadBigEndian32( chunkData + 4 );
+				header.bitDepth = chunkData[8];
+				header.colorType = chunkData[9];
+				header.interlaceMethod = chunkData[12];
+				const auto compressionMethod = chunkData[10];
+				const auto filterMethod = chunkData[11];
+				auto isBitDepthValid = false;
+				switch ( header.colorType )
+				{
+				case ColorTypes::Gray:
+					isBitDepthValid = ( header.bitDepth == 1 ) || ( header.bitDepth == 2 ) || ( header.bitDepth == 4 )
+						|| ( header.bitDepth == 8 ) || ( header.bitDepth == 16 );
+					break;
+				case ColorTypes::Palette:
+					isBitDepthValid = ( header.bitDepth == 1 ) || ( header.bitDepth == 2 ) || ( header.bitDepth == 4 ) || ( header.bitDepth == 8 );
+					break;
+				case ColorTypes::Rgb:
+				case ColorTypes::GrayAlpha:
+				case ColorTypes::Rgba:
+					isBitDepthValid = ( header.bitDepth == 8 ) || ( header.bitDepth == 16 );
+					break;
+				}
+				if ( ( header.width == 0 ) || ( header.height == 0 ) || !isBitDepthValid
+					|| ( compressionMethod != 0 ) || ( filterMethod != 0 ) || ( header.interlaceMethod > 1 ) )
+				{
+					std::ostringstream stream;
+					stream << "The IHDR chunk is invalid (" << header.width << "x" << header.height
+						<< ", bit depth " << static_cast<unsigned int>( header.bitDepth )
+						<< ", color type " << static_cast<unsigned int>( header.colorType ) << ")";
+					errorMessage = stream.str();
+					goto OnError;
+				}
+				hasHeaderBeenRead = true;
+			}
+			else if ( !hasHeaderBeenRead )
+			{
+				errorMessage = "The first chunk isn't IHDR";
+				goto OnError;
+			}
+			else if ( memcmp( chunkType, "PLTE", 4 ) == 0 )
+			{
+				palette.colorCount = static_cast<unsigned int>( chunkSize / 3 );
+				if ( ( ( chunkSize % 3 ) != 0 ) || ( palette.colorCount > 256 ) )
+				{
+					errorMessage = "The PLTE chunk is invalid";
+					goto OnError;
+				}
+				for ( unsigned int i = 0; i < palette.colorCount; ++i )
+				{
+					palette.colors[i][0] = chunkData[( i * 3 ) + 0];
+					palette.colors[i][1] = chunkData[( i * 3 ) + 1];
+					palette.colors[i][2] = chunkData[( i * 3 ) + 2];
+					palette.colors[i][3] = 0xff;
+				}
+			}
+			else if ( memcmp( chunkType, "tRNS", 4 ) == 0 )
+			{
+				if ( header.colorType == ColorTypes::Palette )
+				{
+					for ( size_t i = 0; ( i < chunkSize ) && ( i < palette.colorCount ); ++i )
+					{
+						palette.colors[i][3] = chunkData[i];
+					}
+				}
+				else if ( ( header.colorType == ColorTypes::Gray ) || ( header.colorType == ColorTypes::Rgb ) )
+				{
+					const auto channelCount = GetChannelCount( header.colorType );
+					if ( chunkSize >= ( channelCount * 2 ) )
+					{
+						palette.hasTransparentColor = true;
+						for ( unsigned int i = 0; i < channelCount; ++i )
+						{
+							palette.transparentColor[i] = static_cast<uint16_t>( ( chunkData[i * 2] << 8 ) | chunkData[( i * 2 ) + 1] );
+						}
+					}
+				}
+			}
+			else if ( memcmp( chunkType, "IDAT", 4 ) == 0 )
+			{
+				compressedData.insert( compressedData.end(), chunkData, chunkData + chunkSize );
+			}
+			else if ( memcmp( chunkType, "IEND", 4 ) == 0 )
+			{
+				hasEndBeenRead = true;
+			}
+			// Any other chunks are ignored
+		}
+		if ( ( header.colorType == ColorTypes::Palette ) && ( palette.colorCount == 0 ) )
+		{
+			errorMessage = "The image uses a palette but doesn't have a PLTE chunk";
+			goto OnError;
+		}
+	}
+	// Decompress the rows
+	if ( !InflateZlibStream( compressedData.data(), compressedData.size(), filteredData, errorMessage ) )
+	{
+		goto OnError;
+	}
+	// Make sure that the header's size is sane and matches the decompressed data
+	// before allocating the image
+	// (a damaged header could otherwise ask for far more memory than there is)
+	if ( ( uint64_t( header.width ) * header.height ) > s_maxPixelCount )
+	{
+		std::ostringstream stream;
+		stream << "The image is too big (" << header.width << "x" << header.height << " is more than " << s_maxPixelCount << " pixels)";
+		errorMessage = stream.str();
+		goto OnError;
+	}
+	{
+		const auto requiredSize = GetFilteredDataSize( header );
+		if ( filteredData.size() < requiredSize )
+		{
+			std::ostringstream stream;
+			stream << "The decompressed image data is too small (" << filteredData.size() << " bytes, but a " << header.width << "x" << header.height
+				<< " image needs " << requiredSize << ")";
+			errorMessage = stream.str();
+			goto OnError;
+		}
+	}
+	// Convert the rows to RGBA
+	o_image.Resize( header.width, header.height );
+	if ( header.interlaceMethod == 0 )
+	{
+		if ( !UnfilterRows( header, header.width, header.height, filteredData.data(), filteredData.size(), errorMessage ) )
+		{
+			goto OnError;
+		}
+		const auto rowSize = GetRowSize( header, header.width );
+		for ( uint32_t y = 0; y < header.height; ++y )
+		{
+			// Each row starts with a byte that says how it was filtered
+			const auto* const row = filteredData.data() + ( y * ( rowSize + 1 ) ) + 1;
+			ConvertRow( header, palette, row, header.width, o_image.GetPixel( 0, y ), 4 );
+		}
+	}
+	else
+	{
+		size_t offset = 0;
+		for ( const auto& pass : s_adam7Passes )
+		{
+			uint32_t passWidth, passHeight;
+			GetAdam7PassSize( header, pass, passWidth, passHeight );
+			if ( ( passWidth == 0 ) || ( passHeight == 0 ) )
+			{
+				continue;
+			}
+			if ( !UnfilterRows( header, passWidth, passHeight, filteredData.data() + offset, filteredData.size() - offset, errorMessage ) )
+			{
+				goto OnError;
+			}
+			const auto rowSize = GetRowSize( header, passWidth );
+			for ( uint32_t y = 0; y < passHeight; ++y )
+			{
+				const auto* const row = filteredData.data() + offset + ( y * ( rowSize + 1 ) ) + 1;
+				ConvertRow( header, palette, row, passWidth, o_image.GetPixel( pass.x, pass.y + ( y * pass.dy ) ), pass.dx * 4 );
+			}
+			offset += passHeight * ( rowSize + 1 );
+		}
+	}
+
+	return Results::Success;
+
+OnError:
+
+	if ( o_errorMessage )
+	{
+		*o_errorMessage = errorMessage;
+	}
+	return Results::InvalidFile;
+}
+
+// Helper Class Definition
+//========================
+
+namespace
+{
+	uint32_t cBitReader::ReadBits( const unsigned int i_bitCount )
+	{
+		const auto bits = PeekBits( i_bitCount );
+		ConsumeBits( i_bitCount );
+		return bits;
+	}
+
+	uint32_t cBitReader::PeekBits( const unsigned int i_bitCount )
+	{
+		if ( m_bitCount < i_bitCount )
+		{
+			Refill();
+		}
+		return static_cast<uint32_t>( m_bits & ( ( uint64_t( 1 ) << i_bitCount ) - 1 ) );
+	}
+
+	void cBitReader::ConsumeBits( const unsigned int i_bitCount )
+	{
+		m_bits >>= i_bitCount;
+		m_bitCount -= i_bitCount;
+	}
+
+	void cBitReader::SkipToNextByte()
+	{
+		ConsumeBits( m_bitCount % 8 );
+	}
+
+	void cBitReader::Refill()
+	{
+		while ( m_bitCount <= 56 )
+		{
+			const uint64_t byte = ( m_position < m_size ) ? m_data[m_position] : 0;
+			m_bits |= byte << m_bitCount;
+			m_bitCount += 8;
+			++m_position;
+		}
+	}
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	// Deflate
+	//--------
+
+	bool BuildHuffmanTable( const uint8_t* const i_codeLengths, const unsigned int i_symbolCount, sHuffmanTable& o_table )
+	{
+		memset( &o_table, 0, sizeof( o_table ) );
+		for ( unsigned int i = 0; i < i_symbolCount; ++i )
+		{
+			++o_table.counts[i_codeLengths[i]];
+		}
+		o_table.counts[0] = 0;
+		// A set of code lengths that has too many codes can't be decoded
+		// (one with too few is allowed, e.g. a distance table with a single code)
+		{
+			int codesLeft = 1;
+			for ( unsigned int length = 1; length < 16; ++length )
+			{
+				codesLeft = ( codesLeft * 2 ) - o_table.counts[length];
+				if ( codesLeft < 0 )
+				{
+					return false;
+				}
+			}
+		}
+		// Sort the symbols by their codes
+		// and fill in the lookup table with every short code
+		{
+			uint16_t offsets[16] = {};
+			uint16_t nextCodes[16] = {};
+			{
+				uint16_t code = 0;
+				for ( unsigned int length = 1; length < 16; ++length )
+				{
+					offsets[length] = static_cast<uint16_t>( offsets[length - 1] + o_table.counts[length - 1] );
+					code = static_cast<uint16_t>( ( code + o_table.counts[length - 1] ) << 1 );
+					nextCodes[length] = code;
+				}
+			}
+			for ( unsigned int symbol = 0; symbol < i_symbolCount; ++symbol )
+			{
+				const auto length = i_codeLengths[symbol];
+				if ( length == 0 )
+				{
+					continue;
+				}
+				o_table.symbols[offsets[length]++] = static_cast<uint16_t>( symbol );
+				const auto code = nextCodes[length]++;
+				if ( length <= sHuffmanTable::FastBitCount )
+				{
+					// The codes are stored starting with their most significant bit,
+					// and so they must be reversed to match the order that bits are read
+					unsigned int reversedCode = 0;
+					for ( unsigned int i = 0; i < length; ++i )
+					{
+						reversedCode |= ( ( code >> i ) & 1u ) << ( length - 1 - i );
+					}
+					for ( auto i = reversedCode; i < ( 1u << sHuffmanTable::FastBitCount ); i += ( 1u << length ) )
+					{
+						o_table.fastLookup[i] = static_cast<uint16_t>( ( symbol << 4 ) | length );
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	bool DecodeSymbol( cBitReader& io_bitReader, const sHuffmanTable& i_table, unsigned int& o_symbol )
+	{
+		const auto entry = i_table.fastLookup[io_bitReader.PeekBits( sHuffmanTable::FastBitCount )];
+		if ( entry != 0 )
+		{
+			io_bitReader.ConsumeBits( entry & 0xfu );
+			o_symbol = entry >> 4;
+			return true;
+		}
+		// Longer codes are decoded one bit at a time
+		int code = 0, firstCode = 0, index = 0;
+		for ( unsigned int length = 1; length < 16; ++length )
+		{
+			code |= static_cast<int>( io_bitReader.ReadBits( 1 ) );
+			const int count = i_table.counts[length];
+			if ( ( code - count ) < firstCode )
+			{
+				o_symbol = i_table.symbols[index + ( code - firstCode )];
+				return true;
+			}
+			index += count;
+			firstCode = ( firstCode + count ) << 1;
+			code <<= 1;
+		}
+		return false;
+	}
+
+	bool InflateBlock( cBitReader& io_bitReader, const sHuffmanTable& i_literalLengthTable, const sHuffmanTable& i_distanceTable,
+		std::vector<uint8_t>& io_data, std::string& o_errorMessage )
+	{
+		while ( true )
+		{
+			unsigned int symbol;
+			if ( !DecodeSymbol( io_bitReader, i_literalLengthTable, symbol ) )
+			{
+				o_errorMessage = "The compressed data has an invalid literal/length code";
+				return false;
+			}
+			if ( symbol < s_endOfBlockSymbol )
+			{
+				io_data.push_back( static_cast<uint8_t>( symbol ) );
+			}
+			else if ( symbol == s_endOfBlockSymbol )
+			{
+				return true;
+			}
+			else
+			{
+				// Copy a previous sequence of bytes
+				const auto lengthIndex = symbol - ( s_endOfBlockSymbol + 1 );
+				if ( lengthIndex >= ( sizeof( s_lengthBases ) / sizeof( s_lengthBases[0] ) ) )
+				{
+					o_errorMessage = "The compressed data has an invalid length code";
+					return false;
+				}
+				const auto length = s_lengthBases[lengthIndex] + io_bitReader.ReadBits( s_lengthExtraBits[lengthIndex] );
+				unsigned int distanceIndex;
+				if ( !DecodeSymbol( io_bitReader, i_distanceTable, distanceIndex )
+					|| ( distanceIndex >= ( sizeof( s_distanceBases ) / sizeof( s_distanceBases[0] ) ) ) )
+				{
+					o_errorMessage = "The compressed data has an invalid distance code";
+					return false;
+				}
+				const auto distance = s_distanceBases[distanceIndex] + io_bitReader.ReadBits( s_distanceExtraBits[distanceIndex] );
+				if ( distance > io_data.size() )
+				{
+					o_errorMessage = "The compressed data refers to bytes before the start of the data";
+					return false;
+				}
+				// The sequence can overlap the bytes that are being written
+				// (e.g. a distance of 1 repeats the last byte),
+				// and so the bytes are copied one at a time
+				auto source = io_data.size() - distance;
+				io_data.resize( io_data.size() + length );
+				auto* const data = io_data.data();
+				for ( auto destination = io_data.size() - length; destination < io_data.size(); ++destination, ++source )
+				{
+					data[destination] = data[source];
+				}
+			}
+			if ( io_bitReader.HasReadPastEnd() )
+			{
+				o_errorMessage = "The compressed data ends in the middle of a block";
+				return false;
+			}
+		}
+	}
+
+	bool InflateZlibStream( const uint8_t* const i_data, const size_t i_size, std::vector<uint8_t>& o_data, std::string& o_errorMessage )
+	{
+		// The zlib header is 2 bytes
+		// (the Adler-32 checksum at the end isn't checked)
+		if ( ( i_size < 2 ) || ( ( i_data[0] & 0x0f ) != 8 ) || ( ( ( ( i_data[0] << 8 ) | i_data[1] ) % 31 ) != 0 ) || ( ( i_data[1] & 0x20 ) != 0 ) )
+		{
+			o_errorMessage = "The image data doesn't have a valid zlib header";
+			return false;
+		}
+		cBitReader bitReader( i_data + 2, i_size - 2 );
+		o_data.clear();
+		auto isFinalBlock = false;
+		while ( !isFinalBlock )
+		{
+			isFinalBlock = bitReader.ReadBits( 1 ) != 0;
+			const auto blockType = bitReader.ReadBits( 2 );
+			if ( blockType == 0 )
+			{
+				// The block is stored without compression
+				bitReader.SkipToNextByte();
+				const auto length = bitReader.ReadBits( 16 );
+				const auto length_complement = bitReader.ReadBits( 16 );
+				if ( ( length ^ 0xffff ) != length_complement )
+				{
+					o_errorMessage = "An uncompressed block has an invalid length";
+					return false;
+				}
+				for ( uint32_t i = 0; i < length; ++i )
+				{
+					o_data.push_back( static_cast<uint8_t>( bitReader.ReadBits( 8 ) ) );
+				}
+			}
+			else if ( blockType == 1 )
+			{
+				// The block uses the predefined Huffman codes
+				struct sFixedTables
+				{
+					sHuffmanTable literalLength, distance;
+					sFixedTables()
+					{
+						uint8_t codeLengths[288];
+						memset( codeLengths + 0, 8, 144 );
+						memset( codeLengths + 144, 9, 256 - 144 );
+						memset( codeLengths + 256, 7, 280 - 256 );
+						memset( codeLengths + 280, 8, 288 - 280 );
+						BuildHuffmanTable( codeLengths, 288, literalLength );
+						memset( codeLengths, 5, 30 );
+						BuildHuffmanTable( codeLengths, 30, distance );
+					}
+				};
+				static const sFixedTables s_fixedTables;
+				if ( !InflateBlock( bitReader, s_fixedTables.literalLength, s_fixedTables.distance, o_data, o_errorMessage ) )
+				{
+					return false;
+				}
+			}
+			else if ( blockType == 2 )
+			{
+				sHuffmanTable literalLengthTable, distanceTable;
+				if ( !ReadDynamicHuffmanTables( bitReader, literalLengthTable, distanceTable, o_errorMessage )
+					|| !InflateBlock( bitReader, literalLengthTable, distanceTable, o_data, o_errorMessage ) )
+				{
+					return false;
+				}
+			}
+			else
+			{
+				o_errorMessage = "The compressed data has an invalid block type";
+				return false;
+			}
+			if ( bitReader.HasReadPastEnd() )
+			{
+				o_errorMessage = "The compressed data is truncated";
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool ReadDynamicHuffmanTables( cBitReader& io_bitReader, sHuffmanTable& o_literalLengthTable, sHuffmanTable& o_distanceTable,
+		std::string& o_errorMessage )
+	{
+		const auto literalLengthCount = io_bitReader.ReadBits( 5 ) + 257;
+		const auto distanceCount = io_bitReader.ReadBits( 5 ) + 1;
+		const auto codeLengthCount = io_bitReader.ReadBits( 4 ) + 4;
+		if ( ( literalLengthCount > 286 ) || ( distanceCount > 30 ) )
+		{
+			o_errorMessage = "A block has too many Huffman codes";
+			return false;
+		}
+		// The code lengths are themselves Huffman coded
+		sHuffmanTable codeLengthTable;
+		{
+			uint8_t codeLengthCodeLengths[19] = {};
+			for ( uint32_t i = 0; i < codeLengthCount; ++i )
+			{
+				codeLengthCodeLengths[s_codeLengthOrder[i]] = static_cast<uint8_t>( io_bitReader.ReadBits( 3 ) );
+			}
+			if ( !BuildHuffmanTable( codeLengthCodeLengths, 19, codeLengthTable ) )
+			{
+				o_errorMessage = "A block has invalid code length codes";
+				return false;
+			}
+		}
+		uint8_t codeLengths[286 + 30] = {};
+		for ( uint32_t i = 0; i < ( literalLengthCount + distanceCount ); )
+		{
+			unsigned int symbol;
+			if ( !DecodeSymbol( io_bitReader, codeLengthTable, symbol ) )
+			{
+				o_errorMessage = "A block has an invalid code length";
+				return false;
+			}
+			if ( symbol < 16 )
+			{
+				codeLengths[i++] = static_cast<uint8_t>( symbol );
+				continue;
+			}
+			// The other symbols repeat a code length
+			uint8_t codeLength = 0;
+			uint32_t repeatCount;
+			if ( symbol == 16 )
+			{
+				if ( i == 0 )
+				{
+					o_errorMessage = "A block repeats a code length before the first one";
+					return false;
+				}
+				codeLength = codeLengths[i - 1];
+				repeatCount = 3 + io_bitReader.ReadBits( 2 );
+			}
+			else if ( symbol == 17 )
+			{
+				repeatCount = 3 + io_bitReader.ReadBits( 3 );
+			}
+			else
+			{
+				repeatCount = 11 + io_bitReader.ReadBits( 7 );
+			}
+			if ( ( i + repeatCount ) > ( literalLengthCount + distanceCount ) )
+			{
+				o_errorMessage = "A block has too many code lengths";
+				return false;
+			}
+			for ( ; repeatCount > 0; --repeatCount )
+			{
+				codeLengths[i++] = codeLength;
+			}
+		}
+		if ( codeLengths[s_endOfBlockSymbol] == 0 )
+		{
+			o_errorMessage = "A block doesn't have an end-of-block code";
+			return false;
+		}
+		if ( !BuildHuffmanTable( codeLengths, literalLengthCount, o_literalLengthTable )
+			|| !BuildHuffmanTable( codeLengths + literalLengthCount, distanceCount, o_distanceTable ) )
+		{
+			o_errorMessage = "A block has invalid Huffman codes";
+			return false;
+		}
+		return true;
+	}
+
+	// PNG
+	//----
+
+	void GetAdam7PassSize( const sPngHeader& i_header, const sAdam7Pass& i_pass, uint32_t& o_width, uint32_t& o_height )
+	{
+		o_width = ( i_header.width > i_pass.x ) ? ( ( i_header.width - i_pass.x + i_pass.dx - 1 ) / i_pass.dx ) : 0;
+		o_height = ( i_header.height > i_pass.y ) ? ( ( i_header.height - i_pass.y + i_pass.dy - 1 ) / i_pass.dy ) : 0;
+	}
+
+	unsigned int GetChannelCount( const uint8_t i_colorType )
+	{
+		switch ( i_colorType )
+		{
+		case ColorTypes::Rgb: return 3;
+		case ColorTypes::GrayAlpha: return 2;
+		case ColorTypes::Rgba: return 4;
+		default: return 1;
+		}
+	}
+
+	uint64_t GetFilteredDataSize( const sPngHeader& i_header )
+	{
+		// Each row starts with a byte that says how it was filtered
+		if ( i_header.interlaceMethod == 0 )
+		{
+			return ( uint64_t( GetRowSize( i_header, i_header.width ) ) + 1 ) * i_header.height;
+		}
+		else
+		{
+			uint64_t size = 0;
+			for ( const auto& pass : s_adam7Passes )
+			{
+				uint32_t passWidth, passHeight;
+				GetAdam7PassSize( i_header, pass, passWidth, passHeight );
+				if ( ( passWidth > 0 ) && ( passHeight > 0 ) )
+				{
+					size += ( uint64_t( GetRowSize( i_header, passWidth ) ) + 1 ) * passHeight;
+				}
+			}
+			return size;
+		}
+	}
+
+	size_t GetRowSize( const sPngHeader& i_header, const uint32_t i_width )
+	{
+		const auto bitsPerPixel = static_cast<size_t>( GetChannelCount( i_header.colorType ) ) * i_header.bitDepth;
+		return ( ( i_width * bitsPerPixel ) + 7 ) / 8;
+	}
+
+	uint32_t ReadBigEndian32( const uint8_t* const i_data )
+	{
+		return ( static_cast<uint32_t>( i_data[0] ) << 24 ) | ( static_cast<uint32_t>( i_data[1] ) << 16 )
+			| ( static_cast<uint32_t>( i_data[2] ) << 8 ) | static_cast<uint32_t>( i_data[3] );
+	}
+
+	uint16_t ReadSample( const uint8_t* const i_row, const size_t i_sampleIndex, const uint8_t i_bitDepth )
+	{
+		switch ( i_bitDepth )
+		{
+		case 8:
+			return i_row[i_sampleIndex];
+		case 16:
+			return static_cast<uint16_t>( ( i_row[i_sampleIndex * 2] << 8 ) | i_row[( i_sampleIndex * 2 ) + 1] );
+		default:
+			{
+				// Samples smaller than a byte are packed starting with the most significant bits
+				const auto bitOffset = i_sampleIndex * i_bitDepth;
+				const auto shift = 8 - i_bitDepth - ( bitOffset % 8 );
+				return static_cast<uint16_t>( ( i_row[bitOffset / 8] >> shift ) & ( ( 1u << i_bitDepth ) - 1 ) );
+			}
+		}
+	}
+
+	void ConvertRow( const sPngHeader& i_header, const sPngPalette& i_palette, const uint8_t* const i_row, const uint32_t i_width,
+		uint8_t* o_pixels, const size_t i_pixelStride )
+	{
+		const auto channelCount = GetChannelCount( i_header.colorType );
+		const auto bitDepth = i_header.bitDepth;
+		const auto ConvertSampleTo8Bits = [bitDepth]( const uint16_t i_sample ) -> uint8_t
+		{
+			if ( bitDepth == 16 )
+			{
+				return static_cast<uint8_t>( i_sample >> 8 );
+			}
+			return static_cast<uint8_t>( ( i_sample * 255u ) / ( ( 1u << bitDepth ) - 1 ) );
+		};
+		for ( uint32_t x = 0; x < i_width; ++x, o_pixels += i_pixelStride )
+		{
+			uint16_t samples[4];
+			for ( unsigned int i = 0; i < channelCount; ++i )
+			{
+				samples[i] = ReadSample( i_row, ( static_cast<size_t>( x ) * channelCount ) + i, bitDepth );
+			}
+			switch ( i_header.colorType )
+			{
+			case ColorTypes::Gray:
+				o_pixels[0] = o_pixels[1] = o_pixels[2] = ConvertSampleTo8Bits( samples[0] );
+				o_pixels[3] = ( i_palette.hasTransparentColor && ( samples[0] == i_palette.transparentColor[0] ) ) ? 0 : 0xff;
+				break;
+			case ColorTypes::Rgb:
+				o_pixels[0] = ConvertSampleTo8Bits( samples[0] );
+				o_pixels[1] = ConvertSampleTo8Bits( samples[1] );
+				o_pixels[2] = ConvertSampleTo8Bits( samples[2] );
+				o_pixels[3] = ( i_palette.hasTransparentColor && ( samples[0] == i_palette.transparentColor[0] )
+					&& ( samples[1] == i_palette.transparentColor[1] ) && ( samples[2] == i_palette.transparentColor[2] ) ) ? 0 : 0xff;
+				break;
+			case ColorTypes::Palette:
+				// An index that is outside of the palette is black
+				// (this is what libpng does)
+				if ( samples[0] < i_palette.colorCount )
+				{
+					memcpy( o_pixels, i_palette.colors[samples[0]], 4 );
+				}
+				else
+				{
+					o_pixels[0] = o_pixels[1] = o_pixels[2] = 0;
+					o_pixels[3] = 0xff;
+				}
+				break;
+			case ColorTypes::GrayAlpha:
+				o_pixels[0] = o_pixels[1] = o_pixels[2] = ConvertSampleTo8Bits( samples[0] );
+				o_pixels[3] = ConvertSampleTo8Bits( samples[1] );
+				break;
+			case ColorTypes::Rgba:
+				for ( unsigned int i = 0; i < 4; ++i )
+				{
+					o_pixels[i] = ConvertSampleTo8Bits( samples[i] );
+				}
+				break;
+			}
+		}
+	}
+
+	bool UnfilterRows( const sPngHeader& i_header, const uint32_t i_width, const uint32_t i_height,
+		uint8_t* io_data, const size_t i_size, std::string& o_errorMessage )
+	{
+		const auto rowSize = GetRowSize( i_header, i_width );
+		if ( i_size < ( ( rowSize + 1 ) * i_height ) )
+		{
+			o_errorMessage = "The decompressed image data is too small";
+			return false;
+		}
+		// Filters work on bytes, and use the corresponding byte of the previous pixel
+		// (or the previous byte if pixels are smaller than a byte)
+		const auto bytesPerPixel = std::max<size_t>( ( GetChannelCount( i_header.colorType ) * i_header.bitDepth ) / 8, 1 );
+		const uint8_t* previousRow = nullptr;
+		for ( uint32_t y = 0; y < i_height; ++y )
+		{
+			const auto filterType = io_data[0];
+			auto* const row = io_data + 1;
+			for ( size_t i = 0; i < rowSize; ++i )
+			{
+				const unsigned int left = ( i >= bytesPerPixel ) ? row[i - bytesPerPixel] : 0;
+				const unsigned int above = previousRow ? previousRow[i] : 0;
+				const unsigned int aboveLeft = ( previousRow && ( i >= bytesPerPixel ) ) ? previousRow[i - bytesPerPixel] : 0;
+				unsigned int prediction;
+				switch ( filterType )
+				{
+				case 0: prediction = 0; break;
+				case 1: prediction = left; break;
+				case 2: prediction = above; break;
+				case 3: prediction = ( left + above ) / 2; break;
+				case 4:
+					{
+						const auto estimate = static_cast<int>( left + above ) - static_cast<int>( aboveLeft );
+						const auto distance_left = std::abs( estimate - static_cast<int>( left ) );
+						const auto distance_above = std::abs( estimate - static_cast<int>( above ) );
+						const auto distance_aboveLeft = std::abs( estimate - static_cast<int>( aboveLeft ) );
+						if ( ( distance_left <= distance_above ) && ( distance_left <= distance_aboveLeft ) )
+						{
+							prediction = left;
+						}
+						else if ( distance_above <= distance_aboveLeft )
+						{
+							prediction = above;
+						}
+						else
+						{
+							prediction = aboveLeft;
+						}
+					}
+					break;
+				default:
+					{
+						std::ostringstream stream;
+						stream << "Row " << y << " has an invalid filter type (" << static_cast<unsigned int>( filterType ) << ")";
+						o_errorMessage = stream.str();
+						return false;
+					}
+				}
+				row[i] = static_cast<uint8_t>( row[i] + prediction );
+			}
+			previousRow = row;
+			io_data += rowSize + 1;
+		}
+		return true;
+	}
+}
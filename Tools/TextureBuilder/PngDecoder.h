@@ -0,0 +1,49 @@
+/*
+	The PNG decoder turns a PNG file into an RGBA image
+	without depending on any platform-specific image library:
+		* Every color type and bit depth (including palettes, transparency chunks, and interlacing) is supported
+		* 16-bit channels are reduced to 8 bits and gray channels are copied into red, green, and blue
+		* Color space chunks (e.g. gAMA or iCCP) are ignored,
+			since the renderer isn't gamma-correct
+			(the texture should have the same values in the shaders that the source image has)
+*/
+
+#ifndef EAE6320_TEXTUREBUILDER_PNGDECODER_H
+#define EAE6320_TEXTUREBUILDER_PNGDECODER_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <Engine/Results/Results.h>
+#include <string>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		struct sImage;
+	}
+}
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace PngDecoder
+		{
+			// This returns true if the data starts with the PNG signature
+			bool IsPng( const void* const i_data, const size_t i_size );
+
+			cResult Decode( const void* const i_data, const size_t i_size, sImage& o_image, std::string* const o_errorMessage = nullptr );
+		}
+	}
+}
+
+#endif	// EAE6320_TEXTUREBUILDER_PNGDECODER_H
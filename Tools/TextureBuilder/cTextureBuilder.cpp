@@ -0,0 +1,258 @@
+// Include Files
+//==============
+
+#include "cTextureBuilder.h"
+
+#include "BlockCompression.h"
+#include "MipMaps.h"
+#include "PngDecoder.h"
+#include "sImage.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Engine/Graphics/TextureFormats.h>
+#include <Engine/Math/Functions.h>
+#include <Engine/Platform/Platform.h>
+#include <string>
+#include <Tools/AssetBuildLibrary/BuildTrace.h>
+#include <Tools/AssetBuildLibrary/Functions.h>
+#include <utility>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	eae6320::cResult BuildTexture( const char* const i_path, const eae6320::Graphics::TextureFormats::Compression::eType i_compressionType,
+		eae6320::Assets::sImage&& i_sourceImage, eae6320::Graphics::TextureFormats::sTextureInfo& o_textureInfo, std::vector<uint8_t>& o_textureData );
+	eae6320::cResult GetCompressionType( const char* const i_path, const std::vector<std::string>& i_arguments,
+		eae6320::Graphics::TextureFormats::Compression::eType& o_compressionType );
+	eae6320::cResult LoadSourceImage( const char* const i_path, eae6320::Assets::sImage& o_image );
+	eae6320::cResult WriteTextureToFile( const char* const i_path_target,
+		const eae6320::Graphics::TextureFormats::sTextureInfo& i_textureInfo, const std::vector<uint8_t>& i_textureData );
+}
+
+// Inherited Implementation
+//=========================
+
+// Build
+//------
+
+eae6320::cResult eae6320::Assets::cTextureBuilder::Build( const std::vector<std::string>& i_arguments )
+{
+	auto result = eae6320::Results::Success;
+
+	sImage sourceImage;
+	auto compressionType = Graphics::TextureFormats::Compression::Unknown;
+	Graphics::TextureFormats::sTextureInfo textureInfo{};
+	std::vector<uint8_t> textureData;
+
+	// Decide which format to compress to
+	// (if no format was requested it is decided after the image is loaded)
+	if ( !( result = GetCompressionType( m_path_source, i_arguments, compressionType ) ) )
+	{
+		goto OnExit;
+	}
+	// Load the source image
+	{
+		BuildTrace::cScope traceScope( "Load", "BuilderPhase" );
+		if ( !( result = LoadSourceImage( m_path_source, sourceImage ) ) )
+		{
+			goto OnExit;
+		}
+		traceScope.AddArgument( "bytesDecoded", static_cast<uint64_t>( sourceImage.pixels.size() ) );
+	}
+	// Build the texture
+	{
+		BuildTrace::cScope traceScope( "Build", "BuilderPhase" );
+		if ( compressionType == Graphics::TextureFormats::Compression::Unknown )
+		{
+			// The default formats are:
+			//	* BC1 (compressed with no alpha, used to be known as "DXT1")
+			//	* BC3 (compressed with alpha, used to be known as "DXT5")
+			compressionType = sourceImage.IsAlphaAllOpaque()
+				? Graphics::TextureFormats::Compression::BC1 : Graphics::TextureFormats::Compression::BC3;
+		}
+		if ( !( result = BuildTexture( m_path_source, compressionType, std::move( sourceImage ), textureInfo, textureData ) ) )
+		{
+			goto OnExit;
+		}
+	}
+	// Write the texture to a file
+	{
+		BuildTrace::cScope traceScope( "Write", "BuilderPhase" );
+		if ( !( result = WriteTextureToFile( m_path_target, textureInfo, textureData ) ) )
+		{
+			goto OnExit;
+		}
+		// The texture information that precedes the pixels isn't counted
+		traceScope.AddArgument( "bytesWritten", static_cast<uint64_t>( textureData.size() ) );
+	}
+
+OnExit:
+
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	eae6320::cResult BuildTexture( const char* const i_path, const eae6320::Graphics::TextureFormats::Compression::eType i_compressionType,
+		eae6320::Assets::sImage&& i_sourceImage, eae6320::Graphics::TextureFormats::sTextureInfo& o_textureInfo, std::vector<uint8_t>& o_textureData )
+	{
+		auto image = std::move( i_sourceImage );
+		// PNG images are upside-down from what OpenGL expects
+#if defined ( EAE6320_PLATFORM_GL )
+		image.FlipVertically();
+#endif
+		// Textures used by the GPU have size restrictions that standard images don't
+		{
+			uint32_t targetWidth = image.width;
+			uint32_t targetHeight = image.height;
+			{
+				// Direct3D will only load BC compressed textures whose dimensions are multiples of 4
+				// ("BC" stands for "block compression", and each block is 4x4)
+				{
+					// Round up to the nearest multiple of 4
+					constexpr uint32_t blockSize = 4;
+					targetWidth = eae6320::Math::RoundUpToMultiple_powerOf2( targetWidth, blockSize );
+					targetHeight = eae6320::Math::RoundUpToMultiple_powerOf2( targetHeight, blockSize );
+				}
+				// Direct3D can't support textures over a certain size
+				// (this is D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION)
+				{
+					constexpr uint32_t maxDimension = 16384;
+					targetWidth = std::min( targetWidth, maxDimension );
+					targetHeight = std::min( targetHeight, maxDimension );
+				}
+			}
+			if ( ( targetWidth != image.width ) || ( targetHeight != image.height ) )
+			{
+				eae6320::Assets::sImage resizedImage;
+				eae6320::Assets::MipMaps::Resize( image, targetWidth, targetHeight, resizedImage );
+				image = std::move( resizedImage );
+			}
+		}
+		// Fill in the texture information
+		{
+			// The size was limited above, and so the dimensions always fit
+			o_textureInfo.width = static_cast<uint16_t>( image.width );
+			o_textureInfo.height = static_cast<uint16_t>( image.height );
+			o_textureInfo.mipMapCount = static_cast<uint8_t>( eae6320::Assets::MipMaps::CalculateMipLevelCount( image.width, image.height ) );
+			o_textureInfo.compressionType = i_compressionType;
+		}
+		// Generate MIP maps
+		std::vector<eae6320::Assets::sImage> mipMaps;
+		eae6320::Assets::MipMaps::Generate( std::move( image ), mipMaps );
+		// Compress the texture
+		{
+			std::string errorMessage;
+			if ( !eae6320::Assets::BlockCompression::Compress( mipMaps, i_compressionType, o_textureData, &errorMessage ) )
+			{
+				eae6320::Assets::OutputErrorMessageWithFileInfo( i_path, errorMessage.c_str() );
+				return eae6320::Results::Failure;
+			}
+		}
+
+		return eae6320::Results::Success;
+	}
+
+	eae6320::cResult GetCompressionType( const char* const i_path, const std::vector<std::string>& i_arguments,
+		eae6320::Graphics::TextureFormats::Compression::eType& o_compressionType )
+	{
+		o_compressionType = eae6320::Graphics::TextureFormats::Compression::Unknown;
+		if ( !i_arguments.empty() )
+		{
+			const auto& argument = i_arguments[0];
+			if ( argument == "BC1" )
+			{
+				o_compressionType = eae6320::Graphics::TextureFormats::Compression::BC1;
+			}
+			else if ( argument == "BC3" )
+			{
+				o_compressionType = eae6320::Graphics::TextureFormats::Compression::BC3;
+			}
+			else if ( argument == "BC4" )
+			{
+				o_compressionType = eae6320::Graphics::TextureFormats::Compression::BC4;
+			}
+			else if ( argument == "BC5" )
+			{
+				o_compressionType = eae6320::Graphics::TextureFormats::Compression::BC5;
+			}
+			else
+			{
+				eae6320::Assets::OutputErrorMessageWithFileInfo( i_path,
+					"\"%s\" is not a valid texture compression format (it must be \"BC1\", \"BC3\", \"BC4\", or \"BC5\")", argument.c_str() );
+				return eae6320::Results::Failure;
+			}
+		}
+
+		return eae6320::Results::Success;
+	}
+
+	eae6320::cResult LoadSourceImage( const char* const i_path, eae6320::Assets::sImage& o_image )
+	{
+		auto result = eae6320::Results::Success;
+
+		eae6320::Platform::sDataFromFile dataFromFile;
+		{
+			std::string errorMessage;
+			if ( !( result = eae6320::Platform::LoadBinaryFile( i_path, dataFromFile, &errorMessage ) ) )
+			{
+				eae6320::Assets::OutputErrorMessageWithFileInfo( i_path, errorMessage.c_str() );
+				goto OnExit;
+			}
+		}
+		// The image's format is deduced by looking at its first bytes rather than its file extension
+		if ( !eae6320::Assets::PngDecoder::IsPng( dataFromFile.data, dataFromFile.size ) )
+		{
+			result = eae6320::Results::InvalidFile;
+			eae6320::Assets::OutputErrorMessageWithFileInfo( i_path, "The source image isn't a PNG (the only format that the texture builder supports)" );
+			goto OnExit;
+		}
+		{
+			std::string errorMessage;
+			if ( !( result = eae6320::Assets::PngDecoder::Decode( dataFromFile.data, dataFromFile.size, o_image, &errorMessage ) ) )
+			{
+				eae6320::Assets::OutputErrorMessageWithFileInfo( i_path, "The PNG couldn't be decoded: %s", errorMessage.c_str() );
+				goto OnExit;
+			}
+		}
+		if ( ( o_image.width == 0 ) || ( o_image.height == 0 ) )
+		{
+			result = eae6320::Results::InvalidFile;
+			eae6320::Assets::OutputErrorMessageWithFileInfo( i_path, "The source image is empty" );
+			goto OnExit;
+		}
+
+	OnExit:
+
+		dataFromFile.Free();
+
+		return result;
+	}
+
+	eae6320::cResult WriteTextureToFile( const char* const i_path_target,
+		const eae6320::Graphics::TextureFormats::sTextureInfo& i_textureInfo, const std::vector<uint8_t>& i_textureData )
+	{
+		// The texture information is followed by the data for each MIP map
+		std::vector<uint8_t> fileData( sizeof( i_textureInfo ) + i_textureData.size() );
+		memcpy( fileData.data(), &i_textureInfo, sizeof( i_textureInfo ) );
+		if ( !i_textureData.empty() )
+		{
+			memcpy( fileData.data() + sizeof( i_textureInfo ), i_textureData.data(), i_textureData.size() );
+		}
+
+		std::string errorMessage;
+		const auto result = eae6320::Platform::WriteBinaryFile( i_path_target, fileData.data(), fileData.size(), &errorMessage );
+		if ( !result )
+		{
+			eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_target, errorMessage.c_str() );
+		}
+		return result;
+	}
+}
@@ -1,5 +1,10 @@
 /*
 	This class builds hardware-ready textures from source images
+
+	Textures are built without any platform-specific libraries:
+		* The source image must be a PNG
+		* An optional argument chooses the compression format ("BC1", "BC3", "BC4", or "BC5");
+			otherwise BC1 is used for opaque images and BC3 for images with alpha
 */
 
 #ifndef EAE6320_CTEXTUREBUILDER_H
@@ -0,0 +1,30 @@
+// Include Files
+//==============
+
+#include "sImage.h"
+
+#include <algorithm>
+
+// Interface
+//==========
+
+bool eae6320::Assets::sImage::IsAlphaAllOpaque() const
+{
+	for ( size_t i = 3; i < pixels.size(); i += 4 )
+	{
+		if ( pixels[i] != 0xff )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void eae6320::Assets::sImage::FlipVertically()
+{
+	const auto rowSize = static_cast<size_t>( width ) * 4;
+	for ( uint32_t y_top = 0, y_bottom = height - 1; y_top < y_bottom; ++y_top, --y_bottom )
+	{
+		std::swap_ranges( GetPixel( 0, y_top ), GetPixel( 0, y_top ) + rowSize, GetPixel( 0, y_bottom ) );
+	}
+}
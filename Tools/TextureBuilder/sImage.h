@@ -0,0 +1,54 @@
+/*
+	An image is the uncompressed pixels that a texture is built from
+*/
+
+#ifndef EAE6320_TEXTUREBUILDER_SIMAGE_H
+#define EAE6320_TEXTUREBUILDER_SIMAGE_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Struct Declaration
+//===================
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		struct sImage
+		{
+			// Data
+			//=====
+
+			uint32_t width = 0, height = 0;
+			// Each pixel is 4 bytes (RGBA),
+			// and the rows are stored from the top of the image to the bottom without any padding
+			std::vector<uint8_t> pixels;
+
+			// Interface
+			//==========
+
+			const uint8_t* GetPixel( const uint32_t i_x, const uint32_t i_y ) const { return pixels.data() + ( ( ( static_cast<size_t>( i_y ) * width ) + i_x ) * 4 ); }
+			uint8_t* GetPixel( const uint32_t i_x, const uint32_t i_y ) { return pixels.data() + ( ( ( static_cast<size_t>( i_y ) * width ) + i_x ) * 4 ); }
+
+			bool IsAlphaAllOpaque() const;
+			void FlipVertically();
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			void Resize( const uint32_t i_width, const uint32_t i_height )
+			{
+				width = i_width;
+				height = i_height;
+				pixels.resize( static_cast<size_t>( i_width ) * i_height * 4 );
+			}
+		};
+	}
+}
+
+#endif	// EAE6320_TEXTUREBUILDER_SIMAGE_H